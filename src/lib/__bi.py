@@ -43,7 +43,7 @@ def chr(n):
     }
 
     /* Raise ValueError if arg is not int within range(256) */
-    n = ((pPmInt_t)pn)->val;
+    n = INT_GET_VAL(pn);
     if ((n < 0) || (n > 255))
     {
         PM_RAISE(retval, PM_RET_EX_VAL);
@@ -64,8 +64,7 @@ def dir(o):
     pPmObj_t po;
     pPmObj_t pk;
     pPmObj_t pl;
-    pSeglist_t psl;
-    int16_t i;
+    uint16_t i;
     uint8_t objid;
 
     /* Use globals if no arg given */
@@ -126,11 +125,9 @@ def dir(o):
         PM_RETURN_IF_ERROR(retval);
 
         /* Copy dict's keys to the list */
-        psl = ((pPmDict_t)po)->d_keys;
-        for (i = 0; i < ((pPmDict_t)po)->length; i++)
+        i = 0;
+        while (dict_getNext(po, &i, &pk, C_NULL) == PM_RET_OK)
         {
-            retval = seglist_getItem(psl, i, &pk);
-            PM_RETURN_IF_ERROR(retval);
             heap_gcPushTempRoot(pl, &objid);
             retval = list_append(pl, pk);
             heap_gcPopTempRoot(objid);
@@ -476,7 +473,7 @@ def range(a, b, c):
             pc = NATIVE_GET_LOCAL(2);
 
             /* If 3rd arg is 0, ValueError */
-            if (((pPmInt_t)pc)->val == 0)
+            if (INT_GET_VAL(pc) == 0)
             {
                 PM_RAISE(retval, PM_RET_EX_VAL);
                 return retval;
@@ -494,11 +491,11 @@ def range(a, b, c):
     PM_RETURN_IF_ERROR(retval);
 
     /* Iterate depending on counting direction */
-    if (((pPmInt_t)pc)->val > 0)
+    if (INT_GET_VAL(pc) > 0)
     {
-        for (i = ((pPmInt_t)pa)->val;
-             i < ((pPmInt_t)pb)->val;
-             i += ((pPmInt_t)pc)->val)
+        for (i = INT_GET_VAL(pa);
+             i < INT_GET_VAL(pb);
+             i += INT_GET_VAL(pc))
         {
             heap_gcPushTempRoot(pr, &objid1);
             retval = int_new(i, &pi);
@@ -516,9 +513,9 @@ def range(a, b, c):
     }
     else
     {
-        for (i = ((pPmInt_t)pa)->val;
-             i > ((pPmInt_t)pb)->val;
-             i += ((pPmInt_t)pc)->val)
+        for (i = INT_GET_VAL(pa);
+             i > INT_GET_VAL(pb);
+             i += INT_GET_VAL(pc))
         {
             heap_gcPushTempRoot(pr, &objid1);
             retval = int_new(i, &pi);
@@ -607,9 +604,9 @@ def sum(s):
         if (OBJ_GET_TYPE(po) == OBJ_TYPE_INT)
         {
             /* Add value to sum */
-            n += ((pPmInt_t)po)->val;
+            n += INT_GET_VAL(po);
 #ifdef HAVE_FLOAT
-            f += (float)((pPmInt_t)po)->val;
+            f += (float)INT_GET_VAL(po);
 #endif /* HAVE_FLOAT */
         }
 
@@ -791,6 +788,7 @@ class Generator(object):
             /* The pfa tuple is (func, [arg0, ... argN]) */
             ((pPmFrame_t)pframe)->fo_locals[i] = ((pPmTuple_t)pfa)->val[i + 1];
         }
+        HEAP_GC_RESCAN_BARRIER(pframe);
 
         /* Store frame in None attr of instance */
         heap_gcPushTempRoot(pframe, &objid);
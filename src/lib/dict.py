@@ -55,7 +55,6 @@ def keys(d):
     pPmObj_t pd;
     pPmObj_t pl;
     pPmObj_t pk;
-    pSeglist_t psl;
     uint16_t i;
     PmReturn_t retval = PM_RET_OK;
     uint8_t objid;
@@ -72,13 +71,11 @@ def keys(d):
     retval = list_new(&pl);
     PM_RETURN_IF_ERROR(retval);
 
-    /* Iterate through the keys seglist */
-    psl = ((pPmDict_t)pd)->d_keys;
-    for (i = 0; i < ((pPmDict_t)pd)->length; i++)
+    /* Iterate through the keys */
+    i = 0;
+    while (dict_getNext(pd, &i, &pk, C_NULL) == PM_RET_OK)
     {
-        /* Get the key and append it to the list */
-        retval = seglist_getItem(psl, i, &pk);
-        PM_RETURN_IF_ERROR(retval);
+        /* Append the key to the list */
         heap_gcPushTempRoot(pl, &objid);
         retval = list_append(pl, pk);
         heap_gcPopTempRoot(objid);
@@ -101,8 +98,8 @@ def values(d):
     """__NATIVE__
     pPmObj_t pd;
     pPmObj_t pl;
+    pPmObj_t pk;
     pPmObj_t pv;
-    pSeglist_t psl;
     uint16_t i;
     PmReturn_t retval = PM_RET_OK;
     uint8_t objid;
@@ -119,13 +116,11 @@ def values(d):
     retval = list_new(&pl);
     PM_RETURN_IF_ERROR(retval);
 
-    /* Iterate through the values seglist */
-    psl = ((pPmDict_t)pd)->d_vals;
-    for (i = 0; i < ((pPmDict_t)pd)->length; i++)
+    /* Iterate through the values */
+    i = 0;
+    while (dict_getNext(pd, &i, &pk, &pv) == PM_RET_OK)
     {
-        /* Get the value and append it to the list */
-        retval = seglist_getItem(psl, i, &pv);
-        PM_RETURN_IF_ERROR(retval);
+        /* Append the value to the list */
         heap_gcPushTempRoot(pl, &objid);
         retval = list_append(pl, pv);
         heap_gcPopTempRoot(objid);
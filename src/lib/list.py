@@ -135,7 +135,7 @@ def insert(l, i, o):
     }
 
     /* Insert the object before the given index */
-    i = (uint16_t)((pPmInt_t)pi)->val;
+    i = (uint16_t)INT_GET_VAL(pi);
     retval = list_insert(pl, i, po);
 
     if (retval != PM_RET_OK)
@@ -177,7 +177,7 @@ def pop(l, i):
             PM_RAISE(retval, PM_RET_EX_TYPE);
             return retval;
         }
-        i = (uint16_t)((pPmInt_t)pi)->val;
+        i = (uint16_t)INT_GET_VAL(pi);
     }
     else
     {
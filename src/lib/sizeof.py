@@ -49,12 +49,28 @@ def sizeof(obj):
         sizeof(PmDict_t),
         0,
         0,
+#ifdef HAVE_LIST_ARRAYS
+        sizeof(PmListArray_t),
+#else
         0,
+#endif /* HAVE_LIST_ARRAYS */
+#if USE_STRING_CACHE
+        sizeof(PmStringTable_t),
+#else
         0,
+#endif /* USE_STRING_CACHE */
+#ifdef HAVE_HASHED_DICTS
+        sizeof(PmDictTable_t),
+#else
         0,
+#endif /* HAVE_HASHED_DICTS */
         0,
         sizeof(PmFrame_t),
-        sizeof(PmBlock_t),
+#ifdef HAVE_FRAME_STACK
+        sizeof(PmFrameStack_t),
+#else
+        0,
+#endif /* HAVE_FRAME_STACK */
         sizeof(Segment_t),
         sizeof(Seglist_t),
         sizeof(PmSeqIter_t),
@@ -71,7 +87,7 @@ def sizeof(obj):
     pobj = NATIVE_GET_LOCAL(0);
     if (OBJ_GET_TYPE(pobj) == OBJ_TYPE_INT)
     {
-        n = ((pPmInt_t)pobj)->val;
+        n = INT_GET_VAL(pobj);
         if ((n >= 0) && (n < 32))
         {
             /* Return the size of the type represented by the integer */
@@ -79,8 +95,9 @@ def sizeof(obj):
         }
         else
         {
-            /* Return the size of an integer object */
-            retval = int_new(OBJ_GET_SIZE(pobj), &psize);
+            /* Return the size of an integer object (a tagged int has none) */
+            retval = int_new(OBJ_IS_TAGGED(pobj) ? 0 : OBJ_GET_SIZE(pobj),
+                             &psize);
         }
     }
     else
@@ -116,9 +133,13 @@ def print_sizes():
         'CIO',
         'LST',
         'DIC',
-        0, 0, 0, 0, 0, 0,
+        0, 0,
+        'LAR',
+        'STB',
+        'DTB',
+        0,
         'FRM',
-        'BLK',
+        'FST',
         'SEG',
         'SGL',
         'SQI',
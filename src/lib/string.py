@@ -72,7 +72,7 @@ def atoi(a, b):
             return retval;
         }
 
-        base = ((pPmInt_t)pb)->val;
+        base = INT_GET_VAL(pb);
 
         /* Raise ValueError if base is out of range */
         if ((base < 0) || (base == 1) || (base > 36))
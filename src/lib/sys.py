@@ -12,6 +12,29 @@
 #  import sys
 #
 
+"""__NATIVE__
+/* Puts n in the dict under the given key, which must be the newest object */
+static PmReturn_t
+sys_putStat(pPmObj_t pdict, pPmObj_t pkey, uint32_t n)
+{
+    PmReturn_t retval;
+    pPmObj_t pval;
+    uint8_t objid;
+    uint8_t valid;
+
+    heap_gcPushTempRoot(pkey, &objid);
+    retval = int_new((int32_t)n, &pval);
+    if (retval == PM_RET_OK)
+    {
+        heap_gcPushTempRoot(pval, &valid);
+        retval = dict_setItem(pdict, pkey, pval);
+    }
+    heap_gcPopTempRoot(objid);
+    return retval;
+}
+"""
+
+
 #### TODO
 # modules = None #set ptr to dict w/native func
 # platform string or device id, rand
@@ -68,7 +91,7 @@ def gc():
         return retval;
     }
 
-    retval = heap_gcRun();
+    retval = heap_gcCollect();
 #endif
     NATIVE_SET_TOS(PM_NONE);
 
@@ -77,6 +100,101 @@ def gc():
     pass
 
 
+#
+# Returns a dict of heap and garbage collector statistics.
+# The dict's "types" item maps each object type number to the number
+# of objects of that type created so far.
+#
+def gcstats():
+    """__NATIVE__
+    PmReturn_t retval;
+    PmHeapStats_t stats;
+    pPmObj_t pdict;
+    pPmObj_t ptypes;
+    pPmObj_t pkey;
+    uint8_t const *pname;
+    uint8_t objid;
+    uint8_t typesid;
+    uint8_t i;
+
+    /* The names of the statistics, in the order of the values below */
+    static char const * const names[] = {
+        "size", "avail", "maxfree", "nfree", "collections",
+        "minor_collections", "compactions", "gc_ms", "max_pause_ms",
+        "max_pause_work", "reclaimed", "allocs", "alloc_bytes"
+    };
+    static uint8_t const typesstr[] = "types";
+    uint32_t values[13];
+
+    /* If wrong number of args, raise TypeError */
+    if (NATIVE_GET_NUM_ARGS() != 0)
+    {
+        PM_RAISE(retval, PM_RET_EX_TYPE);
+        return retval;
+    }
+
+    heap_getStats(&stats);
+    values[0] = stats.size;
+    values[1] = stats.avail;
+    values[2] = stats.maxfree;
+    values[3] = stats.nfree;
+    values[4] = stats.gc_fullcount;
+    values[5] = stats.gc_minorcount;
+    values[6] = stats.gc_compactcount;
+    values[7] = stats.gc_totalms;
+    values[8] = stats.gc_maxpausems;
+    values[9] = stats.gc_maxpausework;
+    values[10] = stats.gc_reclaimed;
+    values[11] = stats.allocs;
+    values[12] = stats.allocbytes;
+
+    retval = dict_new(&pdict);
+    PM_RETURN_IF_ERROR(retval);
+    heap_gcPushTempRoot(pdict, &objid);
+
+    /* Put each statistic in the dict under its name */
+    for (i = 0; i < 13; i++)
+    {
+        pname = (uint8_t const *)names[i];
+        retval = string_new(&pname, &pkey);
+        PM_BREAK_IF_ERROR(retval);
+        retval = sys_putStat(pdict, pkey, values[i]);
+        PM_BREAK_IF_ERROR(retval);
+    }
+
+    /* Put the count of each type of object in a dict of its own */
+    if (retval == PM_RET_OK)
+    {
+        retval = dict_new(&ptypes);
+    }
+    if (retval == PM_RET_OK)
+    {
+        heap_gcPushTempRoot(ptypes, &typesid);
+        pname = typesstr;
+        retval = string_new(&pname, &pkey);
+    }
+    if (retval == PM_RET_OK)
+    {
+        retval = dict_setItem(pdict, pkey, ptypes);
+    }
+    for (i = 0; (i < HEAP_NUM_TYPES) && (retval == PM_RET_OK); i++)
+    {
+        if (stats.typecount[i] != 0)
+        {
+            retval = int_new(i, &pkey);
+            PM_BREAK_IF_ERROR(retval);
+            retval = sys_putStat(ptypes, pkey, stats.typecount[i]);
+        }
+    }
+    heap_gcPopTempRoot(objid);
+    PM_RETURN_IF_ERROR(retval);
+
+    NATIVE_SET_TOS(pdict);
+    return retval;
+    """
+    pass
+
+
 #
 # Gets a byte from the platform's default I/O
 # Returns the byte in the LSB of the returned integer
@@ -143,6 +261,7 @@ def heap():
     /* Put the two heap values in the tuple */
     ((pPmTuple_t)ptup)->val[0] = pavail;
     ((pPmTuple_t)ptup)->val[1] = psize;
+    HEAP_GC_RESCAN_BARRIER(ptup);
 
     /* Return the tuple on the stack */
     NATIVE_SET_TOS(ptup);
@@ -177,7 +296,7 @@ def putb(b):
         return retval;
     }
 
-    b = ((pPmInt_t)pb)->val & 0xFF;
+    b = INT_GET_VAL(pb) & 0xFF;
     retval = plat_putByte(b);
     NATIVE_SET_TOS(PM_NONE);
     return retval;
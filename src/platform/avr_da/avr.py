@@ -35,7 +35,7 @@ def delay(ms):
 
     pPmObj_t pa = NATIVE_GET_LOCAL(0);
     if (OBJ_GET_TYPE(pa) == OBJ_TYPE_INT) {
-        _delay_ms((double) ((pPmInt_t)pa)->val);
+        _delay_ms((double) INT_GET_VAL(pa));
     }
     else if (OBJ_GET_TYPE(pa) == OBJ_TYPE_FLT) {
         _delay_ms((double) ((pPmFloat_t)pa)->val);
@@ -127,7 +127,7 @@ def _pin(pin_no, value):
             PM_RAISE(retval, PM_RET_EX_TYPE);
             return retval;
         }
-        avr_pin_set(pin_no, ((pPmInt_t)pa)->val);
+        avr_pin_set(pin_no, INT_GET_VAL(pa));
     }
     pa = (avr_pin_get(pin_no)) ? PM_TRUE : PM_FALSE;
 
@@ -156,7 +156,7 @@ def _pin_config(pin_no, config):
         return retval;
     }
 
-    avr_pin_config(pin_no, ((pPmInt_t)pa)->val);
+    avr_pin_config(pin_no, INT_GET_VAL(pa));
 
     NATIVE_SET_TOS(PM_NONE);
     return retval;
@@ -219,7 +219,7 @@ def _spi_config(inst, mode, frequency, mosi, miso, msck):
     PM_CHECK_FUNCTION( getRangedUint8(pa, 0, 3, &mode));
 
     pPmObj_t pf = NATIVE_GET_LOCAL(2);
-    uint32_t frequency =  ((pPmInt_t)pf)->val;
+    uint32_t frequency =  INT_GET_VAL(pf);
     PM_CHECK_FUNCTION( getRangedInt(pf, 0, F_CPU, (int32_t*)&frequency));
     
     uint8_t mosi;
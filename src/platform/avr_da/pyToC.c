@@ -19,7 +19,7 @@ getInt32(pPmObj_t ppo, int32_t* pi32_val)
       "Object must be an int");
 
     // Get the value, now that we know it's an int
-    *pi32_val = ((pPmInt_t) ppo)->val;
+    *pi32_val = INT_GET_VAL(ppo);
 
     return retval;
 }
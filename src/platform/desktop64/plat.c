@@ -24,6 +24,7 @@
 #include <unistd.h>
 #include <signal.h>
 #include <string.h>
+#include <sys/mman.h>
 
 #include "pm.h"
 
@@ -144,6 +145,41 @@ plat_getMsTicks(uint32_t *r_ticks)
 }
 
 
+#ifdef HAVE_HEAP_GROW
+/* Desktop target maps anonymous pages for a new heap region */
+PmReturn_t
+plat_heapGrow(uint32_t size, uint8_t **r_base, uint32_t *r_size)
+{
+    PmReturn_t retval = PM_RET_OK;
+    void *p;
+    long pagesize;
+
+    /* Round the size up to a whole number of pages */
+    pagesize = sysconf(_SC_PAGESIZE);
+    size = (uint32_t)((size + pagesize - 1) & ~(pagesize - 1));
+
+    p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+             -1, 0);
+    if (p == MAP_FAILED)
+    {
+        PM_RAISE(retval, PM_RET_EX_MEM);
+        return retval;
+    }
+
+    *r_base = (uint8_t *)p;
+    *r_size = size;
+    return retval;
+}
+
+
+void
+plat_heapRelease(uint8_t *base, uint32_t size)
+{
+    munmap(base, size);
+}
+#endif /* HAVE_HEAP_GROW */
+
+
 void
 plat_reportError(PmReturn_t result)
 {
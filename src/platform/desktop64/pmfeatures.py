@@ -13,6 +13,23 @@
 PM_FEATURES = {
     "HAVE_PRINT": True,
     "HAVE_GC": True,
+    "HAVE_GC_INCREMENTAL": True,
+    "HAVE_GC_NURSERY": True,
+    "HAVE_GC_COMPACT": True,
+    "HAVE_GC_LAZY_SWEEP": True,
+    "HAVE_HEAP_POOLS": True,
+    "HEAP_POOL_SLOTS": 64,
+    "HAVE_HEAP_STATS": True,
+    "HAVE_HEAP_GROW": True,
+    "HAVE_THREADED_DISPATCH": True,
+    "HAVE_SUPERINSTRUCTIONS": True,
+    "HAVE_INLINE_CACHES": True,
+    "HAVE_FAST_CALLS": True,
+    "HAVE_TAGGED_INTS": True,
+    "HAVE_SMALL_INT_CACHE": False,
+    "HAVE_FRAME_STACK": True,
+    "HAVE_HASHED_DICTS": True,
+    "HAVE_LIST_ARRAYS": True,
     "HAVE_FLOAT": True,
     "HAVE_DEL": True,
     "HAVE_IMPORTS": True,
@@ -13,6 +13,12 @@
 PM_FEATURES = {
     "HAVE_PRINT": True,
     "HAVE_GC": True,
+    "HAVE_GC_INCREMENTAL": False,
+    "HAVE_GC_NURSERY": False,
+    "HAVE_GC_COMPACT": False,
+    "HAVE_GC_LAZY_SWEEP": False,
+    "HAVE_HEAP_POOLS": False,
+    "HAVE_HEAP_STATS": False,
     "HAVE_FLOAT": True,
     "HAVE_DEL": True,
     "HAVE_IMPORTS": True,
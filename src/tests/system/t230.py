@@ -87,7 +87,7 @@ class File():
         PM_RETURN_IF_ERROR(retval);
         /* Removed so file isn't created (doesn't interfere with test) */
         /*
-        pf = (FILE *)((pPmInt_t)pn)->val;
+        pf = (FILE *)INT_GET_VAL(pn);
         fclose(pf);
         */
 
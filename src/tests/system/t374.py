@@ -38,7 +38,7 @@ def __gc_test(val):
         return retval;
     }
 
-    nval = ((pPmInt_t)pval)->val;
+    nval = INT_GET_VAL(pval);
 
     /* Removed so stdio isn't required */
     /* printf("%d [%d]\\n", nval-2, nval); */
@@ -0,0 +1,39 @@
+# This file is Copyright 2011 Dean Hall.
+#
+# This file is part of the Python-on-a-Chip program.
+# Python-on-a-Chip is free software: you can redistribute it and/or modify
+# it under the terms of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1.
+#
+# Python-on-a-Chip is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# A copy of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1
+# is seen in the file COPYING up one directory from this.
+
+#
+# System Test 385
+# Tests sys.gcstats()
+#
+
+import sys
+
+s = sys.gcstats()
+assert s["size"] == sys.heap()[1]
+assert s["maxfree"] <= s["avail"]
+assert s["nfree"] > 0
+
+# Make garbage and collect it; sys.gc() sweeps it all, even a lazy sweep
+n = s["collections"]
+r = s["reclaimed"]
+for i in range(100):
+    l = [i, i, i]
+sys.gc()
+s = sys.gcstats()
+assert s["collections"] > n
+assert s["reclaimed"] > r
+assert s["max_pause_work"] > 0
+
+# The lists above are counted by type (0x12 is a list)
+if s["allocs"] > 0:
+    assert s["alloc_bytes"] > s["allocs"]
+    assert s["types"][0x12] >= 100
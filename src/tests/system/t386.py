@@ -0,0 +1,125 @@
+# This file is Copyright 2011 Dean Hall.
+#
+# This file is part of the Python-on-a-Chip program.
+# Python-on-a-Chip is free software: you can redistribute it and/or modify
+# it under the terms of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1.
+#
+# Python-on-a-Chip is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# A copy of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1
+# is seen in the file COPYING up one directory from this.
+
+#
+# System Test 386
+# Tests superinstructions give the same results as the unfused bytecodes.
+# Code in functions uses LOAD_FAST and LOAD_GLOBAL, so it is fused;
+# code at module level uses LOAD_NAME, so it is not.
+#
+
+class C(object):
+    def __init__(self):
+        self.x = 3
+
+def g():
+    return 5
+
+
+# LOAD_FAST_LOAD_FAST, LOAD_FAST_LOAD_CONST
+def add(a, b):
+    return a + b + 1
+
+a = 4
+b = 7
+assert add(a, b) == a + b + 1
+
+
+# LOAD_FAST_LOAD_ATTR
+def getx(o):
+    return o.x
+
+o = C()
+assert getx(o) == o.x
+
+
+# STORE_FAST_LOAD_FAST
+def twice(a):
+    t = a * 2
+    return t
+
+assert twice(a) == a * 2
+
+
+# COMPARE_OP_POP_JUMP_IF_FALSE, COMPARE_OP_POP_JUMP_IF_TRUE
+def lt(a, b):
+    if a < b:
+        return 1
+    return 0
+
+def ge(a, b):
+    if not a < b:
+        return 1
+    return 0
+
+def eq(a, b):
+    if a == b:
+        return 1
+    return 0
+
+def notin(a, b):
+    if not a in b:
+        return 1
+    return 0
+
+for p in ((1, 2), (2, 1), (2, 2), (1.5, 2), (2, 1.5)):
+    x = p[0]
+    y = p[1]
+    r = x < y
+    assert lt(x, y) == r
+    r = not x < y
+    assert ge(x, y) == r
+for p in (("a", "b"), ("b", "b"), (None, 0), (o, o)):
+    x = p[0]
+    y = p[1]
+    r = x == y
+    assert eq(x, y) == r
+l = [1, 2]
+r = not 3 in l
+assert notin(3, l) == r
+r = not 1 in l
+assert notin(1, l) == r
+
+
+# LOAD_GLOBAL_LOAD_FAST, LOAD_GLOBAL_CALL_FUNCTION
+def calls(a):
+    return add(a, 1) + g() + C().x
+
+assert calls(a) == add(a, 1) + g() + C().x
+
+
+# A jump that lands on the second bytecode of a superinstruction:
+# the path through b jumps to the LOAD_CONST fused with LOAD_FAST d
+def choose(c, b, d):
+    return (b if c else d) + 1
+
+assert choose(0, a, b) == b + 1
+assert choose(1, a, b) == a + 1
+
+
+# A loop whose condition is a superinstruction
+def count(n):
+    i = 0
+    s = 0
+    while i < n:
+        s = s + i
+        i += 1
+    return s
+
+s = 0
+i = 0
+while i < 100:
+    s = s + i
+    i += 1
+assert count(100) == s
+
+print "t386 done"
@@ -0,0 +1,92 @@
+# This file is Copyright 2011 Dean Hall.
+#
+# This file is part of the Python-on-a-Chip program.
+# Python-on-a-Chip is free software: you can redistribute it and/or modify
+# it under the terms of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1.
+#
+# Python-on-a-Chip is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# A copy of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1
+# is seen in the file COPYING up one directory from this.
+
+
+#
+# System Test 387
+# Tests the inline caches of globals see every change to the globals
+# and builtins dicts.
+#
+
+n = 0
+
+def getn():
+    return n
+
+def setn(v):
+    global n
+    n = v
+
+
+# Rebinding a global invalidates a cached LOAD_GLOBAL
+i = 0
+while i < 5:
+    setn(i)
+    assert getn() == i
+    i += 1
+
+
+# A global that shadows a builtin is seen after the builtin was cached
+def size(s):
+    return len(s)
+
+assert size([1, 2]) == 2
+assert size([1, 2]) == 2
+
+def len(s):
+    return 42
+
+assert size([1, 2]) == 42
+del len
+assert size([1, 2]) == 2
+
+
+# Deleting a global and binding it again
+x = 1
+
+def getx():
+    return x
+
+assert getx() == 1
+del x
+x = 2
+assert getx() == 2
+
+
+# LOAD_NAME at module level, while the globals change on every iteration
+total = 0
+for k in range(10):
+    total += k + n
+assert total == 45 + 10 * n
+
+
+# LOAD_NAME in a class body finds names of the class before the globals
+y = 10
+
+class D(object):
+    a = y
+    y = 2
+    b = y
+
+assert D.a == 10
+assert D.b == 2
+assert y == 10
+
+
+# A function defined in a loop sees the global current at each call
+def getz():
+    return z
+
+for z in range(3):
+    assert getz() == z
+
+print "t387 done"
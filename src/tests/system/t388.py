@@ -0,0 +1,143 @@
+# This file is Copyright 2011 Dean Hall.
+#
+# This file is part of the Python-on-a-Chip program.
+# Python-on-a-Chip is free software: you can redistribute it and/or modify
+# it under the terms of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1.
+#
+# Python-on-a-Chip is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# A copy of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1
+# is seen in the file COPYING up one directory from this.
+
+
+#
+# System Test 388
+# Tests the inline caches of attributes see every change to classes
+# and instances.
+#
+
+class A(object):
+    k = 1
+    def val(self):
+        return "A"
+
+class B(A):
+    def val(self):
+        return "B"
+
+class C(object):
+    def val(self):
+        return "C"
+
+def val(o):
+    return o.val()
+
+def getk(o):
+    return o.k
+
+def setk(o, v):
+    o.k = v
+
+
+# More classes at one site than the cache has entries for
+objs = [A(), B(), C(), A(), C(), B()]
+s = ""
+for i in range(3):
+    for o in objs:
+        s = s + val(o)
+assert s == "ABCACB" * 3
+
+
+# A change to a class is seen through its instances and its subclasses
+a = A()
+b = B()
+assert getk(a) == 1
+assert getk(b) == 1
+A.k = 2
+assert getk(a) == 2
+assert getk(b) == 2
+
+
+# An attr stored in an instance hides the attr of the class
+a2 = A()
+assert getk(a2) == 2
+setk(a2, 5)
+assert getk(a2) == 5
+assert getk(a) == 2
+del a2.k
+assert getk(a2) == 2
+
+
+# An attr given to a class after an instance has one by the same name
+class D(object):
+    pass
+
+class E(D):
+    pass
+
+e1 = E()
+e2 = E()
+setk(e1, 7)
+D.k = 3
+assert getk(e1) == 7
+assert getk(e2) == 3
+assert getk(e1) == 7
+
+
+# A method replaced in the class
+def newval(self):
+    return "new"
+
+assert val(a) == "A"
+A.val = newval
+assert val(a) == "new"
+assert val(b) == "B"
+
+
+# Attrs loaded from the class itself
+def getclassk(cls):
+    return cls.k
+
+assert getclassk(A) == 2
+assert getclassk(B) == 2
+B.k = 4
+assert getclassk(B) == 4
+assert getclassk(A) == 2
+assert getk(b) == 4
+
+
+# Stores into instances of different classes at one site
+class F(object):
+    pass
+
+f = F()
+for i in range(3):
+    setk(f, i)
+    setk(e2, i + 10)
+    assert getk(f) == i
+    assert getk(e2) == i + 10
+
+# A change to a base of a base, or to a later base, is seen by a subclass
+class G(object):
+    k = 1
+
+class H(G):
+    pass
+
+class J(object):
+    pass
+
+class K(H, J):
+    pass
+
+k = K()
+assert getk(k) == 1
+G.k = 6
+assert getk(k) == 6
+J.k = 8
+assert getk(k) == 6
+del G.k
+assert getk(k) == 8
+
+print "t388 done"
@@ -0,0 +1,95 @@
+# This file is Copyright 2011 Dean Hall.
+#
+# This file is part of the Python-on-a-Chip program.
+# Python-on-a-Chip is free software: you can redistribute it and/or modify
+# it under the terms of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1.
+#
+# Python-on-a-Chip is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# A copy of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1
+# is seen in the file COPYING up one directory from this.
+
+
+
+#
+# System Test 389
+# Tests that ints of any size work as dict keys, list items, locals and
+# operands, and that they survive garbage collections.
+#
+
+import list
+import sys
+
+# Values at the edges of the tag range of 32-bit targets and of int32
+big = [0, 1, -1, 1000, -1000, 0x3FFFFFFF, -0x40000000, 0x40000000,
+       -0x40000001, 0x7FFFFFFF, -0x7FFFFFFF - 1]
+
+# Arithmetic across the edges
+assert 0x3FFFFFFF + 1 == 0x40000000
+assert 0x40000000 - 1 == 0x3FFFFFFF
+assert -0x40000000 - 1 == -0x40000001
+assert -0x40000001 + 1 == -0x40000000
+assert 0x7FFFFFFF - 0x40000000 == 0x3FFFFFFF
+assert 0x20000000 * 2 == 0x40000000
+assert 0x40000000 / 2 == 0x20000000
+assert (1 << 30) == 0x40000000
+assert (0x40000000 >> 1) == 0x20000000
+assert -(-0x40000000) == 0x40000000
+assert ~0x3FFFFFFF == -0x40000000
+assert (0x7FFFFFFF & 0x40000001) == 0x40000001
+assert (0x40000000 | 1) == 0x40000001
+assert (0x40000001 ^ 1) == 0x40000000
+assert 0x40000000 % 7 == 1
+assert 0x40000000 > 0x3FFFFFFF
+assert -0x40000001 < -0x40000000
+
+# Equal ints are equal whatever their representation
+for n in big:
+    m = n + 1 - 1
+    assert m == n
+    assert not (m != n)
+    assert `m` == `n`
+
+# Ints and bools compare as before
+assert 1 == True
+assert 0 == False
+assert not (2 == True)
+
+# Ints as dict keys and list items
+d = {}
+for n in big:
+    d[n] = n * 0 + 5
+for n in big:
+    m = n - 1 + 1
+    assert d[m] == 5
+assert len(d) == len(big)
+l = []
+for n in big:
+    list.append(l, n)
+for i in range(len(big)):
+    assert l[i] == big[i]
+assert list.index(l, 0x40000000) == 7
+
+# Ints survive garbage collections in locals, lists and dicts
+def churn(n):
+    s = 0
+    i = 0
+    while i < n:
+        s = s + i * 3 - (i & 1)
+        i += 1
+    return s
+
+for j in range(5):
+    assert churn(2000) == 5996000
+    sys.gc()
+    for i in range(len(big)):
+        assert l[i] == big[i]
+    assert d[-0x7FFFFFFF - 1] == 5
+
+# Formatting and conversion
+assert "%d" % 0x40000000 == "1073741824"
+assert "%d" % -0x40000001 == "-1073741825"
+assert `-1000` == "-1000"
+
+print "t389 ok"
@@ -0,0 +1,85 @@
+# This file is Copyright 2011 Dean Hall.
+#
+# This file is part of the Python-on-a-Chip program.
+# Python-on-a-Chip is free software: you can redistribute it and/or modify
+# it under the terms of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1.
+#
+# Python-on-a-Chip is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# A copy of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1
+# is seen in the file COPYING up one directory from this.
+
+
+
+#
+# System Test 390
+# Tests that loops keep their blocks in the frame: nested loops, break,
+# loops over generators and loops in frames that are left and resumed.
+#
+
+import list
+import sys
+
+# Nested loops with break at each depth
+n = 0
+for i in range(4):
+    for j in range(4):
+        while 1:
+            n += 1
+            break
+        if j == 2:
+            break
+    if i == 3:
+        break
+assert n == 12
+
+# A break in a function leaves only its loop
+def find(l, x):
+    r = "missing"
+    for y in l:
+        for z in range(2):
+            if y == x:
+                r = "found"
+                break
+        if r == "found":
+            break
+    return r
+
+assert find([1, 2, 3], 2) == "found"
+assert find([1, 2, 3], 4) == "missing"
+
+# A generator keeps its loop blocks across yields
+def gen(n):
+    for i in range(n):
+        for j in range(2):
+            yield i * 2 + j
+
+l = []
+for x in gen(3):
+    for y in range(2):
+        list.append(l, x * 10 + y)
+assert l == [0, 1, 10, 11, 20, 21, 30, 31, 40, 41, 50, 51]
+
+# Blocks survive garbage collections while the loop runs
+s = 0
+for i in range(3):
+    for j in range(3):
+        sys.gc()
+        s = s + i * 3 + j
+assert s == 36
+
+# Deeply nested loops in a function
+def deep():
+    c = 0
+    for a in range(2):
+        for b in range(2):
+            for c2 in range(2):
+                for d in range(2):
+                    for e in range(2):
+                        c += 1
+    return c
+
+assert deep() == 32
+
+print "t390 ok"
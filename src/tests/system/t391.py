@@ -0,0 +1,95 @@
+# This file is Copyright 2011 Dean Hall.
+#
+# This file is part of the Python-on-a-Chip program.
+# Python-on-a-Chip is free software: you can redistribute it and/or modify
+# it under the terms of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1.
+#
+# Python-on-a-Chip is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# A copy of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1
+# is seen in the file COPYING up one directory from this.
+
+
+
+#
+# System Test 391
+# Tests that calls run in frames on the thread's frame stack: recursion
+# that spans several segments, collections while frames are stacked and
+# generators that call functions and outlive their callers.
+#
+
+import list
+import sys
+
+# Recursion deep enough to need more than one segment
+def fib(n):
+    if n < 2:
+        return n
+    return fib(n - 1) + fib(n - 2)
+
+assert fib(15) == 610
+
+def depth(n):
+    a = n
+    b = n + 1
+    c = n + 2
+    if n == 0:
+        return 0
+    return depth(n - 1) + c - b - a + n
+
+assert depth(150) == 150
+
+# Going up and down across a segment boundary many times
+def down(n):
+    if n == 0:
+        return 0
+    return 1 + down(n - 1)
+
+s = 0
+for i in range(60):
+    s = s + down(i)
+assert s == 1770
+
+# Collections see the stacked frames' locals
+def keep(n):
+    l = [n, n + 1]
+    if n > 0:
+        keep(n - 1)
+    else:
+        sys.gc()
+    assert l == [n, n + 1]
+    return l[0]
+
+assert keep(40) == 40
+
+# A generator calls functions and is resumed from other frames
+def sq(x):
+    return x * x
+
+def gen(n):
+    for i in range(n):
+        yield sq(i) + fib(3)
+
+def take(g):
+    return g.next()
+
+g = gen(4)
+assert take(g) == 2
+assert take(g) == 3
+l = []
+for x in g:
+    list.append(l, down(x))
+assert l == [6, 11]
+
+# A generator made in a frame that has returned
+def make():
+    return gen(3)
+
+l = []
+for x in make():
+    sys.gc()
+    list.append(l, x)
+assert l == [2, 3, 6]
+
+print "t391 ok"
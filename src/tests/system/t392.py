@@ -0,0 +1,78 @@
+# This file is Copyright 2011 Dean Hall.
+#
+# This file is part of the Python-on-a-Chip program.
+# Python-on-a-Chip is free software: you can redistribute it and/or modify
+# it under the terms of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1.
+#
+# Python-on-a-Chip is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# A copy of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1
+# is seen in the file COPYING up one directory from this.
+
+
+
+#
+# System Test 392
+# Tests that calls taking the fast path of CALL_FUNCTION and calls that
+# do not both get their args: all args given, default args, closures,
+# generators, methods and funcs with no args.
+#
+
+import list
+
+def none():
+    return 7
+
+def three(a, b, c):
+    return a * 100 + b * 10 + c
+
+def dflt(a, b=2, c=3):
+    return a * 100 + b * 10 + c
+
+assert none() == 7
+assert three(1, 2, 3) == 123
+assert dflt(4, 5, 6) == 456
+assert dflt(4, 5) == 453
+assert dflt(4) == 423
+
+# A func whose arg is a cellvar
+def outer(x):
+    def inner(y):
+        return x + y
+    return inner
+
+f = outer(10)
+assert f(5) == 15
+assert outer(1)(2) == 3
+
+# A generator with args
+def gen(a, b):
+    yield a
+    yield b
+
+l = []
+for x in gen(1, 2):
+    list.append(l, three(x, x, x))
+assert l == [111, 222]
+
+# Methods and classes
+class C(object):
+    def __init__(self, v):
+        self.v = v
+    def get(self, d):
+        return self.v + d
+
+c = C(3)
+assert c.get(4) == 7
+g = C.get
+assert g(c, 1) == 4
+
+# Funcs passed around and called through locals
+def apply(fn, a, b, c):
+    return fn(a, b, c)
+
+assert apply(three, 3, 2, 1) == 321
+assert apply(dflt, 1, 1, 1) == 111
+
+print "t392 ok"
@@ -0,0 +1,90 @@
+# This file is Copyright 2011 Dean Hall.
+#
+# This file is part of the Python-on-a-Chip program.
+# Python-on-a-Chip is free software: you can redistribute it and/or modify
+# it under the terms of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1.
+#
+# Python-on-a-Chip is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# A copy of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1
+# is seen in the file COPYING up one directory from this.
+
+
+
+#
+# System Test 393
+# Tests dicts that grow, shrink by del and are iterated: int, string, tuple
+# and float keys, keys(), values(), and True and 1 as the same key.
+#
+
+import dict
+import list
+import sys
+
+d = {}
+i = 0
+while i < 300:
+    d[i] = i * 2
+    i += 1
+assert len(d) == 300
+
+i = 0
+while i < 300:
+    assert d[i] == i * 2
+    if i % 3 == 0:
+        del d[i]
+    i += 1
+assert len(d) == 200
+assert 3 not in d
+assert 4 in d
+
+# Iteration visits each key once
+n = 0
+s = 0
+for k in d:
+    n += 1
+    s += d[k]
+assert n == 200
+assert s == 2 * (300 * 299 / 2 - 3 * (100 * 99 / 2))
+
+# A native cannot run the GC, so make room for the lists first
+sys.gc()
+l = dict.keys(d)
+assert len(l) == 200
+l = dict.values(d)
+assert len(l) == 200
+
+# Reinsert the deleted keys
+i = 0
+while i < 300:
+    d[i] = i
+    i += 1
+assert len(d) == 300
+assert d[297] == 297
+
+# Other hashable keys
+e = {}
+e["abc"] = 1
+e["ab" + "c"] = 2
+e[(1, "x")] = 3
+e[(1, "x",)] = 4
+e[1.5] = 5
+e[True] = 6
+e[1] = 7
+assert len(e) == 4
+assert e["abc"] == 2
+assert e[(1, "x")] == 4
+assert e[1.5] == 5
+assert e[True] == 7
+del e[1]
+assert len(e) == 3
+assert True not in e
+
+# Equal dicts built in different orders
+a = {1: 1, 2: 2, "x": 3}
+b = {"x": 3, 2: 2}
+b[1] = 1
+assert a == b
+
+print "t393 ok"
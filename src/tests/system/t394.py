@@ -0,0 +1,57 @@
+# This file is Copyright 2011 Dean Hall.
+#
+# This file is part of the Python-on-a-Chip program.
+# Python-on-a-Chip is free software: you can redistribute it and/or modify
+# it under the terms of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1.
+#
+# Python-on-a-Chip is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# A copy of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1
+# is seen in the file COPYING up one directory from this.
+
+
+
+#
+# System Test 394
+# Tests strings made at run time: as dict keys and global names, and
+# many of them through collections, with only image strings interned.
+#
+
+import sys
+import list
+
+# Keys built at run time find the items made with constant keys
+d = {"alpha": 1, "beta": 2}
+p = "al"
+assert d[p + "pha"] == 1
+d["be" + "ta"] = 3
+assert len(d) == 2
+assert d["beta"] == 3
+assert ("gam" + "ma") not in d
+
+# A global looked up by a built name
+g = globals()
+assert g["sy" + "s"] == sys
+
+# Many transient strings, collected while some are kept
+l = []
+i = 0
+while i < 600:
+    s = "k%d" % i
+    if i % 50 == 0:
+        list.append(l, s)
+        d[s] = i
+    i += 1
+sys.gc()
+assert len(l) == 12
+assert l[3] == "k150"
+assert d["k%d" % 150] == 150
+assert d["k" + "550"] == 550
+
+# Constants are still found after the collection
+assert d["alpha"] == 1
+e = {"k150": 0}
+assert e[l[3]] == 0
+
+print "t394 ok"
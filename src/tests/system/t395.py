@@ -0,0 +1,74 @@
+# This file is Copyright 2011 Dean Hall.
+#
+# This file is part of the Python-on-a-Chip program.
+# Python-on-a-Chip is free software: you can redistribute it and/or modify
+# it under the terms of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1.
+#
+# Python-on-a-Chip is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# A copy of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1
+# is seen in the file COPYING up one directory from this.
+
+
+
+
+#
+# System Test 395
+# Tests for loops over each kind of sequence and over a dict, including
+# lists that change while they are iterated.
+#
+
+import list
+
+s = ""
+for c in "abc":
+    s = s + c
+assert s == "abc"
+
+n = 0
+for x in (1, 2, 3, 4):
+    n = n + x
+assert n == 10
+
+n = 0
+for x in bytearray((1, 2, 8, 1)):
+    n = n + x
+assert n == 12
+
+# Items are fetched by index, so items added to the end are seen
+l = [0, 1, 2]
+n = 0
+for x in l:
+    if x < 20:
+        list.append(l, x + 3)
+    n = n + 1
+assert n == 23
+
+# Removing items behind the loop skips ahead; emptying the list stops it
+l = range(40)
+seen = []
+for x in l:
+    list.append(seen, x)
+    if x == 10:
+        while len(l) > 12:
+            list.remove(l, l[-1])
+assert seen == range(12)
+
+l = range(20)
+n = 0
+for x in l:
+    list.remove(l, x)
+    n = n + 1
+assert n == 10
+assert l == range(1, 20, 2)
+
+d = {"a": 1, "b": 2, "c": 3}
+keys = []
+for k in d:
+    list.append(keys, k)
+assert len(keys) == 3
+for k in keys:
+    assert k in d
+
+print "Success"
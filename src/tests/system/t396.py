@@ -0,0 +1,62 @@
+# This file is Copyright 2011 Dean Hall.
+#
+# This file is part of the Python-on-a-Chip program.
+# Python-on-a-Chip is free software: you can redistribute it and/or modify
+# it under the terms of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1.
+#
+# Python-on-a-Chip is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# A copy of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1
+# is seen in the file COPYING up one directory from this.
+
+
+
+
+#
+# System Test 396
+# Tests a dict with more items than the largest hash table holds.
+#
+
+import dict
+import sys
+
+n = 3000
+d = {}
+i = 0
+while i < n:
+    d[i] = i * 2
+    i += 1
+assert len(d) == n
+
+i = 0
+while i < n:
+    assert d[i] == i * 2
+    i += 1
+d[7] = "seven"
+assert d[7] == "seven"
+assert len(d) == n
+
+# Iterate over the keys, delete some and add new ones
+s = 0
+for k in d:
+    s += 1
+assert s == n
+i = 0
+while i < 100:
+    del d[i]
+    i += 1
+assert len(d) == n - 100
+assert not 5 in d
+d["k"] = 1
+assert d["k"] == 1
+assert dict.has_key(d, 2999)
+# A native cannot run the GC, so make room for the list of keys first
+sys.gc()
+assert len(dict.keys(d)) == n - 99
+dict.clear(d)
+assert len(d) == 0
+d[1] = 2
+assert d[1] == 2
+
+print "Success"
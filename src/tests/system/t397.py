@@ -0,0 +1,81 @@
+# This file is Copyright 2011 Dean Hall.
+#
+# This file is part of the Python-on-a-Chip program.
+# Python-on-a-Chip is free software: you can redistribute it and/or modify
+# it under the terms of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1.
+#
+# Python-on-a-Chip is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# A copy of the GNU LESSER GENERAL PUBLIC LICENSE Version 2.1
+# is seen in the file COPYING up one directory from this.
+
+
+
+
+#
+# System Test 397
+# Tests dicts whose keys are only equal to themselves.
+#
+
+import list
+
+class C(object):
+    def __init__(self):
+        self.v = 0
+
+def f():
+    pass
+
+def g():
+    pass
+
+n = 200
+objs = []
+d = {}
+i = 0
+while i < n:
+    c = C()
+    list.append(objs, c)
+    d[c] = i
+    # Garbage between the keys, so they move if the heap is compacted
+    s = "garbage %d" % i
+    i += 1
+assert len(d) == n
+
+d[C] = "class"
+d[f] = "f"
+d[g] = "g"
+d[None] = "none"
+d[(objs[0], 1)] = "tuple"
+
+i = 0
+while i < n:
+    assert d[objs[i]] == i
+    i += 1
+assert d[C] == "class"
+assert d[f] == "f"
+assert d[g] == "g"
+assert d[None] == "none"
+assert d[(objs[0], 1)] == "tuple"
+assert not C() in d
+
+# Setting a key again replaces its value
+d[objs[5]] = -5
+assert d[objs[5]] == -5
+assert len(d) == n + 5
+d[objs[5]] = 5
+
+# Deleted keys are gone; the others stay
+i = 0
+while i < n:
+    del d[objs[i]]
+    i += 2
+assert len(d) == n / 2 + 5
+i = 1
+while i < n:
+    assert d[objs[i]] == i
+    i += 2
+assert not objs[0] in d
+
+print "Success"
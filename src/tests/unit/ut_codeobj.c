@@ -58,46 +58,11 @@ main()
 uint8_t const test_code_image0[] =
 {
 #if !defined(HAVE_CLOSURES) && !defined(HAVE_DEBUG_INFO)
-    0x0A, 0xFD, 0x00, 0x00, 0x40, 0x01, 0x00, 0x04, 
-    0x02, 0x03, 0x04, 0x00, 0x6D, 0x61, 0x69, 0x6E, 
-    0x03, 0x04, 0x00, 0x74, 0x65, 0x73, 0x74, 0x04, 
-    0x02, 0x0A, 0xCF, 0x00, 0x00, 0x43, 0x09, 0x05, 
-    0x04, 0x01, 0x03, 0x04, 0x00, 0x6D, 0x61, 0x69, 
-    0x6E, 0x04, 0x07, 0x00, 0x01, 0x00, 0x00, 0x00, 
-    0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x02, 
-    0x00, 0x00, 0x00, 0x01, 0x03, 0x00, 0x00, 0x00, 
-    0x04, 0x04, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 
-    0x01, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 
-    0x00, 0x01, 0x03, 0x00, 0x00, 0x00, 0x04, 0x04, 
-    0x01, 0x03, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 
-    0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 
-    0x00, 0x00, 0x00, 0x00, 0x64, 0x01, 0x00, 0x7D, 
-    0x00, 0x00, 0x64, 0x05, 0x00, 0x7D, 0x01, 0x00, 
-    0x64, 0x06, 0x00, 0x7D, 0x02, 0x00, 0x78, 0x18, 
-    0x00, 0x7C, 0x01, 0x00, 0x44, 0x5D, 0x10, 0x00, 
-    0x7D, 0x03, 0x00, 0x7C, 0x00, 0x00, 0x7C, 0x03, 
-    0x00, 0x37, 0x7D, 0x00, 0x00, 0x71, 0x19, 0x00, 
-    0x57, 0x78, 0x18, 0x00, 0x7C, 0x02, 0x00, 0x44, 
-    0x5D, 0x10, 0x00, 0x7D, 0x03, 0x00, 0x7C, 0x00, 
-    0x00, 0x7C, 0x03, 0x00, 0x38, 0x7D, 0x00, 0x00, 
-    0x71, 0x34, 0x00, 0x57, 0x78, 0x2D, 0x00, 0x7C, 
-    0x01, 0x00, 0x44, 0x5D, 0x25, 0x00, 0x7D, 0x03, 
-    0x00, 0x78, 0x1C, 0x00, 0x7C, 0x02, 0x00, 0x44, 
-    0x5D, 0x14, 0x00, 0x7D, 0x04, 0x00, 0x7C, 0x00, 
-    0x00, 0x7C, 0x03, 0x00, 0x7C, 0x04, 0x00, 0x14, 
-    0x37, 0x7D, 0x00, 0x00, 0x71, 0x5C, 0x00, 0x57, 
-    0x71, 0x4F, 0x00, 0x57, 0x7C, 0x00, 0x00, 0x53, 
-    0x00, 0x64, 0x00, 0x00, 0x84, 0x00, 0x00, 0x5A, 
-    0x00, 0x00, 0x65, 0x00, 0x00, 0x83, 0x00, 0x00, 
-    0x01, 0x64, 0x01, 0x00, 0x53, 
-#endif
-#if defined(HAVE_CLOSURES) && !defined(HAVE_DEBUG_INFO)
-/* utco.py */
-    0x0A, 0x03, 0x01, 0x00, 0x40, 0x01, 0x00, 0x00, 
+    0x0A, 0xFF, 0x00, 0x00, 0x40, 0x01, 0x00, 0x00, 
     0x04, 0x02, 0x03, 0x04, 0x00, 0x6D, 0x61, 0x69, 
     0x6E, 0x03, 0x04, 0x00, 0x75, 0x74, 0x63, 0x6F, 
-    0x04, 0x02, 0x0A, 0xD2, 0x00, 0x00, 0x43, 0x09, 
-    0x05, 0x00, 0x04, 0x01, 0x03, 0x04, 0x00, 0x6D, 
+    0x04, 0x02, 0x0A, 0xD0, 0x00, 0x00, 0x43, 0x05, 
+    0x05, 0x02, 0x04, 0x01, 0x03, 0x04, 0x00, 0x6D, 
     0x61, 0x69, 0x6E, 0x04, 0x07, 0x00, 0x01, 0x00, 
     0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 
     0x01, 0x02, 0x00, 0x00, 0x00, 0x01, 0x03, 0x00, 
@@ -106,84 +71,75 @@ uint8_t const test_code_image0[] =
     0x00, 0x00, 0x00, 0x01, 0x03, 0x00, 0x00, 0x00, 
     0x04, 0x04, 0x01, 0x03, 0x00, 0x00, 0x00, 0x01, 
     0x02, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 
-    0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 
-    0x64, 0x01, 0x00, 0x7D, 0x00, 0x00, 0x64, 0x05, 
-    0x00, 0x7D, 0x01, 0x00, 0x64, 0x06, 0x00, 0x7D, 
-    0x02, 0x00, 0x78, 0x18, 0x00, 0x7C, 0x01, 0x00, 
-    0x44, 0x5D, 0x10, 0x00, 0x7D, 0x03, 0x00, 0x7C, 
-    0x00, 0x00, 0x7C, 0x03, 0x00, 0x37, 0x7D, 0x00, 
-    0x00, 0x71, 0x19, 0x00, 0x57, 0x78, 0x18, 0x00, 
-    0x7C, 0x02, 0x00, 0x44, 0x5D, 0x10, 0x00, 0x7D, 
-    0x03, 0x00, 0x7C, 0x00, 0x00, 0x7C, 0x03, 0x00, 
-    0x38, 0x7D, 0x00, 0x00, 0x71, 0x34, 0x00, 0x57, 
-    0x78, 0x2D, 0x00, 0x7C, 0x01, 0x00, 0x44, 0x5D, 
-    0x25, 0x00, 0x7D, 0x03, 0x00, 0x78, 0x1C, 0x00, 
-    0x7C, 0x02, 0x00, 0x44, 0x5D, 0x14, 0x00, 0x7D, 
-    0x04, 0x00, 0x7C, 0x00, 0x00, 0x7C, 0x03, 0x00, 
-    0x7C, 0x04, 0x00, 0x14, 0x37, 0x7D, 0x00, 0x00, 
-    0x71, 0x5C, 0x00, 0x57, 0x71, 0x4F, 0x00, 0x57, 
-    0x7C, 0x00, 0x00, 0x53, 0x00, 0x04, 0x00, 0x64, 
-    0x00, 0x00, 0x84, 0x00, 0x00, 0x5A, 0x00, 0x00, 
-    0x65, 0x00, 0x00, 0x83, 0x00, 0x00, 0x01, 0x64, 
-    0x01, 0x00, 0x53, 
+    0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x64, 0x01, 
+    0x00, 0x7D, 0x00, 0x00, 0x64, 0x05, 0x00, 0x7D, 
+    0x01, 0x00, 0x64, 0x06, 0x00, 0x7D, 0x02, 0x00, 
+    0x78, 0x18, 0x00, 0x7C, 0x01, 0x00, 0x44, 0x5D, 
+    0x10, 0x00, 0x7D, 0x03, 0x00, 0x7C, 0x00, 0x00, 
+    0x7C, 0x03, 0x00, 0x37, 0x7D, 0x00, 0x00, 0x71, 
+    0x19, 0x00, 0x57, 0x78, 0x18, 0x00, 0x7C, 0x02, 
+    0x00, 0x44, 0x5D, 0x10, 0x00, 0x7D, 0x03, 0x00, 
+    0x7C, 0x00, 0x00, 0x7C, 0x03, 0x00, 0x38, 0x7D, 
+    0x00, 0x00, 0x71, 0x34, 0x00, 0x57, 0x78, 0x2D, 
+    0x00, 0x7C, 0x01, 0x00, 0x44, 0x5D, 0x25, 0x00, 
+    0x7D, 0x03, 0x00, 0x78, 0x1C, 0x00, 0x7C, 0x02, 
+    0x00, 0x44, 0x5D, 0x14, 0x00, 0x7D, 0x04, 0x00, 
+    0x7C, 0x00, 0x00, 0x7C, 0x03, 0x00, 0x7C, 0x04, 
+    0x00, 0x14, 0x37, 0x7D, 0x00, 0x00, 0x71, 0x5C, 
+    0x00, 0x57, 0x71, 0x4F, 0x00, 0x57, 0x7C, 0x00, 
+    0x00, 0x53, 0x00, 0x64, 0x00, 0x00, 0x84, 0x00, 
+    0x00, 0x5A, 0x00, 0x00, 0x65, 0x00, 0x00, 0x83, 
+    0x00, 0x00, 0x01, 0x64, 0x01, 0x00, 0x53,
 #endif
-#if !defined(HAVE_CLOSURES) && defined(HAVE_DEBUG_INFO)
+#if defined(HAVE_CLOSURES) && !defined(HAVE_DEBUG_INFO)
 /* utco.py */
-    0x0A, 0x3D, 0x01, 0x00, 0x40, 0x01, 0x00, 0x01, 
+    0x0A, 0x05, 0x01, 0x00, 0x40, 0x01, 0x00, 0x00, 
     0x00, 0x04, 0x02, 0x03, 0x04, 0x00, 0x6D, 0x61, 
     0x69, 0x6E, 0x03, 0x04, 0x00, 0x75, 0x74, 0x63, 
-    0x6F, 0x03, 0x02, 0x00, 0x09, 0x12, 0x03, 0x08, 
-    0x00, 0x75, 0x74, 0x63, 0x6F, 0x2E, 0x70, 0x79, 
-    0x00, 0x04, 0x02, 0x0A, 0xFD, 0x00, 0x00, 0x43, 
-    0x09, 0x05, 0x01, 0x00, 0x04, 0x01, 0x03, 0x04, 
-    0x00, 0x6D, 0x61, 0x69, 0x6E, 0x03, 0x1E, 0x00, 
-    0x00, 0x02, 0x06, 0x01, 0x06, 0x01, 0x06, 0x02, 
-    0x07, 0x00, 0x06, 0x01, 0x0E, 0x02, 0x07, 0x00, 
-    0x06, 0x01, 0x0E, 0x02, 0x07, 0x00, 0x06, 0x01, 
-    0x07, 0x00, 0x06, 0x01, 0x16, 0x02, 0x03, 0x08, 
-    0x00, 0x75, 0x74, 0x63, 0x6F, 0x2E, 0x70, 0x79, 
-    0x00, 0x04, 0x07, 0x00, 0x01, 0x00, 0x00, 0x00, 
-    0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x02, 
-    0x00, 0x00, 0x00, 0x01, 0x03, 0x00, 0x00, 0x00, 
-    0x04, 0x04, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 
-    0x01, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 
-    0x00, 0x01, 0x03, 0x00, 0x00, 0x00, 0x04, 0x04, 
-    0x01, 0x03, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 
-    0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 
-    0x00, 0x00, 0x00, 0x00, 0x64, 0x01, 0x00, 0x7D, 
-    0x00, 0x00, 0x64, 0x05, 0x00, 0x7D, 0x01, 0x00, 
-    0x64, 0x06, 0x00, 0x7D, 0x02, 0x00, 0x78, 0x18, 
-    0x00, 0x7C, 0x01, 0x00, 0x44, 0x5D, 0x10, 0x00, 
-    0x7D, 0x03, 0x00, 0x7C, 0x00, 0x00, 0x7C, 0x03, 
-    0x00, 0x37, 0x7D, 0x00, 0x00, 0x71, 0x19, 0x00, 
-    0x57, 0x78, 0x18, 0x00, 0x7C, 0x02, 0x00, 0x44, 
-    0x5D, 0x10, 0x00, 0x7D, 0x03, 0x00, 0x7C, 0x00, 
-    0x00, 0x7C, 0x03, 0x00, 0x38, 0x7D, 0x00, 0x00, 
-    0x71, 0x34, 0x00, 0x57, 0x78, 0x2D, 0x00, 0x7C, 
-    0x01, 0x00, 0x44, 0x5D, 0x25, 0x00, 0x7D, 0x03, 
-    0x00, 0x78, 0x1C, 0x00, 0x7C, 0x02, 0x00, 0x44, 
-    0x5D, 0x14, 0x00, 0x7D, 0x04, 0x00, 0x7C, 0x00, 
-    0x00, 0x7C, 0x03, 0x00, 0x7C, 0x04, 0x00, 0x14, 
-    0x37, 0x7D, 0x00, 0x00, 0x71, 0x5C, 0x00, 0x57, 
-    0x71, 0x4F, 0x00, 0x57, 0x7C, 0x00, 0x00, 0x53, 
+    0x6F, 0x04, 0x02, 0x0A, 0xD3, 0x00, 0x00, 0x43, 
+    0x05, 0x05, 0x02, 0x00, 0x04, 0x01, 0x03, 0x04, 
+    0x00, 0x6D, 0x61, 0x69, 0x6E, 0x04, 0x07, 0x00, 
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 
+    0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x01, 
+    0x03, 0x00, 0x00, 0x00, 0x04, 0x04, 0x01, 0x00, 
+    0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 
+    0x01, 0x02, 0x00, 0x00, 0x00, 0x01, 0x03, 0x00, 
+    0x00, 0x00, 0x04, 0x04, 0x01, 0x03, 0x00, 0x00, 
+    0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x01, 0x01, 
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 
+    0x04, 0x00, 0x64, 0x01, 0x00, 0x7D, 0x00, 0x00, 
+    0x64, 0x05, 0x00, 0x7D, 0x01, 0x00, 0x64, 0x06, 
+    0x00, 0x7D, 0x02, 0x00, 0x78, 0x18, 0x00, 0x7C, 
+    0x01, 0x00, 0x44, 0x5D, 0x10, 0x00, 0x7D, 0x03, 
+    0x00, 0x7C, 0x00, 0x00, 0x7C, 0x03, 0x00, 0x37, 
+    0x7D, 0x00, 0x00, 0x71, 0x19, 0x00, 0x57, 0x78, 
+    0x18, 0x00, 0x7C, 0x02, 0x00, 0x44, 0x5D, 0x10, 
+    0x00, 0x7D, 0x03, 0x00, 0x7C, 0x00, 0x00, 0x7C, 
+    0x03, 0x00, 0x38, 0x7D, 0x00, 0x00, 0x71, 0x34, 
+    0x00, 0x57, 0x78, 0x2D, 0x00, 0x7C, 0x01, 0x00, 
+    0x44, 0x5D, 0x25, 0x00, 0x7D, 0x03, 0x00, 0x78, 
+    0x1C, 0x00, 0x7C, 0x02, 0x00, 0x44, 0x5D, 0x14, 
+    0x00, 0x7D, 0x04, 0x00, 0x7C, 0x00, 0x00, 0x7C, 
+    0x03, 0x00, 0x7C, 0x04, 0x00, 0x14, 0x37, 0x7D, 
+    0x00, 0x00, 0x71, 0x5C, 0x00, 0x57, 0x71, 0x4F, 
+    0x00, 0x57, 0x7C, 0x00, 0x00, 0x53, 0x00, 0x04, 
     0x00, 0x64, 0x00, 0x00, 0x84, 0x00, 0x00, 0x5A, 
     0x00, 0x00, 0x65, 0x00, 0x00, 0x83, 0x00, 0x00, 
-    0x01, 0x64, 0x01, 0x00, 0x53, 
+    0x01, 0x64, 0x01, 0x00, 0x53,
 #endif
-#if defined(HAVE_CLOSURES) && defined(HAVE_DEBUG_INFO)
+#if !defined(HAVE_CLOSURES) && defined(HAVE_DEBUG_INFO)
 /* utco.py */
-    0x0A, 0x43, 0x01, 0x00, 0x40, 0x01, 0x00, 0x00, 
+    0x0A, 0x37, 0x01, 0x00, 0x40, 0x01, 0x00, 0x00, 
     0x01, 0x00, 0x04, 0x02, 0x03, 0x04, 0x00, 0x6D, 
     0x61, 0x69, 0x6E, 0x03, 0x04, 0x00, 0x75, 0x74, 
     0x63, 0x6F, 0x03, 0x02, 0x00, 0x09, 0x12, 0x03, 
     0x08, 0x00, 0x75, 0x74, 0x63, 0x6F, 0x2E, 0x70, 
-    0x79, 0x00, 0x04, 0x02, 0x0A, 0x00, 0x01, 0x00, 
-    0x43, 0x09, 0x05, 0x00, 0x01, 0x00, 0x04, 0x01, 
+    0x79, 0x00, 0x04, 0x02, 0x0A, 0xF6, 0x00, 0x00, 
+    0x43, 0x05, 0x05, 0x02, 0x01, 0x00, 0x04, 0x01, 
     0x03, 0x04, 0x00, 0x6D, 0x61, 0x69, 0x6E, 0x03, 
-    0x1E, 0x00, 0x00, 0x02, 0x06, 0x01, 0x06, 0x01, 
-    0x06, 0x02, 0x07, 0x00, 0x06, 0x01, 0x0E, 0x02, 
-    0x07, 0x00, 0x06, 0x01, 0x0E, 0x02, 0x07, 0x00, 
-    0x06, 0x01, 0x07, 0x00, 0x06, 0x01, 0x16, 0x02, 
+    0x16, 0x00, 0x00, 0x02, 0x06, 0x01, 0x06, 0x01, 
+    0x06, 0x02, 0x0D, 0x01, 0x0E, 0x02, 0x0D, 0x01, 
+    0x0E, 0x02, 0x0D, 0x01, 0x0D, 0x01, 0x16, 0x02, 
     0x03, 0x08, 0x00, 0x75, 0x74, 0x63, 0x6F, 0x2E, 
     0x70, 0x79, 0x00, 0x04, 0x07, 0x00, 0x01, 0x00, 
     0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 
@@ -193,26 +149,68 @@ uint8_t const test_code_image0[] =
     0x00, 0x00, 0x00, 0x01, 0x03, 0x00, 0x00, 0x00, 
     0x04, 0x04, 0x01, 0x03, 0x00, 0x00, 0x00, 0x01, 
     0x02, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 
-    0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 
-    0x64, 0x01, 0x00, 0x7D, 0x00, 0x00, 0x64, 0x05, 
-    0x00, 0x7D, 0x01, 0x00, 0x64, 0x06, 0x00, 0x7D, 
-    0x02, 0x00, 0x78, 0x18, 0x00, 0x7C, 0x01, 0x00, 
-    0x44, 0x5D, 0x10, 0x00, 0x7D, 0x03, 0x00, 0x7C, 
-    0x00, 0x00, 0x7C, 0x03, 0x00, 0x37, 0x7D, 0x00, 
-    0x00, 0x71, 0x19, 0x00, 0x57, 0x78, 0x18, 0x00, 
-    0x7C, 0x02, 0x00, 0x44, 0x5D, 0x10, 0x00, 0x7D, 
-    0x03, 0x00, 0x7C, 0x00, 0x00, 0x7C, 0x03, 0x00, 
-    0x38, 0x7D, 0x00, 0x00, 0x71, 0x34, 0x00, 0x57, 
-    0x78, 0x2D, 0x00, 0x7C, 0x01, 0x00, 0x44, 0x5D, 
-    0x25, 0x00, 0x7D, 0x03, 0x00, 0x78, 0x1C, 0x00, 
-    0x7C, 0x02, 0x00, 0x44, 0x5D, 0x14, 0x00, 0x7D, 
-    0x04, 0x00, 0x7C, 0x00, 0x00, 0x7C, 0x03, 0x00, 
-    0x7C, 0x04, 0x00, 0x14, 0x37, 0x7D, 0x00, 0x00, 
-    0x71, 0x5C, 0x00, 0x57, 0x71, 0x4F, 0x00, 0x57, 
-    0x7C, 0x00, 0x00, 0x53, 0x00, 0x04, 0x00, 0x64, 
-    0x00, 0x00, 0x84, 0x00, 0x00, 0x5A, 0x00, 0x00, 
-    0x65, 0x00, 0x00, 0x83, 0x00, 0x00, 0x01, 0x64, 
-    0x01, 0x00, 0x53, 
+    0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x64, 0x01, 
+    0x00, 0x7D, 0x00, 0x00, 0x64, 0x05, 0x00, 0x7D, 
+    0x01, 0x00, 0x64, 0x06, 0x00, 0x7D, 0x02, 0x00, 
+    0x78, 0x18, 0x00, 0x7C, 0x01, 0x00, 0x44, 0x5D, 
+    0x10, 0x00, 0x7D, 0x03, 0x00, 0x7C, 0x00, 0x00, 
+    0x7C, 0x03, 0x00, 0x37, 0x7D, 0x00, 0x00, 0x71, 
+    0x19, 0x00, 0x57, 0x78, 0x18, 0x00, 0x7C, 0x02, 
+    0x00, 0x44, 0x5D, 0x10, 0x00, 0x7D, 0x03, 0x00, 
+    0x7C, 0x00, 0x00, 0x7C, 0x03, 0x00, 0x38, 0x7D, 
+    0x00, 0x00, 0x71, 0x34, 0x00, 0x57, 0x78, 0x2D, 
+    0x00, 0x7C, 0x01, 0x00, 0x44, 0x5D, 0x25, 0x00, 
+    0x7D, 0x03, 0x00, 0x78, 0x1C, 0x00, 0x7C, 0x02, 
+    0x00, 0x44, 0x5D, 0x14, 0x00, 0x7D, 0x04, 0x00, 
+    0x7C, 0x00, 0x00, 0x7C, 0x03, 0x00, 0x7C, 0x04, 
+    0x00, 0x14, 0x37, 0x7D, 0x00, 0x00, 0x71, 0x5C, 
+    0x00, 0x57, 0x71, 0x4F, 0x00, 0x57, 0x7C, 0x00, 
+    0x00, 0x53, 0x00, 0x64, 0x00, 0x00, 0x84, 0x00, 
+    0x00, 0x5A, 0x00, 0x00, 0x65, 0x00, 0x00, 0x83, 
+    0x00, 0x00, 0x01, 0x64, 0x01, 0x00, 0x53,
+#endif
+#if defined(HAVE_CLOSURES) && defined(HAVE_DEBUG_INFO)
+/* utco.py */
+    0x0A, 0x3D, 0x01, 0x00, 0x40, 0x01, 0x00, 0x00, 
+    0x00, 0x01, 0x00, 0x04, 0x02, 0x03, 0x04, 0x00, 
+    0x6D, 0x61, 0x69, 0x6E, 0x03, 0x04, 0x00, 0x75, 
+    0x74, 0x63, 0x6F, 0x03, 0x02, 0x00, 0x09, 0x12, 
+    0x03, 0x08, 0x00, 0x75, 0x74, 0x63, 0x6F, 0x2E, 
+    0x70, 0x79, 0x00, 0x04, 0x02, 0x0A, 0xF9, 0x00, 
+    0x00, 0x43, 0x05, 0x05, 0x02, 0x00, 0x01, 0x00, 
+    0x04, 0x01, 0x03, 0x04, 0x00, 0x6D, 0x61, 0x69, 
+    0x6E, 0x03, 0x16, 0x00, 0x00, 0x02, 0x06, 0x01, 
+    0x06, 0x01, 0x06, 0x02, 0x0D, 0x01, 0x0E, 0x02, 
+    0x0D, 0x01, 0x0E, 0x02, 0x0D, 0x01, 0x0D, 0x01, 
+    0x16, 0x02, 0x03, 0x08, 0x00, 0x75, 0x74, 0x63, 
+    0x6F, 0x2E, 0x70, 0x79, 0x00, 0x04, 0x07, 0x00, 
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 
+    0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x01, 
+    0x03, 0x00, 0x00, 0x00, 0x04, 0x04, 0x01, 0x00, 
+    0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 
+    0x01, 0x02, 0x00, 0x00, 0x00, 0x01, 0x03, 0x00, 
+    0x00, 0x00, 0x04, 0x04, 0x01, 0x03, 0x00, 0x00, 
+    0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x01, 0x01, 
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 
+    0x04, 0x00, 0x64, 0x01, 0x00, 0x7D, 0x00, 0x00, 
+    0x64, 0x05, 0x00, 0x7D, 0x01, 0x00, 0x64, 0x06, 
+    0x00, 0x7D, 0x02, 0x00, 0x78, 0x18, 0x00, 0x7C, 
+    0x01, 0x00, 0x44, 0x5D, 0x10, 0x00, 0x7D, 0x03, 
+    0x00, 0x7C, 0x00, 0x00, 0x7C, 0x03, 0x00, 0x37, 
+    0x7D, 0x00, 0x00, 0x71, 0x19, 0x00, 0x57, 0x78, 
+    0x18, 0x00, 0x7C, 0x02, 0x00, 0x44, 0x5D, 0x10, 
+    0x00, 0x7D, 0x03, 0x00, 0x7C, 0x00, 0x00, 0x7C, 
+    0x03, 0x00, 0x38, 0x7D, 0x00, 0x00, 0x71, 0x34, 
+    0x00, 0x57, 0x78, 0x2D, 0x00, 0x7C, 0x01, 0x00, 
+    0x44, 0x5D, 0x25, 0x00, 0x7D, 0x03, 0x00, 0x78, 
+    0x1C, 0x00, 0x7C, 0x02, 0x00, 0x44, 0x5D, 0x14, 
+    0x00, 0x7D, 0x04, 0x00, 0x7C, 0x00, 0x00, 0x7C, 
+    0x03, 0x00, 0x7C, 0x04, 0x00, 0x14, 0x37, 0x7D, 
+    0x00, 0x00, 0x71, 0x5C, 0x00, 0x57, 0x71, 0x4F, 
+    0x00, 0x57, 0x7C, 0x00, 0x00, 0x53, 0x00, 0x04, 
+    0x00, 0x64, 0x00, 0x00, 0x84, 0x00, 0x00, 0x5A, 
+    0x00, 0x00, 0x65, 0x00, 0x00, 0x83, 0x00, 0x00, 
+    0x01, 0x64, 0x01, 0x00, 0x53,
 #endif
 
 /* img-list-terminator */
@@ -104,6 +104,49 @@ ut_dict_setItem_001(CuTest* tc)
 }
 
 
+#ifdef HAVE_INLINE_CACHES
+/**
+ * Test dict versions:
+ *      New dicts get different versions
+ *      Inserting, replacing and deleting an item changes the version
+ *      Storing the same value again leaves the version unchanged
+ *      The version only grows
+ */
+void
+ut_dict_version_000(CuTest* tc)
+{
+    uint8_t heap[HEAP_SIZE];
+    pPmObj_t pobj = C_NULL;
+    pPmObj_t pobj2 = C_NULL;
+    uint32_t version;
+    PmReturn_t retval;
+
+    retval = pm_init(heap, HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    retval = dict_new(&pobj);
+    retval = dict_new(&pobj2);
+    CuAssertTrue(tc, ((pPmDict_t)pobj)->d_version
+                     != ((pPmDict_t)pobj2)->d_version);
+
+    version = ((pPmDict_t)pobj)->d_version;
+    retval = dict_setItem(pobj, PM_ZERO, PM_ONE);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, ((pPmDict_t)pobj)->d_version > version);
+
+    version = ((pPmDict_t)pobj)->d_version;
+    retval = dict_setItem(pobj, PM_ZERO, PM_ONE);
+    CuAssertTrue(tc, ((pPmDict_t)pobj)->d_version == version);
+
+    retval = dict_setItem(pobj, PM_ZERO, PM_NEGONE);
+    CuAssertTrue(tc, ((pPmDict_t)pobj)->d_version > version);
+
+    version = ((pPmDict_t)pobj)->d_version;
+    retval = dict_delItem(pobj, PM_ZERO);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, ((pPmDict_t)pobj)->d_version > version);
+}
+#endif /* HAVE_INLINE_CACHES */
+
+
 /**
  * Test dict_clear():
  *      Pass non-dict object; expect TypeError
@@ -174,6 +217,106 @@ ut_dict_getItem_000(CuTest *tc)
 }
 
 
+/**
+ * Test dict_delItem() and dict_getNext() on a dict that grows:
+ *      Insert 60 int keys; expect length 60 and each value found
+ *      Delete the even keys; expect KeyError for them, odd keys still found
+ *      Reinsert the even keys; expect length 60 and each value found
+ *      Iterate with dict_getNext(); expect each key once, then NO
+ *      Pass True as a key; expect it to find the item with key 1
+ */
+void
+ut_dict_delItem_000(CuTest *tc)
+{
+    uint8_t heap[HEAP_SIZE];
+    pPmObj_t pobj = C_NULL;
+    pPmObj_t pkey;
+    pPmObj_t pval;
+    uint8_t seen[60];
+    uint16_t index;
+    int16_t i;
+    uint8_t objid;
+    uint8_t objid2;
+    uint8_t objid3;
+    PmReturn_t retval;
+
+    retval = pm_init(heap, HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    retval = dict_new(&pobj);
+    heap_gcPushTempRoot(pobj, &objid);
+
+    for (i = 0; i < 60; i++)
+    {
+        retval = int_new(i, &pkey);
+        heap_gcPushTempRoot(pkey, &objid2);
+        retval = int_new(i + 100, &pval);
+        heap_gcPushTempRoot(pval, &objid3);
+        retval = dict_setItem(pobj, pkey, pval);
+        heap_gcPopTempRoot(objid2);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+    CuAssertTrue(tc, ((pPmDict_t)pobj)->length == 60);
+    for (i = 0; i < 60; i++)
+    {
+        retval = int_new(i, &pkey);
+        retval = dict_getItem(pobj, pkey, &pval);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        CuAssertTrue(tc, INT_GET_VAL(pval) == i + 100);
+    }
+
+    for (i = 0; i < 60; i += 2)
+    {
+        retval = int_new(i, &pkey);
+        retval = dict_delItem(pobj, pkey);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+    CuAssertTrue(tc, ((pPmDict_t)pobj)->length == 30);
+    for (i = 0; i < 60; i++)
+    {
+        retval = int_new(i, &pkey);
+        retval = dict_getItem(pobj, pkey, &pval);
+        CuAssertTrue(tc, retval == ((i & 1) ? PM_RET_OK : PM_RET_EX_KEY));
+    }
+
+    for (i = 0; i < 60; i += 2)
+    {
+        retval = int_new(i, &pkey);
+        heap_gcPushTempRoot(pkey, &objid2);
+        retval = int_new(i + 100, &pval);
+        heap_gcPushTempRoot(pval, &objid3);
+        retval = dict_setItem(pobj, pkey, pval);
+        heap_gcPopTempRoot(objid2);
+    }
+    CuAssertTrue(tc, ((pPmDict_t)pobj)->length == 60);
+    for (i = 0; i < 60; i++)
+    {
+        retval = int_new(i, &pkey);
+        retval = dict_getItem(pobj, pkey, &pval);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        CuAssertTrue(tc, INT_GET_VAL(pval) == i + 100);
+        seen[i] = 0;
+    }
+
+    index = 0;
+    while (dict_getNext(pobj, &index, &pkey, &pval) == PM_RET_OK)
+    {
+        i = INT_GET_VAL(pkey);
+        CuAssertTrue(tc, (i >= 0) && (i < 60));
+        CuAssertTrue(tc, seen[i] == 0);
+        CuAssertTrue(tc, INT_GET_VAL(pval) == i + 100);
+        seen[i] = 1;
+    }
+    for (i = 0; i < 60; i++)
+    {
+        CuAssertTrue(tc, seen[i] == 1);
+    }
+
+    retval = dict_getItem(pobj, PM_TRUE, &pval);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, INT_GET_VAL(pval) == 101);
+    heap_gcPopTempRoot(objid);
+}
+
+
 /* BEGIN unit tests ported from Snarf */
 
 char *test_str1 = "zzang1";
@@ -364,8 +507,12 @@ CuSuite *getSuite_testDict(void)
     SUITE_ADD_TEST(suite, ut_dict_new_000);
     SUITE_ADD_TEST(suite, ut_dict_setItem_000);
     SUITE_ADD_TEST(suite, ut_dict_setItem_001);
+#ifdef HAVE_INLINE_CACHES
+    SUITE_ADD_TEST(suite, ut_dict_version_000);
+#endif /* HAVE_INLINE_CACHES */
     SUITE_ADD_TEST(suite, ut_dict_clear_000);
     SUITE_ADD_TEST(suite, ut_dict_getItem_000);
+    SUITE_ADD_TEST(suite, ut_dict_delItem_000);
 
     SUITE_ADD_TEST(suite, ut_dict_getItem_001);
 
@@ -96,7 +96,78 @@ ut_heap_getChunk_001(CuTest *tc)
 
     CuAssertTrue(tc, retval == PM_RET_OK);
     CuAssertPtrNotNull(tc, pchunk);
-    CuAssertTrue(tc, PM_OBJ_GET_SIZE(pobj) >= HEAP_MAX_CHUNK_SIZE);
+    CuAssertTrue(tc, heap_getObjSize(pobj) >= HEAP_MAX_CHUNK_SIZE);
+}
+
+
+/* The heap size and string length for the large object test */
+#define LARGE_HEAP_SIZE 0x8000
+#define LARGE_STRING_LEN 5000
+#define LARGE_TUPLE_LEN 1000
+
+static uint8_t largeheap[LARGE_HEAP_SIZE];
+static char largestring[LARGE_STRING_LEN + 1];
+
+/**
+ * Tests heap_getChunk() with objects bigger than an object descriptor holds:
+ *      a multi-kilobyte string and tuple can be created
+ *      both survive a GC while rooted and keep their contents
+ *      both are reclaimed once they are no longer rooted
+ */
+void
+ut_heap_getChunk_003(CuTest *tc)
+{
+    pPmObj_t pstr;
+    pPmObj_t ptup;
+    uint8_t const *pcstr;
+    uint32_t avail1;
+    int16_t i;
+    uint8_t objid;
+    PmReturn_t retval;
+
+    retval = pm_init(largeheap, LARGE_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    avail1 = heap_getAvail();
+
+    for (i = 0; i < LARGE_STRING_LEN; i++)
+    {
+        largestring[i] = 'a' + (i % 26);
+    }
+    largestring[LARGE_STRING_LEN] = '\0';
+
+    retval = tuple_new(LARGE_TUPLE_LEN, &ptup);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, heap_getObjSize(ptup)
+                     >= sizeof(PmTuple_t)
+                        + (LARGE_TUPLE_LEN - 1) * sizeof(pPmObj_t));
+    for (i = 0; i < LARGE_TUPLE_LEN; i++)
+    {
+        ((pPmTuple_t)ptup)->val[i] = PM_NONE;
+    }
+    heap_gcPushTempRoot(ptup, &objid);
+
+    pcstr = (uint8_t const *)largestring;
+    retval = string_new(&pcstr, &pstr);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, ((pPmString_t)pstr)->length == LARGE_STRING_LEN);
+    ((pPmTuple_t)ptup)->val[LARGE_TUPLE_LEN - 1] = pstr;
+    HEAP_GC_WRITE_BARRIER(ptup, pstr);
+
+    /* Collect while the objects are rooted and check their contents */
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, OBJ_GET_TYPE(ptup) == OBJ_TYPE_TUP);
+    CuAssertTrue(tc, ((pPmTuple_t)ptup)->val[0] == PM_NONE);
+    pstr = ((pPmTuple_t)ptup)->val[LARGE_TUPLE_LEN - 1];
+    CuAssertTrue(tc, OBJ_GET_TYPE(pstr) == OBJ_TYPE_STR);
+    CuAssertTrue(tc, sli_strncmp((char const *)((pPmString_t)pstr)->val,
+                                 largestring, LARGE_STRING_LEN) == 0);
+
+    /* Unroot the objects and collect them */
+    heap_gcPopTempRoot(objid);
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, heap_getAvail() >= avail1);
 }
 
 
@@ -186,6 +257,783 @@ ut_heap_freeChunk_001(CuTest *tc)
 }
 
 
+/**
+ * Tests heap_getChunk():
+ *      a freed chunk that fits best is reused ahead of a larger free chunk
+ *      avail stays accurate across allocation from the bins
+ */
+void
+ut_heap_getChunk_002(CuTest *tc)
+{
+    uint8_t heap[HEAP_SIZE];
+    uint8_t *pchunksmall;
+    uint8_t *pchunklarge;
+    uint8_t *pchunksep;
+    uint8_t *pchunk;
+    uint16_t avail1;
+    PmReturn_t retval;
+
+    retval = heap_init(heap, HEAP_SIZE);
+    retval = heap_getChunk(40, &pchunksmall);
+    retval = heap_getChunk(16, &pchunksep);
+    retval = heap_getChunk(400, &pchunklarge);
+    retval = heap_getChunk(16, &pchunksep);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    retval = heap_freeChunk((pPmObj_t)pchunklarge);
+    retval = heap_freeChunk((pPmObj_t)pchunksmall);
+    avail1 = heap_getAvail();
+
+    retval = heap_getChunk(40, &pchunk);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertPtrEquals(tc, pchunksmall, pchunk);
+    CuAssertTrue(tc, heap_getAvail() == avail1 - PM_OBJ_GET_SIZE(pchunk));
+
+    retval = heap_getChunk(300, &pchunk);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertPtrEquals(tc, pchunklarge, pchunk);
+}
+
+
+#ifdef HAVE_GC
+/* Heap for the GC stress test; large enough to hold the whole chain */
+#define STRESS_HEAP_SIZE 0x800000
+
+/* The number of links in the GC stress test's chain */
+#define STRESS_CHAIN_LEN 100000L
+
+static uint8_t stressheap[STRESS_HEAP_SIZE];
+
+/**
+ * Tests heap_gcRun():
+ *      a 100k-element linked list of (int, next) tuples survives a GC
+ *      while it is rooted; marking depth does not overflow the C stack
+ *      all of the list is reclaimed once it is no longer rooted
+ */
+void
+ut_heap_gcRun_000(CuTest *tc)
+{
+    pPmObj_t phead;
+    pPmObj_t ptup;
+    pPmObj_t pint;
+    uint32_t avail1;
+    int32_t i;
+    uint8_t objid;
+    uint8_t objid2;
+    PmReturn_t retval;
+
+    retval = pm_init(stressheap, STRESS_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    avail1 = heap_getAvail();
+    phead = PM_NONE;
+
+    /* Build the list so that each link references the one before it */
+    heap_gcPushTempRoot(phead, &objid);
+    for (i = 0; i < STRESS_CHAIN_LEN; i++)
+    {
+        retval = int_new(i, &pint);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        heap_gcPushTempRoot(pint, &objid2);
+        retval = tuple_new(2, &ptup);
+        heap_gcPopTempRoot(objid2);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        ((pPmTuple_t)ptup)->val[0] = pint;
+        ((pPmTuple_t)ptup)->val[1] = phead;
+        HEAP_GC_RESCAN_BARRIER(ptup);
+        phead = ptup;
+        heap_gcPopTempRoot(objid);
+        heap_gcPushTempRoot(phead, &objid);
+    }
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    /* Collect while the list is rooted and check every link survived */
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    for (i = STRESS_CHAIN_LEN - 1; i >= 0; i--)
+    {
+        CuAssertTrue(tc, OBJ_GET_TYPE(phead) == OBJ_TYPE_TUP);
+        pint = ((pPmTuple_t)phead)->val[0];
+        CuAssertTrue(tc, OBJ_GET_TYPE(pint) == OBJ_TYPE_INT);
+        CuAssertTrue(tc, INT_GET_VAL(pint) == i);
+        phead = ((pPmTuple_t)phead)->val[1];
+    }
+    CuAssertPtrEquals(tc, PM_NONE, phead);
+
+    /* Unroot the list and collect it */
+    heap_gcPopTempRoot(objid);
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, heap_getAvail() >= avail1);
+}
+#endif /* HAVE_GC */
+
+#ifdef HAVE_GC_LAZY_SWEEP
+/* The number of live and of garbage objects in the lazy sweep test */
+#define LAZY_LIVE_LEN 100
+#define LAZY_GARBAGE_LEN 100000L
+
+/**
+ * Tests heap_gcRun() with a lazy sweep:
+ *      the collection's pause depends on the live objects, not the garbage
+ *      the garbage counts as available before it is swept
+ *      allocation reclaims the garbage and the live objects survive
+ */
+void
+ut_heap_gcRun_001(CuTest *tc)
+{
+    pPmObj_t phead;
+    pPmObj_t ptup;
+    uint8_t *pchunk;
+    uint32_t avail1;
+    uint32_t avail2;
+    uint32_t work;
+    uint32_t ms;
+    int32_t i;
+    uint8_t objid;
+    PmReturn_t retval;
+
+    retval = pm_init(stressheap, STRESS_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    avail1 = heap_getAvail();
+
+    /* Build a short rooted chain, then a lot of garbage */
+    phead = PM_NONE;
+    heap_gcPushTempRoot(phead, &objid);
+    for (i = 0; i < LAZY_LIVE_LEN; i++)
+    {
+        retval = tuple_new(1, &ptup);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        ((pPmTuple_t)ptup)->val[0] = phead;
+        phead = ptup;
+        heap_gcPopTempRoot(objid);
+        heap_gcPushTempRoot(phead, &objid);
+    }
+    avail2 = heap_getAvail();
+    for (i = 0; i < LAZY_GARBAGE_LEN; i++)
+    {
+        retval = tuple_new(1, &ptup);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        ((pPmTuple_t)ptup)->val[0] = PM_NONE;
+    }
+
+    /* The pause marks the chain but does not visit the garbage */
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcGetMaxPause(&work, &ms);
+    CuAssertTrue(tc, work < 10 * LAZY_LIVE_LEN);
+    CuAssertTrue(tc, heap_getAvail() >= avail2);
+
+    /* Allocating everything that was garbage sweeps it */
+    for (i = 0; i < LAZY_GARBAGE_LEN; i++)
+    {
+        retval = heap_getChunk(sizeof(PmTuple_t), &pchunk);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+    for (i = LAZY_LIVE_LEN; i > 0; i--)
+    {
+        CuAssertTrue(tc, OBJ_GET_TYPE(phead) == OBJ_TYPE_TUP);
+        phead = ((pPmTuple_t)phead)->val[0];
+    }
+    CuAssertPtrEquals(tc, PM_NONE, phead);
+
+    /* Unroot the chain and collect everything */
+    heap_gcPopTempRoot(objid);
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, heap_getAvail() >= avail1);
+}
+
+/**
+ * Tests heap_gcCollect() with a lazy sweep:
+ *      retval is OK
+ *      the collection's pause sweeps all of the garbage
+ */
+void
+ut_heap_gcCollect_000(CuTest *tc)
+{
+    pPmObj_t ptup;
+    uint32_t work;
+    uint32_t ms;
+    int32_t i;
+    PmReturn_t retval;
+
+    retval = pm_init(stressheap, STRESS_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    for (i = 0; i < LAZY_GARBAGE_LEN; i++)
+    {
+        retval = tuple_new(1, &ptup);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+
+    retval = heap_gcCollect();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcGetMaxPause(&work, &ms);
+    CuAssertTrue(tc, work >= LAZY_GARBAGE_LEN);
+}
+#endif /* HAVE_GC_LAZY_SWEEP */
+
+#ifdef HAVE_GC_INCREMENTAL
+/**
+ * Test heap_gcStep():
+ *      retval is OK
+ *      incremental steps reclaim garbage once the heap is half used
+ *      a rooted object survives the cycle
+ *      the maximum pause is recorded
+ */
+void
+ut_heap_gcStep_000(CuTest *tc)
+{
+    pPmObj_t pkeep;
+    pPmObj_t pgarbage;
+    uint32_t avail1;
+    uint32_t work;
+    uint32_t ms;
+    int32_t i;
+    uint8_t objid;
+    PmReturn_t retval;
+
+    retval = pm_init(stressheap, STRESS_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = heap_gcSetStepBudget(16);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    retval = int_new(123456, &pkeep);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(pkeep, &objid);
+
+    /* Fill over half of the heap with garbage */
+    while (heap_getAvail() >= (heap_getSize() >> 1))
+    {
+        retval = list_new(&pgarbage);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+    avail1 = heap_getAvail();
+
+    /* Run enough steps to complete a cycle */
+    for (i = 0; i < 100000; i++)
+    {
+        retval = heap_gcStep();
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+    CuAssertTrue(tc, heap_getAvail() > avail1);
+    CuAssertTrue(tc, OBJ_GET_TYPE(pkeep) == OBJ_TYPE_INT);
+    CuAssertTrue(tc, INT_GET_VAL(pkeep) == 123456);
+    heap_gcPopTempRoot(objid);
+
+    heap_gcGetMaxPause(&work, &ms);
+    CuAssertTrue(tc, work > 0);
+}
+#endif /* HAVE_GC_INCREMENTAL */
+
+#if defined(HAVE_GC_NURSERY) && defined(HAVE_FLOAT)
+/**
+ * Test heap_getNurseryChunk():
+ *      garbage floats are reclaimed by minor collections alone
+ *      a float stored in a list survives the minor collections
+ * Floats are used because ints may be tagged and take no memory.
+ */
+void
+ut_heap_getNurseryChunk_000(CuTest *tc)
+{
+    pPmObj_t plist;
+    pPmObj_t pflt;
+    uint32_t full;
+    uint32_t minor;
+    int32_t i;
+    uint8_t objid;
+    PmReturn_t retval;
+
+    retval = pm_init(stressheap, STRESS_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    retval = list_new(&plist);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(plist, &objid);
+    retval = float_new(123456.0, &pflt);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = list_append(plist, pflt);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    /* Make far more garbage floats than fit in the nursery */
+    for (i = 0; i < STRESS_CHAIN_LEN; i++)
+    {
+        retval = float_new((float)(i + 1000), &pflt);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+
+    heap_gcGetCounts(&full, &minor);
+    CuAssertTrue(tc, full == 0);
+    CuAssertTrue(tc, minor > 0);
+
+    retval = list_getItem(plist, 0, &pflt);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, OBJ_GET_TYPE(pflt) == OBJ_TYPE_FLT);
+    CuAssertTrue(tc, ((pPmFloat_t)pflt)->val == 123456.0);
+    heap_gcPopTempRoot(objid);
+}
+#endif /* HAVE_GC_NURSERY && HAVE_FLOAT */
+
+#if defined(HAVE_HEAP_POOLS) && defined(HAVE_GC)
+/* The number of items in the list of the pool test */
+#define POOL_LIST_LEN 100
+
+/**
+ * Test heap_getPoolChunk():
+ *      a pool object takes none of the heap's free memory
+ *      a freed slot is the next one taken from its pool
+ *      the GC returns the slots of garbage objects to their pool
+ *      the segments of a live list survive the GC
+ */
+void
+ut_heap_getPoolChunk_000(CuTest *tc)
+{
+    pPmObj_t plist;
+    pPmObj_t psqi = PM_NONE;
+    pPmObj_t pint;
+    uint8_t *pchunk;
+    uint8_t *pchunk2;
+    uint32_t avail;
+    int32_t i;
+    uint8_t objid;
+    PmReturn_t retval;
+
+    retval = pm_init(stressheap, STRESS_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    avail = heap_getAvail();
+    retval = heap_getPoolChunk(OBJ_TYPE_SQI, sizeof(PmSeqIter_t), &pchunk);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, heap_getAvail() == avail);
+    retval = heap_freeChunk((pPmObj_t)pchunk);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = heap_getPoolChunk(OBJ_TYPE_SQI, sizeof(PmSeqIter_t), &pchunk2);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, pchunk2 == pchunk);
+    retval = heap_freeChunk((pPmObj_t)pchunk2);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    /* A list whose segments come from the pool */
+    retval = list_new(&plist);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(plist, &objid);
+    for (i = 0; i < POOL_LIST_LEN; i++)
+    {
+        retval = int_new(i, &pint);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        retval = list_append(plist, pint);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+
+    /* Use up the pool with garbage iterators */
+    for (i = 0; i < STRESS_CHAIN_LEN; i++)
+    {
+        retval = seqiter_new(plist, &psqi);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    /* The garbage iterators' slots are back in the pool */
+    avail = heap_getAvail();
+    retval = heap_getPoolChunk(OBJ_TYPE_SQI, sizeof(PmSeqIter_t), &pchunk);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, heap_getAvail() == avail);
+
+    CuAssertTrue(tc, ((pPmList_t)plist)->length == POOL_LIST_LEN);
+    for (i = 0; i < POOL_LIST_LEN; i++)
+    {
+        retval = list_getItem(plist, i, &pint);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        CuAssertTrue(tc, OBJ_GET_TYPE(pint) == OBJ_TYPE_INT);
+        CuAssertTrue(tc, INT_GET_VAL(pint) == i);
+    }
+    heap_gcPopTempRoot(objid);
+}
+#endif /* HAVE_HEAP_POOLS && HAVE_GC */
+
+#if defined(HAVE_HEAP_STATS) && defined(HAVE_GC)
+/**
+ * Test heap_getStats():
+ *      new objects are counted by type and in the allocation totals
+ *      a collection is counted and the garbage it reclaims is counted
+ */
+void
+ut_heap_getStats_000(CuTest *tc)
+{
+    PmHeapStats_t before;
+    PmHeapStats_t after;
+    pPmObj_t ptup;
+    int16_t i;
+    PmReturn_t retval;
+
+    retval = pm_init(stressheap, STRESS_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    heap_getStats(&before);
+    CuAssertTrue(tc, before.size == heap_getSize());
+    CuAssertTrue(tc, before.maxfree <= before.avail);
+    CuAssertTrue(tc, before.nfree > 0);
+
+    for (i = 0; i < 10; i++)
+    {
+        retval = tuple_new(4, &ptup);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+    heap_getStats(&after);
+    CuAssertTrue(tc, after.typecount[OBJ_TYPE_TUP]
+                     == before.typecount[OBJ_TYPE_TUP] + 10);
+    CuAssertTrue(tc, after.allocs == before.allocs + 10);
+    CuAssertTrue(tc, after.allocbytes >= before.allocbytes
+                                         + 10 * sizeof(PmTuple_t));
+
+    /* A lazy sweep reclaims the garbage by the start of the next run */
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_getStats(&after);
+    CuAssertTrue(tc, after.gc_fullcount == before.gc_fullcount + 2);
+    CuAssertTrue(tc, after.gc_reclaimed >= before.gc_reclaimed
+                                           + 10 * sizeof(PmTuple_t));
+}
+#endif /* HAVE_HEAP_STATS && HAVE_GC */
+
+/* Size of the region added by the multi-region test */
+#define REGION_SIZE 0x2000
+
+/* Size of each chunk taken by the multi-region test */
+#define REGION_CHUNK_SIZE 500
+
+static uint8_t regionheap[REGION_SIZE];
+
+/* The heap the region is added to; it outlives the test, so it is static */
+static uint8_t regionbaseheap[HEAP_SIZE];
+
+/**
+ * Test heap_addRegion():
+ *      the region's memory is added to the heap size and the free memory
+ *      chunks are given out of both regions until both are used up
+ */
+void
+ut_heap_addRegion_000(CuTest *tc)
+{
+    uint8_t *pchunk;
+    uint32_t size;
+    uint32_t avail;
+    uint8_t inregion = C_FALSE;
+    PmReturn_t retval;
+
+    retval = heap_init(regionbaseheap, HEAP_SIZE);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    size = heap_getSize();
+    avail = heap_getAvail();
+
+    retval = heap_addRegion(regionheap, REGION_SIZE);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, heap_getSize() > size);
+    CuAssertTrue(tc, heap_getSize() <= size + REGION_SIZE);
+    CuAssertTrue(tc, heap_getAvail() - avail == heap_getSize() - size);
+
+    /* Take chunks until the region has given some out */
+    while (heap_getAvail() >= REGION_CHUNK_SIZE + HEAP_CHUNK_MIN_SIZE)
+    {
+        retval = heap_getChunk(REGION_CHUNK_SIZE, &pchunk);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        if ((pchunk >= regionheap) && (pchunk < &regionheap[REGION_SIZE]))
+        {
+            inregion = C_TRUE;
+        }
+    }
+    CuAssertTrue(tc, inregion);
+    CuAssertTrue(tc, heap_getAvail() < avail);
+
+    /* Leave a fresh heap without the region for the tests that follow */
+    retval = pm_init(regionbaseheap, HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+}
+
+#ifdef HAVE_HEAP_GROW
+/* The number of links in the heap growth test's chain */
+#define GROW_CHAIN_LEN 4000
+
+/**
+ * Test heap_getChunk() with HAVE_HEAP_GROW:
+ *      a rooted chain bigger than the heap makes the heap grow and survives
+ *      once it is unrooted and collected, the grown memory is given back
+ */
+void
+ut_heap_getChunk_004(CuTest *tc)
+{
+    pPmObj_t phead;
+    pPmObj_t ptup;
+    pPmObj_t pint;
+    uint32_t size;
+    int16_t i;
+    uint8_t objid;
+    uint8_t objid2;
+    PmReturn_t retval;
+
+    retval = pm_init(largeheap, LARGE_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    size = heap_getSize();
+    phead = PM_NONE;
+
+    heap_gcPushTempRoot(phead, &objid);
+    for (i = 0; i < GROW_CHAIN_LEN; i++)
+    {
+        retval = int_new(i, &pint);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        heap_gcPushTempRoot(pint, &objid2);
+        retval = tuple_new(2, &ptup);
+        heap_gcPopTempRoot(objid2);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        ((pPmTuple_t)ptup)->val[0] = pint;
+        ((pPmTuple_t)ptup)->val[1] = phead;
+        HEAP_GC_RESCAN_BARRIER(ptup);
+        phead = ptup;
+        heap_gcPopTempRoot(objid);
+        heap_gcPushTempRoot(phead, &objid);
+    }
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, heap_getSize() > size);
+
+    /* Collect while the chain is rooted and check every link survived */
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    for (i = GROW_CHAIN_LEN - 1; i >= 0; i--)
+    {
+        CuAssertTrue(tc, OBJ_GET_TYPE(phead) == OBJ_TYPE_TUP);
+        pint = ((pPmTuple_t)phead)->val[0];
+        CuAssertTrue(tc, INT_GET_VAL(pint) == i);
+        phead = ((pPmTuple_t)phead)->val[1];
+    }
+
+    /* Unroot the chain; the sweep that frees it releases the region */
+    heap_gcPopTempRoot(objid);
+    size = heap_getSize();
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, heap_getSize() < size);
+}
+#endif /* HAVE_HEAP_GROW */
+
+#ifdef HAVE_GC_COMPACT
+/* Heap for the compaction test; its free memory fits in one free chunk */
+#define COMPACT_HEAP_SIZE 0x8000
+
+/* The number of items in each tuple of the compaction test */
+#define COMPACT_TUPLE_LEN 20
+
+static uint8_t compactheap[COMPACT_HEAP_SIZE];
+
+/**
+ * Test heap_gcCompact():
+ *      a heap holed by garbage tuples has no large free chunk
+ *      after compaction all free memory is in one chunk
+ *      the kept tuples are intact when found again through the builtins
+ */
+void
+ut_heap_gcCompact_000(CuTest *tc)
+{
+    pPmObj_t pkey;
+    pPmObj_t pkeep;
+    pPmObj_t ptup;
+    pPmObj_t pint;
+    uint8_t *pchunk;
+    int16_t i;
+    int16_t n;
+    uint8_t objid;
+    PmReturn_t retval;
+
+    retval = pm_init(compactheap, COMPACT_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    /* Keep a list in a builtins dict, which compaction fixes up */
+    retval = dict_new(&pkeep);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    gVmGlobal.builtins = (pPmDict_t)pkeep;
+    retval = list_new(&pkeep);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(pkeep, &objid);
+    retval = int_new(1000, &pkey);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = dict_setItem(PM_PBUILTINS, pkey, pkeep);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPopTempRoot(objid);
+
+    /* Fill the heap with tuples, keeping every other one */
+    for (i = 0; heap_getAvail() > 1024; i++)
+    {
+        retval = tuple_new(COMPACT_TUPLE_LEN, &ptup);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        ((pPmTuple_t)ptup)->val[0] = PM_NONE;
+        if ((i & 1) == 0)
+        {
+            heap_gcPushTempRoot(ptup, &objid);
+            retval = int_new(i, &pint);
+            CuAssertTrue(tc, retval == PM_RET_OK);
+            ((pPmTuple_t)ptup)->val[0] = pint;
+            HEAP_GC_RESCAN_BARRIER(ptup);
+            retval = list_append(pkeep, ptup);
+            CuAssertTrue(tc, retval == PM_RET_OK);
+            heap_gcPopTempRoot(objid);
+        }
+    }
+    n = ((pPmList_t)pkeep)->length;
+
+    /* The garbage leaves holes, none big enough for a large chunk */
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, heap_getMaxFree() < (heap_getAvail() >> 1));
+
+    retval = heap_gcCompact();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, heap_getMaxFree() == heap_getAvail());
+
+    /* The list moved; find it again and check its tuples */
+    retval = int_new(1000, &pkey);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = dict_getItem(PM_PBUILTINS, pkey, &pkeep);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, ((pPmList_t)pkeep)->length == n);
+    for (i = 0; i < n; i++)
+    {
+        retval = list_getItem(pkeep, i, &ptup);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        CuAssertTrue(tc, OBJ_GET_TYPE(ptup) == OBJ_TYPE_TUP);
+        pint = ((pPmTuple_t)ptup)->val[0];
+        CuAssertTrue(tc, OBJ_GET_TYPE(pint) == OBJ_TYPE_INT);
+        CuAssertTrue(tc, INT_GET_VAL(pint) == 2 * i);
+    }
+
+    /* A large chunk can now be allocated */
+    retval = heap_getChunk(1024, &pchunk);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+}
+
+#if defined(HAVE_HASHED_DICTS) && defined(HAVE_CLASSES)
+/* The number of instances used as keys by the compaction rehash test */
+#define COMPACT_NUM_KEYS 100
+
+/**
+ * Test heap_gcCompact() with keys that hash by address:
+ *      instances are found as keys of a dict after they have moved
+ *      setting a moved key again replaces its value instead of adding a twin
+ */
+void
+ut_heap_gcCompact_001(CuTest *tc)
+{
+    pPmObj_t pdict;
+    pPmObj_t pkeys;
+    pPmObj_t pclass;
+    pPmObj_t pinst;
+    pPmObj_t pobj;
+    pPmObj_t pname;
+    pPmObj_t pbases;
+    pPmObj_t pkey;
+    uint8_t const *pcs = (uint8_t const *)"C";
+    int16_t i;
+    uint8_t objid;
+    uint8_t objid2;
+    uint8_t objid3;
+    PmReturn_t retval;
+
+    retval = pm_init(compactheap, COMPACT_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    /* A class with no attrs and no bases */
+    retval = dict_new(&pobj);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(pobj, &objid);
+    retval = string_new(&pcs, &pname);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(pname, &objid2);
+    retval = tuple_new(0, &pbases);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(pbases, &objid2);
+    retval = class_new(pobj, pbases, pname, &pclass);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPopTempRoot(objid);
+    heap_gcPushTempRoot(pclass, &objid);
+
+    /*
+     * The dict maps each instance to its index; the list keeps the order.
+     * Both are kept in a builtins dict, which compaction fixes up.
+     */
+    retval = dict_new(&pobj);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    gVmGlobal.builtins = (pPmDict_t)pobj;
+    retval = dict_new(&pdict);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(pdict, &objid2);
+    retval = int_new(1000, &pkey);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = dict_setItem(PM_PBUILTINS, pkey, pdict);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPopTempRoot(objid2);
+    retval = list_new(&pkeys);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(pkeys, &objid2);
+    retval = int_new(1001, &pkey);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = dict_setItem(PM_PBUILTINS, pkey, pkeys);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPopTempRoot(objid2);
+
+    /*
+     * Garbage between the instances makes them move when compacted;
+     * it is kept small so its holes do not stop the dict from growing
+     */
+    for (i = 0; i < COMPACT_NUM_KEYS; i++)
+    {
+        retval = tuple_new(2, &pobj);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        retval = class_instantiate(pclass, &pinst);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        heap_gcPushTempRoot(pinst, &objid2);
+        retval = list_append(pkeys, pinst);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        retval = int_new(i, &pobj);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        heap_gcPushTempRoot(pobj, &objid3);
+        retval = dict_setItem(pdict, pinst, pobj);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        heap_gcPopTempRoot(objid2);
+    }
+    heap_gcPopTempRoot(objid);
+
+    retval = heap_gcCompact();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    /* The dict and the list moved; find them again */
+    retval = int_new(1000, &pkey);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = dict_getItem(PM_PBUILTINS, pkey, &pdict);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = int_new(1001, &pkey);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = dict_getItem(PM_PBUILTINS, pkey, &pkeys);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    for (i = 0; i < COMPACT_NUM_KEYS; i++)
+    {
+        retval = list_getItem(pkeys, i, &pinst);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        retval = dict_getItem(pdict, pinst, &pobj);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        CuAssertTrue(tc, INT_GET_VAL(pobj) == i);
+        retval = dict_setItem(pdict, pinst, PM_NONE);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+    CuAssertTrue(tc, ((pPmDict_t)pdict)->length == COMPACT_NUM_KEYS);
+}
+#endif /* HAVE_HASHED_DICTS && HAVE_CLASSES */
+#endif /* HAVE_GC_COMPACT */
+
+
 /** Make a suite from all tests in this file */
 CuSuite *getSuite_testHeap(void)
 {
@@ -194,9 +1042,40 @@ CuSuite *getSuite_testHeap(void)
     SUITE_ADD_TEST(suite, ut_heap_init_000);
     SUITE_ADD_TEST(suite, ut_heap_getChunk_000);
     SUITE_ADD_TEST(suite, ut_heap_getChunk_001);
+    SUITE_ADD_TEST(suite, ut_heap_getChunk_002);
+    SUITE_ADD_TEST(suite, ut_heap_getChunk_003);
     SUITE_ADD_TEST(suite, ut_heap_getAvail_000);
     SUITE_ADD_TEST(suite, ut_heap_freeChunk_000);
     SUITE_ADD_TEST(suite, ut_heap_freeChunk_001);
+#ifdef HAVE_GC
+    SUITE_ADD_TEST(suite, ut_heap_gcRun_000);
+#endif /* HAVE_GC */
+#ifdef HAVE_GC_LAZY_SWEEP
+    SUITE_ADD_TEST(suite, ut_heap_gcRun_001);
+    SUITE_ADD_TEST(suite, ut_heap_gcCollect_000);
+#endif /* HAVE_GC_LAZY_SWEEP */
+#ifdef HAVE_GC_INCREMENTAL
+    SUITE_ADD_TEST(suite, ut_heap_gcStep_000);
+#endif /* HAVE_GC_INCREMENTAL */
+#if defined(HAVE_GC_NURSERY) && defined(HAVE_FLOAT)
+    SUITE_ADD_TEST(suite, ut_heap_getNurseryChunk_000);
+#endif /* HAVE_GC_NURSERY && HAVE_FLOAT */
+#if defined(HAVE_HEAP_POOLS) && defined(HAVE_GC)
+    SUITE_ADD_TEST(suite, ut_heap_getPoolChunk_000);
+#endif /* HAVE_HEAP_POOLS && HAVE_GC */
+#if defined(HAVE_HEAP_STATS) && defined(HAVE_GC)
+    SUITE_ADD_TEST(suite, ut_heap_getStats_000);
+#endif /* HAVE_HEAP_STATS && HAVE_GC */
+    SUITE_ADD_TEST(suite, ut_heap_addRegion_000);
+#ifdef HAVE_HEAP_GROW
+    SUITE_ADD_TEST(suite, ut_heap_getChunk_004);
+#endif /* HAVE_HEAP_GROW */
+#ifdef HAVE_GC_COMPACT
+    SUITE_ADD_TEST(suite, ut_heap_gcCompact_000);
+#if defined(HAVE_HASHED_DICTS) && defined(HAVE_CLASSES)
+    SUITE_ADD_TEST(suite, ut_heap_gcCompact_001);
+#endif /* HAVE_HASHED_DICTS && HAVE_CLASSES */
+#endif /* HAVE_GC_COMPACT */
 
     return suite;
 }
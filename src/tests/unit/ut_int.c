@@ -50,7 +50,7 @@ ut_int_new_000(CuTest *tc)
     CuAssertTrue(tc, OBJ_GET_TYPE(pint) == OBJ_TYPE_INT);
     
     /* Check that the value is 42 */
-    CuAssertTrue(tc, ((pPmInt_t)pint)->val == 42);
+    CuAssertTrue(tc, INT_GET_VAL(pint) == 42);
 }
 /* END unit tests ported from Snarf */
 
@@ -81,7 +81,7 @@ ut_int_dup_000(CuTest *tc)
     CuAssertTrue(tc, OBJ_GET_TYPE(pdup) == OBJ_TYPE_INT);
     
     /* Check that the value is 42 */
-    CuAssertTrue(tc, ((pPmInt_t)pdup)->val == 42);
+    CuAssertTrue(tc, INT_GET_VAL(pdup) == 42);
     
     /* Check that comparing the two objects yields true */
     CuAssertTrue(tc, obj_compare(pint, pdup) == C_SAME);
@@ -114,7 +114,7 @@ ut_int_positive_000(CuTest *tc)
     CuAssertTrue(tc, OBJ_GET_TYPE(ppos) == OBJ_TYPE_INT);
     
     /* Check that the value is 42 */
-    CuAssertTrue(tc, ((pPmInt_t)ppos)->val == 42);
+    CuAssertTrue(tc, INT_GET_VAL(ppos) == 42);
     
     /* Check that comparing the two objects yields true */
     CuAssertTrue(tc, obj_compare(pint, ppos) == C_SAME);
@@ -147,7 +147,7 @@ ut_int_positive_001(CuTest *tc)
     CuAssertTrue(tc, OBJ_GET_TYPE(ppos) == OBJ_TYPE_INT);
     
     /* Check that the value is 42 */
-    CuAssertTrue(tc, ((pPmInt_t)ppos)->val == -42);
+    CuAssertTrue(tc, INT_GET_VAL(ppos) == -42);
     
     /* Check that comparing the two objects yields true */
     CuAssertTrue(tc, obj_compare(pint, ppos) == C_SAME);
@@ -180,7 +180,7 @@ ut_int_positive_002(CuTest *tc)
     CuAssertTrue(tc, OBJ_GET_TYPE(ppos) == OBJ_TYPE_INT);
     
     /* Check that the value is 42 */
-    CuAssertTrue(tc, ((pPmInt_t)ppos)->val == 0);
+    CuAssertTrue(tc, INT_GET_VAL(ppos) == 0);
     
     /* Check that comparing the two objects yields true */
     CuAssertTrue(tc, obj_compare(pint, ppos) == C_SAME);
@@ -213,7 +213,7 @@ ut_int_negative_000(CuTest *tc)
     CuAssertTrue(tc, OBJ_GET_TYPE(pneg) == OBJ_TYPE_INT);
     
     /* Check that the value is 42 */
-    CuAssertTrue(tc, ((pPmInt_t)pneg)->val == -42);
+    CuAssertTrue(tc, INT_GET_VAL(pneg) == -42);
     
     /* Check that comparing the two objects yields false */
     CuAssertTrue(tc, obj_compare(pint, pneg) == C_DIFFER);
@@ -246,7 +246,7 @@ ut_int_negative_001(CuTest *tc)
     CuAssertTrue(tc, OBJ_GET_TYPE(pneg) == OBJ_TYPE_INT);
     
     /* Check that the value is 42 */
-    CuAssertTrue(tc, ((pPmInt_t)pneg)->val == 42);
+    CuAssertTrue(tc, INT_GET_VAL(pneg) == 42);
     
     /* Check that comparing the two objects yields false */
     CuAssertTrue(tc, obj_compare(pint, pneg) == C_DIFFER);
@@ -279,7 +279,7 @@ ut_int_negative_002(CuTest *tc)
     CuAssertTrue(tc, OBJ_GET_TYPE(pneg) == OBJ_TYPE_INT);
     
     /* Check that the value is 0 */
-    CuAssertTrue(tc, ((pPmInt_t)pneg)->val == 0);
+    CuAssertTrue(tc, INT_GET_VAL(pneg) == 0);
     
     /* Check that comparing the two objects yields true */
     CuAssertTrue(tc, obj_compare(pint, pneg) == C_SAME);
@@ -312,7 +312,7 @@ ut_int_bitInvert_000(CuTest *tc)
     CuAssertTrue(tc, OBJ_GET_TYPE(pinv) == OBJ_TYPE_INT);
     
     /* Check that the value is -43 */
-    CuAssertTrue(tc, ((pPmInt_t)pinv)->val == -43);
+    CuAssertTrue(tc, INT_GET_VAL(pinv) == -43);
     
     /* Check that comparing the two objects yields false */
     CuAssertTrue(tc, obj_compare(pint, pinv) == C_DIFFER);
@@ -320,12 +320,123 @@ ut_int_bitInvert_000(CuTest *tc)
 /* BEGIN unit tests ported from Snarf */
 
 
+#ifdef HAVE_TAGGED_INTS
+/**
+ * Tests int_new() with tagged ints:
+ *      a small int is tagged and takes no heap memory
+ *      the extreme values survive the round trip
+ *      ints with the same value are the same object
+ *      a tagged int compares equal to itself and unequal to others
+ */
+void
+ut_int_new_001(CuTest *tc)
+{
+    uint8_t heap[HEAP_SIZE];
+    PmReturn_t retval;
+    pPmObj_t pint;
+    pPmObj_t pint2;
+    uint32_t avail;
+
+    pm_init(heap, HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    avail = heap_getAvail();
+    retval = int_new(1000, &pint);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, OBJ_IS_TAGGED(pint));
+    CuAssertTrue(tc, OBJ_GET_TYPE(pint) == OBJ_TYPE_INT);
+    CuAssertTrue(tc, INT_GET_VAL(pint) == 1000);
+    CuAssertTrue(tc, heap_getAvail() == avail);
+
+    retval = int_new(-1073741824L, &pint);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, INT_GET_VAL(pint) == -1073741824L);
+    retval = int_new(0x3FFFFFFFL, &pint);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, INT_GET_VAL(pint) == 0x3FFFFFFFL);
+
+    /* Values outside the tag range on 32-bit targets are boxed there */
+    retval = int_new(INT32_MIN, &pint);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, INT_GET_VAL(pint) == INT32_MIN);
+    retval = int_new(INT32_MAX, &pint);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, INT_GET_VAL(pint) == INT32_MAX);
+
+    retval = int_new(-7, &pint);
+    retval = int_new(-7, &pint2);
+    CuAssertTrue(tc, pint == pint2);
+    CuAssertTrue(tc, obj_compare(pint, pint2) == C_SAME);
+    retval = int_new(7, &pint2);
+    CuAssertTrue(tc, obj_compare(pint, pint2) == C_DIFFER);
+    CuAssertTrue(tc, obj_compare(pint2, PM_NONE) == C_DIFFER);
+    CuAssertTrue(tc, obj_compare(PM_ONE, PM_TRUE) == C_DIFFER);
+}
+#endif /* HAVE_TAGGED_INTS */
+
+
+#ifdef HAVE_SMALL_INT_CACHE
+/**
+ * Tests int_new() and int_dup() with the small int cache:
+ *      a small int takes no heap memory and is made once
+ *      zero, one and negone are the cached ints
+ *      an int outside the cache is allocated and compares by value
+ */
+void
+ut_int_new_002(CuTest *tc)
+{
+    uint8_t heap[HEAP_SIZE];
+    PmReturn_t retval;
+    pPmObj_t pint;
+    pPmObj_t pint2;
+    uint32_t avail;
+
+    pm_init(heap, HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    avail = heap_getAvail();
+    retval = int_new(INT_CACHE_MAX, &pint);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = int_new(INT_CACHE_MAX, &pint2);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, pint == pint2);
+    CuAssertTrue(tc, INT_GET_VAL(pint) == INT_CACHE_MAX);
+    retval = int_dup(pint, &pint2);
+    CuAssertTrue(tc, pint == pint2);
+    retval = int_new(INT_CACHE_MIN, &pint);
+    CuAssertTrue(tc, INT_IS_CACHED(pint));
+    CuAssertTrue(tc, INT_GET_VAL(pint) == INT_CACHE_MIN);
+    CuAssertTrue(tc, heap_getAvail() == avail);
+
+    retval = int_new(0, &pint);
+    CuAssertTrue(tc, pint == PM_ZERO);
+    retval = int_new(1, &pint);
+    CuAssertTrue(tc, pint == PM_ONE);
+    retval = int_new(-1, &pint);
+    CuAssertTrue(tc, pint == PM_NEGONE);
+
+    retval = int_new(INT_CACHE_MAX + 1, &pint);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, !INT_IS_CACHED(pint));
+    retval = int_dup(pint, &pint2);
+    CuAssertTrue(tc, pint != pint2);
+    CuAssertTrue(tc, obj_compare(pint, pint2) == C_SAME);
+    retval = int_new(INT_CACHE_MAX, &pint2);
+    CuAssertTrue(tc, obj_compare(pint, pint2) == C_DIFFER);
+    CuAssertTrue(tc, obj_compare(pint2, pint) == C_DIFFER);
+    CuAssertTrue(tc, obj_compare(PM_ONE, PM_TRUE) == C_DIFFER);
+}
+#endif /* HAVE_SMALL_INT_CACHE */
+
+
 /** Make a suite from all tests in this file */
 CuSuite *getSuite_testIntObj(void)
 {
     CuSuite* suite = CuSuiteNew();
 
     SUITE_ADD_TEST(suite, ut_int_new_000);
+#ifdef HAVE_TAGGED_INTS
+    SUITE_ADD_TEST(suite, ut_int_new_001);
+#endif /* HAVE_TAGGED_INTS */
+#ifdef HAVE_SMALL_INT_CACHE
+    SUITE_ADD_TEST(suite, ut_int_new_002);
+#endif /* HAVE_SMALL_INT_CACHE */
     SUITE_ADD_TEST(suite, ut_int_dup_000);
     SUITE_ADD_TEST(suite, ut_int_positive_000);
     SUITE_ADD_TEST(suite, ut_int_positive_001);
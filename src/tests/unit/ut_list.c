@@ -614,6 +614,163 @@ ut_list_index_000(CuTest *tc)
 }
 
 
+/* Big enough for the items of a large list when ints are boxed */
+#define LARGE_HEAP_SIZE 0x100000
+
+/* More items than the largest item array holds on any host */
+#define LARGE_LIST_LEN 17000
+
+static uint8_t largeheap[LARGE_HEAP_SIZE];
+
+/**
+ * Test a list that grows:
+ *      items appended one by one are found at their indices
+ *      a GC keeps every item of a rooted list
+ *      insert and delete at the front shift all the items
+ *      a list that outgrows the largest item array keeps working
+ */
+void
+ut_list_grow_000(CuTest *tc)
+{
+    pPmObj_t plist;
+    pPmObj_t pobj;
+    int16_t i;
+    uint8_t objid;
+    uint8_t objid2;
+    PmReturn_t retval;
+
+    retval = pm_init(largeheap, LARGE_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    retval = list_new(&plist);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(plist, &objid);
+
+    for (i = 0; i < LARGE_LIST_LEN; i++)
+    {
+        retval = int_new(i, &pobj);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        heap_gcPushTempRoot(pobj, &objid2);
+        retval = list_append(plist, pobj);
+        heap_gcPopTempRoot(objid2);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        if (i == 100)
+        {
+            retval = heap_gcRun();
+            CuAssertTrue(tc, retval == PM_RET_OK);
+        }
+    }
+    CuAssertTrue(tc, ((pPmList_t)plist)->length == LARGE_LIST_LEN);
+
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    for (i = 0; i < LARGE_LIST_LEN; i += 97)
+    {
+        retval = list_getItem(plist, i, &pobj);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        CuAssertTrue(tc, INT_GET_VAL(pobj) == i);
+    }
+
+    retval = list_insert(plist, 0, PM_NONE);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = list_getItem(plist, LARGE_LIST_LEN, &pobj);
+    CuAssertTrue(tc, INT_GET_VAL(pobj) == LARGE_LIST_LEN - 1);
+    retval = list_delItem(plist, 0);
+    retval = list_delItem(plist, 0);
+    CuAssertTrue(tc, ((pPmList_t)plist)->length == LARGE_LIST_LEN - 1);
+    retval = list_getItem(plist, 0, &pobj);
+    CuAssertTrue(tc, INT_GET_VAL(pobj) == 1);
+    retval = list_getItem(plist, -1, &pobj);
+    CuAssertTrue(tc, INT_GET_VAL(pobj) == LARGE_LIST_LEN - 1);
+
+    heap_gcPopTempRoot(objid);
+}
+
+
+/**
+ * Tests iterating over a seglist-backed list while the list changes
+ */
+void
+ut_list_iter_000(CuTest *tc)
+{
+    pPmObj_t plist;
+    pPmObj_t psqi;
+    pPmObj_t pobj;
+    pPmObj_t pitem;
+    int16_t i;
+    uint8_t objid;
+    uint8_t objid2;
+    uint8_t objid3;
+    PmReturn_t retval;
+
+    retval = pm_init(largeheap, LARGE_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    retval = list_new(&plist);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(plist, &objid);
+    for (i = 0; i < LARGE_LIST_LEN; i++)
+    {
+        retval = int_new(i, &pobj);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        heap_gcPushTempRoot(pobj, &objid2);
+        retval = list_append(plist, pobj);
+        heap_gcPopTempRoot(objid2);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+    retval = seqiter_new(plist, &psqi);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(psqi, &objid2);
+
+    /* Items come back by index, also after changes ahead of the iterator */
+    for (i = 0; i < LARGE_LIST_LEN - 4; i++)
+    {
+        if (i == 1000)
+        {
+            retval = heap_gcRun();
+            CuAssertTrue(tc, retval == PM_RET_OK);
+        }
+        if (i == 3000)
+        {
+            retval = list_delItem(plist, 0);
+            CuAssertTrue(tc, retval == PM_RET_OK);
+            retval = int_new(-100, &pobj);
+            CuAssertTrue(tc, retval == PM_RET_OK);
+            heap_gcPushTempRoot(pobj, &objid3);
+            retval = list_insert(plist, 1, pobj);
+            heap_gcPopTempRoot(objid3);
+            CuAssertTrue(tc, retval == PM_RET_OK);
+        }
+        retval = seqiter_getNext(psqi, &pitem);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        retval = list_getItem(plist, i, &pobj);
+        CuAssertTrue(tc, pitem == pobj);
+    }
+
+    /* Unlink the iterator's segment, then refill the list with new items */
+    for (i = 0; i < 12; i++)
+    {
+        retval = list_delItem(plist, ((pPmList_t)plist)->length - 1);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+    for (i = 0; i < 12; i++)
+    {
+        retval = int_new(-1 - i, &pobj);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        heap_gcPushTempRoot(pobj, &objid3);
+        retval = list_append(plist, pobj);
+        heap_gcPopTempRoot(objid3);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+    for (i = 8; i < 12; i++)
+    {
+        retval = seqiter_getNext(psqi, &pitem);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        CuAssertTrue(tc, INT_GET_VAL(pitem) == -1 - i);
+    }
+    retval = seqiter_getNext(psqi, &pitem);
+    CuAssertTrue(tc, retval == PM_RET_EX_STOP);
+
+    heap_gcPopTempRoot(objid);
+}
+
+
 /** Make a suite from all tests in this file */
 CuSuite *getSuite_testList(void)
 {
@@ -631,6 +788,8 @@ CuSuite *getSuite_testList(void)
     SUITE_ADD_TEST(suite, ut_list_removeItem_000);
     SUITE_ADD_TEST(suite, ut_list_insert_000);
     SUITE_ADD_TEST(suite, ut_list_index_000);
+    SUITE_ADD_TEST(suite, ut_list_grow_000);
+    SUITE_ADD_TEST(suite, ut_list_iter_000);
 
     return suite;
 }
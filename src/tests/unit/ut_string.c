@@ -71,6 +71,250 @@ ut_string_newFromChar_000(CuTest *tc)
 }
 
 
+/**
+ * Tests string_newFromChar() with a null character:
+ *      length is 1 and the empty string keeps length 0
+ */
+void
+ut_string_newFromChar_001(CuTest *tc)
+{
+    uint8_t heap[HEAP_SIZE];
+    pPmObj_t pstring;
+    pPmObj_t pempty;
+    uint8_t cstring[] = "";
+    uint8_t const *pcstring = cstring;
+    PmReturn_t retval;
+
+    pm_init(heap, HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+
+    retval = string_new(&pcstring, &pempty);
+    retval = string_newFromChar('\0', &pstring);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, ((pPmString_t)pstring)->length == 1);
+    CuAssertTrue(tc, ((pPmString_t)pempty)->length == 0);
+    CuAssertTrue(tc, pstring != pempty);
+}
+
+
+/**
+ * Tests string_hash() and string_compare():
+ *      the hash is not 0 and is kept in the string
+ *      equal strings have equal hashes
+ *      a string and its concatenated twin compare the same
+ *      strings that differ compare differ
+ */
+void
+ut_string_hash_000(CuTest *tc)
+{
+    uint8_t heap[HEAP_SIZE];
+    pPmObj_t pstr1;
+    pPmObj_t pstr2;
+    pPmObj_t pstr3;
+    pPmObj_t pa;
+    pPmObj_t pb;
+    uint8_t cs1[] = "forty-two";
+    uint8_t cs2[] = "forty-two";
+    uint8_t cs3[] = "forty-three";
+    uint8_t csa[] = "forty";
+    uint8_t csb[] = "-two";
+    uint8_t const *pcs;
+    uint16_t h;
+    PmReturn_t retval;
+
+    pm_init(heap, HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+
+    pcs = cs1;
+    retval = string_new(&pcs, &pstr1);
+    pcs = cs3;
+    retval = string_new(&pcs, &pstr3);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+
+    h = string_hash((pPmString_t)pstr1);
+    CuAssertTrue(tc, h != 0);
+    CuAssertTrue(tc, ((pPmString_t)pstr1)->hash == h);
+    CuAssertTrue(tc, string_compare((pPmString_t)pstr1, (pPmString_t)pstr3)
+                     == C_DIFFER);
+
+    pcs = cs2;
+    retval = string_new(&pcs, &pstr2);
+    CuAssertTrue(tc, string_compare((pPmString_t)pstr1, (pPmString_t)pstr2)
+                     == C_SAME);
+    CuAssertTrue(tc, string_hash((pPmString_t)pstr2) == h);
+
+    pcs = csa;
+    retval = string_new(&pcs, &pa);
+    pcs = csb;
+    retval = string_new(&pcs, &pb);
+    retval = string_concat((pPmString_t)pa, (pPmString_t)pb, &pstr2);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, string_compare((pPmString_t)pstr1, (pPmString_t)pstr2)
+                     == C_SAME);
+    CuAssertTrue(tc, string_hash((pPmString_t)pstr2) == h);
+}
+
+
+/**
+ * Tests string_intern():
+ *      the first string of a value is interned and returned as is
+ *      a twin, such as a concatenation, is not interned until asked
+ *      interning a twin returns the first string and leaves the twin alone
+ *      the cache grows to hold many strings
+ *      the cache does not keep an unreferenced string alive
+ */
+void
+ut_string_intern_000(CuTest *tc)
+{
+    uint8_t heap[HEAP_SIZE];
+    pPmObj_t pstr1;
+    pPmObj_t pstr2;
+    pPmObj_t pa;
+    pPmObj_t pb;
+    pPmObj_t pobj;
+    pPmObj_t pnames;
+    uint8_t cs1[] = "forty-two";
+    uint8_t csa[] = "forty";
+    uint8_t csb[] = "-two";
+    uint8_t cs[3];
+    uint8_t const *pcs;
+    uint8_t objid;
+    int16_t i;
+    PmReturn_t retval;
+
+    pm_init(heap, HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+
+    pcs = cs1;
+    retval = string_new(&pcs, &pstr1);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = string_intern(pstr1, &pobj);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, pobj == pstr1);
+
+    pcs = csa;
+    retval = string_new(&pcs, &pa);
+    pcs = csb;
+    retval = string_new(&pcs, &pb);
+    retval = string_concat((pPmString_t)pa, (pPmString_t)pb, &pstr2);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, pstr2 != pstr1);
+    retval = string_intern(pstr2, &pobj);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, pobj == pstr1);
+#if USE_STRING_CACHE
+    CuAssertTrue(tc, ((pPmString_t)pstr1)->interned);
+    CuAssertTrue(tc, !((pPmString_t)pstr2)->interned);
+#endif /* USE_STRING_CACHE */
+
+    /* Intern many two-char names, keeping them in a tuple */
+    retval = tuple_new(100, &pnames);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(pnames, &objid);
+    for (i = 0; i < 100; i++)
+    {
+        cs[0] = 'a' + i % 26;
+        cs[1] = 'A' + i / 26;
+        cs[2] = '\0';
+        pcs = cs;
+        retval = string_new(&pcs, &pobj);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        retval = string_intern(pobj, &((pPmTuple_t)pnames)->val[i]);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+    for (i = 0; i < 100; i++)
+    {
+        cs[0] = 'a' + i % 26;
+        cs[1] = 'A' + i / 26;
+        pcs = cs;
+        retval = string_new(&pcs, &pobj);
+        retval = string_intern(pobj, &pobj);
+        CuAssertTrue(tc, pobj == ((pPmTuple_t)pnames)->val[i]);
+    }
+    heap_gcPopTempRoot(objid);
+
+    /* Once collected, a string's twin takes its place in the cache */
+    retval = heap_gcRun();
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    pcs = cs1;
+    retval = string_new(&pcs, &pstr2);
+    retval = string_intern(pstr2, &pobj);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    CuAssertTrue(tc, pobj == pstr2);
+}
+
+
+#if USE_STRING_CACHE && defined(HAVE_HEAP_STATS)
+/* The most slots in the string cache, as strobj.c defines it */
+#define CACHE_MAX_SLOTS (0x8000 / sizeof(pPmString_t))
+
+/* The heap for the full cache test holds the strings, a list and the cache */
+#define CACHE_HEAP_SIZE 0x40000
+
+static uint8_t cacheheap[CACHE_HEAP_SIZE];
+
+/**
+ * Tests string_intern() with the cache at its largest size:
+ *      interning allocates nothing once the cache has reached that size
+ *      a string that does not fit in the full cache is returned uninterned
+ */
+void
+ut_string_intern_001(CuTest *tc)
+{
+    pPmObj_t pkeep;
+    pPmObj_t pobj;
+    PmHeapStats_t before;
+    PmHeapStats_t after;
+    uint8_t cs[5];
+    uint8_t const *pcs;
+    uint8_t objid;
+    uint8_t objid2;
+    uint8_t full = C_FALSE;
+    uint16_t i;
+    PmReturn_t retval;
+
+    retval = pm_init(cacheheap, CACHE_HEAP_SIZE, MEMSPACE_RAM, C_NULL);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    retval = list_new(&pkeep);
+    CuAssertTrue(tc, retval == PM_RET_OK);
+    heap_gcPushTempRoot(pkeep, &objid);
+
+    /* Intern distinct four-char names, keeping them in the list */
+    for (i = 0; i <= CACHE_MAX_SLOTS; i++)
+    {
+        cs[0] = 'a' + i % 26;
+        cs[1] = 'a' + (i / 26) % 26;
+        cs[2] = 'a' + i / 676;
+        cs[3] = '_';
+        cs[4] = '\0';
+        pcs = cs;
+        retval = string_new(&pcs, &pobj);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        heap_gcPushTempRoot(pobj, &objid2);
+        heap_getStats(&before);
+        retval = string_intern(pobj, &pobj);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+        heap_getStats(&after);
+        heap_gcPopTempRoot(objid2);
+
+        /* The cache reaches its largest size when half of it is used */
+        if (i > (CACHE_MAX_SLOTS >> 1))
+        {
+            CuAssertTrue(tc, after.allocs == before.allocs);
+        }
+
+        /* The VM's names are cached too, so the cache fills a bit early */
+        if (!((pPmString_t)pobj)->interned)
+        {
+            full = C_TRUE;
+        }
+        CuAssertTrue(tc, ((pPmString_t)pobj)->interned == !full);
+        retval = list_append(pkeep, pobj);
+        CuAssertTrue(tc, retval == PM_RET_OK);
+    }
+    CuAssertTrue(tc, full);
+    heap_gcPopTempRoot(objid);
+}
+#endif /* USE_STRING_CACHE && HAVE_HEAP_STATS */
+
+
 /** Make a suite from all tests in this file */
 CuSuite *getSuite_testStringObj(void)
 {
@@ -78,6 +322,12 @@ CuSuite *getSuite_testStringObj(void)
 
     SUITE_ADD_TEST(suite, ut_string_new_000);
     SUITE_ADD_TEST(suite, ut_string_newFromChar_000);
+    SUITE_ADD_TEST(suite, ut_string_newFromChar_001);
+    SUITE_ADD_TEST(suite, ut_string_hash_000);
+    SUITE_ADD_TEST(suite, ut_string_intern_000);
+#if USE_STRING_CACHE && defined(HAVE_HEAP_STATS)
+    SUITE_ADD_TEST(suite, ut_string_intern_001);
+#endif /* USE_STRING_CACHE && HAVE_HEAP_STATS */
 
     return suite;
 }
@@ -7,6 +7,7 @@
 
 """
 Generates C definitions on stdout for all features in the input set to True
+and for all numeric settings in the input, such as pool sizes
 
 Expects name of a pmfeatures.py file as the only argument.
 """
@@ -19,4 +20,8 @@ execfile(sys.argv[1])
 sys.stdout.write("/* Automatically generated by %s on %s.  DO NOT EDIT. */\n"
                  % (sys.argv[0], time.ctime(time.time())))
 map(sys.stdout.write,
-    ("#define %s\n" % s for s in PM_FEATURES.keys() if PM_FEATURES[s]))
+    ("#define %s\n" % s for s in PM_FEATURES.keys()
+     if PM_FEATURES[s] is True))
+map(sys.stdout.write,
+    ("#define %s (%d)\n" % (s, PM_FEATURES[s]) for s in PM_FEATURES.keys()
+     if type(PM_FEATURES[s]) == int))
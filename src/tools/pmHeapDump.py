@@ -217,8 +217,8 @@ def PmObjectClass(dumpversion, features):
             PmTypeInfo('NON', ""),
             PmTypeInfo("INT", "val:i"),
             PmTypeInfo("FLT", "val:f"),
-            PmTypeInfo("STR", "len:H,"+
-                       (features.USE_STRING_CACHE and "cache_next:P," or "") +
+            PmTypeInfo("STR", "len:H,hash:H,"+
+                       (features.USE_STRING_CACHE and "interned:B," or "") +
                        "val:B:len"),
             PmTypeInfo("TUP", "len:H,items:P:len"),
             PmTypeInfo("COB", "codeimg:P,names:P,consts:P,code:P"),
@@ -233,26 +233,32 @@ def PmObjectClass(dumpversion, features):
             PmTypeInfo("CIM", "data:B:*"),
             PmTypeInfo("NIM", ""),
             PmTypeInfo("NOB", "argcount:B,funcidx:H"),
-            PmTypeInfo("THR", "frame:P,interpctrl:I"),
+            PmTypeInfo("THR", "frame:P," +
+                       (features.HAVE_FRAME_STACK and "fstack:P," or "") +
+                       "interpctrl:I"),
             PmTypeInfo("x", ""),
             PmTypeInfo("BOL", "val:i"),
             PmTypeInfo("CIO", "data:B:*"),
             PmTypeInfo("MTH", "instance:P,func:P,attrs:P"),
             PmTypeInfo("LST", "len:H,sgl:P"),
-            PmTypeInfo("DIC", "len:H,keys:P,vals:P"),
+            PmTypeInfo("DIC", "len:H," +
+                       (features.HAVE_HASHED_DICTS and "fill:H,table:P,vals:P"
+                        or "keys:P,vals:P")),
             PmTypeInfo("x", ""),
+            PmTypeInfo("LAR", "size:H,items:P:size"),
+            PmTypeInfo("STB", "len:H,count:H,fill:H,slots:P:*"),
+            PmTypeInfo("DTB", "len:H,slots:P:*"),
             PmTypeInfo("x", ""),
-            PmTypeInfo("x", ""),
-            PmTypeInfo("x", ""),
-            PmTypeInfo("x", ""),
-            PmTypeInfo("FRM", "back:P,func:P,memspace:B,ip:P,blockstack:P,"
-                              "attrs:P,globals:P,sp:P,isImport:.," +
+            PmTypeInfo("FRM", "back:P,func:P,memspace:B,ip:P,blocks:P,"
+                              "attrs:P,globals:P,sp:P," +
+                       (features.HAVE_FRAME_STACK and "stack:P," or "") +
+                       "nblocks:B,isImport:.," +
                        (features.HAVE_CLASSES and "isInit:.," or "") +
                        "locals:P:<sp"),
-            PmTypeInfo("BLK", "sp:P,handler:P,type:B,next:P"),
+            PmTypeInfo("FST", "prev:P,next:P,top:P,size:H"),
             PmTypeInfo("SEG", "items:P:8,next:P"),
             PmTypeInfo("SGL", "length:H,rootseg:P,lastseg:P"),
-            PmTypeInfo("SQI", "sequence:P,index:H"),
+            PmTypeInfo("SQI", "sequence:P,index:H,seg:P,unlinks:I"),
             PmTypeInfo("NFM", "back:P,func:P,stack:P,active:B,numlocals:B,"
                               "locals:P:8"),
             )
@@ -454,10 +460,7 @@ def PmObjectClass(dumpversion, features):
             for f in self.objtype.fields:
                 if f.type != 'P':
                     continue
-                if f.name == "cache_next" and d[f.name] in self.heap.data:
-                    pointers.append("%s=%s"%(f.name, hex(d[f.name])))
-                else:
-                    pointers.append("<%s> %s" % (f.name, f.name))
+                pointers.append("<%s> %s" % (f.name, f.name))
             if len(pointers):
                 label.append('|{')
                 label.append("|".join(pointers))
@@ -477,8 +480,6 @@ def PmObjectClass(dumpversion, features):
             for f in self.objtype.fields:
                 if f.type != 'P':
                     continue
-                if f.name == "cache_next":
-                    continue
                 if f.mul == False:
                     if d[f.name] == 0:
                         continue
@@ -536,7 +537,7 @@ class PmHeap(UserDict.UserDict):
     """
 
     FEATURES = ['USE_STRING_CACHE', 'HAVE_DEFAULTARGS', 'HAVE_CLOSURES',
-                'HAVE_CLASSES']
+                'HAVE_CLASSES', 'HAVE_FRAME_STACK', 'HAVE_HASHED_DICTS']
 
 
     def __init__(self, fp):
@@ -140,8 +140,9 @@ IMG_LIST_TERMINATOR = "\xFF"
 ################################################################
 
 # Number of bytes from top of code img to start of consts:
-# type, sizelo, sizehi, co_argcount, co_flags, co_stacksize, co_nlocals
-CO_IMG_FIXEDPART_SIZE = 7
+# type, sizelo, sizehi, co_argcount, co_flags, co_stacksize, co_nlocals,
+# co_nblocks
+CO_IMG_FIXEDPART_SIZE = 8
 
 # PyMite's unimplemented bytecodes (from Python 2.0 through 2.5)
 UNIMPLEMENTED_BCODES = [
@@ -157,6 +158,21 @@ UNIMPLEMENTED_BCODES = [
     "EXTENDED_ARG",
     ]
 
+# Superinstructions: pairs of bytecodes that often come together in loops
+# and the opcode of the fused bytecode that replaces the first one's opcode
+# when HAVE_SUPERINSTRUCTIONS is set.  The opcodes are unused by Python
+# and must match PmBcode_e in interp.h
+SUPERINSTRUCTIONS = {
+    ("LOAD_FAST", "LOAD_FAST"): 117,            # LOAD_FAST_LOAD_FAST
+    ("LOAD_FAST", "LOAD_CONST"): 118,           # LOAD_FAST_LOAD_CONST
+    ("LOAD_FAST", "LOAD_ATTR"): 123,            # LOAD_FAST_LOAD_ATTR
+    ("STORE_FAST", "LOAD_FAST"): 127,           # STORE_FAST_LOAD_FAST
+    ("COMPARE_OP", "POP_JUMP_IF_FALSE"): 128,   # COMPARE_OP_POP_JUMP_IF_FALSE
+    ("COMPARE_OP", "POP_JUMP_IF_TRUE"): 129,    # COMPARE_OP_POP_JUMP_IF_TRUE
+    ("LOAD_GLOBAL", "LOAD_FAST"): 138,          # LOAD_GLOBAL_LOAD_FAST
+    ("LOAD_GLOBAL", "CALL_FUNCTION"): 139,      # LOAD_GLOBAL_CALL_FUNCTION
+    }
+
 
 ################################################################
 # CLASS
@@ -454,7 +470,8 @@ class PmImgCreator:
         imgstr = self._U8_to_str(co.co_argcount) + \
                  self._U8_to_str(co.co_flags & 0xFF) + \
                  self._U8_to_str(co.co_stacksize) + \
-                 self._U8_to_str(co.co_nlocals)
+                 self._U8_to_str(co.co_nlocals) + \
+                 self._U8_to_str(self._block_depth(code))
 
         # Issue #56: Add support for closures
         if PM_FEATURES["HAVE_CLOSURES"]:
@@ -659,6 +676,10 @@ class PmImgCreator:
                 code += s[i:i+3]
                 i += 3
 
+        # Fuse pairs of bytecodes into superinstructions
+        if PM_FEATURES.get("HAVE_SUPERINSTRUCTIONS", False):
+            code = self._fuse_bcodes(code)
+
         # if the first const is a String,
         if (len(consts) > 0 and type(consts[0]) == types.StringType):
 
@@ -724,6 +745,62 @@ class PmImgCreator:
         return consts, names, code, nativecode
 
 
+    def _block_depth(self, code):
+        """Return the most blocks the code has open at once.
+
+        The compiler nests blocks in the order of the code:
+        each SETUP_ bytecode is closed by a later POP_BLOCK
+        before any enclosing block is closed.
+        The VM sizes each frame's block stack with this value.
+        """
+        depth = 0
+        maxdepth = 0
+        i = 0
+        while i < len(code):
+            c = ord(code[i])
+            if dis.opname[c] in ("SETUP_LOOP", "SETUP_EXCEPT",
+                                 "SETUP_FINALLY"):
+                depth += 1
+                maxdepth = max(maxdepth, depth)
+            elif c == dis.opmap["POP_BLOCK"]:
+                depth -= 1
+            if c < dis.HAVE_ARGUMENT:
+                i += 1
+            else:
+                i += 3
+        assert maxdepth <= 255
+        return maxdepth
+
+
+    def _fuse_bcodes(self, code):
+        """Return the code string with superinstructions.
+
+        For each pair of bytecodes in SUPERINSTRUCTIONS,
+        the opcode of the first is replaced by the fused opcode.
+        The second bytecode is left in place, so the code keeps its size,
+        jumps keep their targets and a jump to the second bytecode
+        runs it alone.  Pairs are matched against the original opcodes,
+        so a bytecode may both end one pair and begin another.
+        """
+        # Find the offset and opcode of every bytecode
+        bcodes = []
+        i = 0
+        while i < len(code):
+            c = ord(code[i])
+            bcodes.append((i, dis.opname[c]))
+            if c < dis.HAVE_ARGUMENT:
+                i += 1
+            else:
+                i += 3
+
+        fused = list(code)
+        for n in range(len(bcodes) - 1):
+            pair = (bcodes[n][1], bcodes[n + 1][1])
+            if pair in SUPERINSTRUCTIONS:
+                fused[bcodes[n][0]] = chr(SUPERINSTRUCTIONS[pair])
+        return "".join(fused)
+
+
 ################################################################
 # IMAGE WRITING FUNCTIONS
 ################################################################
@@ -50,13 +50,18 @@ TYPES = (
     'OBJ_TYPE_MTH',
     'OBJ_TYPE_LST',
     'OBJ_TYPE_DIC',
-    0x14,0x15,0x16,0x17,0x18,
+    0x14,
+    'OBJ_TYPE_LAR',
+    'OBJ_TYPE_STB',
+    'OBJ_TYPE_DTB',
+    0x18,
     'OBJ_TYPE_FRM',
-    'OBJ_TYPE_BLK',
+    'OBJ_TYPE_FST',
     'OBJ_TYPE_SEG',
     'OBJ_TYPE_SGL',
     'OBJ_TYPE_SQI',
     'OBJ_TYPE_NFM',
+    'OBJ_TYPE_ICA',
 )
 
 
@@ -54,13 +54,13 @@ bytes_getByteFromObj(pPmObj_t pobj, uint8_t *b)
 
     if (OBJ_GET_TYPE(pobj) == OBJ_TYPE_INT)
     {
-        if ((((pPmInt_t)pobj)->val > 255) || (((pPmInt_t)pobj)->val < 0))
+        if ((INT_GET_VAL(pobj) > 255) || (INT_GET_VAL(pobj) < 0))
         {
             PM_RAISE(retval, PM_RET_EX_VAL);
             return retval;
         }
 
-        *b = (uint8_t)((pPmInt_t)pobj)->val;
+        *b = (uint8_t)INT_GET_VAL(pobj);
     }
 
     else if (OBJ_GET_TYPE(pobj) == OBJ_TYPE_STR)
@@ -107,7 +107,7 @@ bytearray_new(pPmObj_t pobj, pPmObj_t *r_pobj)
     switch (OBJ_GET_TYPE(pobj))
     {
         case OBJ_TYPE_INT:
-            i = ((pPmInt_t)pobj)->val;
+            i = INT_GET_VAL(pobj);
             if ((i < 0) || (i > 65535))
             {
                 PM_RAISE(retval, PM_RET_EX_VAL);
@@ -56,6 +56,11 @@ class_new(pPmObj_t pattrs, pPmObj_t pbases, pPmObj_t pname, pPmObj_t *r_pclass)
     ((pPmClass_t)pobj)->cl_attrs = (pPmDict_t)pattrs;
     ((pPmClass_t)pobj)->cl_bases = (pPmTuple_t)pbases;
 
+#ifdef HAVE_INLINE_CACHES
+    /* Changes to the attrs from now on are changes to the class */
+    dict_setFlags((pPmDict_t)pattrs, DICT_FLAG_CLASS);
+#endif /* HAVE_INLINE_CACHES */
+
     *r_pclass = pobj;
 
     return retval;
@@ -266,3 +271,55 @@ class_isSubclass(pPmObj_t ptest_class, pPmObj_t pbase_class)
     }
     return retval;
 }
+
+
+#ifdef HAVE_INLINE_CACHES
+uint8_t /* boolean */
+class_isShadowed(pPmObj_t pclass)
+{
+    uint8_t i;
+
+    if (((pPmClass_t)pclass)->cl_attrs->d_flags & DICT_FLAG_SHADOWED)
+    {
+        return C_TRUE;
+    }
+
+    /* Recursively check the base classes */
+    if (((pPmClass_t)pclass)->cl_bases != C_NULL)
+    {
+        for (i = 0; i < ((pPmClass_t)pclass)->cl_bases->length; i++)
+        {
+            if (class_isShadowed(((pPmClass_t)pclass)->cl_bases->val[i]))
+            {
+                return C_TRUE;
+            }
+        }
+    }
+    return C_FALSE;
+}
+
+
+uint32_t
+class_getVersion(pPmObj_t pclass)
+{
+    uint32_t version;
+    uint32_t v;
+    uint8_t i;
+
+    version = ((pPmClass_t)pclass)->cl_attrs->d_version;
+
+    /* Recursively check the base classes */
+    if (((pPmClass_t)pclass)->cl_bases != C_NULL)
+    {
+        for (i = 0; i < ((pPmClass_t)pclass)->cl_bases->length; i++)
+        {
+            v = class_getVersion(((pPmClass_t)pclass)->cl_bases->val[i]);
+            if (v > version)
+            {
+                version = v;
+            }
+        }
+    }
+    return version;
+}
+#endif /* HAVE_INLINE_CACHES */
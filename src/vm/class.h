@@ -129,4 +129,29 @@ PmReturn_t class_getAttr(pPmObj_t pobj, pPmObj_t pname, pPmObj_t *r_pobj);
  */
 uint8_t class_isSubclass(pPmObj_t ptest_class, pPmObj_t pbase_class);
 
+#ifdef HAVE_INLINE_CACHES
+/**
+ * Returns a C boolean if an instance of the class may have the name of
+ * an attribute of the class, or of one of its bases, in its own attrs dict.
+ * A lookup of such a name on an instance must not skip the instance's
+ * dict.  NOTE: This function is recursive.
+ *
+ * @param   pclass ptr to class whose inheritance tree is checked
+ * @return  Returns C_TRUE if any class in the tree is marked
+ *          DICT_FLAG_SHADOWED; C_FALSE otherwise.
+ */
+uint8_t class_isShadowed(pPmObj_t pclass);
+
+/**
+ * Returns the version of the class: the latest version of the attrs dicts
+ * of the class and of its bases.  A change to any of them gives that dict
+ * a version later than all others, so the class gets a new version.
+ * NOTE: This function is recursive.
+ *
+ * @param   pclass ptr to class whose inheritance tree is checked
+ * @return  Returns the version of the class
+ */
+uint32_t class_getVersion(pPmObj_t pclass);
+#endif /* HAVE_INLINE_CACHES */
+
 #endif /* __CLASS_H__ */
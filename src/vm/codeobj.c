@@ -53,6 +53,7 @@ co_loadFromImg(PmMemSpace_t memspace, uint8_t const **paddr, pPmObj_t *r_pco)
     pco->co_flags = mem_getByte(memspace, paddr);
     pco->co_stacksize = mem_getByte(memspace, paddr);
     pco->co_nlocals = mem_getByte(memspace, paddr);
+    pco->co_nblocks = mem_getByte(memspace, paddr);
 
     /* Do not set code image address if image is in RAM.
      * CIs in RAM have their image address set in obj_loadFromImgObj() */
@@ -68,6 +69,11 @@ co_loadFromImg(PmMemSpace_t memspace, uint8_t const **paddr, pPmObj_t *r_pco)
     pco->co_cellvars = C_NULL;
 #endif /* HAVE_CLOSURES */
 
+#ifdef HAVE_INLINE_CACHES
+    pco->co_cache = C_NULL;
+    pco->co_attrcache = C_NULL;
+#endif /* HAVE_INLINE_CACHES */
+
 #ifdef HAVE_DEBUG_INFO
     pco->co_firstlineno = mem_getWord(memspace, paddr);
     pco->co_lnotab = C_NULL;
@@ -124,6 +130,19 @@ co_loadFromImg(PmMemSpace_t memspace, uint8_t const **paddr, pPmObj_t *r_pco)
     /* Start of bcode always follows consts */
     pco->co_codeaddr = *paddr;
 
+#ifdef HAVE_FAST_CALLS
+    /* Mark a code object whose calls only need their args copied */
+    pco->co_flags &= ~CO_FASTCALL;
+    if (!(pco->co_flags & CO_GENERATOR)
+#ifdef HAVE_CLOSURES
+        && (pco->co_nfreevars == 0) && (pco->co_cellvars == C_NULL)
+#endif /* HAVE_CLOSURES */
+       )
+    {
+        pco->co_flags |= CO_FASTCALL;
+    }
+#endif /* HAVE_FAST_CALLS */
+
     /* Set addr to point one past end of img */
     *paddr = pci + size;
 
@@ -152,6 +171,117 @@ co_rSetCodeImgAddr(pPmCo_t pco, uint8_t const *pimg)
 }
 
 
+#ifdef HAVE_INLINE_CACHES
+void
+co_cacheGlobal(pPmCo_t pco, uint16_t indx, pPmObj_t pval,
+               pPmDict_t pglobals, pPmDict_t pbuiltins)
+{
+    PmReturn_t retval;
+    pPmInlineCache_t pcache;
+    uint8_t *pchunk;
+    uint16_t n;
+
+    /* Nothing is cached until the builtins are loaded; a saturated version
+     * may be shared by several dicts */
+    if ((pbuiltins == C_NULL)
+        || (pglobals->d_version == DICT_VERSION_MAX)
+        || (pbuiltins->d_version == DICT_VERSION_MAX))
+    {
+        return;
+    }
+
+    /* Allocate the cache with one empty entry per name */
+    pcache = pco->co_cache;
+    if (pcache == C_NULL)
+    {
+        n = pco->co_names->length;
+        retval = heap_getChunk(sizeof(PmInlineCache_t)
+                               + (n - 1) * sizeof(PmCacheEntry_t), &pchunk);
+        if (retval != PM_RET_OK)
+        {
+            return;
+        }
+        pcache = (pPmInlineCache_t)pchunk;
+        OBJ_SET_TYPE(pcache, OBJ_TYPE_ICA);
+        pcache->length = n;
+        pcache->ic_kind = ICA_KIND_GLOBALS;
+        sli_memset((unsigned char *)pcache->ic_entry, 0,
+                   n * sizeof(PmCacheEntry_t));
+        pco->co_cache = pcache;
+        HEAP_GC_WRITE_BARRIER(pco, pcache);
+    }
+
+    pcache->ic_entry[indx].ce_val = pval;
+    pcache->ic_entry[indx].ce_gversion = pglobals->d_version;
+    pcache->ic_entry[indx].ce_bversion = pbuiltins->d_version;
+    HEAP_GC_WRITE_BARRIER(pcache, pval);
+}
+
+
+void
+co_cacheAttr(pPmCo_t pco, uint16_t indx, pPmObj_t pclass,
+             PmAttrKind_t kind, pPmObj_t pval)
+{
+    PmReturn_t retval;
+    pPmAttrCache_t pcache;
+    pPmAttrEntry_t pentry;
+    uint8_t *pchunk;
+    uint32_t version;
+    uint16_t n;
+    uint8_t i;
+
+    /* A saturated version may be the version of more than one change */
+    version = class_getVersion(pclass);
+    if (version == DICT_VERSION_MAX)
+    {
+        return;
+    }
+
+    /* Allocate the cache with empty entries for every name */
+    pcache = pco->co_attrcache;
+    if (pcache == C_NULL)
+    {
+        n = pco->co_names->length * CO_ATTR_CACHE_WAYS;
+        retval = heap_getChunk(sizeof(PmAttrCache_t)
+                               + (n - 1) * sizeof(PmAttrEntry_t), &pchunk);
+        if (retval != PM_RET_OK)
+        {
+            return;
+        }
+        pcache = (pPmAttrCache_t)pchunk;
+        OBJ_SET_TYPE(pcache, OBJ_TYPE_ICA);
+        pcache->length = n;
+        pcache->ic_kind = ICA_KIND_ATTRS;
+        sli_memset((unsigned char *)pcache->ac_entry, 0,
+                   n * sizeof(PmAttrEntry_t));
+        pco->co_attrcache = pcache;
+        HEAP_GC_WRITE_BARRIER(pco, pcache);
+    }
+
+    /* Reuse the entry for the same lookup, or drop the oldest entry */
+    pentry = &pcache->ac_entry[indx * CO_ATTR_CACHE_WAYS];
+    for (i = 0; i < CO_ATTR_CACHE_WAYS - 1; i++)
+    {
+        if ((pentry[i].ae_class == pclass) && (pentry[i].ae_kind == kind))
+        {
+            break;
+        }
+    }
+    for (; i > 0; i--)
+    {
+        pentry[i] = pentry[i - 1];
+    }
+
+    pentry->ae_class = pclass;
+    pentry->ae_val = pval;
+    pentry->ae_version = version;
+    pentry->ae_kind = (uint8_t)kind;
+    HEAP_GC_WRITE_BARRIER(pcache, pclass);
+    HEAP_GC_WRITE_BARRIER(pcache, pval);
+}
+#endif /* HAVE_INLINE_CACHES */
+
+
 PmReturn_t
 no_loadFromImg(PmMemSpace_t memspace, uint8_t const **paddr, pPmObj_t *r_pno)
 {
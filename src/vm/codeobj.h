@@ -25,21 +25,22 @@
 #define CI_FLAGS_FIELD      4
 #define CI_STACKSIZE_FIELD  5
 #define CI_NLOCALS_FIELD    6
+#define CI_NBLOCKS_FIELD    7
 
 #ifdef HAVE_CLOSURES
-# define CI_FREEVARS_FIELD  7
+# define CI_FREEVARS_FIELD  8
 # ifdef HAVE_DEBUG_INFO
-#  define CI_FIRST_LINE_NO  8
-#  define CI_NAMES_FIELD    10
+#  define CI_FIRST_LINE_NO  9
+#  define CI_NAMES_FIELD    11
 # else
-#  define CI_NAMES_FIELD    8
+#  define CI_NAMES_FIELD    9
 # endif /* HAVE_DEBUG_INFO */
 #else
 # ifdef HAVE_DEBUG_INFO
-#  define CI_FIRST_LINE_NO  7
-#  define CI_NAMES_FIELD    9
+#  define CI_FIRST_LINE_NO  8
+#  define CI_NAMES_FIELD    10
 # else
-#  define CI_NAMES_FIELD    7
+#  define CI_NAMES_FIELD    8
 # endif /* HAVE_DEBUG_INFO */
 #endif /* HAVE_CLOSURES */
 
@@ -56,6 +57,117 @@
 #define CO_GENERATOR 0x20
 #define CO_NOFREE 0x40
 
+#ifdef HAVE_FAST_CALLS
+/**
+ * Set by co_loadFromImg() in a code object that CALL_FUNCTION may run by
+ * only copying the args into a new frame: it is not a generator and has
+ * no cellvars or freevars.  Python does not use this bit.
+ */
+#define CO_FASTCALL 0x80
+#endif /* HAVE_FAST_CALLS */
+
+#ifdef HAVE_INLINE_CACHES
+/**
+ * Inline Cache Entry
+ *
+ * The result of looking up one name, with the versions of the globals
+ * and builtins dicts it was found with.  The entry is valid while both
+ * dicts still have those versions.  An empty entry has version 0,
+ * which no dict has.
+ */
+typedef struct PmCacheEntry_s
+{
+    /** The cached value */
+    pPmObj_t ce_val;
+    /** Version of the globals dict */
+    uint32_t ce_gversion;
+    /** Version of the builtins dict */
+    uint32_t ce_bversion;
+} PmCacheEntry_t,
+ *pPmCacheEntry_t;
+
+/**
+ * Inline Cache
+ *
+ * Holds one cache entry for each name in a code object's names tuple.
+ * Every instruction that loads a global by the same name in one code
+ * object finds the same value, so the entries are shared between them.
+ */
+typedef struct PmInlineCache_s
+{
+    /** Object descriptor */
+    PmObjDesc_t od;
+    /** Number of entries */
+    uint16_t length;
+    /** Kind of cache (ICA_KIND_GLOBALS) */
+    uint8_t ic_kind;
+    /** Array of entries */
+    PmCacheEntry_t ic_entry[1];
+} PmInlineCache_t,
+ *pPmInlineCache_t;
+
+/** Kinds of inline cache objects (OBJ_TYPE_ICA) */
+#define ICA_KIND_GLOBALS 0
+#define ICA_KIND_ATTRS 1
+
+/** Number of classes an attribute name is cached for in one code object */
+#define CO_ATTR_CACHE_WAYS 2
+
+/** Kinds of attribute cache entries */
+typedef enum PmAttrKind_e
+{
+    /** LOAD_ATTR on the class itself finds the cached value */
+    ATTR_KIND_CLASS = 1,
+    /** LOAD_ATTR on an instance of the class finds the cached value
+     * in the class, since the name is not in the instance's dict */
+    ATTR_KIND_INSTANCE,
+    /** STORE_ATTR on an instance of the class stores into the instance's
+     * dict, since the name is not an attribute of the class */
+    ATTR_KIND_STORE
+} PmAttrKind_t;
+
+/**
+ * Attribute Cache Entry
+ *
+ * The result of looking up an attribute on a class or on an instance of
+ * the class.  The entry is valid while neither the class nor its bases
+ * have changed since it was filled, that is while class_getVersion()
+ * still gives its version.  An empty entry has no class.
+ */
+typedef struct PmAttrEntry_s
+{
+    /** The class, or the class of the instance, the entry is for */
+    pPmObj_t ae_class;
+    /** The cached value */
+    pPmObj_t ae_val;
+    /** The class version */
+    uint32_t ae_version;
+    /** The kind of lookup */
+    uint8_t ae_kind;
+} PmAttrEntry_t,
+ *pPmAttrEntry_t;
+
+/**
+ * Attribute Cache
+ *
+ * Holds CO_ATTR_CACHE_WAYS entries for each name in a code object's names
+ * tuple, the most recently filled first.  Like the globals cache, it is
+ * shared by the instructions of the code object that use the same name.
+ */
+typedef struct PmAttrCache_s
+{
+    /** Object descriptor */
+    PmObjDesc_t od;
+    /** Number of entries */
+    uint16_t length;
+    /** Kind of cache (ICA_KIND_ATTRS) */
+    uint8_t ic_kind;
+    /** Array of entries */
+    PmAttrEntry_t ac_entry[1];
+} PmAttrCache_t,
+ *pPmAttrCache_t;
+#endif /* HAVE_INLINE_CACHES */
+
 /**
  * Code Object
  *
@@ -92,6 +204,13 @@ typedef struct PmCo_s
     uint8_t co_nfreevars;
 #endif /* HAVE_CLOSURES */
 
+#ifdef HAVE_INLINE_CACHES
+    /** Inline cache of globals, allocated on first use */
+    pPmInlineCache_t co_cache;
+    /** Inline cache of attributes, allocated on first use */
+    pPmAttrCache_t co_attrcache;
+#endif /* HAVE_INLINE_CACHES */
+
     /** Memory space selector */
     PmMemSpace_t co_memspace:8;
     /** Number of positional arguments the function expects */
@@ -102,6 +221,8 @@ typedef struct PmCo_s
     uint8_t co_stacksize;
     /** Number of local variables */
     uint8_t co_nlocals;
+    /** Most blocks (loops) nested at once, the size of the block stack */
+    uint8_t co_nblocks;
 } PmCo_t,
  *pPmCo_t;
 
@@ -152,6 +273,7 @@ typedef struct PmNo_s
  *      -argcount:  8b - number of arguments to this code obj.
  *      -stacksz:   8b - the maximum arg-stack size needed.
  *      -nlocals:   8b - number of local vars in the code obj.
+ *      -nblocks:   8b - the maximum block-stack size needed.
  *      -names:     Tuple - tuple of string objs.
  *      -consts:    Tuple - tuple of objs.
  *      -code:      8b[] - bytecode array.
@@ -178,6 +300,40 @@ co_loadFromImg(PmMemSpace_t memspace, uint8_t const **paddr, pPmObj_t *r_pco);
  */
 void co_rSetCodeImgAddr(pPmCo_t pco, uint8_t const *pimg);
 
+#ifdef HAVE_INLINE_CACHES
+/**
+ * Fills the code object's cache entry for the name at the given index
+ * with the value found for it and the versions of the globals and builtins
+ * dicts it was found in.  Allocates the cache if the code object has none.
+ * Nothing is cached if the builtins are not loaded yet, if a version has
+ * saturated or if memory is short, since the cache is only an optimization.
+ *
+ * @param   pco Ptr to the code object
+ * @param   indx Index of the name in the names tuple
+ * @param   pval Ptr to the value of the name
+ * @param   pglobals Ptr to the globals dict
+ * @param   pbuiltins Ptr to the builtins dict
+ */
+void co_cacheGlobal(pPmCo_t pco, uint16_t indx, pPmObj_t pval,
+                    pPmDict_t pglobals, pPmDict_t pbuiltins);
+
+/**
+ * Fills an entry of the code object's attribute cache for the name at the
+ * given index.  An entry for the same class and kind is refilled;
+ * otherwise the new entry goes first and the oldest is dropped.
+ * Allocates the cache if the code object has none.  Nothing is cached
+ * if the class version has saturated or if memory is short.
+ *
+ * @param   pco Ptr to the code object
+ * @param   indx Index of the name in the names tuple
+ * @param   pclass Ptr to the class the entry is for
+ * @param   kind Kind of lookup
+ * @param   pval Ptr to the value found, or C_NULL for ATTR_KIND_STORE
+ */
+void co_cacheAttr(pPmCo_t pco, uint16_t indx, pPmObj_t pclass,
+                  PmAttrKind_t kind, pPmObj_t pval);
+#endif /* HAVE_INLINE_CACHES */
+
 /**
  * Creates a Native code object by loading a native image.
  *
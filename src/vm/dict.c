@@ -21,6 +21,325 @@
 #include "pm.h"
 
 
+#ifdef HAVE_INLINE_CACHES
+/** The last version given to a dict */
+static uint32_t dict_lastVersion = 0;
+
+
+/* Gives the dict a version that no other dict has had */
+static void
+dict_newVersion(pPmDict_t pdict)
+{
+    if (dict_lastVersion < DICT_VERSION_MAX)
+    {
+        dict_lastVersion++;
+    }
+    pdict->d_version = dict_lastVersion;
+}
+
+
+void
+dict_setFlags(pPmDict_t pdict, uint8_t flags)
+{
+    pdict->d_flags |= flags;
+    dict_newVersion(pdict);
+}
+#define DICT_NEW_VERSION(pdict) dict_newVersion((pPmDict_t)(pdict))
+#else
+#define DICT_NEW_VERSION(pdict)
+#endif /* HAVE_INLINE_CACHES */
+
+
+#ifdef HAVE_HASHED_DICTS
+/**
+ * The most slots in a table: the largest power of two whose slots
+ * take at most 32 KB, so a table always fits in one chunk.
+ * A dict with more items keeps them in seglists.
+ */
+#define DICT_TABLE_MAX_SIZE ((uint16_t)(0x8000 / sizeof(PmDictSlot_t)))
+
+
+/*
+ * Finds the key in the dict's table.  Returns PM_RET_OK and the key's slot,
+ * or PM_RET_NO and the slot where the key would be inserted: the first
+ * deleted slot passed, else the empty slot that ended the probe.
+ * The table always has an empty slot, so the probe ends.
+ */
+static PmReturn_t
+dict_findSlot(pPmDict_t pdict, pPmObj_t pkey, pPmDictSlot_t *r_pslot)
+{
+    pPmDictTable_t ptable = (pPmDictTable_t)pdict->d_table;
+    pPmDictSlot_t pslot;
+    pPmDictSlot_t pdeleted = C_NULL;
+    uint16_t mask = ptable->length - 1;
+    uint16_t i;
+
+    for (i = obj_hash(pkey) & mask; ; i = (i + 1) & mask)
+    {
+        pslot = &ptable->dt_slot[i];
+        if (pslot->ds_key == C_NULL)
+        {
+            /* An empty slot ends the probe */
+            if (pslot->ds_val == C_NULL)
+            {
+                *r_pslot = (pdeleted != C_NULL) ? pdeleted : pslot;
+                return PM_RET_NO;
+            }
+            if (pdeleted == C_NULL)
+            {
+                pdeleted = pslot;
+            }
+        }
+        else if ((pslot->ds_key == pkey)
+                 || (obj_compare(pslot->ds_key, pkey) == C_SAME))
+        {
+            *r_pslot = pslot;
+            return PM_RET_OK;
+        }
+    }
+}
+
+
+/*
+ * Moves the dict's items to a new table with room for at least one more
+ * item.  The new table has no deleted slots, and its items fill at most
+ * half of it unless it has DICT_TABLE_MAX_SIZE slots.
+ * Returns PM_RET_NO, and changes nothing, if the largest table
+ * has no room for one more item.
+ */
+static PmReturn_t
+dict_resize(pPmDict_t pdict)
+{
+    PmReturn_t retval = PM_RET_OK;
+    pPmDictTable_t pold = (pPmDictTable_t)pdict->d_table;
+    pPmDictTable_t pnew;
+    uint8_t *pchunk;
+    uint16_t size;
+    uint16_t mask;
+    uint16_t i;
+    uint16_t j;
+
+    size = DICT_TABLE_MIN_SIZE;
+    while ((size < DICT_TABLE_MAX_SIZE)
+           && (size < (((uint32_t)pdict->length + 1) << 1)))
+    {
+        size <<= 1;
+    }
+
+    /* Keep an empty slot to end every probe */
+    if ((uint32_t)pdict->length + 1 >= size)
+    {
+        return PM_RET_NO;
+    }
+
+    /* A table at its largest size with no deleted slots is kept as is */
+    if ((pold != C_NULL) && (pold->length == size)
+        && (pdict->d_fill == pdict->length))
+    {
+        return retval;
+    }
+
+    retval = heap_getChunk(sizeof(PmDictTable_t)
+                           + (size - 1) * sizeof(PmDictSlot_t), &pchunk);
+    PM_RETURN_IF_ERROR(retval);
+    pnew = (pPmDictTable_t)pchunk;
+    OBJ_SET_TYPE(pnew, OBJ_TYPE_DTB);
+    pnew->length = size;
+    sli_memset((unsigned char *)pnew->dt_slot, 0,
+               size * sizeof(PmDictSlot_t));
+
+    /* Put each item in the first empty slot from its hash */
+    if (pold != C_NULL)
+    {
+        mask = size - 1;
+        for (i = 0; i < pold->length; i++)
+        {
+            if (pold->dt_slot[i].ds_key != C_NULL)
+            {
+                j = obj_hash(pold->dt_slot[i].ds_key) & mask;
+                while (pnew->dt_slot[j].ds_key != C_NULL)
+                {
+                    j = (j + 1) & mask;
+                }
+                pnew->dt_slot[j] = pold->dt_slot[i];
+            }
+        }
+        retval = heap_freeChunk((pPmObj_t)pold);
+    }
+
+    pdict->d_table = (pPmObj_t)pnew;
+    pdict->d_fill = pdict->length;
+    HEAP_GC_WRITE_BARRIER(pdict, pnew);
+    HEAP_GC_RESCAN_BARRIER(pnew);
+    return retval;
+}
+
+
+#ifdef HAVE_GC_COMPACT
+/*
+ * An item is out of reach if an empty slot comes before it in the probe
+ * from its hash.  Each such item moves to that empty slot, which shortens
+ * its probe.  The move empties the item's old slot, which may put other
+ * items out of reach, so the table is checked again until nothing moves.
+ */
+void
+dict_rehashTable(pPmObj_t ptable)
+{
+    pPmDictTable_t pdt = (pPmDictTable_t)ptable;
+    uint16_t mask = pdt->length - 1;
+    uint16_t i;
+    uint16_t j;
+    uint8_t moved;
+
+    do
+    {
+        moved = C_FALSE;
+        for (i = 0; i < pdt->length; i++)
+        {
+            if (pdt->dt_slot[i].ds_key == C_NULL)
+            {
+                continue;
+            }
+
+            /* Find the first empty slot from the item's hash */
+            for (j = obj_hash(pdt->dt_slot[i].ds_key) & mask; j != i;
+                 j = (j + 1) & mask)
+            {
+                if ((pdt->dt_slot[j].ds_key == C_NULL)
+                    && (pdt->dt_slot[j].ds_val == C_NULL))
+                {
+                    break;
+                }
+            }
+            if (j == i)
+            {
+                continue;
+            }
+
+            pdt->dt_slot[j] = pdt->dt_slot[i];
+            pdt->dt_slot[i].ds_key = C_NULL;
+            pdt->dt_slot[i].ds_val = C_NULL;
+            moved = C_TRUE;
+        }
+    }
+    while (moved);
+}
+#endif /* HAVE_GC_COMPACT */
+
+
+/*
+ * Moves the items of a dict whose largest table is full to a keys
+ * and a values seglist.
+ */
+static PmReturn_t
+dict_toSeglists(pPmDict_t pdict)
+{
+    PmReturn_t retval;
+    pPmDictTable_t ptable = (pPmDictTable_t)pdict->d_table;
+    pSeglist_t pkeys;
+    pSeglist_t pvals;
+    uint16_t i;
+    uint8_t objid;
+    uint8_t objid2;
+
+    retval = seglist_new(&pkeys);
+    PM_RETURN_IF_ERROR(retval);
+    heap_gcPushTempRoot((pPmObj_t)pkeys, &objid);
+    retval = seglist_new(&pvals);
+    if (retval != PM_RET_OK)
+    {
+        heap_gcPopTempRoot(objid);
+        return retval;
+    }
+    heap_gcPushTempRoot((pPmObj_t)pvals, &objid2);
+
+    for (i = 0; i < ptable->length; i++)
+    {
+        if (ptable->dt_slot[i].ds_key != C_NULL)
+        {
+            retval = seglist_appendItem(pkeys, ptable->dt_slot[i].ds_key);
+            PM_BREAK_IF_ERROR(retval);
+            retval = seglist_appendItem(pvals, ptable->dt_slot[i].ds_val);
+            PM_BREAK_IF_ERROR(retval);
+        }
+    }
+    heap_gcPopTempRoot(objid);
+    PM_RETURN_IF_ERROR(retval);
+
+    pdict->d_table = (pPmObj_t)pkeys;
+    pdict->d_vals = pvals;
+    pdict->d_fill = 0;
+    HEAP_GC_WRITE_BARRIER(pdict, pkeys);
+    HEAP_GC_WRITE_BARRIER(pdict, pvals);
+    return heap_freeChunk((pPmObj_t)ptable);
+}
+
+
+/*
+ * Sets the key,val pair in the dict's table, making or growing the table
+ * as needed.  Returns PM_RET_NO, and changes nothing, if the key is new
+ * and the largest table has no room for it.
+ */
+static PmReturn_t
+dict_setTableItem(pPmDict_t pdict, pPmObj_t pkey, pPmObj_t pval)
+{
+    PmReturn_t retval;
+    pPmDictSlot_t pslot = C_NULL;
+
+    /* If found a matching key, replace val obj */
+    if (pdict->d_table != C_NULL)
+    {
+        retval = dict_findSlot(pdict, pkey, &pslot);
+        if (retval == PM_RET_OK)
+        {
+#ifdef HAVE_INLINE_CACHES
+            /* Storing the same object again leaves the dict unchanged */
+            if (pslot->ds_val == pval)
+            {
+                return retval;
+            }
+#endif /* HAVE_INLINE_CACHES */
+            DICT_NEW_VERSION(pdict);
+            pslot->ds_val = pval;
+            HEAP_GC_WRITE_BARRIER(pdict->d_table, pval);
+            return retval;
+        }
+    }
+
+    /* Grow the table (or make the first one) before it gets too full */
+    if ((pdict->d_table == C_NULL)
+        || ((((uint32_t)pdict->d_fill + 1) << 2)
+            > ((uint32_t)((pPmDictTable_t)pdict->d_table)->length * 3)))
+    {
+        retval = dict_resize(pdict);
+        PM_RETURN_IF_ERROR(retval);
+        retval = dict_findSlot(pdict, pkey, &pslot);
+        C_ASSERT(retval == PM_RET_NO);
+    }
+
+    /* Insert the key,val pair; a deleted slot was already counted */
+#ifdef HAVE_INLINE_CACHES
+    if (pdict->d_flags & DICT_FLAG_CLASS)
+    {
+        pdict->d_flags |= DICT_FLAG_SHADOWED;
+    }
+#endif /* HAVE_INLINE_CACHES */
+    DICT_NEW_VERSION(pdict);
+    if (pslot->ds_val == C_NULL)
+    {
+        pdict->d_fill++;
+    }
+    pslot->ds_key = pkey;
+    pslot->ds_val = pval;
+    HEAP_GC_WRITE_BARRIER(pdict->d_table, pkey);
+    HEAP_GC_WRITE_BARRIER(pdict->d_table, pval);
+    pdict->length++;
+
+    return PM_RET_OK;
+}
+#endif /* HAVE_HASHED_DICTS */
+
+
 PmReturn_t
 dict_new(pPmObj_t *r_pdict)
 {
@@ -36,8 +355,17 @@ dict_new(pPmObj_t *r_pdict)
     pdict = (pPmDict_t)pchunk;
     OBJ_SET_TYPE(pdict, OBJ_TYPE_DIC);
     pdict->length = 0;
+#ifdef HAVE_HASHED_DICTS
+    pdict->d_fill = 0;
+    pdict->d_table = C_NULL;
+#else
     pdict->d_keys = C_NULL;
+#endif /* HAVE_HASHED_DICTS */
     pdict->d_vals = C_NULL;
+#ifdef HAVE_INLINE_CACHES
+    pdict->d_flags = 0;
+#endif /* HAVE_INLINE_CACHES */
+    DICT_NEW_VERSION(pdict);
 
     *r_pdict = (pPmObj_t)pchunk;
     return retval;
@@ -48,6 +376,7 @@ PmReturn_t
 dict_clear(pPmObj_t pdict)
 {
     PmReturn_t retval = PM_RET_OK;
+    pSeglist_t pkeys;
 
     C_ASSERT(pdict != C_NULL);
 
@@ -60,14 +389,30 @@ dict_clear(pPmObj_t pdict)
 
     /* clear length */
     ((pPmDict_t)pdict)->length = 0;
+    DICT_NEW_VERSION(pdict);
+
+#ifdef HAVE_HASHED_DICTS
+    /* Free the table if needed */
+    ((pPmDict_t)pdict)->d_fill = 0;
+    if (DICT_GET_TABLE(pdict) != C_NULL)
+    {
+        retval = heap_freeChunk(((pPmDict_t)pdict)->d_table);
+        ((pPmDict_t)pdict)->d_table = C_NULL;
+        return retval;
+    }
+#endif /* HAVE_HASHED_DICTS */
 
     /* Free the keys and values seglists if needed */
-    if (((pPmDict_t)pdict)->d_keys != C_NULL)
+    pkeys = DICT_GET_KEYS(pdict);
+#ifdef HAVE_HASHED_DICTS
+    ((pPmDict_t)pdict)->d_table = C_NULL;
+#else
+    ((pPmDict_t)pdict)->d_keys = C_NULL;
+#endif /* HAVE_HASHED_DICTS */
+    if (pkeys != C_NULL)
     {
-        PM_RETURN_IF_ERROR(seglist_clear(((pPmDict_t)pdict)->d_keys));
-        PM_RETURN_IF_ERROR(heap_freeChunk((pPmObj_t)
-                                          ((pPmDict_t)pdict)->d_keys));
-        ((pPmDict_t)pdict)->d_keys = C_NULL;
+        PM_RETURN_IF_ERROR(seglist_clear(pkeys));
+        PM_RETURN_IF_ERROR(heap_freeChunk((pPmObj_t)pkeys));
     }
     if (((pPmDict_t)pdict)->d_vals != C_NULL)
     {
@@ -79,6 +424,54 @@ dict_clear(pPmObj_t pdict)
 }
 
 
+PmReturn_t
+dict_getNext(pPmObj_t pdict, uint16_t *pindex,
+             pPmObj_t *r_pkey, pPmObj_t *r_pval)
+{
+    PmReturn_t retval = PM_RET_OK;
+#ifdef HAVE_HASHED_DICTS
+    pPmDictTable_t ptable = DICT_GET_TABLE(pdict);
+    uint16_t i;
+
+    /* The position is an index into the table; skip the empty and
+     * deleted slots */
+    if (ptable != C_NULL)
+    {
+        for (i = *pindex; i < ptable->length; i++)
+        {
+            if (ptable->dt_slot[i].ds_key != C_NULL)
+            {
+                *r_pkey = ptable->dt_slot[i].ds_key;
+                if (r_pval != C_NULL)
+                {
+                    *r_pval = ptable->dt_slot[i].ds_val;
+                }
+                *pindex = i + 1;
+                return retval;
+            }
+        }
+        *pindex = i;
+        return PM_RET_NO;
+    }
+#endif /* HAVE_HASHED_DICTS */
+
+    /* The position is an index into the seglists */
+    if (*pindex >= ((pPmDict_t)pdict)->length)
+    {
+        return PM_RET_NO;
+    }
+    retval = seglist_getItem(DICT_GET_KEYS(pdict), *pindex, r_pkey);
+    PM_RETURN_IF_ERROR(retval);
+    if (r_pval != C_NULL)
+    {
+        retval = seglist_getItem(((pPmDict_t)pdict)->d_vals, *pindex, r_pval);
+        PM_RETURN_IF_ERROR(retval);
+    }
+    (*pindex)++;
+    return retval;
+}
+
+
 /*
  * Sets a value in the dict using the given key.
  *
@@ -90,6 +483,9 @@ dict_setItem(pPmObj_t pdict, pPmObj_t pkey, pPmObj_t pval)
 {
     PmReturn_t retval = PM_RET_OK;
     int16_t indx;
+#ifdef HAVE_INLINE_CACHES
+    pPmObj_t pobj;
+#endif /* HAVE_INLINE_CACHES */
 
     C_ASSERT(pdict != C_NULL);
     C_ASSERT(pkey != C_NULL);
@@ -120,6 +516,19 @@ dict_setItem(pPmObj_t pdict, pPmObj_t pkey, pPmObj_t pval)
         pkey = PM_ZERO;
     }
 
+#ifdef HAVE_HASHED_DICTS
+    /* Use the table until the dict outgrows the largest one */
+    if (DICT_GET_KEYS(pdict) == C_NULL)
+    {
+        retval = dict_setTableItem((pPmDict_t)pdict, pkey, pval);
+        if (retval != PM_RET_NO)
+        {
+            return retval;
+        }
+        retval = dict_toSeglists((pPmDict_t)pdict);
+        PM_RETURN_IF_ERROR(retval);
+    }
+#else
     /*
      * #115: If this is the first key/value pair to be added to the Dict,
      * allocate the key and value seglists that hold those items
@@ -132,21 +541,39 @@ dict_setItem(pPmObj_t pdict, pPmObj_t pkey, pPmObj_t pval)
         PM_RETURN_IF_ERROR(retval);
     }
     else
+#endif /* HAVE_HASHED_DICTS */
     {
         /* Check for matching key */
         indx = 0;
-        retval = seglist_findEqual(((pPmDict_t)pdict)->d_keys, pkey, &indx);
+        retval = seglist_findEqual(DICT_GET_KEYS(pdict), pkey, &indx);
 
         /* If found a matching key, replace val obj */
         if (retval == PM_RET_OK)
         {
+#ifdef HAVE_INLINE_CACHES
+            /* Storing the same object again leaves the dict unchanged */
+            retval = seglist_getItem(((pPmDict_t)pdict)->d_vals, indx, &pobj);
+            PM_RETURN_IF_ERROR(retval);
+            if (pobj == pval)
+            {
+                return retval;
+            }
+#endif /* HAVE_INLINE_CACHES */
+            DICT_NEW_VERSION(pdict);
             retval = seglist_setItem(((pPmDict_t)pdict)->d_vals, pval, indx);
             return retval;
         }
     }
 
     /* Otherwise, insert the key,val pair */
-    retval = seglist_insertItem(((pPmDict_t)pdict)->d_keys, pkey, 0);
+#ifdef HAVE_INLINE_CACHES
+    if (((pPmDict_t)pdict)->d_flags & DICT_FLAG_CLASS)
+    {
+        ((pPmDict_t)pdict)->d_flags |= DICT_FLAG_SHADOWED;
+    }
+#endif /* HAVE_INLINE_CACHES */
+    DICT_NEW_VERSION(pdict);
+    retval = seglist_insertItem(DICT_GET_KEYS(pdict), pkey, 0);
     PM_RETURN_IF_ERROR(retval);
     retval = seglist_insertItem(((pPmDict_t)pdict)->d_vals, pval, 0);
     ((pPmDict_t)pdict)->length++;
@@ -159,6 +586,9 @@ PmReturn_t
 dict_getItem(pPmObj_t pdict, pPmObj_t pkey, pPmObj_t *r_pobj)
 {
     PmReturn_t retval = PM_RET_OK;
+#ifdef HAVE_HASHED_DICTS
+    pPmDictSlot_t pslot;
+#endif /* HAVE_HASHED_DICTS */
     int16_t indx = 0;
 
 /*    C_ASSERT(pdict != C_NULL);*/
@@ -187,8 +617,23 @@ dict_getItem(pPmObj_t pdict, pPmObj_t pkey, pPmObj_t *r_pobj)
         pkey = PM_ZERO;
     }
 
+#ifdef HAVE_HASHED_DICTS
+    /* check for matching key; if key not found, raise KeyError */
+    if (DICT_GET_TABLE(pdict) != C_NULL)
+    {
+        retval = dict_findSlot((pPmDict_t)pdict, pkey, &pslot);
+        if (retval == PM_RET_NO)
+        {
+            PM_RAISE(retval, PM_RET_EX_KEY);
+            return retval;
+        }
+        *r_pobj = pslot->ds_val;
+        return retval;
+    }
+#endif /* HAVE_HASHED_DICTS */
+
     /* check for matching key */
-    retval = seglist_findEqual(((pPmDict_t)pdict)->d_keys, pkey, &indx);
+    retval = seglist_findEqual(DICT_GET_KEYS(pdict), pkey, &indx);
     /* if key not found, raise KeyError */
     if (retval == PM_RET_NO)
     {
@@ -208,12 +653,50 @@ PmReturn_t
 dict_delItem(pPmObj_t pdict, pPmObj_t pkey)
 {
     PmReturn_t retval = PM_RET_OK;
+#ifdef HAVE_HASHED_DICTS
+    pPmDictSlot_t pslot;
+#endif /* HAVE_HASHED_DICTS */
     int16_t indx = 0;
 
     C_ASSERT(pdict != C_NULL);
 
+#ifdef HAVE_HASHED_DICTS
+    /* #147: Change boolean keys to integers */
+    if (pkey == PM_TRUE)
+    {
+        pkey = PM_ONE;
+    }
+    else if (pkey == PM_FALSE)
+    {
+        pkey = PM_ZERO;
+    }
+
+    /* Raise KeyError if key is not found */
+    if (((pPmDict_t)pdict)->d_table == C_NULL)
+    {
+        PM_RAISE(retval, PM_RET_EX_KEY);
+        return retval;
+    }
+    if (DICT_GET_TABLE(pdict) != C_NULL)
+    {
+        retval = dict_findSlot((pPmDict_t)pdict, pkey, &pslot);
+        if (retval == PM_RET_NO)
+        {
+            PM_RAISE(retval, PM_RET_EX_KEY);
+            return retval;
+        }
+
+        /* Leave a deleted slot so probes for later keys go on past it */
+        DICT_NEW_VERSION(pdict);
+        pslot->ds_key = C_NULL;
+        pslot->ds_val = PM_NONE;
+        ((pPmDict_t)pdict)->length--;
+        return retval;
+    }
+#endif /* HAVE_HASHED_DICTS */
+
     /* Check for matching key */
-    retval = seglist_findEqual(((pPmDict_t)pdict)->d_keys, pkey, &indx);
+    retval = seglist_findEqual(DICT_GET_KEYS(pdict), pkey, &indx);
 
     /* Raise KeyError if key is not found */
     if (retval == PM_RET_NO)
@@ -225,7 +708,8 @@ dict_delItem(pPmObj_t pdict, pPmObj_t pkey)
     PM_RETURN_IF_ERROR(retval);
 
     /* Remove the key and value */
-    retval = seglist_removeItem(((pPmDict_t)pdict)->d_keys, indx);
+    DICT_NEW_VERSION(pdict);
+    retval = seglist_removeItem(DICT_GET_KEYS(pdict), indx);
     PM_RETURN_IF_ERROR(retval);
     retval = seglist_removeItem(((pPmDict_t)pdict)->d_vals, indx);
 
@@ -242,10 +726,10 @@ PmReturn_t
 dict_print(pPmObj_t pdict)
 {
     PmReturn_t retval = PM_RET_OK;
-    int16_t index;
-    pSeglist_t keys,
-      vals;
-    pPmObj_t pobj1;
+    uint16_t index;
+    pPmObj_t pkey;
+    pPmObj_t pval;
+    uint8_t is_first = C_TRUE;
 
     C_ASSERT(pdict != C_NULL);
 
@@ -258,26 +742,20 @@ dict_print(pPmObj_t pdict)
 
     plat_putByte('{');
 
-    keys = ((pPmDict_t)pdict)->d_keys;
-    vals = ((pPmDict_t)pdict)->d_vals;
-
-    /* if dict is empty, raise KeyError */
-    for (index = 0; index < ((pPmDict_t)pdict)->length; index++)
+    index = 0;
+    while (dict_getNext(pdict, &index, &pkey, &pval) == PM_RET_OK)
     {
-        if (index != 0)
+        if (!is_first)
         {
             plat_putByte(',');
             plat_putByte(' ');
         }
-        retval = seglist_getItem(keys, index, &pobj1);
-        PM_RETURN_IF_ERROR(retval);
-        retval = obj_print(pobj1, C_FALSE, C_TRUE);
+        is_first = C_FALSE;
+        retval = obj_print(pkey, C_FALSE, C_TRUE);
         PM_RETURN_IF_ERROR(retval);
 
         plat_putByte(':');
-        retval = seglist_getItem(vals, index, &pobj1);
-        PM_RETURN_IF_ERROR(retval);
-        retval = obj_print(pobj1, C_FALSE, C_TRUE);
+        retval = obj_print(pval, C_FALSE, C_TRUE);
         PM_RETURN_IF_ERROR(retval);
     }
 
@@ -290,7 +768,7 @@ PmReturn_t
 dict_update(pPmObj_t pdestdict, pPmObj_t psourcedict, uint8_t omit_underscored)
 {
     PmReturn_t retval = PM_RET_OK;
-    int16_t i;
+    uint16_t i;
     pPmObj_t pkey;
     pPmObj_t pval;
 
@@ -312,14 +790,9 @@ dict_update(pPmObj_t pdestdict, pPmObj_t psourcedict, uint8_t omit_underscored)
     }
 
     /* Iterate over the add-on dict */
-    for (i = 0; i < ((pPmDict_t)psourcedict)->length; i++)
+    i = 0;
+    while (dict_getNext(psourcedict, &i, &pkey, &pval) == PM_RET_OK)
     {
-        /* Get the key,val from the add-on dict */
-        retval = seglist_getItem(((pPmDict_t)psourcedict)->d_keys, i, &pkey);
-        PM_RETURN_IF_ERROR(retval);
-        retval = seglist_getItem(((pPmDict_t)psourcedict)->d_vals, i, &pval);
-        PM_RETURN_IF_ERROR(retval);
-
         if (!(omit_underscored && (OBJ_GET_TYPE(pkey) == OBJ_TYPE_STR)
               && ((pPmString_t)pkey)->val[0] == '_'))
         {
@@ -329,7 +802,7 @@ dict_update(pPmObj_t pdestdict, pPmObj_t psourcedict, uint8_t omit_underscored)
         }
     }
 
-    return retval;
+    return PM_RET_OK;
 }
 
 
@@ -350,14 +823,10 @@ dict_compare(pPmObj_t d1, pPmObj_t d2)
         return C_DIFFER;
     }
 
-    for (i = 0; i < pd1->length; i++)
+    /* Get each key,val from one dict */
+    i = 0;
+    while (dict_getNext(d1, &i, &pkey1, &pval1) == PM_RET_OK)
     {
-        /* Get the key,val from one dict */
-        retval = seglist_getItem(pd1->d_keys, i, &pkey1);
-        PM_RETURN_IF_ERROR(retval);
-        retval = seglist_getItem(pd1->d_vals, i, &pval1);
-        PM_RETURN_IF_ERROR(retval);
-
         /* Return if the key,val pair is not in the other dict */
         retval = dict_getItem(d2, pkey1, &pval2);
         if (retval != PM_RET_OK)
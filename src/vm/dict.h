@@ -18,12 +18,84 @@
  */
 
 
+#ifdef HAVE_INLINE_CACHES
+/**
+ * The version a dict saturates at.  Caches are not filled from a dict
+ * with this version, since it is no longer unique.
+ */
+#define DICT_VERSION_MAX 0xFFFFFFFFUL
+
+/** Flag: the dict is the attrs dict of a class */
+#define DICT_FLAG_CLASS 0x01
+
+/**
+ * Flag: instances of the class whose attrs dict this is may have names
+ * of class attributes in their own attrs dicts.  Set when the class gets
+ * a new attribute after it was made, or when an instance stores an
+ * attribute that hides one of the class.
+ */
+#define DICT_FLAG_SHADOWED 0x02
+#endif /* HAVE_INLINE_CACHES */
+
+#ifdef HAVE_HASHED_DICTS
+/** The number of slots in a dict's first table; must be a power of two */
+#define DICT_TABLE_MIN_SIZE 8
+
+
+/**
+ * Dict Slot
+ *
+ * A slot in the table of a hashed dict.  An empty slot has a null key and
+ * a null value.  A slot whose item was deleted has a null key and PM_NONE
+ * as its value; probes go on past it, and an insert may reuse it.
+ */
+typedef struct PmDictSlot_s
+{
+    /** key obj, or C_NULL if the slot holds no item */
+    pPmObj_t ds_key;
+    /** value obj */
+    pPmObj_t ds_val;
+} PmDictSlot_t,
+ *pPmDictSlot_t;
+
+
+/**
+ * Dict Table
+ *
+ * The open-addressed hash table of a dict.  A key is looked for from the
+ * slot its hash selects, then in the following slots (wrapping around),
+ * up to the first empty slot.  The dict grows the table before
+ * three quarters of its slots are used by items and deleted items.
+ */
+typedef struct PmDictTable_s
+{
+    /** object descriptor */
+    PmObjDesc_t od;
+    /** number of slots, a power of two */
+    uint16_t length;
+    /** array of slots */
+    PmDictSlot_t dt_slot[1];
+} PmDictTable_t,
+ *pPmDictTable_t;
+#endif /* HAVE_HASHED_DICTS */
+
+
 /**
  * Dict
  *
  * Contains ptr to two seglists,
  * one for keys, the other for values;
  * and a length, the number of key/value pairs.
+ * With HAVE_HASHED_DICTS, contains a ptr to a hash table of key/value
+ * slots instead of the seglists.  A dict with more items than the
+ * largest table holds goes back to the seglists; the table ptr then
+ * points to the keys seglist.
+ *
+ * With HAVE_INLINE_CACHES, a dict also has a version that is given a new
+ * value, unique among all dicts, each time the dict is created or changed.
+ * Two equal versions mean the same dict with the same contents.
+ * The versions of a class's attrs dicts make its version; see
+ * class_getVersion().
  */
 typedef struct PmDict_s
 {
@@ -31,14 +103,50 @@ typedef struct PmDict_s
     PmObjDesc_t od;
     /** number of key,value pairs in the dict */
     uint16_t length;
+#ifdef HAVE_INLINE_CACHES
+    /** DICT_FLAG_* bits */
+    uint8_t d_flags;
+#endif /* HAVE_INLINE_CACHES */
+#ifdef HAVE_HASHED_DICTS
+    /** number of slots that hold an item or a deleted item */
+    uint16_t d_fill;
+    /**
+     * ptr to the hash table, or C_NULL before the first item is set;
+     * or ptr to seglist containing keys, once the dict outgrew the
+     * largest table
+     */
+    pPmObj_t d_table;
+#else
     /** ptr to seglist containing keys */
     pSeglist_t d_keys;
+#endif /* HAVE_HASHED_DICTS */
     /** ptr to seglist containing values */
     pSeglist_t d_vals;
+#ifdef HAVE_INLINE_CACHES
+    /** version, changed by every change to the dict */
+    uint32_t d_version;
+#endif /* HAVE_INLINE_CACHES */
 } PmDict_t,
  *pPmDict_t;
 
 
+#ifdef HAVE_HASHED_DICTS
+/** Evaluates to the dict's hash table, or C_NULL if it has none */
+#define DICT_GET_TABLE(pdict) \
+    ((((pPmDict_t)(pdict))->d_table != C_NULL) \
+     && (OBJ_GET_TYPE(((pPmDict_t)(pdict))->d_table) == OBJ_TYPE_DTB) \
+     ? (pPmDictTable_t)((pPmDict_t)(pdict))->d_table : (pPmDictTable_t)C_NULL)
+
+/** Evaluates to the dict's keys seglist, or C_NULL if it has none */
+#define DICT_GET_KEYS(pdict) \
+    ((((pPmDict_t)(pdict))->d_table != C_NULL) \
+     && (OBJ_GET_TYPE(((pPmDict_t)(pdict))->d_table) == OBJ_TYPE_SGL) \
+     ? (pSeglist_t)((pPmDict_t)(pdict))->d_table : (pSeglist_t)C_NULL)
+#else
+#define DICT_GET_KEYS(pdict) (((pPmDict_t)(pdict))->d_keys)
+#endif /* HAVE_HASHED_DICTS */
+
+
 /**
  * Clears the contents of a dict.
  * after this operation, the dict should in the same state
@@ -81,12 +189,27 @@ PmReturn_t dict_delItem(pPmObj_t pdict, pPmObj_t pkey);
  */
 PmReturn_t dict_new(pPmObj_t *r_pdict);
 
+/**
+ * Gets the next key,val pair in the dict at or after the given position
+ * and moves the position past it.  Start with a position of 0 to visit
+ * every pair once; the dict must not change in between.
+ *
+ * @param   pdict ptr to dict
+ * @param   pindex ptr to the position; updated
+ * @param   r_pkey Return; addr of ptr to key obj
+ * @param   r_pval Return; addr of ptr to val obj, or C_NULL if not wanted
+ * @return  PM_RET_OK, or PM_RET_NO if there are no more pairs
+ */
+PmReturn_t dict_getNext(pPmObj_t pdict, uint16_t *pindex,
+                        pPmObj_t *r_pkey, pPmObj_t *r_pval);
+
 /**
  * Sets a value in the dict using the given key.
  *
  * If the dict already contains a matching key, the value is
  * replaced; otherwise the new key,val pair is inserted
- * at the front of the dict (for fast lookup).
+ * at the front of the dict (for fast lookup),
+ * or in the hash table with HAVE_HASHED_DICTS.
  * In the later case, the length of the dict is incremented.
  *
  * @param   pdict ptr to dict in which (key,val) will go
@@ -96,6 +219,17 @@ PmReturn_t dict_new(pPmObj_t *r_pdict);
  */
 PmReturn_t dict_setItem(pPmObj_t pdict, pPmObj_t pkey, pPmObj_t pval);
 
+#ifdef HAVE_INLINE_CACHES
+/**
+ * Sets the given DICT_FLAG_* bits in the dict.  This counts as a change
+ * to the dict, so the dict gets a new version.
+ *
+ * @param   pdict ptr to dict
+ * @param   flags flags to set
+ */
+void dict_setFlags(pPmDict_t pdict, uint8_t flags);
+#endif /* HAVE_INLINE_CACHES */
+
 #ifdef HAVE_PRINT
 /**
  * Prints out a dict. Uses obj_print() to print elements.
@@ -127,4 +261,15 @@ PmReturn_t dict_update(pPmObj_t pdestdict, pPmObj_t psourcedict,
  */
 int8_t dict_compare(pPmObj_t d1, pPmObj_t d2);
 
+#if defined(HAVE_HASHED_DICTS) && defined(HAVE_GC_COMPACT)
+/**
+ * Moves the items of a table that can no longer be found from their keys'
+ * hashes, without allocating.  The compactor calls this after moving
+ * objects, since a key that hashes by address has a new hash.
+ *
+ * @param   ptable ptr to a dict's table
+ */
+void dict_rehashTable(pPmObj_t ptable);
+#endif /* HAVE_HASHED_DICTS && HAVE_GC_COMPACT */
+
 #endif /* __DICT_H__ */
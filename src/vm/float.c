@@ -30,7 +30,14 @@ float_new(float f, pPmObj_t *r_pf)
 {
     PmReturn_t retval = PM_RET_OK;
 
+#ifdef HAVE_GC_NURSERY
+    retval = heap_getNurseryChunk(sizeof(PmFloat_t), (uint8_t **)r_pf);
+#elif defined(HAVE_HEAP_POOLS)
+    retval = heap_getPoolChunk(OBJ_TYPE_FLT, sizeof(PmFloat_t),
+                               (uint8_t **)r_pf);
+#else
     retval = heap_getChunk(sizeof(PmFloat_t), (uint8_t **)r_pf);
+#endif /* HAVE_GC_NURSERY */
     PM_RETURN_IF_ERROR(retval);
     OBJ_SET_TYPE(*r_pf, OBJ_TYPE_FLT);
     ((pPmFloat_t) * r_pf)->val = f;
@@ -108,7 +115,7 @@ float_op(pPmObj_t px, pPmObj_t py, pPmObj_t *r_pn, int8_t op)
     /* Get the values as floats */
     if (OBJ_GET_TYPE(px) == OBJ_TYPE_INT)
     {
-        x = (float)((pPmInt_t)px)->val;
+        x = (float)INT_GET_VAL(px);
     }
     else
     {
@@ -117,7 +124,7 @@ float_op(pPmObj_t px, pPmObj_t py, pPmObj_t *r_pn, int8_t op)
 
     if (OBJ_GET_TYPE(py) == OBJ_TYPE_INT)
     {
-        y = (float)((pPmInt_t)py)->val;
+        y = (float)INT_GET_VAL(py);
     }
     else
     {
@@ -171,7 +178,7 @@ float_compare(pPmObj_t px, pPmObj_t py, pPmObj_t *r_pobj, PmCompare_t cmp)
     /* Get the values as floats */
     if (OBJ_GET_TYPE(px) == OBJ_TYPE_INT)
     {
-        x = (float)((pPmInt_t)px)->val;
+        x = (float)INT_GET_VAL(px);
     }
     else
     {
@@ -180,7 +187,7 @@ float_compare(pPmObj_t px, pPmObj_t py, pPmObj_t *r_pobj, PmCompare_t cmp)
 
     if (OBJ_GET_TYPE(py) == OBJ_TYPE_INT)
     {
-        y = (float)((pPmInt_t)py)->val;
+        y = (float)INT_GET_VAL(py);
     }
     else
     {
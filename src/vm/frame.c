@@ -21,24 +21,11 @@
 #include "pm.h"
 
 
-PmReturn_t
-frame_new(pPmObj_t pfunc, pPmObj_t *r_pobj)
+/* Gets the size of a frame for the given code object */
+static uint16_t
+frame_getSize(pPmCo_t pco)
 {
-    PmReturn_t retval = PM_RET_OK;
-    int16_t fsize = 0;
-    pPmCo_t pco = C_NULL;
-    pPmFrame_t pframe = C_NULL;
-    uint8_t *pchunk;
-
-    /* Get fxn's code obj */
-    pco = ((pPmFunc_t)pfunc)->f_co;
-
-    /* TypeError if passed func's CO is not a true COB */
-    if (OBJ_GET_TYPE(pco) != OBJ_TYPE_COB)
-    {
-        PM_RAISE(retval, PM_RET_EX_TYPE);
-        return retval;
-    }
+    uint16_t fsize;
 
 #ifdef HAVE_GENERATORS
     /* #207: Initializing a Generator using CALL_FUNC needs extra stack slot */
@@ -52,24 +39,35 @@ frame_new(pPmObj_t pfunc, pPmObj_t *r_pobj)
 
 #ifdef HAVE_CLOSURES
     /* #256: Add support for closures */
-    fsize = fsize + pco->co_nfreevars
-            + ((pco->co_cellvars == C_NULL) ? 0 : pco->co_cellvars->length);
+    fsize = fsize + (pco->co_nfreevars
+            + ((pco->co_cellvars == C_NULL) ? 0 : pco->co_cellvars->length))
+            * sizeof(pPmObj_t);
 #endif /* HAVE_CLOSURES */
 
-    /* Allocate a frame */
-    retval = heap_getChunk(fsize, &pchunk);
-    PM_RETURN_IF_ERROR(retval);
-    pframe = (pPmFrame_t)pchunk;
+    /* The block stack follows the locals and stack */
+    return fsize + pco->co_nblocks * sizeof(PmBlock_t);
+}
+
+
+/* Fills in the fields of a new frame of the given size */
+static void
+frame_init(pPmFrame_t pframe, pPmObj_t pfunc, uint16_t fsize)
+{
+    pPmCo_t pco = ((pPmFunc_t)pfunc)->f_co;
 
     /* Set frame fields */
-    OBJ_SET_TYPE(pframe, OBJ_TYPE_FRM);
     pframe->fo_back = C_NULL;
     pframe->fo_func = (pPmFunc_t)pfunc;
     pframe->fo_memspace = pco->co_memspace;
 
     /* Init instruction pointer and block stack */
     pframe->fo_ip = pco->co_codeaddr;
-    pframe->fo_blockstack = C_NULL;
+    pframe->fo_blocks = (pPmBlock_t)((uint8_t *)pframe + fsize
+                                     - pco->co_nblocks * sizeof(PmBlock_t));
+    pframe->fo_nblocks = 0;
+#ifdef HAVE_FRAME_STACK
+    pframe->fo_stack = C_NULL;
+#endif /* HAVE_FRAME_STACK */
 
     /* Get globals and attrs from the function object */
     pframe->fo_globals = ((pPmFunc_t)pfunc)->f_globals;
@@ -90,11 +88,174 @@ frame_new(pPmObj_t pfunc, pPmObj_t *r_pobj)
     pframe->fo_isInit = 0;
 #endif
 
-    /* Clear the stack */
+    /* Clear the locals; nothing above the stack pointer is ever read */
     sli_memset((unsigned char *)&(pframe->fo_locals), (char const)0,
-               (unsigned int)fsize - sizeof(PmFrame_t));
+               (unsigned int)((uint8_t *)pframe->fo_sp
+                              - (uint8_t *)pframe->fo_locals));
+}
+
+
+PmReturn_t
+frame_new(pPmObj_t pfunc, pPmObj_t *r_pobj)
+{
+    PmReturn_t retval = PM_RET_OK;
+    uint16_t fsize;
+    pPmCo_t pco = C_NULL;
+    uint8_t *pchunk;
+
+    /* Get fxn's code obj */
+    pco = ((pPmFunc_t)pfunc)->f_co;
+
+    /* TypeError if passed func's CO is not a true COB */
+    if (OBJ_GET_TYPE(pco) != OBJ_TYPE_COB)
+    {
+        PM_RAISE(retval, PM_RET_EX_TYPE);
+        return retval;
+    }
+
+    /* Allocate a frame */
+    fsize = frame_getSize(pco);
+    retval = heap_getChunk(fsize, &pchunk);
+    PM_RETURN_IF_ERROR(retval);
+    OBJ_SET_TYPE(pchunk, OBJ_TYPE_FRM);
+    frame_init((pPmFrame_t)pchunk, pfunc, fsize);
 
     /* Return ptr to frame */
+    *r_pobj = (pPmObj_t)pchunk;
+    return retval;
+}
+
+
+#ifdef HAVE_FRAME_STACK
+/*
+ * Makes the segment above the thread's current one current, so it can take
+ * a frame of the given size.  Reuses the kept empty segment if it is big
+ * enough; otherwise allocates a new one.
+ */
+static PmReturn_t
+frame_growStack(pPmThread_t pthread, uint16_t fsize)
+{
+    PmReturn_t retval;
+    pPmFrameStack_t pfs;
+    pPmFrameStack_t pnext;
+    uint8_t *pchunk;
+    uint16_t size;
+
+    pfs = pthread->fstack;
+    pnext = (pfs == C_NULL) ? C_NULL : pfs->fs_next;
+
+    if ((pnext == C_NULL) || (pnext->fs_size < fsize))
+    {
+        size = (fsize > FRAME_STACK_SIZE) ? fsize : FRAME_STACK_SIZE;
+        retval = heap_getChunk(sizeof(PmFrameStack_t) + size, &pchunk);
+        PM_RETURN_IF_ERROR(retval);
+
+        /* The kept segment is too small for this frame */
+        if (pnext != C_NULL)
+        {
+            retval = heap_freeChunk((pPmObj_t)pnext);
+            PM_RETURN_IF_ERROR(retval);
+        }
+
+        pnext = (pPmFrameStack_t)pchunk;
+        OBJ_SET_TYPE(pnext, OBJ_TYPE_FST);
+        pnext->fs_prev = pfs;
+        pnext->fs_next = C_NULL;
+        pnext->fs_size = size;
+        if (pfs != C_NULL)
+        {
+            pfs->fs_next = pnext;
+            HEAP_GC_WRITE_BARRIER(pfs, pnext);
+        }
+    }
+
+    pnext->fs_top = FRAME_STACK_BASE(pnext);
+    pthread->fstack = pnext;
+    HEAP_GC_WRITE_BARRIER(pthread, pnext);
+    return PM_RET_OK;
+}
+#endif /* HAVE_FRAME_STACK */
+
+
+PmReturn_t
+frame_push(pPmObj_t pfunc, pPmObj_t *r_pobj)
+{
+#ifdef HAVE_FRAME_STACK
+    PmReturn_t retval = PM_RET_OK;
+    pPmThread_t pthread = gVmGlobal.pthread;
+    pPmFrameStack_t pfs;
+    pPmFrame_t pframe;
+    uint16_t fsize;
+
+    /* TypeError if passed func's CO is not a true COB */
+    if (OBJ_GET_TYPE(((pPmFunc_t)pfunc)->f_co) != OBJ_TYPE_COB)
+    {
+        PM_RAISE(retval, PM_RET_EX_TYPE);
+        return retval;
+    }
+
+    /* Move to the next segment if the frame does not fit in this one */
+    fsize = frame_getSize(((pPmFunc_t)pfunc)->f_co);
+    pfs = pthread->fstack;
+    if ((pfs == C_NULL) || ((pfs->fs_top + fsize) > FRAME_STACK_END(pfs)))
+    {
+        retval = frame_growStack(pthread, fsize);
+
+        /* With no room for a segment, the frame gets a chunk of its own */
+        if (retval == PM_RET_EX_MEM)
+        {
+            return frame_new(pfunc, r_pobj);
+        }
+        PM_RETURN_IF_ERROR(retval);
+        pfs = pthread->fstack;
+    }
+
+    /* Bump-allocate the frame; it has no chunk of its own */
+    pframe = (pPmFrame_t)pfs->fs_top;
+    pfs->fs_top += fsize;
+    pframe->od = 0;
+    OBJ_SET_TYPE(pframe, OBJ_TYPE_FRM);
+    frame_init(pframe, pfunc, fsize);
+    pframe->fo_stack = pfs;
+
     *r_pobj = (pPmObj_t)pframe;
     return retval;
+#else
+    return frame_new(pfunc, r_pobj);
+#endif /* HAVE_FRAME_STACK */
+}
+
+
+PmReturn_t
+frame_free(pPmFrame_t pframe)
+{
+#ifdef HAVE_FRAME_STACK
+    PmReturn_t retval = PM_RET_OK;
+    pPmFrameStack_t pfs = pframe->fo_stack;
+    pPmFrameStack_t pnext;
+
+    if (pfs != C_NULL)
+    {
+        /* Pop the frame and any newer ones; its segment becomes current */
+        pfs->fs_top = (uint8_t *)pframe;
+        gVmGlobal.pthread->fstack = pfs;
+
+        /* Keep the segment above this one empty, free any above that */
+        pnext = pfs->fs_next;
+        if (pnext != C_NULL)
+        {
+            pnext->fs_top = FRAME_STACK_BASE(pnext);
+        }
+        while ((pnext != C_NULL) && (pnext->fs_next != C_NULL))
+        {
+            pfs = pnext->fs_next;
+            pnext->fs_next = pfs->fs_next;
+            retval = heap_freeChunk((pPmObj_t)pfs);
+            PM_RETURN_IF_ERROR(retval);
+        }
+        return retval;
+    }
+#endif /* HAVE_FRAME_STACK */
+
+    return heap_freeChunk((pPmObj_t)pframe);
 }
@@ -24,6 +24,16 @@
  */
 #define NATIVE_MAX_NUM_LOCALS   8
 
+#ifdef HAVE_FRAME_STACK
+/**
+ * The number of bytes of frames in each segment of a thread's frame stack.
+ * A frame bigger than this gets a segment of its own size.
+ */
+#ifndef FRAME_STACK_SIZE
+#define FRAME_STACK_SIZE        0x200
+#endif
+#endif /* HAVE_FRAME_STACK */
+
 
 /**
  * Block Type
@@ -47,14 +57,12 @@ typedef enum PmBlockType_e
  * Block
  *
  * Extra info for loops and trys (others?)
- * Frames use linked list of blocks to handle
+ * Frames use a stack of blocks to handle
  * nested loops and try-catch blocks.
+ * A block is not an object; it lives in the block stack of its frame.
  */
 typedef struct PmBlock_s
 {
-    /** Obligatory obj descriptor */
-    PmObjDesc_t od;
-
     /** Ptr to backup stack ptr */
     pPmObj_t *b_sp;
 
@@ -63,13 +71,47 @@ typedef struct PmBlock_s
 
     /** Block type */
     PmBlockType_t b_type:8;
-
-    /** Next block in stack */
-    struct PmBlock_s *next;
 } PmBlock_t,
  *pPmBlock_t;
 
 
+#ifdef HAVE_FRAME_STACK
+/**
+ * Frame Stack Segment
+ *
+ * A chunk of a thread's frame stack.  Frames are bump-allocated from
+ * fs_top upward and released in LIFO order by moving fs_top back down.
+ * The frames follow this struct; the GC marks and scans them all
+ * as part of their segment.  A thread's segments are a linked list;
+ * one empty segment is kept above the thread's current segment.
+ */
+typedef struct PmFrameStack_s
+{
+    /** Obligatory obj descriptor */
+    PmObjDesc_t od;
+
+    /** Segment of the older frames */
+    struct PmFrameStack_s *fs_prev;
+
+    /** Empty segment kept for newer frames */
+    struct PmFrameStack_s *fs_next;
+
+    /** Points just past the newest frame in this segment */
+    uint8_t *fs_top;
+
+    /** Number of bytes of frames this segment can hold */
+    uint16_t fs_size;
+} PmFrameStack_t,
+ *pPmFrameStack_t;
+
+/** Gets the address of the first frame in the segment */
+#define FRAME_STACK_BASE(pfs) ((uint8_t *)(pfs) + sizeof(PmFrameStack_t))
+
+/** Gets the address just past the end of the segment */
+#define FRAME_STACK_END(pfs) (FRAME_STACK_BASE(pfs) + (pfs)->fs_size)
+#endif /* HAVE_FRAME_STACK */
+
+
 /**
  * Frame
  *
@@ -78,7 +120,11 @@ typedef struct PmBlock_s
  *
  * This struct doesn't declare the stack.
  * frame_new() is responsible for allocating the extra memory
- * at the tail of fo_locals[] to hold both the locals and stack.
+ * at the tail of fo_locals[] to hold the locals, the stack
+ * and the block stack.
+ *
+ * With HAVE_FRAME_STACK, the frame of a call is pushed on its thread's
+ * frame stack by frame_push() instead; fo_stack then holds the segment.
  */
 typedef struct PmFrame_s
 {
@@ -97,8 +143,8 @@ typedef struct PmFrame_s
     /** Instrxn ptr (pts into memspace) */
     uint8_t const *fo_ip;
 
-    /** Linked list of blocks */
-    pPmBlock_t fo_blockstack;
+    /** Block stack; room for co_nblocks blocks after the stack */
+    pPmBlock_t fo_blocks;
 
     /** Local attributes dict (non-fast locals) */
     pPmDict_t fo_attrs;
@@ -109,6 +155,14 @@ typedef struct PmFrame_s
     /** Points to next empty slot in fo_locals (1 past TOS) */
     pPmObj_t *fo_sp;
 
+#ifdef HAVE_FRAME_STACK
+    /** Frame stack segment that holds this frame, or C_NULL if in the heap */
+    pPmFrameStack_t fo_stack;
+#endif /* HAVE_FRAME_STACK */
+
+    /** Number of blocks in the block stack */
+    uint8_t fo_nblocks;
+
     /** Frame can be an import-frame that handles RETURN differently */
     uint8_t fo_isImport:1;
 
@@ -123,6 +177,10 @@ typedef struct PmFrame_s
 } PmFrame_t,
  *pPmFrame_t;
 
+/** Gets the address just past the frame; its block stack ends it */
+#define FRAME_GET_END(pframe) \
+    ((uint8_t *)&(pframe)->fo_blocks[(pframe)->fo_func->f_co->co_nblocks])
+
 
 /**
  * Native Frame
@@ -172,4 +230,27 @@ typedef struct PmNativeFrame_s
  */
 PmReturn_t frame_new(pPmObj_t pfunc, pPmObj_t *r_pobj);
 
+/**
+ * Makes a new frame for a call of the given function object.
+ * With HAVE_FRAME_STACK, the frame is pushed on the running thread's
+ * frame stack; otherwise it is allocated like frame_new() does.
+ * The frame must be released by frame_free() when the call is over,
+ * so it must not be used for a frame that outlives its call.
+ *
+ * @param   pfunc ptr to Function object.
+ * @param   r_pobj Return value; the new frame.
+ * @return  Return status.
+ */
+PmReturn_t frame_push(pPmObj_t pfunc, pPmObj_t *r_pobj);
+
+/**
+ * Releases the frame of a call that is over.
+ * A frame on the running thread's frame stack is popped, along with any
+ * newer frames; a frame in the heap is freed.
+ *
+ * @param   pframe ptr to the frame.
+ * @return  Return status.
+ */
+PmReturn_t frame_free(pPmFrame_t pframe);
+
 #endif /* __FRAME_H__ */
@@ -31,6 +31,19 @@ static uint8_t const *bistr = (uint8_t const *)"__bi";
 volatile PmVmGlobal_t gVmGlobal;
 
 
+/* Creates the interned string of a name the VM looks up */
+static PmReturn_t
+global_newName(uint8_t const *pcstr, pPmObj_t *r_pstring)
+{
+    PmReturn_t retval;
+    pPmObj_t pstr;
+
+    retval = string_new(&pcstr, &pstr);
+    PM_RETURN_IF_ERROR(retval);
+    return string_intern(pstr, r_pstring);
+}
+
+
 PmReturn_t
 global_init(void)
 {
@@ -52,6 +65,9 @@ global_init(void)
     uint8_t const *pbastr = (uint8_t const *)"bytearray";
 #endif /* HAVE_BYTEARRAY */
     uint8_t const *pmdstr = (uint8_t const *)"__md";
+#ifdef HAVE_SMALL_INT_CACHE
+    int32_t n;
+#endif /* HAVE_SMALL_INT_CACHE */
 
     /* Clear the global struct */
     sli_memset((uint8_t *)&gVmGlobal, '\0', sizeof(PmVmGlobal_t));
@@ -59,6 +75,23 @@ global_init(void)
     /* Set the PyMite release num (for debug and post mortem) */
     gVmGlobal.errVmRelease = PM_RELEASE;
 
+#ifdef HAVE_TAGGED_INTS
+    /* Zero, one and negone are tagged ints like any other small int */
+    gVmGlobal.pzero = (pPmInt_t)INT_TAG(0);
+    gVmGlobal.pone = (pPmInt_t)INT_TAG(1);
+    gVmGlobal.pnegone = (pPmInt_t)INT_TAG(-1);
+#elif defined(HAVE_SMALL_INT_CACHE)
+    /* Init the small ints, which include zero, one and negone */
+    for (n = INT_CACHE_MIN; n <= INT_CACHE_MAX; n++)
+    {
+        pobj = INT_CACHED(n);
+        OBJ_SET_TYPE_RAW(pobj, OBJ_TYPE_INT);
+        ((pPmInt_t)pobj)->val = n;
+    }
+    gVmGlobal.pzero = (pPmInt_t)INT_CACHED(0);
+    gVmGlobal.pone = (pPmInt_t)INT_CACHED(1);
+    gVmGlobal.pnegone = (pPmInt_t)INT_CACHED(-1);
+#else
     /* Init zero */
     retval = heap_getChunk(sizeof(PmInt_t), &pchunk);
     PM_RETURN_IF_ERROR(retval);
@@ -82,6 +115,7 @@ global_init(void)
     OBJ_SET_TYPE(pobj, OBJ_TYPE_INT);
     ((pPmInt_t)pobj)->val = (int32_t)-1;
     gVmGlobal.pnegone = (pPmInt_t)pobj;
+#endif /* HAVE_TAGGED_INTS */
 
     /* Init False */
     retval = heap_getChunk(sizeof(PmBoolean_t), &pchunk);
@@ -107,45 +141,45 @@ global_init(void)
     gVmGlobal.pnone = pobj;
 
     /* Init "code" string obj */
-    retval = string_new((uint8_t const **)&codestr, &pobj);
+    retval = global_newName(codestr, &pobj);
     PM_RETURN_IF_ERROR(retval);
     gVmGlobal.pcodeStr = (pPmString_t)pobj;
 
 #ifdef HAVE_CLASSES
     /* Init "__init__" string obj */
-    retval = string_new((uint8_t const **)&initstr, &pobj);
+    retval = global_newName(initstr, &pobj);
     PM_RETURN_IF_ERROR(retval);
     gVmGlobal.pinitStr = (pPmString_t)pobj;
 #endif /* HAVE_CLASSES */
 
 #ifdef HAVE_GENERATORS
     /* Init "Generator" string obj */
-    retval = string_new((uint8_t const **)&genstr, &pobj);
+    retval = global_newName(genstr, &pobj);
     PM_RETURN_IF_ERROR(retval);
     gVmGlobal.pgenStr = (pPmString_t)pobj;
     
     /* Init "next" string obj */
-    retval = string_new((uint8_t const **)&nextstr, &pobj);
+    retval = global_newName(nextstr, &pobj);
     PM_RETURN_IF_ERROR(retval);
     gVmGlobal.pnextStr = (pPmString_t)pobj;
 #endif /* HAVE_GENERATORS */
 
 #ifdef HAVE_ASSERT
     /* Init "Exception" string obj */
-    retval = string_new((uint8_t const **)&exnstr, &pobj);
+    retval = global_newName(exnstr, &pobj);
     PM_RETURN_IF_ERROR(retval);
     gVmGlobal.pexnStr = (pPmString_t)pobj;
 #endif /* HAVE_ASSERT */
 
 #ifdef HAVE_BYTEARRAY
     /* Init "bytearray" string obj */
-    retval = string_new((uint8_t const **)&pbastr, &pobj);
+    retval = global_newName(pbastr, &pobj);
     PM_RETURN_IF_ERROR(retval);
     gVmGlobal.pbaStr = (pPmString_t)pobj;
 #endif /* HAVE_BYTEARRAY */
 
     /* Init "__md" string obj */
-    retval = string_new((uint8_t const **)&pmdstr, &pobj);
+    retval = global_newName(pmdstr, &pobj);
     PM_RETURN_IF_ERROR(retval);
     gVmGlobal.pmdStr = (pPmString_t)pobj;
 
@@ -154,7 +188,7 @@ global_init(void)
 
     /* Init native frame */
     gVmGlobal.nativeframe.od = sizeof(PmNativeFrame_t);
-    OBJ_SET_TYPE(&gVmGlobal.nativeframe, OBJ_TYPE_NFM);
+    OBJ_SET_TYPE_RAW(&gVmGlobal.nativeframe, OBJ_TYPE_NFM);
     gVmGlobal.nativeframe.nf_func = C_NULL;
     gVmGlobal.nativeframe.nf_stack = C_NULL;
     gVmGlobal.nativeframe.nf_active = C_FALSE;
@@ -183,7 +217,6 @@ global_setBuiltins(pPmFunc_t pmod)
 {
     PmReturn_t retval = PM_RET_OK;
     pPmObj_t pkey = C_NULL;
-    uint8_t const *pbistr = bistr;
     uint8_t objid;
 
     if (PM_PBUILTINS == C_NULL)
@@ -193,7 +226,7 @@ global_setBuiltins(pPmFunc_t pmod)
     }
 
     /* Put builtins module in the module's attrs dict */
-    retval = string_new(&pbistr, &pkey);
+    retval = global_newName(bistr, &pkey);
     PM_RETURN_IF_ERROR(retval);
 
     heap_gcPushTempRoot(pkey, &objid);
@@ -215,6 +248,7 @@ global_loadBuiltins(void)
     pPmObj_t pstr = C_NULL;
     pPmObj_t pbimod;
     uint8_t const *pbistr = bistr;
+    uint8_t objid;
 
     /* Import the builtins */
     retval = string_new(&pbistr, &pstr);
@@ -222,34 +256,47 @@ global_loadBuiltins(void)
     retval = mod_import(pstr, &pbimod);
     PM_RETURN_IF_ERROR(retval);
 
-    /* Must interpret builtins' root code to set the attrs */
+    /*
+     * Must interpret builtins' root code to set the attrs.
+     * Root the module so a GC can't free it before it is freed below.
+     */
     C_ASSERT(gVmGlobal.threadList->length == 0);
+    heap_gcPushTempRoot(pbimod, &objid);
     interp_addThread((pPmFunc_t)pbimod);
+
+    /*
+     * This function and its callers (global_setBuiltins() and embedders
+     * setting up modules) hold objects in C variables, so objects must
+     * not move while the builtins run
+     */
+    gVmGlobal.interpNesting++;
     retval = interpret(INTERP_RETURN_ON_NO_THREADS);
+    gVmGlobal.interpNesting--;
     PM_RETURN_IF_ERROR(retval);
 
     /* Builtins points to the builtins module's attrs dict */
     gVmGlobal.builtins = ((pPmFunc_t)pbimod)->f_attrs;
 
     /* Set None manually */
-    retval = string_new(&nonestr, &pkey);
+    retval = global_newName(nonestr, &pkey);
     PM_RETURN_IF_ERROR(retval);
     retval = dict_setItem(PM_PBUILTINS, pkey, PM_NONE);
     PM_RETURN_IF_ERROR(retval);
 
     /* Set False manually */
-    retval = string_new(&falsestr, &pkey);
+    retval = global_newName(falsestr, &pkey);
     PM_RETURN_IF_ERROR(retval);
     retval = dict_setItem(PM_PBUILTINS, pkey, PM_FALSE);
     PM_RETURN_IF_ERROR(retval);
 
     /* Set True manually */
-    retval = string_new(&truestr, &pkey);
+    retval = global_newName(truestr, &pkey);
     PM_RETURN_IF_ERROR(retval);
     retval = dict_setItem(PM_PBUILTINS, pkey, PM_TRUE);
     PM_RETURN_IF_ERROR(retval);
 
     /* Deallocate builtins module */
+    heap_gcPopTempRoot(objid);
     retval = heap_freeChunk((pPmObj_t)pbimod);
 
     return retval;
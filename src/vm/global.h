@@ -103,6 +103,11 @@ typedef struct PmVmGlobal_s
     /** The single native frame.  Static alloc so it won't be GC'd */
     PmNativeFrame_t nativeframe;
 
+#ifdef HAVE_SMALL_INT_CACHE
+    /** The small ints.  Static alloc so they are never GC'd or moved */
+    PmInt_t smallInts[INT_CACHE_SIZE];
+#endif /* HAVE_SMALL_INT_CACHE */
+
     /** PyMite release value for when an error occurs */
     uint8_t errVmRelease;
 
@@ -151,6 +156,16 @@ typedef struct PmVmGlobal_s
     uint8_t somethingPrinted;
 #endif /* HAVE_PRINT */
 
+    /**
+     * Number of interpret() runs in progress, plus one for each caller
+     * that holds objects in C variables across a run; objects are only
+     * moved by compaction while it is one
+     */
+    uint8_t interpNesting;
+
+    /** Count of segments unlinked from any seglist, checked by iterators */
+    uint32_t segUnlinks;
+
     /** Flag to trigger rescheduling */
     uint8_t reschedule;
 } PmVmGlobal_t,
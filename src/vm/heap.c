@@ -26,6 +26,135 @@
 /** The size of the temporary roots stack */
 #define HEAP_NUM_TEMP_ROOTS 24
 
+/**
+ * The size of the GC's mark stack.  If the stack overflows, the marker
+ * falls back to rescanning the heap, so this bounds only the C memory used.
+ */
+#define HEAP_MARK_STACK_SIZE 32
+
+/**
+ * The most regions of memory the heap can have: the one given to heap_init()
+ * and those added by heap_addRegion() or by growing the heap.
+ */
+#ifndef HEAP_MAX_REGIONS
+#ifdef HAVE_HEAP_GROW
+#define HEAP_MAX_REGIONS 32
+#else
+#define HEAP_MAX_REGIONS 4
+#endif /* HAVE_HEAP_GROW */
+#endif
+
+#ifdef HAVE_HEAP_GROW
+/**
+ * The heap grows by a region as big as the heap already is, but at least
+ * HEAP_GROW_MIN_SIZE and at most HEAP_GROW_MAX_SIZE bytes (or the request).
+ */
+#ifndef HEAP_GROW_MIN_SIZE
+#define HEAP_GROW_MIN_SIZE 0x100000
+#endif
+#ifndef HEAP_GROW_MAX_SIZE
+#define HEAP_GROW_MAX_SIZE 0x4000000
+#endif
+#endif /* HAVE_HEAP_GROW */
+
+#ifdef HAVE_GC_INCREMENTAL
+/** Incremental GC states */
+#define HEAP_GC_IDLE 0
+#define HEAP_GC_MARK 1
+#define HEAP_GC_SWEEP 2
+#endif /* HAVE_GC_INCREMENTAL */
+
+#ifdef HAVE_GC_COMPACT
+/**
+ * The number of free chunks that one compaction pass slides live objects
+ * over.  A heap with more free chunks is compacted in several passes.
+ */
+#ifndef HEAP_COMPACT_NUM_GAPS
+#define HEAP_COMPACT_NUM_GAPS 32
+#endif
+#endif /* HAVE_GC_COMPACT */
+
+#ifdef HAVE_GC_NURSERY
+/**
+ * The most slots in the nursery.  The nursery is carved from the tail of
+ * the heap; it gets a sixteenth of the heap, up to this many slots.
+ */
+#ifndef HEAP_NURSERY_MAX_SLOTS
+#define HEAP_NURSERY_MAX_SLOTS 512
+#endif
+
+/** The nursery gets (heap size >> HEAP_NURSERY_SHIFT) bytes */
+#define HEAP_NURSERY_SHIFT 4
+
+/**
+ * Heaps smaller than this get no nursery; they are too tight to give up
+ * a fixed region to young objects.
+ */
+#ifndef HEAP_NURSERY_MIN_HEAP_SIZE
+#define HEAP_NURSERY_MIN_HEAP_SIZE 0x4000
+#endif
+
+/** The size of a nursery slot; large enough for an int or a float */
+#define HEAP_NURSERY_SLOT_SIZE 8
+
+/**
+ * The size of the remembered set.  If it overflows, the minor GC falls back
+ * to scanning every chunk in the heap for references into the nursery.
+ */
+#define HEAP_REMSET_SIZE 32
+
+/** Evaluates to non-zero if the pointer is within the nursery */
+#define HEAP_IN_NURSERY(pobj) \
+    (((uint8_t *)(pobj) >= pmHeap.nursery) \
+     && ((uint8_t *)(pobj) < &pmHeap.nursery[pmHeap.nursery_slots \
+                                            * HEAP_NURSERY_SLOT_SIZE]))
+
+/** Gets the index of the nursery slot at the pointer */
+#define HEAP_NURSERY_INDEX(pobj) \
+    ((uint16_t)(((uint8_t *)(pobj) - pmHeap.nursery) / HEAP_NURSERY_SLOT_SIZE))
+
+/** Tests, sets and clears bit i of a nursery bitmap */
+#define NURSERY_GET_BIT(map, i) ((map)[(i) >> 3] & (1 << ((i) & 7)))
+#define NURSERY_SET_BIT(map, i) ((map)[(i) >> 3] |= (uint8_t)(1 << ((i) & 7)))
+#define NURSERY_CLR_BIT(map, i) ((map)[(i) >> 3] &= (uint8_t)~(1 << ((i) & 7)))
+#endif /* HAVE_GC_NURSERY */
+
+#ifdef HAVE_HEAP_POOLS
+/**
+ * The most slots in each pool.  The pools are carved from the tail of the
+ * heap; together they get a sixteenth of the heap, up to this many slots
+ * each.  Usually set in pmfeatures.py.
+ */
+#ifndef HEAP_POOL_SLOTS
+#define HEAP_POOL_SLOTS 32
+#endif
+
+/** The pools get (heap size >> HEAP_POOL_SHIFT) bytes */
+#define HEAP_POOL_SHIFT 4
+
+/** Heaps smaller than this get no pools */
+#ifndef HEAP_POOL_MIN_HEAP_SIZE
+#define HEAP_POOL_MIN_HEAP_SIZE 0x4000
+#endif
+
+/**
+ * The number of pools: segments and sequence iterators, plus
+ * ints and floats unless the nursery holds them
+ */
+#if defined(HAVE_GC_NURSERY)
+#define HEAP_NUM_POOLS 2
+#elif defined(HAVE_FLOAT)
+#define HEAP_NUM_POOLS 4
+#else
+#define HEAP_NUM_POOLS 3
+#endif
+
+/** Evaluates to non-zero if the pointer is within a pool */
+#define HEAP_IN_POOLS(pobj) \
+    (((uint8_t *)(pobj) >= pmHeap.pools[0].base) \
+     && ((uint8_t *)(pobj) < pmHeap.pools[HEAP_NUM_POOLS - 1].end))
+#endif /* HAVE_HEAP_POOLS */
+
 /**
  * The maximum size a live chunk can be (a live chunk is one that is in use).
  * The live chunk size is determined by the size field in the *object*
@@ -57,6 +186,39 @@
 #endif
 #endif
 
+/**
+ * Chunk sizes are multiples of the heap granule (the platform pointer
+ * alignment), so the small bins are indexed by size >> HEAP_GRANULE_SHIFT.
+ */
+#ifdef PM_PLAT_POINTER_SIZE
+#if PM_PLAT_POINTER_SIZE == 8
+#define HEAP_GRANULE_SHIFT 3
+#else
+#define HEAP_GRANULE_SHIFT 2
+#endif
+#else
+#define HEAP_GRANULE_SHIFT 2
+#endif
+
+/**
+ * The number of exact-fit bins for small free chunks.
+ * Bin i holds free chunks of size (i << HEAP_GRANULE_SHIFT).
+ */
+#define HEAP_NUM_SMALL_BINS 32
+
+/** The smallest chunk size that goes in a large bin (log base 2) */
+#define HEAP_LARGE_BIN_MIN_LOG2 (5 + HEAP_GRANULE_SHIFT)
+
+/**
+ * The number of large bins.  Large bin i holds free chunks whose size is in
+ * [2**(i + HEAP_LARGE_BIN_MIN_LOG2), 2**(i + HEAP_LARGE_BIN_MIN_LOG2 + 1)),
+ * up to the 16-bit maximum free chunk size.
+ */
+#define HEAP_NUM_LARGE_BINS (16 - HEAP_LARGE_BIN_MIN_LOG2)
+
+/** The total number of free list bins */
+#define HEAP_NUM_BINS (HEAP_NUM_SMALL_BINS + HEAP_NUM_LARGE_BINS)
+
 /** The minimum size a chunk can be
  * (rounded up to a multiple of platform-pointer-size) */
 #ifdef PM_PLAT_POINTER_SIZE
@@ -150,20 +312,155 @@ typedef struct PmHeapDesc_s
 } PmHeapDesc_t,
  *pPmHeapDesc_t;
 
-typedef struct PmHeap_s
+/**
+ * The descriptor at the head of a large chunk, one that holds an object
+ * bigger than HEAP_MAX_LIVE_CHUNK_SIZE.  The object's own descriptor has
+ * no room for its size, so the object follows this descriptor:
+ * @verbatim
+ *      pchunk-> +---------------+     ld: zero except the free bit (clear);
+ *               |      ld       |         a size of zero marks a large chunk
+ *               +---------------+
+ *               |    ld_size    |     ld_size: size of the whole chunk
+ *               +---------------+
+ *               | (pad)         |
+ *        pobj-> +---------------+     the object's od has a size of zero
+ *               | object        |
+ *               ...           ...
+ * @endverbatim
+ * A large chunk comes from and returns to the free list like any other,
+ * and a free large chunk has an ordinary heap descriptor.
+ */
+typedef struct PmLargeDesc_s
+{
+    /** Object descriptor with a size of zero */
+    uint16_t ld;
+
+    /** Size of the chunk in bytes */
+    uint16_t ld_size;
+} PmLargeDesc_t,
+ *pPmLargeDesc_t;
+
+/** The size of a large chunk's descriptor, rounded up to the granule */
+#define HEAP_LARGE_DESC_SIZE \
+    ((((sizeof(PmLargeDesc_t) - 1) >> HEAP_GRANULE_SHIFT) + 1) \
+     << HEAP_GRANULE_SHIFT)
+
+/** The biggest object that fits in a large chunk */
+#define HEAP_MAX_LARGE_OBJ_SIZE \
+    (HEAP_MAX_FREE_CHUNK_SIZE - HEAP_LARGE_DESC_SIZE)
+
+/**
+ * Evaluates to non-zero if the chunk, or the object, is large.
+ * Only a large chunk's descriptor or large object's od has a size of zero.
+ */
+#define HEAP_IS_LARGE(p) \
+    (!OBJ_GET_FREE(p) && (PM_OBJ_GET_SIZE(p) == 0))
+
+/** Gets the object held in a chunk that is in use */
+#define HEAP_CHUNK_OBJ(pchunk) \
+    ((pPmObj_t)(HEAP_IS_LARGE(pchunk) \
+                ? (uint8_t *)(pchunk) + HEAP_LARGE_DESC_SIZE \
+                : (uint8_t *)(pchunk)))
+
+/** Gets the chunk that holds a large object */
+#define HEAP_LARGE_CHUNK(pobj) \
+    ((pPmLargeDesc_t)((uint8_t *)(pobj) - HEAP_LARGE_DESC_SIZE))
+
+#ifdef HAVE_HEAP_POOLS
+/** A free pool slot, linked to the next free slot of its pool */
+typedef struct PmPoolSlot_s
+{
+    /** Object descriptor with the free bit set */
+    PmObjDesc_t od;
+
+    /** Next free slot in the pool */
+    struct PmPoolSlot_s *next;
+} PmPoolSlot_t,
+ *pPmPoolSlot_t;
+
+/** A slab of fixed-size slots for the objects of one type */
+typedef struct PmPool_s
+{
+    /** First slot of the pool */
+    uint8_t *base;
+
+    /** End of the last slot of the pool */
+    uint8_t *end;
+
+    /** Free slots, most recently freed first */
+    pPmPoolSlot_t free;
+
+    /** Size of a slot in bytes */
+    uint16_t slotsize;
+
+    /** Type of the objects in the pool */
+    PmType_t type;
+} PmPool_t,
+ *pPmPool_t;
+#endif /* HAVE_HEAP_POOLS */
+
+#ifdef HAVE_GC
+/** Evaluates to non-zero if part of the heap is still to be swept */
+#define HEAP_SWEEP_PENDING() (pmHeap.sweep_region < pmHeap.nregions)
+#endif /* HAVE_GC */
+
+/** A contiguous region of memory that is part of the heap */
+typedef struct PmHeapRegion_s
 {
-    /** Pointer to base of heap.  Set at initialization of VM */
+    /** Pointer to the first chunk of the region */
     uint8_t *base;
 
-    /** Size of the heap.  Set at initialization of VM */
+    /** Size of the region in bytes */
+    uint32_t size;
+} PmHeapRegion_t,
+ *pPmHeapRegion_t;
+
+typedef struct PmHeap_s
+{
+    /**
+     * The regions of memory whose chunks make up the heap.  The first is
+     * the one given to heap_init(); the others may be anywhere.
+     */
+    PmHeapRegion_t regions[HEAP_MAX_REGIONS];
+
+    /** Number of regions in the heap */
+    uint8_t nregions;
+
+    /** Total size of the heap's regions */
     uint32_t size;
 
-    /** Ptr to list of free chunks; sorted smallest to largest. */
-    pPmHeapDesc_t pfreelist;
+    /**
+     * Segregated free lists.  The small bins hold chunks of one size each;
+     * each large bin holds a power-of-two range of sizes sorted smallest
+     * to largest.  Together they allow best-fit without a full list scan.
+     */
+    pPmHeapDesc_t bins[HEAP_NUM_BINS];
+
+    /** Bitmap of the non-empty small bins */
+    uint32_t smallmap;
+
+    /** Bitmap of the non-empty large bins */
+    uint16_t largemap;
 
     /** The amount of heap space available in free list */
     uint32_t avail;
 
+#ifdef HAVE_HEAP_POOLS
+    /** Pools of fixed-size objects, contiguous and in address order */
+    PmPool_t pools[HEAP_NUM_POOLS];
+#endif /* HAVE_HEAP_POOLS */
+
+#ifdef HAVE_HEAP_STATS
+    /** Number of chunks allocated */
+    uint32_t allocs;
+
+    /** Bytes allocated */
+    uint32_t allocbytes;
+
+    /** Number of objects created of each type */
+    uint32_t typecount[HEAP_NUM_TYPES];
+#endif /* HAVE_HEAP_STATS */
+
 #ifdef HAVE_GC
     /** Garbage collection mark value */
     uint8_t gcval;
@@ -176,6 +473,108 @@ typedef struct PmHeap_s
     pPmObj_t temp_roots[HEAP_NUM_TEMP_ROOTS];
 
     uint8_t temp_root_index;
+
+    /** Stack of marked objects whose references are not yet marked */
+    pPmObj_t mark_stack[HEAP_MARK_STACK_SIZE];
+
+    uint8_t mark_stack_index;
+
+    /** Set if an object could not be pushed because the mark stack was full */
+    uint8_t mark_overflow;
+
+    /** The chunk where the sweep resumes */
+    pPmObj_t sweep_ptr;
+
+    /** The region of the chunk where the sweep resumes */
+    uint8_t sweep_region;
+
+    /** Objects marked plus chunks swept during the current GC pause */
+    uint32_t gc_work;
+
+    /** The most work done in any one GC pause */
+    uint32_t gc_maxpausework;
+
+    /** The longest GC pause in milliseconds */
+    uint32_t gc_maxpausems;
+
+    /** Number of full collections (sweeps of the whole heap) */
+    uint32_t gc_fullcount;
+
+    /** Milliseconds spent in GC pauses */
+    uint32_t gc_totalms;
+
+    /** Bytes of garbage reclaimed by the GC */
+    uint32_t gc_reclaimed;
+
+#ifdef HAVE_GC_LAZY_SWEEP
+    /** Bytes in the chunks marked by the current collection */
+    uint32_t gc_live;
+
+    /** Bytes of garbage that the sweep has not yet reclaimed */
+    uint32_t gc_garbage;
+#endif /* HAVE_GC_LAZY_SWEEP */
+
+#ifdef HAVE_GC_INCREMENTAL
+    /** Incremental GC state: idle, marking or sweeping */
+    uint8_t gc_state;
+
+    /** Number of objects marked or chunks swept per incremental step */
+    uint16_t gc_budget;
+#endif /* HAVE_GC_INCREMENTAL */
+
+#ifdef HAVE_GC_NURSERY
+    /** Base of the nursery of ints and floats; C_NULL if the heap is small */
+    uint8_t *nursery;
+
+    /** Number of slots in the nursery */
+    uint16_t nursery_slots;
+
+    /** Index of the slot where the bump allocator resumes */
+    uint16_t nursery_next;
+
+    /** Set when minor GCs stop freeing slots; cleared by a full GC */
+    uint8_t nursery_full;
+
+    /** Bitmap of the nursery slots that are in use */
+    uint8_t nursery_used[HEAP_NURSERY_MAX_SLOTS / 8];
+
+    /**
+     * Bitmap of the nursery slots that survived a collection.
+     * A slot that is in use but not old holds a young object.
+     */
+    uint8_t nursery_old[HEAP_NURSERY_MAX_SLOTS / 8];
+
+    /** Objects outside the nursery that may reference young objects */
+    pPmObj_t remset[HEAP_REMSET_SIZE];
+
+    uint8_t remset_index;
+
+    /** Set if an object could not be remembered because the set was full */
+    uint8_t remset_overflow;
+
+    /** Number of minor collections */
+    uint32_t gc_minorcount;
+#endif /* HAVE_GC_NURSERY */
+
+#ifdef HAVE_GC_COMPACT
+    /** The free chunks of the current compaction pass, in address order */
+    uint8_t *compact_gap[HEAP_COMPACT_NUM_GAPS];
+
+    /** Total size of gaps 0 to i; how far a live chunk after gap i slides */
+    uint32_t compact_shift[HEAP_COMPACT_NUM_GAPS];
+
+    /** Number of gaps in the current compaction pass */
+    uint8_t compact_ngaps;
+
+    /** End of the current pass's region; chunks at or past it do not move */
+    uint8_t *compact_end;
+
+    /** Largest free chunk size under which the heap is auto-compacted */
+    uint16_t compact_threshold;
+
+    /** Number of compactions */
+    uint32_t gc_compactcount;
+#endif /* HAVE_GC_COMPACT */
 #endif                          /* HAVE_GC */
 
 } PmHeap_t,
@@ -190,15 +589,20 @@ static PmHeap_t pmHeap PM_PLAT_HEAP_ATTR;
 static void
 heap_gcPrintFreelist(void)
 {
-    pPmHeapDesc_t pchunk = pmHeap.pfreelist;
+    pPmHeapDesc_t pchunk;
+    uint8_t bin;
 
     printf("DEBUG: pmHeap.avail = %d\n", pmHeap.avail);
     printf("DEBUG: freelist:\n");
-    while (pchunk != C_NULL)
+    for (bin = 0; bin < HEAP_NUM_BINS; bin++)
     {
-        printf("DEBUG:     free chunk (%d bytes) @ 0x%0x\n",
-               CHUNK_GET_SIZE(pchunk), (int)pchunk);
-        pchunk = pchunk->next;
+        pchunk = pmHeap.bins[bin];
+        while (pchunk != C_NULL)
+        {
+            printf("DEBUG:     bin %d free chunk (%d bytes) @ 0x%0x\n",
+                   bin, CHUNK_GET_SIZE(pchunk), (int)pchunk);
+            pchunk = pchunk->next;
+        }
     }
 }
 #endif
@@ -245,6 +649,12 @@ heap_dump(void)
 #endif
 #ifdef HAVE_CLASSES
     s |= 1<<3;
+#endif
+#ifdef HAVE_FRAME_STACK
+    s |= 1<<4;
+#endif
+#ifdef HAVE_HASHED_DICTS
+    s |= 1<<5;
 #endif
     fwrite(&s, sizeof(uint16_t), 1, fp);
 
@@ -252,10 +662,10 @@ heap_dump(void)
     fwrite(&pmHeap.size, sizeof(uint32_t), 1, fp);
 
     /* Write base address of heap */
-    fwrite((void*)&pmHeap.base, sizeof(intptr_t), 1, fp);
+    fwrite((void*)&pmHeap.regions[0].base, sizeof(intptr_t), 1, fp);
 
     /* Write contents of heap */
-    fwrite(pmHeap.base, 1, pmHeap.size, fp);
+    fwrite(pmHeap.regions[0].base, 1, pmHeap.regions[0].size, fp);
 
     /* Write num roots*/
     i = 10;
@@ -277,10 +687,114 @@ heap_dump(void)
 #endif
 
 
-/* Removes the given chunk from the free list; leaves list in sorted order */
+/* Returns the index of the free list bin that holds chunks of the given size */
+static uint8_t
+heap_getBinIndex(uint16_t size)
+{
+    uint8_t bin;
+
+    if ((size >> HEAP_GRANULE_SHIFT) < HEAP_NUM_SMALL_BINS)
+    {
+        return (uint8_t)(size >> HEAP_GRANULE_SHIFT);
+    }
+
+    /* Large bins are indexed by the position of the size's msb */
+    size >>= HEAP_LARGE_BIN_MIN_LOG2;
+    for (bin = HEAP_NUM_SMALL_BINS; size > 1; bin++)
+    {
+        size >>= 1;
+    }
+    return bin;
+}
+
+
+/* Returns the index of the lowest set bit in the (non-zero) map */
+static uint8_t
+heap_getLowestBit(uint32_t map)
+{
+#ifdef __GNUC__
+    return (uint8_t)__builtin_ctzl((unsigned long)map);
+#else
+    uint8_t i = 0;
+
+    while ((map & 1) == 0)
+    {
+        map >>= 1;
+        i++;
+    }
+    return i;
+#endif /* __GNUC__ */
+}
+
+
+/*
+ * Returns the index of the first non-empty bin at or above the given bin,
+ * or HEAP_NUM_BINS if there is none.
+ */
+static uint8_t
+heap_findNonEmptyBin(uint8_t bin)
+{
+    uint32_t map;
+
+    if (bin < HEAP_NUM_SMALL_BINS)
+    {
+        map = pmHeap.smallmap & ~(((uint32_t)1 << bin) - 1);
+        if (map != 0)
+        {
+            return heap_getLowestBit(map);
+        }
+        bin = HEAP_NUM_SMALL_BINS;
+    }
+
+    if (bin < HEAP_NUM_BINS)
+    {
+        map = pmHeap.largemap
+              & ~(((uint32_t)1 << (bin - HEAP_NUM_SMALL_BINS)) - 1);
+        if (map != 0)
+        {
+            return HEAP_NUM_SMALL_BINS + heap_getLowestBit(map);
+        }
+    }
+
+    return HEAP_NUM_BINS;
+}
+
+
+/* Sets or clears the bin's bit in the non-empty bitmaps */
+static void
+heap_setBinMapBit(uint8_t bin, uint8_t nonempty)
+{
+    if (bin < HEAP_NUM_SMALL_BINS)
+    {
+        if (nonempty)
+        {
+            pmHeap.smallmap |= (uint32_t)1 << bin;
+        }
+        else
+        {
+            pmHeap.smallmap &= ~((uint32_t)1 << bin);
+        }
+    }
+    else
+    {
+        if (nonempty)
+        {
+            pmHeap.largemap |= (uint16_t)(1 << (bin - HEAP_NUM_SMALL_BINS));
+        }
+        else
+        {
+            pmHeap.largemap &= ~(uint16_t)(1 << (bin - HEAP_NUM_SMALL_BINS));
+        }
+    }
+}
+
+
+/* Removes the given chunk from its free list bin; leaves bin in sorted order */
 static PmReturn_t
 heap_unlinkFromFreelist(pPmHeapDesc_t pchunk)
 {
+    uint8_t bin;
+
     C_ASSERT(pchunk != C_NULL);
 
     pmHeap.avail -= CHUNK_GET_SIZE(pchunk);
@@ -290,10 +804,15 @@ heap_unlinkFromFreelist(pPmHeapDesc_t pchunk)
         pchunk->next->prev = pchunk->prev;
     }
 
-    /* If pchunk was the first chunk in the free list, update the heap ptr */
+    /* If pchunk was the first chunk in its bin, update the bin's head */
     if (pchunk->prev == C_NULL)
     {
-        pmHeap.pfreelist = pchunk->next;
+        bin = heap_getBinIndex(CHUNK_GET_SIZE(pchunk));
+        pmHeap.bins[bin] = pchunk->next;
+        if (pchunk->next == C_NULL)
+        {
+            heap_setBinMapBit(bin, C_FALSE);
+        }
     }
     else
     {
@@ -304,108 +823,116 @@ heap_unlinkFromFreelist(pPmHeapDesc_t pchunk)
 }
 
 
-/* Inserts in order a chunk into the free list.  Caller adjusts heap state */
+/* Inserts in order a chunk into its free list bin.  Caller adjusts heap state */
 static PmReturn_t
 heap_linkToFreelist(pPmHeapDesc_t pchunk)
 {
     uint16_t size;
+    uint8_t bin;
     pPmHeapDesc_t pscan;
 
     /* Ensure the object is already free */
     C_ASSERT(OBJ_GET_FREE(pchunk) != 0);
 
-    pmHeap.avail += CHUNK_GET_SIZE(pchunk);
+    size = CHUNK_GET_SIZE(pchunk);
+    pmHeap.avail += size;
+    bin = heap_getBinIndex(size);
+    pscan = pmHeap.bins[bin];
 
-    /* If free list is empty, add to head of list */
-    if (pmHeap.pfreelist == C_NULL)
+    /*
+     * Add to head of bin if the bin is empty, if it is a small bin
+     * (all chunks are the same size) or if the chunk is the smallest in the bin
+     */
+    if ((pscan == C_NULL)
+        || (bin < HEAP_NUM_SMALL_BINS)
+        || (size <= CHUNK_GET_SIZE(pscan)))
     {
-        pmHeap.pfreelist = pchunk;
-        pchunk->next = C_NULL;
         pchunk->prev = C_NULL;
+        pchunk->next = pscan;
+        if (pscan == C_NULL)
+        {
+            heap_setBinMapBit(bin, C_TRUE);
+        }
+        else
+        {
+            pscan->prev = pchunk;
+        }
+        pmHeap.bins[bin] = pchunk;
 
         return PM_RET_OK;
     }
 
-    /* Scan free list for insertion point */
-    pscan = pmHeap.pfreelist;
-    size = CHUNK_GET_SIZE(pchunk);
-    while ((CHUNK_GET_SIZE(pscan) < size) && (pscan->next != C_NULL))
+    /* Scan large bin for insertion point; insert chunk after the scan chunk */
+    while ((pscan->next != C_NULL) && (CHUNK_GET_SIZE(pscan->next) < size))
     {
         pscan = pscan->next;
     }
-
-    /*
-     * Insert chunk after the scan chunk (next is NULL).
-     * This is a slightly rare case where the last chunk in the free list
-     * is smaller than the chunk being freed.
-     */
-    if (size > CHUNK_GET_SIZE(pscan))
+    pchunk->next = pscan->next;
+    pchunk->prev = pscan;
+    if (pscan->next != C_NULL)
     {
-        pchunk->next = pscan->next;
-        pscan->next = pchunk;
-        pchunk->prev = pscan;
+        pscan->next->prev = pchunk;
     }
+    pscan->next = pchunk;
 
-    /* Insert chunk before the scan chunk */
-    else
+    return PM_RET_OK;
+}
+
+
+/* Returns the size of the chunk, whether it is free, in use or large */
+static uint16_t
+heap_getChunkSize(pPmObj_t pchunk)
+{
+    if (OBJ_GET_FREE(pchunk))
     {
-        pchunk->next = pscan;
-        pchunk->prev = pscan->prev;
+        return CHUNK_GET_SIZE(pchunk);
+    }
+    if (PM_OBJ_GET_SIZE(pchunk) == 0)
+    {
+        return ((pPmLargeDesc_t)pchunk)->ld_size;
+    }
+    return PM_OBJ_GET_SIZE(pchunk);
+}
 
-        /* If chunk will be first item in free list */
-        if (pscan->prev == C_NULL)
-        {
-            pmHeap.pfreelist = pchunk;
-        }
-        else
+
+/* Returns the index of the region that holds the pointer; nregions if none */
+static uint8_t
+heap_getRegion(void const *p)
+{
+    uint8_t r;
+
+    for (r = 0; r < pmHeap.nregions; r++)
+    {
+        if (((uint8_t *)p >= pmHeap.regions[r].base)
+            && ((uint8_t *)p
+                < &pmHeap.regions[r].base[pmHeap.regions[r].size]))
         {
-            pscan->prev->next = pchunk;
+            break;
         }
-        pscan->prev = pchunk;
     }
-
-    return PM_RET_OK;
+    return r;
 }
 
 
-PmReturn_t
-heap_init(uint8_t *base, uint32_t size)
+/* Puts all of the given region in the free list */
+static void
+heap_linkRegion(pPmHeapRegion_t pregion)
 {
     pPmHeapDesc_t pchunk;
     uint32_t hs;
-    uint8_t *adjbase;
 
-    /* Round-up Heap base by the size of the platform pointer */
-    adjbase = base + ((sizeof(intptr_t) - 1) & ~(sizeof(intptr_t) - 1));
-    pmHeap.base = adjbase;
-    pmHeap.size = size - (adjbase - base);
+    pchunk = (pPmHeapDesc_t)pregion->base;
+    hs = pregion->size;
 
-#ifdef __DEBUG__
-    /* Fill the heap with a non-NULL value to bring out any heap bugs. */
-    sli_memset(pmHeap.base, 0xAA, pmHeap.size);
-#endif
-
-    /* Init heap globals */
-    pmHeap.pfreelist = C_NULL;
-    pmHeap.avail = 0;
-#ifdef HAVE_GC
-    pmHeap.gcval = (uint8_t)0;
-    pmHeap.temp_root_index = (uint8_t)0;
-    heap_gcSetAuto(C_TRUE);
-#endif /* HAVE_GC */
-
-    pchunk = (pPmHeapDesc_t)pmHeap.base;
-    hs = pmHeap.size;
-
-    /* #180 Proactively link memory previously lost/neglected at tail of heap */
-    if ((hs % HEAP_MAX_FREE_CHUNK_SIZE) < HEAP_MIN_CHUNK_SIZE)
-    {
-        OBJ_SET_FREE(pchunk, 1);
-        CHUNK_SET_SIZE(pchunk, HEAP_MIN_CHUNK_SIZE);
-        heap_linkToFreelist(pchunk);
-        hs -= HEAP_MIN_CHUNK_SIZE;
-        pchunk = (pPmHeapDesc_t)((uint8_t *)pchunk + HEAP_MIN_CHUNK_SIZE);
-    }
+    /* #180 Proactively link memory previously lost/neglected at tail of heap */
+    if ((hs % HEAP_MAX_FREE_CHUNK_SIZE) < HEAP_MIN_CHUNK_SIZE)
+    {
+        OBJ_SET_FREE(pchunk, 1);
+        CHUNK_SET_SIZE(pchunk, HEAP_MIN_CHUNK_SIZE);
+        heap_linkToFreelist(pchunk);
+        hs -= HEAP_MIN_CHUNK_SIZE;
+        pchunk = (pPmHeapDesc_t)((uint8_t *)pchunk + HEAP_MIN_CHUNK_SIZE);
+    }
 
     /* Create as many max-sized chunks as possible in the freelist */
     for (;
@@ -420,15 +947,272 @@ heap_init(uint8_t *base, uint32_t size)
     /* Add any leftover memory to the freelist */
     if (hs >= HEAP_MIN_CHUNK_SIZE)
     {
-        /* Round down to a multiple of four */
-        hs = hs & ~3;
         OBJ_SET_FREE(pchunk, 1);
         CHUNK_SET_SIZE(pchunk, hs);
         heap_linkToFreelist(pchunk);
     }
+}
+
+
+#ifdef HAVE_GC_LAZY_SWEEP
+/* Returns the size of the chunk that holds the object; zero if not in heap */
+static uint16_t
+heap_gcObjChunkSize(pPmObj_t pobj)
+{
+    if (heap_getRegion(pobj) == pmHeap.nregions)
+    {
+        return 0;
+    }
+    if (HEAP_IS_LARGE(pobj))
+    {
+        return HEAP_LARGE_CHUNK(pobj)->ld_size;
+    }
+    return PM_OBJ_GET_SIZE(pobj);
+}
+
+
+/* Returns true if the object is in a part of the heap not yet swept */
+static uint8_t
+heap_gcIsUnswept(pPmObj_t pobj)
+{
+    uint8_t r;
+
+    r = heap_getRegion(pobj);
+    return (r < pmHeap.nregions)
+           && ((r > pmHeap.sweep_region)
+               || ((r == pmHeap.sweep_region)
+                   && ((uint8_t *)pobj >= (uint8_t *)pmHeap.sweep_ptr)));
+}
+
+
+static PmReturn_t heap_gcSweepChunks(uint32_t budget, uint16_t size);
+#endif /* HAVE_GC_LAZY_SWEEP */
+
+
+#ifdef HAVE_HEAP_POOLS
+/* The type of object that each pool holds */
+static PmType_t const heap_poolTypes[HEAP_NUM_POOLS] = {
+    OBJ_TYPE_SEG,
+    OBJ_TYPE_SQI,
+#ifndef HAVE_GC_NURSERY
+    OBJ_TYPE_INT,
+#ifdef HAVE_FLOAT
+    OBJ_TYPE_FLT,
+#endif /* HAVE_FLOAT */
+#endif /* !HAVE_GC_NURSERY */
+};
+
+/* The size of the object that each pool holds */
+static uint16_t const heap_poolObjSizes[HEAP_NUM_POOLS] = {
+    sizeof(Segment_t),
+    sizeof(PmSeqIter_t),
+#ifndef HAVE_GC_NURSERY
+    sizeof(PmInt_t),
+#ifdef HAVE_FLOAT
+    sizeof(PmFloat_t),
+#endif /* HAVE_FLOAT */
+#endif /* !HAVE_GC_NURSERY */
+};
+
+
+/* Puts the pool slot at the head of its pool's free list */
+static void
+heap_poolFreeSlot(pPmObj_t pobj)
+{
+    pPmPool_t ppool = pmHeap.pools;
+
+    while ((uint8_t *)pobj >= ppool->end)
+    {
+        ppool++;
+    }
+    pobj->od = 0;
+    OBJ_SET_FREE(pobj, 1);
+    ((pPmPoolSlot_t)pobj)->next = ppool->free;
+    ppool->free = (pPmPoolSlot_t)pobj;
+}
+
+
+/*
+ * Carves the pools from the tail of the heap, all with the same number of
+ * slots, and puts every slot in its pool's free list
+ */
+static void
+heap_poolInit(void)
+{
+    uint32_t total = 0;
+    uint32_t nslots;
+    uint16_t size;
+    uint8_t *pslot;
+    uint8_t i;
+
+    for (i = 0; i < HEAP_NUM_POOLS; i++)
+    {
+        size = heap_poolObjSizes[i];
+        if (size < sizeof(PmPoolSlot_t))
+        {
+            size = sizeof(PmPoolSlot_t);
+        }
+        size = (((size - 1) >> HEAP_GRANULE_SHIFT) + 1) << HEAP_GRANULE_SHIFT;
+        pmHeap.pools[i].slotsize = size;
+        pmHeap.pools[i].type = heap_poolTypes[i];
+        total += size;
+    }
+
+    nslots = (pmHeap.size >> HEAP_POOL_SHIFT) / total;
+    if (pmHeap.size < HEAP_POOL_MIN_HEAP_SIZE)
+    {
+        nslots = 0;
+    }
+    else if (nslots > HEAP_POOL_SLOTS)
+    {
+        nslots = HEAP_POOL_SLOTS;
+    }
+    pmHeap.size -= nslots * total;
+
+    pslot = &pmHeap.regions[0].base[pmHeap.size];
+    for (i = 0; i < HEAP_NUM_POOLS; i++)
+    {
+        pmHeap.pools[i].base = pslot;
+        pmHeap.pools[i].end = pslot + nslots * pmHeap.pools[i].slotsize;
+        pmHeap.pools[i].free = C_NULL;
+
+        /* Free the slots last to first so the free list is in address order */
+        for (pslot = pmHeap.pools[i].end; pslot > pmHeap.pools[i].base;)
+        {
+            pslot -= pmHeap.pools[i].slotsize;
+            heap_poolFreeSlot((pPmObj_t)pslot);
+        }
+        pslot = pmHeap.pools[i].end;
+    }
+}
+
+
+/*
+ * Returns the first pool object in use after the given one,
+ * or the first one of all if pobj is C_NULL.  Returns C_NULL after the last.
+ */
+static pPmObj_t
+heap_poolNextObj(pPmObj_t pobj)
+{
+    uint8_t *pslot = (uint8_t *)pobj;
+    pPmPool_t ppool;
+
+    for (ppool = pmHeap.pools; ppool < &pmHeap.pools[HEAP_NUM_POOLS]; ppool++)
+    {
+        if ((pslot != C_NULL) && (pslot >= ppool->end))
+        {
+            continue;
+        }
+        pslot = (pslot == C_NULL) ? ppool->base : pslot + ppool->slotsize;
+        for (; pslot < ppool->end; pslot += ppool->slotsize)
+        {
+            if (!OBJ_GET_FREE(pslot))
+            {
+                return (pPmObj_t)pslot;
+            }
+        }
+        pslot = C_NULL;
+    }
+    return C_NULL;
+}
+#endif /* HAVE_HEAP_POOLS */
+
+
+PmReturn_t
+heap_init(uint8_t *base, uint32_t size)
+{
+#ifdef HAVE_GC_NURSERY
+    uint32_t hs;
+#endif /* HAVE_GC_NURSERY */
+    uint8_t *adjbase;
+
+    /* Round-up Heap base by the size of the platform pointer */
+    adjbase = base + ((sizeof(intptr_t) - 1) & ~(sizeof(intptr_t) - 1));
+    pmHeap.nregions = 1;
+    pmHeap.regions[0].base = adjbase;
+    pmHeap.size = size - (adjbase - base);
+
+    /* Round down the heap size so no partial granule is left at the tail */
+    pmHeap.size &= ~(uint32_t)((1 << HEAP_GRANULE_SHIFT) - 1);
+
+#ifdef HAVE_GC_NURSERY
+    /* Carve the nursery from the tail of the heap, in whole bitmap bytes */
+    hs = (pmHeap.size >> HEAP_NURSERY_SHIFT) / HEAP_NURSERY_SLOT_SIZE;
+    if (pmHeap.size < HEAP_NURSERY_MIN_HEAP_SIZE)
+    {
+        hs = 0;
+    }
+    else if (hs > HEAP_NURSERY_MAX_SLOTS)
+    {
+        hs = HEAP_NURSERY_MAX_SLOTS;
+    }
+    pmHeap.nursery_slots = (uint16_t)(hs & ~7);
+    pmHeap.size -= (uint32_t)pmHeap.nursery_slots * HEAP_NURSERY_SLOT_SIZE;
+    pmHeap.nursery = (pmHeap.nursery_slots > 0)
+                     ? &adjbase[pmHeap.size] : C_NULL;
+    pmHeap.nursery_next = 0;
+    pmHeap.nursery_full = C_FALSE;
+    sli_memset(pmHeap.nursery_used, 0, sizeof(pmHeap.nursery_used));
+    sli_memset(pmHeap.nursery_old, 0, sizeof(pmHeap.nursery_old));
+    pmHeap.remset_index = 0;
+    pmHeap.remset_overflow = C_FALSE;
+    pmHeap.gc_minorcount = 0;
+#endif /* HAVE_GC_NURSERY */
+
+#ifdef HAVE_HEAP_POOLS
+    heap_poolInit();
+#endif /* HAVE_HEAP_POOLS */
+
+    /* What is left is the heap's first region */
+    pmHeap.regions[0].size = pmHeap.size;
+
+#ifdef __DEBUG__
+    /* Fill the heap with a non-NULL value to bring out any heap bugs. */
+    sli_memset(adjbase, 0xAA, pmHeap.size);
+#endif
+
+    /* Init heap globals */
+    sli_memset((unsigned char *)pmHeap.bins, 0, sizeof(pmHeap.bins));
+    pmHeap.smallmap = 0;
+    pmHeap.largemap = 0;
+    pmHeap.avail = 0;
+#ifdef HAVE_HEAP_STATS
+    pmHeap.allocs = 0;
+    pmHeap.allocbytes = 0;
+    sli_memset((unsigned char *)pmHeap.typecount, 0,
+               sizeof(pmHeap.typecount));
+#endif /* HAVE_HEAP_STATS */
+#ifdef HAVE_GC
+    pmHeap.gcval = (uint8_t)0;
+    pmHeap.temp_root_index = (uint8_t)0;
+    pmHeap.mark_stack_index = (uint8_t)0;
+    pmHeap.mark_overflow = C_FALSE;
+    pmHeap.gc_maxpausework = 0;
+    pmHeap.gc_maxpausems = 0;
+    pmHeap.gc_fullcount = 0;
+    pmHeap.gc_totalms = 0;
+    pmHeap.gc_reclaimed = 0;
+    pmHeap.sweep_ptr = C_NULL;
+    pmHeap.sweep_region = pmHeap.nregions;
+#ifdef HAVE_GC_LAZY_SWEEP
+    pmHeap.gc_live = 0;
+    pmHeap.gc_garbage = 0;
+#endif /* HAVE_GC_LAZY_SWEEP */
+#ifdef HAVE_GC_INCREMENTAL
+    pmHeap.gc_state = HEAP_GC_IDLE;
+    pmHeap.gc_budget = HEAP_GC_STEP_BUDGET;
+#endif /* HAVE_GC_INCREMENTAL */
+#ifdef HAVE_GC_COMPACT
+    pmHeap.compact_threshold = HEAP_GC_COMPACT_THRESHOLD;
+    pmHeap.gc_compactcount = 0;
+#endif /* HAVE_GC_COMPACT */
+    heap_gcSetAuto(C_TRUE);
+#endif /* HAVE_GC */
+
+    heap_linkRegion(&pmHeap.regions[0]);
 
     C_DEBUG_PRINT(VERBOSITY_LOW, "heap_init(), id=%p, s=%u\n",
-                  pmHeap.base, (unsigned int)pmHeap.avail);
+                  adjbase, (unsigned int)pmHeap.avail);
 
 #if USE_STRING_CACHE
     string_cacheInit();
@@ -438,11 +1222,163 @@ heap_init(uint8_t *base, uint32_t size)
 }
 
 
+/* Adds a region of memory to the heap */
+PmReturn_t
+heap_addRegion(uint8_t *base, uint32_t size)
+{
+    PmReturn_t retval = PM_RET_OK;
+    pPmHeapRegion_t pregion;
+    uint8_t *adjbase;
+
+    /* Align the region to the heap granule at both ends */
+    adjbase = (uint8_t *)(((intptr_t)base + (1 << HEAP_GRANULE_SHIFT) - 1)
+                          & ~(intptr_t)((1 << HEAP_GRANULE_SHIFT) - 1));
+    size = (size > (uint32_t)(adjbase - base))
+           ? size - (uint32_t)(adjbase - base) : 0;
+    size &= ~(uint32_t)((1 << HEAP_GRANULE_SHIFT) - 1);
+
+    /* Raise a MemoryError if the region cannot be used */
+    if ((pmHeap.nregions == HEAP_MAX_REGIONS) || (size < HEAP_MIN_CHUNK_SIZE)
+        || ((pmHeap.size + size) < pmHeap.size))
+    {
+        PM_RAISE(retval, PM_RET_EX_MEM);
+        return retval;
+    }
+
+    pregion = &pmHeap.regions[pmHeap.nregions++];
+    pregion->base = adjbase;
+    pregion->size = size;
+    pmHeap.size += size;
+    heap_linkRegion(pregion);
+
+#ifdef HAVE_GC
+    /* A finished sweep stays finished */
+    if (pmHeap.sweep_region == (pmHeap.nregions - 1))
+    {
+        pmHeap.sweep_region = pmHeap.nregions;
+    }
+#endif /* HAVE_GC */
+
+    C_DEBUG_PRINT(VERBOSITY_LOW, "heap_addRegion(), id=%p, s=%u\n",
+                  adjbase, (unsigned int)size);
+    return retval;
+}
+
+
+#ifdef HAVE_HEAP_GROW
+/* Gets a new region from the platform that can hold a chunk of the size */
+static PmReturn_t
+heap_grow(uint16_t size)
+{
+    PmReturn_t retval;
+    uint8_t *base;
+    uint32_t regionsize;
+
+    if (pmHeap.nregions == HEAP_MAX_REGIONS)
+    {
+        PM_RAISE(retval, PM_RET_EX_MEM);
+        return retval;
+    }
+
+    /* Double the heap, within limits, so growing is rare */
+    regionsize = pmHeap.size;
+    if (regionsize < HEAP_GROW_MIN_SIZE)
+    {
+        regionsize = HEAP_GROW_MIN_SIZE;
+    }
+    else if (regionsize > HEAP_GROW_MAX_SIZE)
+    {
+        regionsize = HEAP_GROW_MAX_SIZE;
+    }
+
+    /* The region must still hold the chunk once aligned and linked */
+    if (regionsize < ((uint32_t)size + HEAP_MIN_CHUNK_SIZE
+                      + (2 << HEAP_GRANULE_SHIFT)))
+    {
+        regionsize = (uint32_t)size + HEAP_MIN_CHUNK_SIZE
+                     + (2 << HEAP_GRANULE_SHIFT);
+    }
+
+    retval = plat_heapGrow(regionsize, &base, &regionsize);
+    PM_RETURN_IF_ERROR(retval);
+
+    retval = heap_addRegion(base, regionsize);
+    if (retval != PM_RET_OK)
+    {
+        plat_heapRelease(base, regionsize);
+    }
+
+    C_DEBUG_PRINT(VERBOSITY_LOW, "heap_grow(), s=%u for %u\n",
+                  (unsigned int)regionsize, (unsigned int)size);
+    return retval;
+}
+
+
+/*
+ * Gives back to the platform every grown region that is wholly free,
+ * so long as the heap is left no more than half used, so that the next
+ * allocations do not grow it again at once.
+ * Must only be called when no sweep is pending.
+ */
+static void
+heap_releaseRegions(void)
+{
+    pPmHeapRegion_t pregion;
+    uint8_t *pchunk;
+    uint8_t *pend;
+    uint8_t r;
+
+    /* The first region is the static heap and is never released */
+    for (r = pmHeap.nregions - 1; r > 0; r--)
+    {
+        pregion = &pmHeap.regions[r];
+        if ((pmHeap.avail < pregion->size)
+            || ((pmHeap.avail - pregion->size)
+                < (pmHeap.size - pmHeap.avail)))
+        {
+            continue;
+        }
+
+        /* Skip the region if any chunk in it is in use */
+        pend = &pregion->base[pregion->size];
+        for (pchunk = pregion->base;
+             (pchunk < pend) && OBJ_GET_FREE(pchunk);
+             pchunk += CHUNK_GET_SIZE(pchunk));
+        if (pchunk < pend)
+        {
+            continue;
+        }
+
+        for (pchunk = pregion->base; pchunk < pend;
+             pchunk += CHUNK_GET_SIZE(pchunk))
+        {
+            heap_unlinkFromFreelist((pPmHeapDesc_t)pchunk);
+        }
+        pmHeap.size -= pregion->size;
+        plat_heapRelease(pregion->base, pregion->size);
+
+        C_DEBUG_PRINT(VERBOSITY_LOW, "heap_releaseRegions(), id=%p, s=%u\n",
+                      pregion->base, (unsigned int)pregion->size);
+
+        /* Close up the table of regions */
+        pmHeap.nregions--;
+        for (; pregion < &pmHeap.regions[pmHeap.nregions]; pregion++)
+        {
+            pregion[0] = pregion[1];
+        }
+    }
+    pmHeap.sweep_region = pmHeap.nregions;
+}
+#endif /* HAVE_HEAP_GROW */
+
+
 /**
  * Obtains a chunk of memory from the free list
  *
  * Performs the Best Fit algorithm.
- * Iterates through the freelist to see if a chunk of suitable size exists.
+ * Takes the head of the request's small bin, or scans the request's
+ * sorted large bin, then falls back to the smallest chunk in the next
+ * non-empty bin found through the bin bitmaps.
  * Shaves a chunk to perfect size iff the remainder is greater than
  * the minimum chunk size.
  *
@@ -456,16 +1392,38 @@ heap_getChunkImpl(uint16_t size, uint8_t **r_pchunk)
     PmReturn_t retval;
     pPmHeapDesc_t pchunk;
     pPmHeapDesc_t premainderChunk;
+    uint8_t bin;
 
     C_ASSERT(r_pchunk != C_NULL);
 
-    /* Skip to the first chunk that can hold the requested size */
-    pchunk = pmHeap.pfreelist;
+    /* A small bin's head is an exact fit; a large bin is scanned for a fit */
+    bin = heap_getBinIndex(size);
+    pchunk = pmHeap.bins[bin];
     while ((pchunk != C_NULL) && (CHUNK_GET_SIZE(pchunk) < size))
     {
         pchunk = pchunk->next;
     }
 
+    /* Otherwise the best fit is the first chunk in the next non-empty bin */
+    if (pchunk == C_NULL)
+    {
+        bin = heap_findNonEmptyBin(bin + 1);
+        if (bin < HEAP_NUM_BINS)
+        {
+            pchunk = pmHeap.bins[bin];
+        }
+    }
+
+#ifdef HAVE_GC_LAZY_SWEEP
+    /* Sweep just enough of the heap to reclaim a chunk, then try again */
+    if ((pchunk == C_NULL) && HEAP_SWEEP_PENDING())
+    {
+        retval = heap_gcSweepChunks(0xFFFFFFFF, size);
+        PM_RETURN_IF_ERROR(retval);
+        return heap_getChunkImpl(size, r_pchunk);
+    }
+#endif /* HAVE_GC_LAZY_SWEEP */
+
     /* No chunk of appropriate size was found, raise OutOfMemory exception */
     if (pchunk == C_NULL)
     {
@@ -490,31 +1448,49 @@ heap_getChunkImpl(uint16_t size, uint8_t **r_pchunk)
         retval = heap_linkToFreelist(premainderChunk);
         PM_RETURN_IF_ERROR(retval);
 
-        /* Convert the chunk from a heap descriptor to an object descriptor */
-        OBJ_SET_SIZE(pchunk, 0);
-        OBJ_SET_FREE(pchunk, 0);
-        OBJ_SET_SIZE(pchunk, size);
-
         C_DEBUG_PRINT(VERBOSITY_HIGH,
                       "heap_getChunkImpl()carved, id=%p, s=%d\n", pchunk,
                       size);
     }
     else
     {
-        /* Set chunk's type to none (overwrites size field's high byte) */
-        OBJ_SET_TYPE((pPmObj_t)pchunk, OBJ_TYPE_NON);
-        OBJ_SET_FREE(pchunk, 0);
+        size = CHUNK_GET_SIZE(pchunk);
 
         C_DEBUG_PRINT(VERBOSITY_HIGH,
                       "heap_getChunkImpl()exact, id=%p, s=%d\n", pchunk,
-                      PM_OBJ_GET_SIZE(pchunk));
+                      size);
+    }
+
+    /* A chunk too big for an object descriptor gets a large descriptor */
+    if (size > HEAP_MAX_LIVE_CHUNK_SIZE)
+    {
+        ((pPmLargeDesc_t)pchunk)->ld = 0;
+        ((pPmLargeDesc_t)pchunk)->ld_size = size;
+        pchunk = (pPmHeapDesc_t)((uint8_t *)pchunk + HEAP_LARGE_DESC_SIZE);
+        ((pPmObj_t)pchunk)->od = 0;
+    }
+
+    /* Otherwise convert the heap descriptor to an object descriptor */
+    else
+    {
+        ((pPmObj_t)pchunk)->od = 0;
+        OBJ_SET_SIZE(pchunk, size);
     }
 
     /*
      * Set the chunk's GC mark so it will be collected during the next GC cycle
      * if it is not reachable
      */
+#ifdef HAVE_GC_INCREMENTAL
+    /*
+     * While marking, allocate white: a new object is found through the
+     * frame or container that it is stored in, so filling it needs no barrier.
+     */
+    OBJ_SET_GCVAL(pchunk, (pmHeap.gc_state == HEAP_GC_MARK)
+                          ? (pmHeap.gcval ^ 1) : pmHeap.gcval);
+#else
     OBJ_SET_GCVAL(pchunk, pmHeap.gcval);
+#endif /* HAVE_GC_INCREMENTAL */
 
     /* Return the chunk */
     *r_pchunk = (uint8_t *)pchunk;
@@ -536,12 +1512,18 @@ heap_getChunk(uint16_t requestedsize, uint8_t **r_pchunk)
     uint16_t adjustedsize;
 
     /* Ensure size request is valid */
-    if (requestedsize > HEAP_MAX_LIVE_CHUNK_SIZE)
+    if (requestedsize > HEAP_MAX_LARGE_OBJ_SIZE)
     {
         PM_RAISE(retval, PM_RET_EX_MEM);
         return retval;
     }
 
+    /* An object too big for its descriptor's size field goes in a large chunk */
+    else if (requestedsize > HEAP_MAX_LIVE_CHUNK_SIZE)
+    {
+        requestedsize += HEAP_LARGE_DESC_SIZE;
+    }
+
     else if (requestedsize < HEAP_MIN_CHUNK_SIZE)
     {
         requestedsize = HEAP_MIN_CHUNK_SIZE;
@@ -578,9 +1560,25 @@ heap_getChunk(uint16_t requestedsize, uint8_t **r_pchunk)
     }
 #endif /* HAVE_GC */
 
+#ifdef HAVE_HEAP_GROW
+    /* Grow the heap if the GC could not free enough memory */
+    if (retval == PM_RET_EX_MEM)
+    {
+        retval = heap_grow(adjustedsize);
+        if (retval == PM_RET_OK)
+        {
+            retval = heap_getChunkImpl(adjustedsize, r_pchunk);
+        }
+    }
+#endif /* HAVE_HEAP_GROW */
+
     /* Ensure that the pointer is N-byte aligned */
     if (retval == PM_RET_OK)
     {
+#ifdef HAVE_HEAP_STATS
+        pmHeap.allocs++;
+        pmHeap.allocbytes += adjustedsize;
+#endif /* HAVE_HEAP_STATS */
 #ifdef PM_PLAT_POINTER_SIZE
 #if PM_PLAT_POINTER_SIZE == 8
         C_ASSERT(((intptr_t)*r_pchunk & 7) == 0);
@@ -596,73 +1594,551 @@ heap_getChunk(uint16_t requestedsize, uint8_t **r_pchunk)
 }
 
 
-/* Releases chunk to the free list */
+#ifdef HAVE_HEAP_POOLS
+/* Pops a slot from the type's pool, or allocates a chunk if it has none */
 PmReturn_t
-heap_freeChunk(pPmObj_t ptr)
+heap_getPoolChunk(PmType_t type, uint16_t requestedsize, uint8_t **r_pchunk)
 {
-    PmReturn_t retval;
+    pPmPool_t ppool;
+    pPmPoolSlot_t pslot;
 
-    C_DEBUG_PRINT(VERBOSITY_HIGH, "heap_freeChunk(), id=%p, s=%d\n",
-                  ptr, PM_OBJ_GET_SIZE(ptr));
-
-    /* Ensure the chunk falls within the heap */
-    C_ASSERT(((uint8_t *)ptr >= &pmHeap.base[0])
-              && ((uint8_t *)ptr <= &pmHeap.base[pmHeap.size]));
+    for (ppool = pmHeap.pools; ppool < &pmHeap.pools[HEAP_NUM_POOLS]; ppool++)
+    {
+        if (ppool->type != type)
+        {
+            continue;
+        }
 
-    /* Insert the chunk into the freelist */
-    OBJ_SET_FREE(ptr, 1);
+        pslot = ppool->free;
+        if (pslot == C_NULL)
+        {
+            break;
+        }
+        ppool->free = pslot->next;
 
-    /* Clear type so that heap descriptor's size's upper byte is zero */
-    OBJ_SET_TYPE(ptr, 0);
-    retval = heap_linkToFreelist((pPmHeapDesc_t)ptr);
-    PM_RETURN_IF_ERROR(retval);
+        pslot->od = 0;
+        OBJ_SET_SIZE(pslot, ppool->slotsize);
+#ifdef HAVE_GC_INCREMENTAL
+        OBJ_SET_GCVAL(pslot, (pmHeap.gc_state == HEAP_GC_MARK)
+                             ? (pmHeap.gcval ^ 1) : pmHeap.gcval);
+#else
+        OBJ_SET_GCVAL(pslot, pmHeap.gcval);
+#endif /* HAVE_GC_INCREMENTAL */
+#ifdef HAVE_HEAP_STATS
+        pmHeap.allocs++;
+        pmHeap.allocbytes += ppool->slotsize;
+#endif /* HAVE_HEAP_STATS */
+        *r_pchunk = (uint8_t *)pslot;
+        return PM_RET_OK;
+    }
 
-    return retval;
+    return heap_getChunk(requestedsize, r_pchunk);
 }
+#endif /* HAVE_HEAP_POOLS */
 
 
-uint32_t
-heap_getAvail(void)
+#ifdef HAVE_GC_NURSERY
+/*
+ * Checks one reference for a young object.  If promote is true, the young
+ * object is made old so the minor GC keeps it.  Returns C_TRUE if the
+ * reference is to a young object.
+ */
+static uint8_t
+heap_nurseryVisit(pPmObj_t pobj, uint8_t promote)
 {
-    return pmHeap.avail;
-}
+    uint16_t i;
 
+    if (!HEAP_IN_NURSERY(pobj)
+        || ((((uint8_t *)pobj - pmHeap.nursery) % HEAP_NURSERY_SLOT_SIZE) != 0))
+    {
+        return C_FALSE;
+    }
 
-uint32_t
-heap_getSize(void)
-{
-    return pmHeap.size;
+    i = HEAP_NURSERY_INDEX(pobj);
+    if (!NURSERY_GET_BIT(pmHeap.nursery_used, i)
+        || NURSERY_GET_BIT(pmHeap.nursery_old, i))
+    {
+        return C_FALSE;
+    }
+
+    if (promote)
+    {
+        NURSERY_SET_BIT(pmHeap.nursery_old, i);
+    }
+    return C_TRUE;
 }
 
 
-#ifdef HAVE_GC
 /*
- * Marks the given object and the objects it references.
- *
- * @param   pobj Any non-free heap object
- * @return  Return code
+ * Checks the references held directly by an object for young objects.
+ * Only objects that may hold a reference to an int or a float are checked;
+ * the object's referents are not followed.  Returns C_TRUE if any
+ * reference is to a young object.
+ */
+static uint8_t
+heap_nurseryScanObj(pPmObj_t pobj, uint8_t promote)
+{
+    uint8_t found = C_FALSE;
+    pPmObj_t *ppobj;
+    pSegment_t pseg;
+#ifdef HAVE_FRAME_STACK
+    pPmFrame_t pframe;
+#endif /* HAVE_FRAME_STACK */
+    int16_t i;
+
+    switch (OBJ_GET_TYPE(pobj))
+    {
+        case OBJ_TYPE_TUP:
+            for (i = 0; i < ((pPmTuple_t)pobj)->length; i++)
+            {
+                found |= heap_nurseryVisit(((pPmTuple_t)pobj)->val[i],
+                                           promote);
+            }
+            break;
+
+        case OBJ_TYPE_SGL:
+            for (pseg = ((pSeglist_t)pobj)->sl_rootseg;
+                 pseg != C_NULL; pseg = pseg->next)
+            {
+                found |= heap_nurseryScanObj((pPmObj_t)pseg, promote);
+            }
+            break;
+
+#ifdef HAVE_LIST_ARRAYS
+        case OBJ_TYPE_LST:
+            /* The items in a seglist are visited with the seglist */
+            if ((((pPmList_t)pobj)->val != C_NULL)
+                && (OBJ_GET_TYPE(((pPmList_t)pobj)->val) == OBJ_TYPE_LAR))
+            {
+                for (i = 0; i < ((pPmList_t)pobj)->length; i++)
+                {
+                    found |= heap_nurseryVisit(((pPmListArray_t)
+                        ((pPmList_t)pobj)->val)->la_val[i], promote);
+                }
+            }
+            break;
+#endif /* HAVE_LIST_ARRAYS */
+
+        case OBJ_TYPE_SEG:
+            for (i = 0; i < SEGLIST_OBJS_PER_SEG; i++)
+            {
+                found |= heap_nurseryVisit(((pSegment_t)pobj)->s_val[i],
+                                           promote);
+            }
+            break;
+
+#ifdef HAVE_HASHED_DICTS
+        case OBJ_TYPE_DTB:
+            for (i = 0; i < ((pPmDictTable_t)pobj)->length; i++)
+            {
+                found |= heap_nurseryVisit(
+                    ((pPmDictTable_t)pobj)->dt_slot[i].ds_key, promote);
+                found |= heap_nurseryVisit(
+                    ((pPmDictTable_t)pobj)->dt_slot[i].ds_val, promote);
+            }
+            break;
+#endif /* HAVE_HASHED_DICTS */
+
+#ifdef HAVE_INLINE_CACHES
+        case OBJ_TYPE_ICA:
+            for (i = 0; i < ((pPmInlineCache_t)pobj)->length; i++)
+            {
+                found |= heap_nurseryVisit(
+                    (((pPmInlineCache_t)pobj)->ic_kind == ICA_KIND_GLOBALS)
+                    ? ((pPmInlineCache_t)pobj)->ic_entry[i].ce_val
+                    : ((pPmAttrCache_t)pobj)->ac_entry[i].ae_val, promote);
+            }
+            break;
+#endif /* HAVE_INLINE_CACHES */
+
+        case OBJ_TYPE_FRM:
+            for (ppobj = ((pPmFrame_t)pobj)->fo_locals;
+                 ppobj < ((pPmFrame_t)pobj)->fo_sp; ppobj++)
+            {
+                found |= heap_nurseryVisit(*ppobj, promote);
+            }
+            break;
+
+#ifdef HAVE_FRAME_STACK
+        case OBJ_TYPE_FST:
+            for (pframe = (pPmFrame_t)FRAME_STACK_BASE(pobj);
+                 (uint8_t *)pframe < ((pPmFrameStack_t)pobj)->fs_top;
+                 pframe = (pPmFrame_t)FRAME_GET_END(pframe))
+            {
+                found |= heap_nurseryScanObj((pPmObj_t)pframe, promote);
+            }
+            break;
+#endif /* HAVE_FRAME_STACK */
+
+        case OBJ_TYPE_NFM:
+            if (gVmGlobal.nativeframe.nf_active)
+            {
+                found |= heap_nurseryVisit(gVmGlobal.nativeframe.nf_stack,
+                                           promote);
+                for (i = 0; i < NATIVE_GET_NUM_ARGS(); i++)
+                {
+                    found |= heap_nurseryVisit(
+                        gVmGlobal.nativeframe.nf_locals[i], promote);
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+    return found;
+}
+
+
+/* Adds an object to the remembered set unless it is already there */
+static void
+heap_nurseryRemember(pPmObj_t pobj)
+{
+    uint8_t i;
+
+    if (pobj == C_NULL)
+    {
+        return;
+    }
+    for (i = 0; i < pmHeap.remset_index; i++)
+    {
+        if (pmHeap.remset[i] == pobj)
+        {
+            return;
+        }
+    }
+    if (pmHeap.remset_index < HEAP_REMSET_SIZE)
+    {
+        pmHeap.remset[pmHeap.remset_index++] = pobj;
+    }
+    else
+    {
+        pmHeap.remset_overflow = C_TRUE;
+    }
+}
+
+
+/* Frees the nursery slot at index i */
+static void
+heap_nurseryFreeSlot(uint16_t i)
+{
+    NURSERY_CLR_BIT(pmHeap.nursery_used, i);
+    NURSERY_CLR_BIT(pmHeap.nursery_old, i);
+    OBJ_SET_FREE(&pmHeap.nursery[i * HEAP_NURSERY_SLOT_SIZE], 1);
+}
+
+
+/*
+ * Frees the nursery slots whose objects do not have a current mark and
+ * makes the rest old.  Called after a full mark, so the remembered set
+ * is no longer needed.
+ */
+static void
+heap_nurserySweep(void)
+{
+    uint16_t i;
+
+    for (i = 0; i < pmHeap.nursery_slots; i++)
+    {
+        if (!NURSERY_GET_BIT(pmHeap.nursery_used, i))
+        {
+            continue;
+        }
+        if (OBJ_GET_GCVAL(&pmHeap.nursery[i * HEAP_NURSERY_SLOT_SIZE])
+            != pmHeap.gcval)
+        {
+            heap_nurseryFreeSlot(i);
+            pmHeap.gc_reclaimed += HEAP_NURSERY_SLOT_SIZE;
+        }
+        else
+        {
+            NURSERY_SET_BIT(pmHeap.nursery_old, i);
+        }
+    }
+    pmHeap.nursery_next = 0;
+    pmHeap.nursery_full = C_FALSE;
+    pmHeap.remset_index = 0;
+    pmHeap.remset_overflow = C_FALSE;
+}
+#endif /* HAVE_GC_NURSERY */
+
+
+/* Releases chunk to the free list */
+PmReturn_t
+heap_freeChunk(pPmObj_t ptr)
+{
+    PmReturn_t retval;
+
+    C_DEBUG_PRINT(VERBOSITY_HIGH, "heap_freeChunk(), id=%p, s=%d\n",
+                  ptr, PM_OBJ_GET_SIZE(ptr));
+
+#ifdef HAVE_GC_NURSERY
+    /* A nursery object goes back to its slot */
+    if (HEAP_IN_NURSERY(ptr))
+    {
+        heap_nurseryFreeSlot(HEAP_NURSERY_INDEX(ptr));
+        return PM_RET_OK;
+    }
+#endif /* HAVE_GC_NURSERY */
+
+    /* Ensure the chunk falls within the heap */
+#ifdef HAVE_HEAP_POOLS
+    C_ASSERT((heap_getRegion(ptr) < pmHeap.nregions) || HEAP_IN_POOLS(ptr));
+#else
+    C_ASSERT(heap_getRegion(ptr) < pmHeap.nregions);
+#endif /* HAVE_HEAP_POOLS */
+
+#ifdef HAVE_GC_INCREMENTAL
+    /* A gray object that is freed must not be scanned later */
+    if (pmHeap.gc_state == HEAP_GC_MARK)
+    {
+        uint8_t i = 0;
+
+        while (i < pmHeap.mark_stack_index)
+        {
+            if (pmHeap.mark_stack[i] == ptr)
+            {
+                pmHeap.mark_stack[i] =
+                    pmHeap.mark_stack[--pmHeap.mark_stack_index];
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+#endif /* HAVE_GC_INCREMENTAL */
+
+#ifdef HAVE_GC_NURSERY
+    /* A freed object must not be checked by the next minor GC */
+    {
+        uint8_t i = 0;
+
+        while (i < pmHeap.remset_index)
+        {
+            if (pmHeap.remset[i] == ptr)
+            {
+                pmHeap.remset[i] = pmHeap.remset[--pmHeap.remset_index];
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+#endif /* HAVE_GC_NURSERY */
+
+#ifdef HAVE_GC_LAZY_SWEEP
+    /* A freed chunk is no longer live, nor garbage left for the sweep */
+#ifdef HAVE_GC_INCREMENTAL
+    if ((pmHeap.gc_state == HEAP_GC_MARK)
+        && (OBJ_GET_GCVAL(ptr) == pmHeap.gcval))
+    {
+        pmHeap.gc_live -= heap_gcObjChunkSize(ptr);
+    }
+#endif /* HAVE_GC_INCREMENTAL */
+    if (heap_gcIsUnswept(ptr) && (OBJ_GET_GCVAL(ptr) != pmHeap.gcval)
+        && (heap_gcObjChunkSize(ptr) <= pmHeap.gc_garbage))
+    {
+        pmHeap.gc_garbage -= heap_gcObjChunkSize(ptr);
+    }
+#endif /* HAVE_GC_LAZY_SWEEP */
+
+#ifdef HAVE_HEAP_POOLS
+    /* A pool object goes back to its pool */
+    if (HEAP_IN_POOLS(ptr))
+    {
+        heap_poolFreeSlot(ptr);
+        return PM_RET_OK;
+    }
+#endif /* HAVE_HEAP_POOLS */
+
+    /* A large object frees its whole chunk, descriptor included */
+    if (HEAP_IS_LARGE(ptr))
+    {
+        pPmHeapDesc_t pchunk = (pPmHeapDesc_t)HEAP_LARGE_CHUNK(ptr);
+        uint16_t size = ((pPmLargeDesc_t)pchunk)->ld_size;
+
+        pchunk->hd = 0;
+        OBJ_SET_FREE(pchunk, 1);
+        CHUNK_SET_SIZE(pchunk, size);
+        return heap_linkToFreelist(pchunk);
+    }
+
+    /* Insert the chunk into the freelist */
+    OBJ_SET_FREE(ptr, 1);
+
+    /* Clear type so that heap descriptor's size's upper byte is zero */
+    OBJ_SET_TYPE_RAW(ptr, 0);
+    retval = heap_linkToFreelist((pPmHeapDesc_t)ptr);
+    PM_RETURN_IF_ERROR(retval);
+
+    return retval;
+}
+
+
+uint32_t
+heap_getAvail(void)
+{
+#ifdef HAVE_GC_LAZY_SWEEP
+    /* Garbage that is not yet swept is as good as free */
+    return pmHeap.avail + pmHeap.gc_garbage;
+#else
+    return pmHeap.avail;
+#endif /* HAVE_GC_LAZY_SWEEP */
+}
+
+
+uint32_t
+heap_getSize(void)
+{
+    return pmHeap.size;
+}
+
+
+uint16_t
+heap_getObjSize(pPmObj_t pobj)
+{
+    if (HEAP_IS_LARGE(pobj))
+    {
+        return HEAP_LARGE_CHUNK(pobj)->ld_size - HEAP_LARGE_DESC_SIZE;
+    }
+    return PM_OBJ_GET_SIZE(pobj);
+}
+
+
+/* Returns the size of the largest free chunk */
+uint16_t
+heap_getMaxFree(void)
+{
+    pPmHeapDesc_t pchunk;
+    uint8_t bin;
+
+    /* A large bin is sorted, so its largest chunk is at its tail */
+    if (pmHeap.largemap != 0)
+    {
+        for (bin = HEAP_NUM_BINS - 1;
+             (pmHeap.largemap & (1 << (bin - HEAP_NUM_SMALL_BINS))) == 0;
+             bin--);
+        for (pchunk = pmHeap.bins[bin]; pchunk->next != C_NULL;
+             pchunk = pchunk->next);
+        return CHUNK_GET_SIZE(pchunk);
+    }
+
+    /* Otherwise the largest chunk is in the highest non-empty small bin */
+    if (pmHeap.smallmap != 0)
+    {
+        for (bin = HEAP_NUM_SMALL_BINS - 1;
+             (pmHeap.smallmap & ((uint32_t)1 << bin)) == 0; bin--);
+        return (uint16_t)bin << HEAP_GRANULE_SHIFT;
+    }
+
+    return 0;
+}
+
+
+void
+heap_getStats(pPmHeapStats_t r_stats)
+{
+    pPmHeapDesc_t pchunk;
+    uint8_t bin;
+
+    sli_memset((unsigned char *)r_stats, 0, sizeof(PmHeapStats_t));
+    r_stats->size = heap_getSize();
+    r_stats->avail = heap_getAvail();
+    r_stats->maxfree = heap_getMaxFree();
+    for (bin = 0; bin < HEAP_NUM_BINS; bin++)
+    {
+        for (pchunk = pmHeap.bins[bin]; pchunk != C_NULL;
+             pchunk = pchunk->next)
+        {
+            r_stats->nfree++;
+        }
+    }
+
+#ifdef HAVE_GC
+    r_stats->gc_fullcount = pmHeap.gc_fullcount;
+    r_stats->gc_totalms = pmHeap.gc_totalms;
+    r_stats->gc_maxpausems = pmHeap.gc_maxpausems;
+    r_stats->gc_maxpausework = pmHeap.gc_maxpausework;
+    r_stats->gc_reclaimed = pmHeap.gc_reclaimed;
+#ifdef HAVE_GC_NURSERY
+    r_stats->gc_minorcount = pmHeap.gc_minorcount;
+#endif /* HAVE_GC_NURSERY */
+#ifdef HAVE_GC_COMPACT
+    r_stats->gc_compactcount = pmHeap.gc_compactcount;
+#endif /* HAVE_GC_COMPACT */
+#endif /* HAVE_GC */
+
+#ifdef HAVE_HEAP_STATS
+    r_stats->allocs = pmHeap.allocs;
+    r_stats->allocbytes = pmHeap.allocbytes;
+    sli_memcpy((unsigned char *)r_stats->typecount,
+               (unsigned char *)pmHeap.typecount, sizeof(pmHeap.typecount));
+#endif /* HAVE_HEAP_STATS */
+}
+
+
+#ifdef HAVE_HEAP_STATS
+void
+heap_countObj(PmType_t type)
+{
+    if ((uint8_t)type < HEAP_NUM_TYPES)
+    {
+        pmHeap.typecount[type]++;
+    }
+}
+#endif /* HAVE_HEAP_STATS */
+
+
+#ifdef HAVE_GC
+/*
+ * Marks the given object.  If the object may reference other objects,
+ * it is pushed on the mark stack so its references are marked later
+ * by heap_gcDrainMarkStack().  If the mark stack is full, the overflow
+ * flag is set and the object is found again by heap_gcRescanHeap().
+ *
+ * @param   pobj Any non-free heap object
+ * @return  Return code
  */
 static PmReturn_t
 heap_gcMarkObj(pPmObj_t pobj)
 {
     PmReturn_t retval = PM_RET_OK;
-    int16_t i = 0;
-    int16_t n;
-    PmType_t type;
 
-    /* Return if ptr is null or object is already marked */
-    if (pobj == C_NULL)
+    /* Return if ptr is null, a tagged int or object is already marked */
+    if ((pobj == C_NULL) || OBJ_IS_TAGGED(pobj))
+    {
+        return retval;
+    }
+#ifdef HAVE_SMALL_INT_CACHE
+    /* The small ints are immortal and live outside the heap */
+    if (INT_IS_CACHED(pobj))
     {
         return retval;
     }
+#endif /* HAVE_SMALL_INT_CACHE */
+#ifdef HAVE_FRAME_STACK
+    /* A frame in a frame stack is marked with its segment */
+    if ((OBJ_GET_TYPE(pobj) == OBJ_TYPE_FRM)
+        && (((pPmFrame_t)pobj)->fo_stack != C_NULL))
+    {
+        pobj = (pPmObj_t)((pPmFrame_t)pobj)->fo_stack;
+    }
+#endif /* HAVE_FRAME_STACK */
     if (OBJ_GET_GCVAL(pobj) == pmHeap.gcval)
     {
         return retval;
     }
 
     /* The pointer must be within the heap (native frame is special case) */
-    C_ASSERT((((uint8_t *)pobj >= &pmHeap.base[0])
-              && ((uint8_t *)pobj <= &pmHeap.base[pmHeap.size]))
+    C_ASSERT((heap_getRegion(pobj) < pmHeap.nregions)
+#ifdef HAVE_GC_NURSERY
+             || HEAP_IN_NURSERY(pobj)
+#endif /* HAVE_GC_NURSERY */
+#ifdef HAVE_HEAP_POOLS
+             || HEAP_IN_POOLS(pobj)
+#endif /* HAVE_HEAP_POOLS */
              || ((uint8_t *)pobj == (uint8_t *)&gVmGlobal.nativeframe));
 
     /* The object must not already be free */
@@ -670,11 +2146,15 @@ heap_gcMarkObj(pPmObj_t pobj)
     // should I skip the rest if that happens???
     if (OBJ_GET_FREE(pobj) != 0)
         return retval;
-        
-    type = (PmType_t)OBJ_GET_TYPE(pobj);
-    switch (type)
+
+    OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+#ifdef HAVE_GC_LAZY_SWEEP
+    pmHeap.gc_live += heap_gcObjChunkSize(pobj);
+#endif /* HAVE_GC_LAZY_SWEEP */
+
+    switch (OBJ_GET_TYPE(pobj))
     {
-        /* Objects with no references to other objects */
+        /* Objects with no references to other objects are done */
         case OBJ_TYPE_NON:
         case OBJ_TYPE_INT:
         case OBJ_TYPE_FLT:
@@ -682,535 +2162,2118 @@ heap_gcMarkObj(pPmObj_t pobj)
         case OBJ_TYPE_NOB:
         case OBJ_TYPE_BOOL:
         case OBJ_TYPE_CIO:
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+#ifdef HAVE_BYTEARRAY
+        case OBJ_TYPE_BYS:
+#endif /* HAVE_BYTEARRAY */
+#if USE_STRING_CACHE
+        /* The string cache does not keep its strings alive */
+        case OBJ_TYPE_STB:
+#endif /* USE_STRING_CACHE */
+#ifdef HAVE_LIST_ARRAYS
+        /* A list's items are marked through the list */
+        case OBJ_TYPE_LAR:
+#endif /* HAVE_LIST_ARRAYS */
             break;
 
-        case OBJ_TYPE_TUP:
-            i = ((pPmTuple_t)pobj)->length;
+        /* Push all other objects so their references are marked */
+        default:
+            if (pmHeap.mark_stack_index < HEAP_MARK_STACK_SIZE)
+            {
+                pmHeap.mark_stack[pmHeap.mark_stack_index++] = pobj;
+            }
+            else
+            {
+                pmHeap.mark_overflow = C_TRUE;
+            }
+            break;
+    }
+    return retval;
+}
 
-            /* Mark tuple head */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
 
-            /* Mark each obj in tuple */
-            while (--i >= 0)
-            {
-                retval = heap_gcMarkObj(((pPmTuple_t)pobj)->val[i]);
-                PM_RETURN_IF_ERROR(retval);
+/*
+ * Marks the objects referenced by the given marked object.
+ *
+ * @param   pobj Any marked, non-free heap object
+ * @return  Return code
+ */
+static PmReturn_t
+heap_gcScanObj(pPmObj_t pobj)
+{
+    PmReturn_t retval = PM_RET_OK;
+    int16_t i = 0;
+    int16_t n;
+    PmType_t type;
+
+    pmHeap.gc_work++;
+    type = (PmType_t)OBJ_GET_TYPE(pobj);
+    switch (type)
+    {
+        /* Objects with no references to other objects are never pushed */
+        case OBJ_TYPE_NON:
+        case OBJ_TYPE_INT:
+        case OBJ_TYPE_FLT:
+        case OBJ_TYPE_STR:
+        case OBJ_TYPE_NOB:
+        case OBJ_TYPE_BOOL:
+        case OBJ_TYPE_CIO:
+#if USE_STRING_CACHE
+        case OBJ_TYPE_STB:
+#endif /* USE_STRING_CACHE */
+#ifdef HAVE_LIST_ARRAYS
+        case OBJ_TYPE_LAR:
+#endif /* HAVE_LIST_ARRAYS */
+            break;
+
+        case OBJ_TYPE_TUP:
+            i = ((pPmTuple_t)pobj)->length;
+
+            /* Mark each obj in tuple */
+            while (--i >= 0)
+            {
+                retval = heap_gcMarkObj(((pPmTuple_t)pobj)->val[i]);
+                PM_RETURN_IF_ERROR(retval);
+            }
+            break;
+
+        case OBJ_TYPE_LST:
+            /* Mark the seglist or item array */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmList_t)pobj)->val);
+#ifdef HAVE_LIST_ARRAYS
+            /* Mark the items in use in the item array */
+            if ((retval == PM_RET_OK) && (((pPmList_t)pobj)->val != C_NULL)
+                && (OBJ_GET_TYPE(((pPmList_t)pobj)->val) == OBJ_TYPE_LAR))
+            {
+                n = ((pPmList_t)pobj)->length;
+                for (i = 0; i < n; i++)
+                {
+                    retval = heap_gcMarkObj(((pPmListArray_t)
+                        ((pPmList_t)pobj)->val)->la_val[i]);
+                    PM_BREAK_IF_ERROR(retval);
+                }
+            }
+#endif /* HAVE_LIST_ARRAYS */
+            break;
+
+        case OBJ_TYPE_DIC:
+#ifdef HAVE_HASHED_DICTS
+            /* Mark the hash table, or the keys seglist */
+            retval = heap_gcMarkObj(((pPmDict_t)pobj)->d_table);
+#else
+            /* Mark the keys seglist */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmDict_t)pobj)->d_keys);
+#endif /* HAVE_HASHED_DICTS */
+            PM_RETURN_IF_ERROR(retval);
+
+            /* Mark the vals seglist */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmDict_t)pobj)->d_vals);
+            break;
+
+#ifdef HAVE_HASHED_DICTS
+        case OBJ_TYPE_DTB:
+            /* Mark the keys and values (deleted slots hold None) */
+            for (i = 0; i < ((pPmDictTable_t)pobj)->length; i++)
+            {
+                retval = heap_gcMarkObj(
+                    ((pPmDictTable_t)pobj)->dt_slot[i].ds_key);
+                PM_BREAK_IF_ERROR(retval);
+                retval = heap_gcMarkObj(
+                    ((pPmDictTable_t)pobj)->dt_slot[i].ds_val);
+                PM_BREAK_IF_ERROR(retval);
+            }
+            break;
+#endif /* HAVE_HASHED_DICTS */
+
+        case OBJ_TYPE_COB:
+            /* Mark the names tuple */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmCo_t)pobj)->co_names);
+            PM_RETURN_IF_ERROR(retval);
+
+            /* Mark the consts tuple */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmCo_t)pobj)->co_consts);
+            PM_RETURN_IF_ERROR(retval);
+
+            /* #122: Mark the code image if it is in RAM */
+            if (((pPmCo_t)pobj)->co_memspace == MEMSPACE_RAM)
+            {
+                retval = heap_gcMarkObj((pPmObj_t)
+                                        (((pPmCo_t)pobj)->co_codeimgaddr));
+                PM_RETURN_IF_ERROR(retval);
+            }
+
+#ifdef HAVE_CLOSURES
+            /* #256: Add support for closures */
+            /* Mark the cellvars tuple */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmCo_t)pobj)->co_cellvars);
+            PM_RETURN_IF_ERROR(retval);
+#endif /* HAVE_CLOSURES */
+
+#ifdef HAVE_INLINE_CACHES
+            /* Mark the inline caches */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmCo_t)pobj)->co_cache);
+            PM_RETURN_IF_ERROR(retval);
+            retval = heap_gcMarkObj((pPmObj_t)((pPmCo_t)pobj)->co_attrcache);
+#endif /* HAVE_INLINE_CACHES */
+            break;
+
+#ifdef HAVE_INLINE_CACHES
+        case OBJ_TYPE_ICA:
+            /* Mark the cached values (and classes) */
+            for (i = 0; i < ((pPmInlineCache_t)pobj)->length; i++)
+            {
+                if (((pPmInlineCache_t)pobj)->ic_kind == ICA_KIND_GLOBALS)
+                {
+                    retval = heap_gcMarkObj(
+                        ((pPmInlineCache_t)pobj)->ic_entry[i].ce_val);
+                }
+                else
+                {
+                    retval = heap_gcMarkObj(
+                        ((pPmAttrCache_t)pobj)->ac_entry[i].ae_class);
+                    PM_BREAK_IF_ERROR(retval);
+                    retval = heap_gcMarkObj(
+                        ((pPmAttrCache_t)pobj)->ac_entry[i].ae_val);
+                }
+                PM_BREAK_IF_ERROR(retval);
+            }
+            break;
+#endif /* HAVE_INLINE_CACHES */
+
+        case OBJ_TYPE_MOD:
+        case OBJ_TYPE_FXN:
+            /* Module and Func objs are implemented via the PmFunc_t */
+
+            /* Mark the code obj */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmFunc_t)pobj)->f_co);
+            PM_RETURN_IF_ERROR(retval);
+
+            /* Mark the attr dict */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmFunc_t)pobj)->f_attrs);
+            PM_RETURN_IF_ERROR(retval);
+
+            /* Mark the globals dict */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmFunc_t)pobj)->f_globals);
+            PM_RETURN_IF_ERROR(retval);
+
+#ifdef HAVE_DEFAULTARGS
+            /* Mark the default args tuple */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmFunc_t)pobj)->f_defaultargs);
+            PM_RETURN_IF_ERROR(retval);
+#endif /* HAVE_DEFAULTARGS */
+
+#ifdef HAVE_CLOSURES
+            /* #256: Mark the closure tuple */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmFunc_t)pobj)->f_closure);
+#endif /* HAVE_CLOSURES */
+            break;
+
+#ifdef HAVE_CLASSES
+        case OBJ_TYPE_CLI:
+            /* Mark the class */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmInstance_t)pobj)->cli_class);
+            PM_RETURN_IF_ERROR(retval);
+
+            /* Mark the attrs dict */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmInstance_t)pobj)->cli_attrs);
+            break;
+
+        case OBJ_TYPE_MTH:
+            /* Mark the instance */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmMethod_t)pobj)->m_instance);
+            PM_RETURN_IF_ERROR(retval);
+
+            /* Mark the func */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmMethod_t)pobj)->m_func);
+            PM_RETURN_IF_ERROR(retval);
+
+            /* Mark the attrs dict */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmMethod_t)pobj)->m_attrs);
+            break;
+
+        case OBJ_TYPE_CLO:
+            /* Mark the attrs dict */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmClass_t)pobj)->cl_attrs);
+            PM_RETURN_IF_ERROR(retval);
+
+            /* Mark the base tuple */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmClass_t)pobj)->cl_bases);
+            break;
+#endif /* HAVE_CLASSES */
+
+        /*
+         * An obj in ram should not be of these types.
+         * Images arrive in RAM as string objects (image is array of bytes)
+         */
+        case OBJ_TYPE_CIM:
+        case OBJ_TYPE_NIM:
+            PM_RAISE(retval, PM_RET_EX_SYS);
+            return retval;
+
+        case OBJ_TYPE_FRM:
+        {
+            pPmObj_t *ppobj2 = C_NULL;
+
+#ifdef HAVE_GC_INCREMENTAL
+            /*
+             * A frame that died after it was marked can outlive its function
+             * (global_setBuiltins frees the builtins module); skip such frames
+             */
+            if ((OBJ_GET_TYPE(((pPmFrame_t)pobj)->fo_func) != OBJ_TYPE_FXN)
+                && (OBJ_GET_TYPE(((pPmFrame_t)pobj)->fo_func) != OBJ_TYPE_MOD))
+            {
+                break;
+            }
+#endif /* HAVE_GC_INCREMENTAL */
+
+            /* Mark the previous frame, if this isn't a generator's frame */
+            /* Issue #129: Fix iterator losing its object */
+            if ((((pPmFrame_t)pobj)->fo_func->f_co->co_flags & CO_GENERATOR) == 0)
+            {
+                retval = heap_gcMarkObj((pPmObj_t)((pPmFrame_t)pobj)->fo_back);
+                PM_RETURN_IF_ERROR(retval);
+            }
+
+            /* Mark the fxn obj */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmFrame_t)pobj)->fo_func);
+            PM_RETURN_IF_ERROR(retval);
+
+            /* Mark the attrs dict */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmFrame_t)pobj)->fo_attrs);
+            PM_RETURN_IF_ERROR(retval);
+
+            /* Mark the globals dict */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmFrame_t)pobj)->fo_globals);
+            PM_RETURN_IF_ERROR(retval);
+
+            /* Mark each obj in the locals list and the stack */
+            ppobj2 = ((pPmFrame_t)pobj)->fo_locals;
+            while (ppobj2 < ((pPmFrame_t)pobj)->fo_sp)
+            {
+                retval = heap_gcMarkObj(*ppobj2);
+                PM_RETURN_IF_ERROR(retval);
+                ppobj2++;
+            }
+            break;
+        }
+
+        case OBJ_TYPE_SGL:
+            /* Mark the seglist's segments */
+            n = ((pSeglist_t)pobj)->sl_length;
+            pobj = (pPmObj_t)((pSeglist_t)pobj)->sl_rootseg;
+            for (i = 0; i < n; i++)
+            {
+                /* Mark the segment item */
+                retval = heap_gcMarkObj(((pSegment_t)pobj)->s_val[i % SEGLIST_OBJS_PER_SEG]);
+                PM_RETURN_IF_ERROR(retval);
+
+                /* Mark the segment obj head */
+                if ((i % SEGLIST_OBJS_PER_SEG) == 0)
+                {
+#ifdef HAVE_GC_LAZY_SWEEP
+                    if (OBJ_GET_GCVAL(pobj) != pmHeap.gcval)
+                    {
+                        pmHeap.gc_live += heap_gcObjChunkSize(pobj);
+                    }
+#endif /* HAVE_GC_LAZY_SWEEP */
+                    OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+                }
+
+                /* Point to the next segment */
+                else
+                if ((i % SEGLIST_OBJS_PER_SEG) == (SEGLIST_OBJS_PER_SEG - 1))
+                {
+                    pobj = (pPmObj_t)((pSegment_t)pobj)->next;
+                    if (pobj == C_NULL)
+                    {
+                        break;
+                    }
+                }
+            }
+            break;
+
+        case OBJ_TYPE_SQI:
+            /* Mark the sequence */
+            retval = heap_gcMarkObj(((pPmSeqIter_t)pobj)->si_sequence);
+            break;
+
+        case OBJ_TYPE_THR:
+        {
+            pPmFrame_t pframe;
+
+#ifdef HAVE_FRAME_STACK
+            /* Mark the frame stack */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmThread_t)pobj)->fstack);
+            PM_RETURN_IF_ERROR(retval);
+#endif /* HAVE_FRAME_STACK */
+
+            /*
+             * Mark the current frame and its callers; a generator's frame
+             * does not mark its caller, even while the generator runs
+             */
+            for (pframe = ((pPmThread_t)pobj)->pframe;
+                 pframe != C_NULL; pframe = pframe->fo_back)
+            {
+                retval = heap_gcMarkObj((pPmObj_t)pframe);
+                PM_RETURN_IF_ERROR(retval);
+            }
+            break;
+        }
+
+#ifdef HAVE_FRAME_STACK
+        case OBJ_TYPE_FST:
+        {
+            pPmFrame_t pframe;
+
+            /* Mark the other segments */
+            retval = heap_gcMarkObj((pPmObj_t)((pPmFrameStack_t)pobj)->fs_prev);
+            PM_RETURN_IF_ERROR(retval);
+            retval = heap_gcMarkObj((pPmObj_t)((pPmFrameStack_t)pobj)->fs_next);
+            PM_RETURN_IF_ERROR(retval);
+
+            /* Scan each frame in the segment */
+            for (pframe = (pPmFrame_t)FRAME_STACK_BASE(pobj);
+                 (uint8_t *)pframe < ((pPmFrameStack_t)pobj)->fs_top;
+                 pframe = (pPmFrame_t)FRAME_GET_END(pframe))
+            {
+                retval = heap_gcScanObj((pPmObj_t)pframe);
+                PM_RETURN_IF_ERROR(retval);
+            }
+            break;
+        }
+#endif /* HAVE_FRAME_STACK */
+
+        case OBJ_TYPE_NFM:
+            /* Mark the native frame's remaining fields if active */
+            if (gVmGlobal.nativeframe.nf_active)
+            {
+                /* Mark the frame stack */
+                retval = heap_gcMarkObj((pPmObj_t)
+                                        gVmGlobal.nativeframe.nf_back);
+                PM_RETURN_IF_ERROR(retval);
+
+                /* Mark the function object */
+                retval = heap_gcMarkObj((pPmObj_t)
+                                        gVmGlobal.nativeframe.nf_func);
+                PM_RETURN_IF_ERROR(retval);
+
+                /* Mark the stack object */
+                retval = heap_gcMarkObj(gVmGlobal.nativeframe.nf_stack);
+                PM_RETURN_IF_ERROR(retval);
+
+                /* Mark the args to the native func */
+                for (i = 0; i < NATIVE_GET_NUM_ARGS(); i++)
+                {
+                    retval =
+                        heap_gcMarkObj(gVmGlobal.nativeframe.nf_locals[i]);
+                    PM_RETURN_IF_ERROR(retval);
+                }
+            }
+            break;
+
+#ifdef HAVE_BYTEARRAY
+        case OBJ_TYPE_BYA:
+            retval = heap_gcMarkObj((pPmObj_t)((pPmBytearray_t)pobj)->val);
+            break;
+
+        case OBJ_TYPE_BYS:
+            break;
+#endif /* HAVE_BYTEARRAY */
+
+        case OBJ_TYPE_SEG:
+            /* Segments are scanned only through their seglist */
+            break;
+
+        default:
+            /* There should be no invalid types */
+            PM_RAISE(retval, PM_RET_EX_SYS);
+            break;
+    }
+
+    return retval;
+}
+
+
+/* Marks the references of every object on the mark stack until it is empty */
+static PmReturn_t
+heap_gcDrainMarkStack(void)
+{
+    PmReturn_t retval = PM_RET_OK;
+
+    while (pmHeap.mark_stack_index > 0)
+    {
+        retval = heap_gcScanObj(
+            pmHeap.mark_stack[--pmHeap.mark_stack_index]);
+        PM_RETURN_IF_ERROR(retval);
+    }
+    return retval;
+}
+
+
+/*
+ * Recovers from a mark stack overflow.  Walks the heap and scans every
+ * marked object so that any object that was marked but could not be pushed
+ * has its references marked.  Repeats until a walk causes no overflow.
+ */
+static PmReturn_t
+heap_gcRescanHeap(void)
+{
+    PmReturn_t retval = PM_RET_OK;
+    pPmObj_t pobj;
+    uint8_t *pend;
+    uint8_t r;
+
+    while (pmHeap.mark_overflow)
+    {
+        pmHeap.mark_overflow = C_FALSE;
+
+        /* The native frame is the one root that is not in the heap */
+        retval = heap_gcScanObj((pPmObj_t)&gVmGlobal.nativeframe);
+        PM_RETURN_IF_ERROR(retval);
+        retval = heap_gcDrainMarkStack();
+        PM_RETURN_IF_ERROR(retval);
+
+        for (r = 0; r < pmHeap.nregions; r++)
+        {
+            pobj = (pPmObj_t)pmHeap.regions[r].base;
+            pend = &pmHeap.regions[r].base[pmHeap.regions[r].size];
+            while ((uint8_t *)pobj < pend)
+            {
+                if (OBJ_GET_FREE(pobj))
+                {
+                    pobj = (pPmObj_t)((uint8_t *)pobj + CHUNK_GET_SIZE(pobj));
+                    continue;
+                }
+
+                if (OBJ_GET_GCVAL(HEAP_CHUNK_OBJ(pobj)) == pmHeap.gcval)
+                {
+                    retval = heap_gcScanObj(HEAP_CHUNK_OBJ(pobj));
+                    PM_RETURN_IF_ERROR(retval);
+                    retval = heap_gcDrainMarkStack();
+                    PM_RETURN_IF_ERROR(retval);
+                }
+                pobj = (pPmObj_t)((uint8_t *)pobj + heap_getChunkSize(pobj));
+            }
+        }
+
+#ifdef HAVE_HEAP_POOLS
+        for (pobj = heap_poolNextObj(C_NULL); pobj != C_NULL;
+             pobj = heap_poolNextObj(pobj))
+        {
+            if (OBJ_GET_GCVAL(pobj) == pmHeap.gcval)
+            {
+                retval = heap_gcScanObj(pobj);
+                PM_RETURN_IF_ERROR(retval);
+                retval = heap_gcDrainMarkStack();
+                PM_RETURN_IF_ERROR(retval);
+            }
+        }
+#endif /* HAVE_HEAP_POOLS */
+    }
+    return retval;
+}
+
+
+/* Marks a root object and everything reachable from it */
+static PmReturn_t
+heap_gcMarkRoot(pPmObj_t pobj)
+{
+    PmReturn_t retval;
+
+    retval = heap_gcMarkObj(pobj);
+    PM_RETURN_IF_ERROR(retval);
+    return heap_gcDrainMarkStack();
+}
+
+
+/*
+ * Marks the root objects and all objects reachable from the roots
+ * using the mark stack.  Does not change the GC marking value.
+ */
+static PmReturn_t
+heap_gcMarkRootObjs(void)
+{
+    PmReturn_t retval;
+    uint8_t i;
+#if USE_STRING_CACHE
+    pPmStringTable_t *pptable;
+#endif /* USE_STRING_CACHE */
+
+    /* Mark the constant objects */
+    retval = heap_gcMarkRoot(PM_NONE);
+    PM_RETURN_IF_ERROR(retval);
+    retval = heap_gcMarkRoot(PM_FALSE);
+    PM_RETURN_IF_ERROR(retval);
+    retval = heap_gcMarkRoot(PM_TRUE);
+    PM_RETURN_IF_ERROR(retval);
+    retval = heap_gcMarkRoot(PM_ZERO);
+    PM_RETURN_IF_ERROR(retval);
+    retval = heap_gcMarkRoot(PM_ONE);
+    PM_RETURN_IF_ERROR(retval);
+    retval = heap_gcMarkRoot(PM_NEGONE);
+    PM_RETURN_IF_ERROR(retval);
+    retval = heap_gcMarkRoot(PM_CODE_STR);
+    PM_RETURN_IF_ERROR(retval);
+
+    /* Mark the VM's name strings; the string cache does not keep them */
+#ifdef HAVE_CLASSES
+    retval = heap_gcMarkRoot((pPmObj_t)gVmGlobal.pinitStr);
+    PM_RETURN_IF_ERROR(retval);
+#endif /* HAVE_CLASSES */
+#ifdef HAVE_GENERATORS
+    retval = heap_gcMarkRoot((pPmObj_t)gVmGlobal.pgenStr);
+    PM_RETURN_IF_ERROR(retval);
+    retval = heap_gcMarkRoot((pPmObj_t)gVmGlobal.pnextStr);
+    PM_RETURN_IF_ERROR(retval);
+#endif /* HAVE_GENERATORS */
+#ifdef HAVE_ASSERT
+    retval = heap_gcMarkRoot((pPmObj_t)gVmGlobal.pexnStr);
+    PM_RETURN_IF_ERROR(retval);
+#endif /* HAVE_ASSERT */
+#ifdef HAVE_BYTEARRAY
+    retval = heap_gcMarkRoot((pPmObj_t)gVmGlobal.pbaStr);
+    PM_RETURN_IF_ERROR(retval);
+#endif /* HAVE_BYTEARRAY */
+    retval = heap_gcMarkRoot((pPmObj_t)gVmGlobal.pmdStr);
+    PM_RETURN_IF_ERROR(retval);
+
+    /* Mark the builtins dict */
+    retval = heap_gcMarkRoot(PM_PBUILTINS);
+    PM_RETURN_IF_ERROR(retval);
+
+    /* Mark the native frame if it is active */
+    retval = heap_gcMarkRoot((pPmObj_t)&gVmGlobal.nativeframe);
+    PM_RETURN_IF_ERROR(retval);
+
+    /* Mark the thread list */
+    retval = heap_gcMarkRoot((pPmObj_t)gVmGlobal.threadList);
+    PM_RETURN_IF_ERROR(retval);
+
+#if USE_STRING_CACHE
+    /* Mark the string cache, but not its strings */
+    retval = string_getCache(&pptable);
+    if (pptable != C_NULL)
+    {
+        retval = heap_gcMarkRoot((pPmObj_t)*pptable);
+        PM_RETURN_IF_ERROR(retval);
+    }
+#endif /* USE_STRING_CACHE */
+
+    /* Mark the temporary roots */
+    for (i = 0; i < pmHeap.temp_root_index; i++)
+    {
+        retval = heap_gcMarkRoot(pmHeap.temp_roots[i]);
+        PM_RETURN_IF_ERROR(retval);
+    }
+
+    /* Mark what was missed if the mark stack overflowed */
+    return heap_gcRescanHeap();
+}
+
+
+/*
+ * Marks the root objects so they won't be collected during the sweep phase.
+ * Marks all objects reachable from the roots using the mark stack.
+ */
+static PmReturn_t
+heap_gcMarkRoots(void)
+{
+    /* Toggle the GC marking value so it differs from the last run */
+    pmHeap.gcval ^= 1;
+    pmHeap.mark_stack_index = 0;
+    pmHeap.mark_overflow = C_FALSE;
+#ifdef HAVE_GC_LAZY_SWEEP
+    pmHeap.gc_live = 0;
+#endif /* HAVE_GC_LAZY_SWEEP */
+
+    return heap_gcMarkRootObjs();
+}
+
+
+#if USE_STRING_CACHE
+/**
+ * Deletes unmarked strings from the string cache.
+ * This function must only be called by the GC after the heap has been marked
+ * and before the heap has been swept.
+ *
+ * The cache does not mark its strings, so a string that nothing else
+ * references is collected; its slot must not point to the freed chunk.
+ *
+ * @param gcval The current value for chunks marked by the GC
+ */
+static PmReturn_t
+heap_purgeStringCache(uint8_t gcval)
+{
+    PmReturn_t retval;
+    pPmStringTable_t *pptable;
+    pPmStringTable_t ptable;
+    uint16_t i;
+
+    retval = string_getCache(&pptable);
+    if ((pptable == C_NULL) || (*pptable == C_NULL))
+    {
+        return retval;
+    }
+
+    /* Replace each unmarked string by a deleted slot */
+    ptable = *pptable;
+    for (i = 0; i < ptable->length; i++)
+    {
+        if ((ptable->st_slot[i] != C_NULL)
+            && (ptable->st_slot[i] != (pPmString_t)PM_NONE)
+            && (OBJ_GET_GCVAL(ptable->st_slot[i]) != gcval))
+        {
+            ptable->st_slot[i] = (pPmString_t)PM_NONE;
+            ptable->count--;
+        }
+    }
+
+    return retval;
+}
+#endif
+
+
+/*
+ * Reclaims any object that does not have a current mark, starting at the
+ * sweep cursor.  Puts it in the free list.  Coalesces all contiguous free
+ * chunks within each region.  Stops at the end of the last region, once the
+ * given number of chunks has been visited or once a free chunk of at least
+ * the given size (if not zero) is in the free list; the sweep cursor is left
+ * where the next sweep resumes.
+ */
+static PmReturn_t
+heap_gcSweepChunks(uint32_t budget, uint16_t size)
+{
+    PmReturn_t retval;
+    pPmObj_t pobj;
+    pPmHeapDesc_t pchunk;
+    uint16_t totalchunksize;
+    uint16_t chunksize;
+    uint8_t *pend;
+
+    pobj = pmHeap.sweep_ptr;
+    while (HEAP_SWEEP_PENDING() && (budget > 0))
+    {
+        /* Move on to the next region at the end of this one */
+        pend = &pmHeap.regions[pmHeap.sweep_region].base
+                   [pmHeap.regions[pmHeap.sweep_region].size];
+        if ((uint8_t *)pobj >= pend)
+        {
+            pmHeap.sweep_region++;
+            pobj = HEAP_SWEEP_PENDING()
+                   ? (pPmObj_t)pmHeap.regions[pmHeap.sweep_region].base
+                   : C_NULL;
+            continue;
+        }
+
+        /* Skip a marked chunk */
+        if (!OBJ_GET_FREE(pobj)
+            && (OBJ_GET_GCVAL(HEAP_CHUNK_OBJ(pobj)) == pmHeap.gcval))
+        {
+            pobj = (pPmObj_t)((uint8_t *)pobj + heap_getChunkSize(pobj));
+            budget--;
+            pmHeap.gc_work++;
+            continue;
+        }
+
+        /* Accumulate the sizes of all consecutive unmarked or free chunks */
+        totalchunksize = 0;
+
+        /* Coalesce all contiguous free chunks */
+        pchunk = (pPmHeapDesc_t)pobj;
+        while (OBJ_GET_FREE(pchunk)
+               || (!OBJ_GET_FREE(pchunk)
+                   && (OBJ_GET_GCVAL(HEAP_CHUNK_OBJ((pPmObj_t)pchunk))
+                       != pmHeap.gcval)))
+        {
+            /*
+             * If the chunk is already free, unlink it because its size
+             * is about to change
+             */
+            if (OBJ_GET_FREE(pchunk))
+            {
+                if ((totalchunksize + CHUNK_GET_SIZE(pchunk))
+                    > HEAP_MAX_FREE_CHUNK_SIZE)
+                {
+                    break;
+                }
+                retval = heap_unlinkFromFreelist(pchunk);
+                PM_RETURN_IF_ERROR(retval);
+            }
+
+            /* Otherwise free and reclaim the unmarked chunk */
+            else
+            {
+                chunksize = heap_getChunkSize((pPmObj_t)pchunk);
+                if ((totalchunksize + chunksize) > HEAP_MAX_FREE_CHUNK_SIZE)
+                {
+                    break;
+                }
+                pchunk->hd = 0;
+                OBJ_SET_FREE(pchunk, 1);
+                CHUNK_SET_SIZE(pchunk, chunksize);
+                pmHeap.gc_reclaimed += chunksize;
+#ifdef HAVE_GC_LAZY_SWEEP
+                pmHeap.gc_garbage -= (chunksize < pmHeap.gc_garbage)
+                                     ? chunksize : pmHeap.gc_garbage;
+#endif /* HAVE_GC_LAZY_SWEEP */
+            }
+            totalchunksize = totalchunksize + CHUNK_GET_SIZE(pchunk);
+            if (budget > 0)
+            {
+                budget--;
+            }
+            pmHeap.gc_work++;
+
+            C_DEBUG_PRINT(VERBOSITY_HIGH, "heap_gcSweep(), id=%p, s=%d\n",
+                          pchunk, CHUNK_GET_SIZE(pchunk));
+
+            /* Proceed to the next chunk */
+            pchunk = (pPmHeapDesc_t)
+                ((uint8_t *)pchunk + CHUNK_GET_SIZE(pchunk));
+
+            /* Stop if it's past the end of the region */
+            if ((uint8_t *)pchunk >= pend)
+            {
+                break;
+            }
+        }
+
+        /* Set the heap descriptor data */
+        OBJ_SET_FREE(pobj, 1);
+        CHUNK_SET_SIZE(pobj, totalchunksize);
+
+        /* Insert chunk into free list */
+        retval = heap_linkToFreelist((pPmHeapDesc_t)pobj);
+        PM_RETURN_IF_ERROR(retval);
+
+        /* Continue to the next chunk */
+        pobj = (pPmObj_t)pchunk;
+
+        /* Stop once a chunk of the wanted size is free */
+        if ((size != 0) && (totalchunksize >= size))
+        {
+            break;
+        }
+    }
+
+    /* Step past the end of the last region so the sweep is seen as done */
+    if ((pmHeap.sweep_region == (pmHeap.nregions - 1))
+        && ((uint8_t *)pobj
+            >= &pmHeap.regions[pmHeap.sweep_region].base
+                   [pmHeap.regions[pmHeap.sweep_region].size]))
+    {
+        pmHeap.sweep_region++;
+        pobj = C_NULL;
+    }
+    pmHeap.sweep_ptr = pobj;
+
+    if (!HEAP_SWEEP_PENDING())
+    {
+#ifdef HAVE_GC_LAZY_SWEEP
+        pmHeap.gc_garbage = 0;
+#endif /* HAVE_GC_LAZY_SWEEP */
+#ifdef HAVE_HEAP_GROW
+        heap_releaseRegions();
+#endif /* HAVE_HEAP_GROW */
+    }
+    return PM_RET_OK;
+}
+
+
+#ifdef HAVE_HEAP_POOLS
+/* Returns the pool objects that do not have a current mark to their pools */
+static void
+heap_poolSweep(void)
+{
+    pPmObj_t pobj;
+
+    for (pobj = heap_poolNextObj(C_NULL); pobj != C_NULL;
+         pobj = heap_poolNextObj(pobj))
+    {
+        if (OBJ_GET_GCVAL(pobj) != pmHeap.gcval)
+        {
+            pmHeap.gc_reclaimed += PM_OBJ_GET_SIZE(pobj);
+            heap_poolFreeSlot(pobj);
+        }
+        pmHeap.gc_work++;
+    }
+}
+#endif /* HAVE_HEAP_POOLS */
+
+
+/* Prepares the sweep phase; must be called after the heap has been marked */
+static PmReturn_t
+heap_gcStartSweep(void)
+{
+    PmReturn_t retval = PM_RET_OK;
+
+#if USE_STRING_CACHE
+    retval = heap_purgeStringCache(pmHeap.gcval);
+#endif
+
+#ifdef HAVE_GC_NURSERY
+    heap_nurserySweep();
+#endif /* HAVE_GC_NURSERY */
+
+#ifdef HAVE_HEAP_POOLS
+    heap_poolSweep();
+#endif /* HAVE_HEAP_POOLS */
+
+    /* Start at the base of the first region */
+    pmHeap.sweep_region = 0;
+    pmHeap.sweep_ptr = (pPmObj_t)pmHeap.regions[0].base;
+    pmHeap.gc_fullcount++;
+
+#ifdef HAVE_GC_LAZY_SWEEP
+    /* Whatever is neither free nor marked is garbage left for the sweep */
+    pmHeap.gc_garbage = ((pmHeap.avail + pmHeap.gc_live) < pmHeap.size)
+                        ? (pmHeap.size - pmHeap.avail - pmHeap.gc_live) : 0;
+#endif /* HAVE_GC_LAZY_SWEEP */
+    return retval;
+}
+
+
+#ifndef HAVE_GC_LAZY_SWEEP
+/* Sweeps the whole heap */
+static PmReturn_t
+heap_gcSweep(void)
+{
+    PmReturn_t retval;
+
+    retval = heap_gcStartSweep();
+    PM_RETURN_IF_ERROR(retval);
+    return heap_gcSweepChunks(0xFFFFFFFF, 0);
+}
+#endif /* !HAVE_GC_LAZY_SWEEP */
+
+
+/* Starts the accounting of one GC pause */
+static void
+heap_gcStartPause(uint32_t *r_startms)
+{
+    pmHeap.gc_work = 0;
+    *r_startms = pm_timerMsTicks;
+}
+
+
+/* Records the GC pause if it is the longest so far */
+static void
+heap_gcEndPause(uint32_t startms)
+{
+    uint32_t ms = pm_timerMsTicks - startms;
+
+    pmHeap.gc_totalms += ms;
+    if (pmHeap.gc_work > pmHeap.gc_maxpausework)
+    {
+        pmHeap.gc_maxpausework = pmHeap.gc_work;
+    }
+    if (ms > pmHeap.gc_maxpausems)
+    {
+        pmHeap.gc_maxpausems = ms;
+    }
+}
+
+
+#ifdef HAVE_GC_NURSERY
+/*
+ * Collects the nursery.  A young object survives if it is referenced by
+ * a remembered object, a temporary root, the native frame or the frame
+ * of any thread.  Survivors become old and stay in place; their slots are
+ * reclaimed only by a full collection.  Every other young slot is freed.
+ */
+static void
+heap_gcMinor(void)
+{
+    pPmObj_t pobj;
+    pPmFrame_t pframe;
+    uint32_t startms;
+    uint16_t nfree;
+    uint16_t i;
+    uint8_t *pend;
+    uint8_t r;
+
+    heap_gcStartPause(&startms);
+    pmHeap.gc_minorcount++;
+
+    /* Check the remembered objects, or every object if the set overflowed */
+    if (pmHeap.remset_overflow)
+    {
+        for (r = 0; r < pmHeap.nregions; r++)
+        {
+            pobj = (pPmObj_t)pmHeap.regions[r].base;
+            pend = &pmHeap.regions[r].base[pmHeap.regions[r].size];
+            while ((uint8_t *)pobj < pend)
+            {
+                if (OBJ_GET_FREE(pobj))
+                {
+                    pobj = (pPmObj_t)((uint8_t *)pobj + CHUNK_GET_SIZE(pobj));
+                    continue;
+                }
+                heap_nurseryScanObj(HEAP_CHUNK_OBJ(pobj), C_TRUE);
+                pmHeap.gc_work++;
+                pobj = (pPmObj_t)((uint8_t *)pobj + heap_getChunkSize(pobj));
+            }
+        }
+#ifdef HAVE_HEAP_POOLS
+        for (pobj = heap_poolNextObj(C_NULL); pobj != C_NULL;
+             pobj = heap_poolNextObj(pobj))
+        {
+            heap_nurseryScanObj(pobj, C_TRUE);
+            pmHeap.gc_work++;
+        }
+#endif /* HAVE_HEAP_POOLS */
+    }
+    else
+    {
+        for (i = 0; i < pmHeap.remset_index; i++)
+        {
+            heap_nurseryScanObj(pmHeap.remset[i], C_TRUE);
+            pmHeap.gc_work++;
+        }
+    }
+
+    /* Check the temporary roots and the objects they reference */
+    for (i = 0; i < pmHeap.temp_root_index; i++)
+    {
+        heap_nurseryVisit(pmHeap.temp_roots[i], C_TRUE);
+        heap_nurseryScanObj(pmHeap.temp_roots[i], C_TRUE);
+    }
+
+    /* Frames change without a barrier, so check every thread's frames */
+    heap_nurseryScanObj((pPmObj_t)&gVmGlobal.nativeframe, C_TRUE);
+    if (gVmGlobal.threadList != C_NULL)
+    {
+        for (i = 0; i < gVmGlobal.threadList->length; i++)
+        {
+            if (list_getItem((pPmObj_t)gVmGlobal.threadList, i, &pobj)
+                != PM_RET_OK)
+            {
+                break;
+            }
+            for (pframe = ((pPmThread_t)pobj)->pframe;
+                 pframe != C_NULL; pframe = pframe->fo_back)
+            {
+                heap_nurseryScanObj((pPmObj_t)pframe, C_TRUE);
+                pmHeap.gc_work++;
+            }
+        }
+    }
+    if (gVmGlobal.nativeframe.nf_active)
+    {
+        for (pframe = gVmGlobal.nativeframe.nf_back;
+             pframe != C_NULL; pframe = pframe->fo_back)
+        {
+            heap_nurseryScanObj((pPmObj_t)pframe, C_TRUE);
+        }
+    }
+
+    /* Free the young slots that were not promoted */
+    nfree = 0;
+    for (i = 0; i < pmHeap.nursery_slots; i++)
+    {
+        if (NURSERY_GET_BIT(pmHeap.nursery_used, i)
+            && !NURSERY_GET_BIT(pmHeap.nursery_old, i))
+        {
+            heap_nurseryFreeSlot(i);
+            pmHeap.gc_reclaimed += HEAP_NURSERY_SLOT_SIZE;
+        }
+        if (!NURSERY_GET_BIT(pmHeap.nursery_used, i))
+        {
+            nfree++;
+        }
+    }
+    pmHeap.gc_work += pmHeap.nursery_slots;
+
+    pmHeap.remset_index = 0;
+    pmHeap.remset_overflow = C_FALSE;
+    pmHeap.nursery_next = 0;
+
+    /* Stop using the nursery if it is mostly old objects */
+    if (nfree < (pmHeap.nursery_slots >> 2))
+    {
+        pmHeap.nursery_full = C_TRUE;
+    }
+
+    heap_gcEndPause(startms);
+}
+
+
+/* Takes the next free nursery slot at or after the bump index */
+static uint8_t
+heap_nurseryBump(uint8_t **r_pchunk)
+{
+    pPmObj_t pobj;
+    uint16_t i;
+
+    i = pmHeap.nursery_next;
+    while (i < pmHeap.nursery_slots)
+    {
+        /* Skip eight slots in use at a time */
+        if (pmHeap.nursery_used[i >> 3] == 0xFF)
+        {
+            i = (i | 7) + 1;
+            continue;
+        }
+        if (NURSERY_GET_BIT(pmHeap.nursery_used, i))
+        {
+            i++;
+            continue;
+        }
+
+        NURSERY_SET_BIT(pmHeap.nursery_used, i);
+        pmHeap.nursery_next = i + 1;
+
+        pobj = (pPmObj_t)&pmHeap.nursery[i * HEAP_NURSERY_SLOT_SIZE];
+        pobj->od = 0;
+        OBJ_SET_SIZE(pobj, HEAP_NURSERY_SLOT_SIZE);
+#ifdef HAVE_GC_INCREMENTAL
+        OBJ_SET_GCVAL(pobj, (pmHeap.gc_state == HEAP_GC_MARK)
+                            ? (pmHeap.gcval ^ 1) : pmHeap.gcval);
+#else
+        OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+#endif /* HAVE_GC_INCREMENTAL */
+#ifdef HAVE_HEAP_STATS
+        pmHeap.allocs++;
+        pmHeap.allocbytes += HEAP_NURSERY_SLOT_SIZE;
+#endif /* HAVE_HEAP_STATS */
+        *r_pchunk = (uint8_t *)pobj;
+        return C_TRUE;
+    }
+
+    pmHeap.nursery_next = i;
+    return C_FALSE;
+}
+
+
+/* Obtains a chunk for a small, short-lived object */
+PmReturn_t
+heap_getNurseryChunk(uint16_t requestedsize, uint8_t **r_pchunk)
+{
+    if ((requestedsize <= HEAP_NURSERY_SLOT_SIZE) && !pmHeap.nursery_full)
+    {
+        if (heap_nurseryBump(r_pchunk))
+        {
+            return PM_RET_OK;
+        }
+
+        /* The nursery is full; collect it if it is safe to do so */
+        if ((pmHeap.nursery_slots > 0) && (pmHeap.auto_gc == C_TRUE)
+            && (gVmGlobal.nativeframe.nf_active == C_FALSE))
+        {
+            heap_gcMinor();
+            if (!pmHeap.nursery_full && heap_nurseryBump(r_pchunk))
+            {
+                return PM_RET_OK;
+            }
+        }
+    }
+
+    return heap_getChunk(requestedsize, r_pchunk);
+}
+#endif /* HAVE_GC_NURSERY */
+
+
+#ifdef HAVE_GC_INCREMENTAL
+/* Scans a frame and its callers, even those already marked */
+static PmReturn_t
+heap_gcRescanFrames(pPmFrame_t pframe)
+{
+    PmReturn_t retval = PM_RET_OK;
+
+    while (pframe != C_NULL)
+    {
+#ifdef HAVE_FRAME_STACK
+        /* A frame in a frame stack is marked with its segment */
+        if (pframe->fo_stack != C_NULL)
+        {
+            retval = heap_gcMarkObj((pPmObj_t)pframe);
+            PM_RETURN_IF_ERROR(retval);
+        }
+        else
+#endif /* HAVE_FRAME_STACK */
+        {
+#ifdef HAVE_GC_LAZY_SWEEP
+            if (OBJ_GET_GCVAL(pframe) != pmHeap.gcval)
+            {
+                pmHeap.gc_live += heap_gcObjChunkSize((pPmObj_t)pframe);
+            }
+#endif /* HAVE_GC_LAZY_SWEEP */
+            OBJ_SET_GCVAL(pframe, pmHeap.gcval);
+        }
+        retval = heap_gcScanObj((pPmObj_t)pframe);
+        PM_RETURN_IF_ERROR(retval);
+        retval = heap_gcDrainMarkStack();
+        PM_RETURN_IF_ERROR(retval);
+        pframe = pframe->fo_back;
+    }
+    return retval;
+}
+
+
+/*
+ * Completes the mark phase of an incremental cycle.  This step is atomic.
+ * Objects that are mutated without a write barrier (frames, threads and
+ * the native frame) are rescanned, the roots are marked again and the
+ * marking is finished.  Then the string cache is purged and the sweep
+ * phase is entered.
+ */
+static PmReturn_t
+heap_gcFinishMark(void)
+{
+    PmReturn_t retval;
+    pPmObj_t pobj;
+    int16_t i;
+
+    retval = heap_gcDrainMarkStack();
+    PM_RETURN_IF_ERROR(retval);
+
+    /*
+     * Frame stacks and locals change without a write barrier,
+     * so rescan every frame of every thread's call chain
+     */
+    for (i = 0; i < gVmGlobal.threadList->length; i++)
+    {
+        retval = list_getItem((pPmObj_t)gVmGlobal.threadList, i, &pobj);
+        PM_RETURN_IF_ERROR(retval);
+        retval = heap_gcRescanFrames(((pPmThread_t)pobj)->pframe);
+        PM_RETURN_IF_ERROR(retval);
+    }
+    if (gVmGlobal.nativeframe.nf_active)
+    {
+        retval = heap_gcRescanFrames(gVmGlobal.nativeframe.nf_back);
+        PM_RETURN_IF_ERROR(retval);
+    }
+
+    /* Rescan the native frame, then mark the roots and what they reach */
+    retval = heap_gcScanObj((pPmObj_t)&gVmGlobal.nativeframe);
+    PM_RETURN_IF_ERROR(retval);
+    retval = heap_gcMarkRootObjs();
+    PM_RETURN_IF_ERROR(retval);
+
+    pmHeap.gc_state = HEAP_GC_SWEEP;
+    return heap_gcStartSweep();
+}
+
+
+/* Runs any incremental cycle in progress to completion */
+static PmReturn_t
+heap_gcFinishCycle(void)
+{
+    PmReturn_t retval = PM_RET_OK;
+
+    if (pmHeap.gc_state == HEAP_GC_MARK)
+    {
+        retval = heap_gcFinishMark();
+        PM_RETURN_IF_ERROR(retval);
+    }
+    if (pmHeap.gc_state == HEAP_GC_SWEEP)
+    {
+        retval = heap_gcSweepChunks(0xFFFFFFFF, 0);
+        pmHeap.gc_state = HEAP_GC_IDLE;
+    }
+    return retval;
+}
+
+
+/* Does a bounded amount of incremental GC work */
+PmReturn_t
+heap_gcStep(void)
+{
+    PmReturn_t retval = PM_RET_OK;
+    uint32_t startms;
+    uint8_t i;
+
+    /* Do nothing unless a cycle is running or the heap is half used */
+    if ((pmHeap.gc_state == HEAP_GC_IDLE)
+        && ((pmHeap.auto_gc != C_TRUE)
+            || (pmHeap.avail >= (pmHeap.size >> 1))))
+    {
+        return retval;
+    }
+
+    heap_gcStartPause(&startms);
+
+    switch (pmHeap.gc_state)
+    {
+        case HEAP_GC_IDLE:
+            /* Start a cycle: toggle the mark value and gray the roots */
+            pmHeap.gcval ^= 1;
+            pmHeap.mark_stack_index = 0;
+            pmHeap.mark_overflow = C_FALSE;
+#ifdef HAVE_GC_LAZY_SWEEP
+            pmHeap.gc_live = 0;
+#endif /* HAVE_GC_LAZY_SWEEP */
+            pmHeap.gc_state = HEAP_GC_MARK;
+
+            retval = heap_gcMarkObj(PM_PBUILTINS);
+            PM_BREAK_IF_ERROR(retval);
+            retval = heap_gcMarkObj((pPmObj_t)gVmGlobal.threadList);
+            PM_BREAK_IF_ERROR(retval);
+            for (i = 0; i < pmHeap.temp_root_index; i++)
+            {
+                retval = heap_gcMarkObj(pmHeap.temp_roots[i]);
+                PM_BREAK_IF_ERROR(retval);
+            }
+            break;
+
+        case HEAP_GC_MARK:
+            /* Mark the references of up to budget gray objects */
+            while ((pmHeap.mark_stack_index > 0)
+                   && (pmHeap.gc_work < pmHeap.gc_budget))
+            {
+                retval = heap_gcScanObj(
+                    pmHeap.mark_stack[--pmHeap.mark_stack_index]);
+                PM_BREAK_IF_ERROR(retval);
+            }
+            PM_BREAK_IF_ERROR(retval);
+
+            /* When no gray objects remain, finish the mark phase */
+            if (pmHeap.mark_stack_index == 0)
+            {
+                retval = heap_gcFinishMark();
+            }
+            break;
+
+        case HEAP_GC_SWEEP:
+            retval = heap_gcSweepChunks(pmHeap.gc_budget, 0);
+            if (!HEAP_SWEEP_PENDING())
+            {
+                pmHeap.gc_state = HEAP_GC_IDLE;
             }
             break;
+    }
 
-        case OBJ_TYPE_LST:
-
-            /* Mark the list */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+    heap_gcEndPause(startms);
+    return retval;
+}
 
-            /* Mark the seglist */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmList_t)pobj)->val);
-            break;
 
-        case OBJ_TYPE_DIC:
-            /* Mark the dict head */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+/* Sets the number of objects marked or chunks swept per GC step */
+PmReturn_t
+heap_gcSetStepBudget(uint16_t budget)
+{
+    pmHeap.gc_budget = (budget > 0) ? budget : 1;
+    return PM_RET_OK;
+}
+#endif /* HAVE_GC_INCREMENTAL */
 
-            /* Mark the keys seglist */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmDict_t)pobj)->d_keys);
-            PM_RETURN_IF_ERROR(retval);
 
-            /* Mark the vals seglist */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmDict_t)pobj)->d_vals);
-            break;
+#if defined(HAVE_GC_INCREMENTAL) || defined(HAVE_GC_NURSERY)
+/* Records a store of an object into a container */
+void
+heap_gcWriteBarrier(pPmObj_t pcontainer, pPmObj_t pobj)
+{
+#ifdef HAVE_GC_INCREMENTAL
+    /* Gray the stored object while the GC is marking */
+    if (pmHeap.gc_state == HEAP_GC_MARK)
+    {
+        heap_gcMarkObj(pobj);
+    }
+#endif /* HAVE_GC_INCREMENTAL */
 
-        case OBJ_TYPE_COB:
-            /* Mark the code obj head */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+#ifdef HAVE_GC_NURSERY
+    /* Remember the container if it now references a young object */
+    if (heap_nurseryVisit(pobj, C_FALSE))
+    {
+        heap_nurseryRemember(pcontainer);
+    }
+#endif /* HAVE_GC_NURSERY */
+}
 
-            /* Mark the names tuple */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmCo_t)pobj)->co_names);
-            PM_RETURN_IF_ERROR(retval);
 
-            /* Mark the consts tuple */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmCo_t)pobj)->co_consts);
-            PM_RETURN_IF_ERROR(retval);
+/* Records that an object was filled or mutated without the write barrier */
+void
+heap_gcRescanBarrier(pPmObj_t pobj)
+{
+#ifdef HAVE_GC_INCREMENTAL
+    /* Gray an already marked object again */
+    if ((pmHeap.gc_state == HEAP_GC_MARK)
+        && (OBJ_GET_GCVAL(pobj) == pmHeap.gcval))
+    {
+        OBJ_SET_GCVAL(pobj, pmHeap.gcval ^ 1);
+#ifdef HAVE_GC_LAZY_SWEEP
+        pmHeap.gc_live -= heap_gcObjChunkSize(pobj);
+#endif /* HAVE_GC_LAZY_SWEEP */
+        heap_gcMarkObj(pobj);
+    }
+#endif /* HAVE_GC_INCREMENTAL */
 
-            /* #122: Mark the code image if it is in RAM */
-            if (((pPmCo_t)pobj)->co_memspace == MEMSPACE_RAM)
-            {
-                retval = heap_gcMarkObj((pPmObj_t)
-                                        (((pPmCo_t)pobj)->co_codeimgaddr));
-                PM_RETURN_IF_ERROR(retval);
-            }
+#ifdef HAVE_GC_NURSERY
+    /* Remember the object if it references a young object */
+    if (heap_nurseryScanObj(pobj, C_FALSE))
+    {
+        heap_nurseryRemember(pobj);
+    }
+#endif /* HAVE_GC_NURSERY */
+}
+#endif /* HAVE_GC_INCREMENTAL || HAVE_GC_NURSERY */
 
-#ifdef HAVE_CLOSURES
-            /* #256: Add support for closures */
-            /* Mark the cellvars tuple */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmCo_t)pobj)->co_cellvars);
-#endif /* HAVE_CLOSURES */
-            break;
 
-        case OBJ_TYPE_MOD:
-        case OBJ_TYPE_FXN:
-            /* Module and Func objs are implemented via the PmFunc_t */
-            /* Mark the func obj head */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+/*
+ * Runs the mark-sweep garbage collector.  With HAVE_GC_LAZY_SWEEP and lazy
+ * set, the sweep is left to heap_getChunk(); otherwise it is finished here.
+ */
+static PmReturn_t
+heap_gcRunImpl(uint8_t lazy)
+{
+    PmReturn_t retval;
+    uint32_t startms;
 
-            /* Mark the code obj */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmFunc_t)pobj)->f_co);
-            PM_RETURN_IF_ERROR(retval);
+    /* #239: Fix GC when 2+ unlinked allocs occur */
+    /* This assertion fails when there are too many objects on the temporary
+     * root stack and a GC occurs; consider increasing PM_HEAP_NUM_TEMP_ROOTS
+     */
+    C_ASSERT(pmHeap.temp_root_index < HEAP_NUM_TEMP_ROOTS);
 
-            /* Mark the attr dict */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmFunc_t)pobj)->f_attrs);
-            PM_RETURN_IF_ERROR(retval);
+    C_DEBUG_PRINT(VERBOSITY_LOW, "heap_gcRun()\n");
 
-            /* Mark the globals dict */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmFunc_t)pobj)->f_globals);
-            PM_RETURN_IF_ERROR(retval);
+    heap_gcStartPause(&startms);
 
-#ifdef HAVE_DEFAULTARGS
-            /* Mark the default args tuple */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmFunc_t)pobj)->f_defaultargs);
-            PM_RETURN_IF_ERROR(retval);
-#endif /* HAVE_DEFAULTARGS */
+#ifdef HAVE_GC_INCREMENTAL
+    /* A full collection must not interleave with an incremental cycle */
+    retval = heap_gcFinishCycle();
+    PM_RETURN_IF_ERROR(retval);
+#endif /* HAVE_GC_INCREMENTAL */
 
-#ifdef HAVE_CLOSURES
-            /* #256: Mark the closure tuple */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmFunc_t)pobj)->f_closure);
-#endif /* HAVE_CLOSURES */
-            break;
+#ifdef HAVE_GC_LAZY_SWEEP
+    /* The last collection's garbage must be swept before marks change */
+    retval = heap_gcSweepChunks(0xFFFFFFFF, 0);
+    PM_RETURN_IF_ERROR(retval);
+#endif /* HAVE_GC_LAZY_SWEEP */
 
-#ifdef HAVE_CLASSES
-        case OBJ_TYPE_CLI:
-            /* Mark the obj head */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+    retval = heap_gcMarkRoots();
+    PM_RETURN_IF_ERROR(retval);
 
-            /* Mark the class */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmInstance_t)pobj)->cli_class);
-            PM_RETURN_IF_ERROR(retval);
+#ifdef HAVE_GC_LAZY_SWEEP
+    /* Leave the sweep to heap_getChunk() */
+    retval = heap_gcStartSweep();
+#ifdef HAVE_GC_INCREMENTAL
+    /* and to the incremental steps */
+    pmHeap.gc_state = HEAP_GC_SWEEP;
+#endif /* HAVE_GC_INCREMENTAL */
 
-            /* Mark the attrs dict */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmInstance_t)pobj)->cli_attrs);
-            break;
+    /* unless the whole collection was asked for */
+    if ((retval == PM_RET_OK) && !lazy)
+    {
+        retval = heap_gcSweepChunks(0xFFFFFFFF, 0);
+#ifdef HAVE_GC_INCREMENTAL
+        pmHeap.gc_state = HEAP_GC_IDLE;
+#endif /* HAVE_GC_INCREMENTAL */
+    }
+#else
+    /*heap_dump();*/
+    retval = heap_gcSweep();
+    /*heap_dump();*/
+#endif /* HAVE_GC_LAZY_SWEEP */
 
-        case OBJ_TYPE_MTH:
-            /* Mark the obj head */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+    heap_gcEndPause(startms);
+    return retval;
+}
 
-            /* Mark the instance */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmMethod_t)pobj)->m_instance);
-            PM_RETURN_IF_ERROR(retval);
 
-            /* Mark the func */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmMethod_t)pobj)->m_func);
-            PM_RETURN_IF_ERROR(retval);
+PmReturn_t
+heap_gcRun(void)
+{
+    return heap_gcRunImpl(C_TRUE);
+}
 
-            /* Mark the attrs dict */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmMethod_t)pobj)->m_attrs);
-            break;
 
-        case OBJ_TYPE_CLO:
-            /* Mark the obj head */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+PmReturn_t
+heap_gcCollect(void)
+{
+    return heap_gcRunImpl(C_FALSE);
+}
 
-            /* Mark the attrs dict */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmClass_t)pobj)->cl_attrs);
-            PM_RETURN_IF_ERROR(retval);
 
-            /* Mark the base tuple */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmClass_t)pobj)->cl_bases);
-            break;
-#endif /* HAVE_CLASSES */
+#ifdef HAVE_GC_COMPACT
+/*
+ * Returns where the given address is after the current compaction pass.
+ * An address in the pass's region moves down by the size of the gaps
+ * below it.  Works for pointers into an object and for a pointer just
+ * past the end of one, such as a full frame's stack pointer.
+ */
+static uint8_t *
+heap_compactForward(uint8_t const *p)
+{
+    uint8_t lo;
+    uint8_t hi;
+    uint8_t mid;
 
-        /*
-         * An obj in ram should not be of these types.
-         * Images arrive in RAM as string objects (image is array of bytes)
-         */
-        case OBJ_TYPE_CIM:
-        case OBJ_TYPE_NIM:
-            PM_RAISE(retval, PM_RET_EX_SYS);
-            return retval;
+    if ((p <= pmHeap.compact_gap[0]) || (p >= pmHeap.compact_end))
+    {
+        return (uint8_t *)p;
+    }
 
-        case OBJ_TYPE_FRM:
+    /* Find the last gap that starts below p */
+    lo = 0;
+    hi = pmHeap.compact_ngaps - 1;
+    while (lo < hi)
+    {
+        mid = (uint8_t)((lo + hi + 1) >> 1);
+        if (pmHeap.compact_gap[mid] < p)
         {
-            pPmObj_t *ppobj2 = C_NULL;
+            lo = mid;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+    return (uint8_t *)p - pmHeap.compact_shift[lo];
+}
 
-            /* Mark the frame obj head */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
 
-            /* Mark the previous frame, if this isn't a generator's frame */
-            /* Issue #129: Fix iterator losing its object */
-            if ((((pPmFrame_t)pobj)->fo_func->f_co->co_flags & CO_GENERATOR) == 0)
-            {
-                retval = heap_gcMarkObj((pPmObj_t)((pPmFrame_t)pobj)->fo_back);
-                PM_RETURN_IF_ERROR(retval);
-            }
+/** Updates a pointer field (of any pointer type) for the compaction pass */
+#define HEAP_COMPACT_FIX(field) \
+    do \
+    { \
+        *(uint8_t **)(void *)&(field) = \
+            heap_compactForward((uint8_t const *)(field)); \
+    } \
+    while (0)
 
-            /* Mark the fxn obj */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmFrame_t)pobj)->fo_func);
-            PM_RETURN_IF_ERROR(retval);
 
-            /* Mark the blockstack */
-            retval = heap_gcMarkObj((pPmObj_t)
-                                    ((pPmFrame_t)pobj)->fo_blockstack);
-            PM_RETURN_IF_ERROR(retval);
+/** Updates a field that may hold any object, including a tagged int */
+#define HEAP_COMPACT_FIX_OBJ(field) \
+    do \
+    { \
+        if (!OBJ_IS_TAGGED(field)) \
+        { \
+            HEAP_COMPACT_FIX(field); \
+        } \
+    } \
+    while (0)
 
-            /* Mark the attrs dict */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmFrame_t)pobj)->fo_attrs);
-            PM_RETURN_IF_ERROR(retval);
 
-            /* Mark the globals dict */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmFrame_t)pobj)->fo_globals);
-            PM_RETURN_IF_ERROR(retval);
+/* Updates every pointer field held by the given live object */
+static void
+heap_compactFixObj(pPmObj_t pobj)
+{
+    pPmObj_t *ppobj;
+    int16_t i;
 
-            /* Mark each obj in the locals list and the stack */
-            ppobj2 = ((pPmFrame_t)pobj)->fo_locals;
-            while (ppobj2 < ((pPmFrame_t)pobj)->fo_sp)
+    switch (OBJ_GET_TYPE(pobj))
+    {
+#if USE_STRING_CACHE
+        case OBJ_TYPE_STB:
+            for (i = 0; i < ((pPmStringTable_t)pobj)->length; i++)
             {
-                retval = heap_gcMarkObj(*ppobj2);
-                PM_RETURN_IF_ERROR(retval);
-                ppobj2++;
+                HEAP_COMPACT_FIX(((pPmStringTable_t)pobj)->st_slot[i]);
             }
             break;
-        }
+#endif /* USE_STRING_CACHE */
 
-        case OBJ_TYPE_BLK:
-            /* Mark the block obj head */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+        case OBJ_TYPE_TUP:
+            for (i = 0; i < ((pPmTuple_t)pobj)->length; i++)
+            {
+                HEAP_COMPACT_FIX_OBJ(((pPmTuple_t)pobj)->val[i]);
+            }
+            break;
 
-            /* Mark the next block in the stack */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmBlock_t)pobj)->next);
+        case OBJ_TYPE_LST:
+#ifdef HAVE_LIST_ARRAYS
+            /* The items in use are fixed in the array before it moves */
+            if ((((pPmList_t)pobj)->val != C_NULL)
+                && (OBJ_GET_TYPE(((pPmList_t)pobj)->val) == OBJ_TYPE_LAR))
+            {
+                for (i = 0; i < ((pPmList_t)pobj)->length; i++)
+                {
+                    HEAP_COMPACT_FIX_OBJ(((pPmListArray_t)
+                        ((pPmList_t)pobj)->val)->la_val[i]);
+                }
+            }
+#endif /* HAVE_LIST_ARRAYS */
+            HEAP_COMPACT_FIX(((pPmList_t)pobj)->val);
             break;
 
-        case OBJ_TYPE_SGL:
-            /* Mark the seglist obj head */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+        case OBJ_TYPE_DIC:
+#ifdef HAVE_HASHED_DICTS
+            HEAP_COMPACT_FIX(((pPmDict_t)pobj)->d_table);
+#else
+            HEAP_COMPACT_FIX(((pPmDict_t)pobj)->d_keys);
+#endif /* HAVE_HASHED_DICTS */
+            HEAP_COMPACT_FIX(((pPmDict_t)pobj)->d_vals);
+            break;
 
-            /* Mark the seglist's segments */
-            n = ((pSeglist_t)pobj)->sl_length;
-            pobj = (pPmObj_t)((pSeglist_t)pobj)->sl_rootseg;
-            for (i = 0; i < n; i++)
+#ifdef HAVE_HASHED_DICTS
+        case OBJ_TYPE_DTB:
+            for (i = 0; i < ((pPmDictTable_t)pobj)->length; i++)
             {
-                /* Mark the segment item */
-                retval = heap_gcMarkObj(((pSegment_t)pobj)->s_val[i % SEGLIST_OBJS_PER_SEG]);
-                PM_RETURN_IF_ERROR(retval);
+                HEAP_COMPACT_FIX_OBJ(
+                    ((pPmDictTable_t)pobj)->dt_slot[i].ds_key);
+                HEAP_COMPACT_FIX_OBJ(
+                    ((pPmDictTable_t)pobj)->dt_slot[i].ds_val);
+            }
+            break;
+#endif /* HAVE_HASHED_DICTS */
 
-                /* Mark the segment obj head */
-                if ((i % SEGLIST_OBJS_PER_SEG) == 0)
+        case OBJ_TYPE_COB:
+            /* The code pointers point into the image, which may be in RAM */
+            HEAP_COMPACT_FIX(((pPmCo_t)pobj)->co_codeimgaddr);
+            HEAP_COMPACT_FIX(((pPmCo_t)pobj)->co_names);
+            HEAP_COMPACT_FIX(((pPmCo_t)pobj)->co_consts);
+            HEAP_COMPACT_FIX(((pPmCo_t)pobj)->co_codeaddr);
+#ifdef HAVE_DEBUG_INFO
+            HEAP_COMPACT_FIX(((pPmCo_t)pobj)->co_lnotab);
+            HEAP_COMPACT_FIX(((pPmCo_t)pobj)->co_filename);
+#endif /* HAVE_DEBUG_INFO */
+#ifdef HAVE_CLOSURES
+            HEAP_COMPACT_FIX(((pPmCo_t)pobj)->co_cellvars);
+#endif /* HAVE_CLOSURES */
+#ifdef HAVE_INLINE_CACHES
+            HEAP_COMPACT_FIX(((pPmCo_t)pobj)->co_cache);
+            HEAP_COMPACT_FIX(((pPmCo_t)pobj)->co_attrcache);
+#endif /* HAVE_INLINE_CACHES */
+            break;
+
+#ifdef HAVE_INLINE_CACHES
+        case OBJ_TYPE_ICA:
+            for (i = 0; i < ((pPmInlineCache_t)pobj)->length; i++)
+            {
+                if (((pPmInlineCache_t)pobj)->ic_kind == ICA_KIND_GLOBALS)
                 {
-                    OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+                    HEAP_COMPACT_FIX_OBJ(
+                        ((pPmInlineCache_t)pobj)->ic_entry[i].ce_val);
                 }
-
-                /* Point to the next segment */
                 else
-                if ((i % SEGLIST_OBJS_PER_SEG) == (SEGLIST_OBJS_PER_SEG - 1))
                 {
-                    pobj = (pPmObj_t)((pSegment_t)pobj)->next;
-                    if (pobj == C_NULL)
-                    {
-                        break;
-                    }
+                    HEAP_COMPACT_FIX(
+                        ((pPmAttrCache_t)pobj)->ac_entry[i].ae_class);
+                    HEAP_COMPACT_FIX_OBJ(
+                        ((pPmAttrCache_t)pobj)->ac_entry[i].ae_val);
                 }
             }
             break;
+#endif /* HAVE_INLINE_CACHES */
 
-        case OBJ_TYPE_SQI:
-            /* Mark the sequence iterator obj head */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+        case OBJ_TYPE_MOD:
+        case OBJ_TYPE_FXN:
+            HEAP_COMPACT_FIX(((pPmFunc_t)pobj)->f_co);
+            HEAP_COMPACT_FIX(((pPmFunc_t)pobj)->f_attrs);
+            HEAP_COMPACT_FIX(((pPmFunc_t)pobj)->f_globals);
+#ifdef HAVE_DEFAULTARGS
+            HEAP_COMPACT_FIX(((pPmFunc_t)pobj)->f_defaultargs);
+#endif /* HAVE_DEFAULTARGS */
+#ifdef HAVE_CLOSURES
+            HEAP_COMPACT_FIX(((pPmFunc_t)pobj)->f_closure);
+#endif /* HAVE_CLOSURES */
+            break;
 
-            /* Mark the sequence */
-            retval = heap_gcMarkObj(((pPmSeqIter_t)pobj)->si_sequence);
+#ifdef HAVE_CLASSES
+        case OBJ_TYPE_CLI:
+            HEAP_COMPACT_FIX(((pPmInstance_t)pobj)->cli_class);
+            HEAP_COMPACT_FIX(((pPmInstance_t)pobj)->cli_attrs);
             break;
 
-        case OBJ_TYPE_THR:
-            /* Mark the thread obj head */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+        case OBJ_TYPE_MTH:
+            HEAP_COMPACT_FIX(((pPmMethod_t)pobj)->m_instance);
+            HEAP_COMPACT_FIX(((pPmMethod_t)pobj)->m_func);
+            HEAP_COMPACT_FIX(((pPmMethod_t)pobj)->m_attrs);
+            break;
 
-            /* Mark the current frame */
-            retval = heap_gcMarkObj((pPmObj_t)((pPmThread_t)pobj)->pframe);
+        case OBJ_TYPE_CLO:
+            HEAP_COMPACT_FIX(((pPmClass_t)pobj)->cl_attrs);
+            HEAP_COMPACT_FIX(((pPmClass_t)pobj)->cl_bases);
+            break;
+#endif /* HAVE_CLASSES */
+
+        case OBJ_TYPE_FRM:
+            /* Fix the locals and the stack before the stack pointer */
+            for (ppobj = ((pPmFrame_t)pobj)->fo_locals;
+                 ppobj < ((pPmFrame_t)pobj)->fo_sp; ppobj++)
+            {
+                HEAP_COMPACT_FIX_OBJ(*ppobj);
+            }
+            HEAP_COMPACT_FIX(((pPmFrame_t)pobj)->fo_back);
+            HEAP_COMPACT_FIX(((pPmFrame_t)pobj)->fo_func);
+            HEAP_COMPACT_FIX(((pPmFrame_t)pobj)->fo_ip);
+
+            /* The blocks point into the frame and its code */
+            for (i = 0; i < ((pPmFrame_t)pobj)->fo_nblocks; i++)
+            {
+                HEAP_COMPACT_FIX(((pPmFrame_t)pobj)->fo_blocks[i].b_sp);
+                HEAP_COMPACT_FIX(((pPmFrame_t)pobj)->fo_blocks[i].b_handler);
+            }
+            HEAP_COMPACT_FIX(((pPmFrame_t)pobj)->fo_blocks);
+#ifdef HAVE_FRAME_STACK
+            HEAP_COMPACT_FIX(((pPmFrame_t)pobj)->fo_stack);
+#endif /* HAVE_FRAME_STACK */
+            HEAP_COMPACT_FIX(((pPmFrame_t)pobj)->fo_attrs);
+            HEAP_COMPACT_FIX(((pPmFrame_t)pobj)->fo_globals);
+            HEAP_COMPACT_FIX(((pPmFrame_t)pobj)->fo_sp);
+            break;
+
+        case OBJ_TYPE_SGL:
+            HEAP_COMPACT_FIX(((pSeglist_t)pobj)->sl_rootseg);
+            HEAP_COMPACT_FIX(((pSeglist_t)pobj)->sl_lastseg);
+            break;
+
+        case OBJ_TYPE_SEG:
+            for (i = 0; i < SEGLIST_OBJS_PER_SEG; i++)
+            {
+                HEAP_COMPACT_FIX_OBJ(((pSegment_t)pobj)->s_val[i]);
+            }
+            HEAP_COMPACT_FIX(((pSegment_t)pobj)->next);
             break;
 
-        case OBJ_TYPE_NFM:
-            /*
-             * Mark the obj desc.  This doesn't really do much since the
-             * native frame is declared static (not from the heap), but this
-             * is here in case that ever changes
-             */
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+        case OBJ_TYPE_SQI:
+            HEAP_COMPACT_FIX(((pPmSeqIter_t)pobj)->si_sequence);
 
-            /* Mark the native frame's remaining fields if active */
-            if (gVmGlobal.nativeframe.nf_active)
+            /* A stale cursor may point at a freed segment, so drop it */
+            if (((pPmSeqIter_t)pobj)->si_unlinks != gVmGlobal.segUnlinks)
             {
-                /* Mark the frame stack */
-                retval = heap_gcMarkObj((pPmObj_t)
-                                        gVmGlobal.nativeframe.nf_back);
-                PM_RETURN_IF_ERROR(retval);
+                ((pPmSeqIter_t)pobj)->si_seg = C_NULL;
+            }
+            HEAP_COMPACT_FIX(((pPmSeqIter_t)pobj)->si_seg);
+            break;
 
-                /* Mark the function object */
-                retval = heap_gcMarkObj((pPmObj_t)
-                                        gVmGlobal.nativeframe.nf_func);
-                PM_RETURN_IF_ERROR(retval);
+        case OBJ_TYPE_THR:
+            HEAP_COMPACT_FIX(((pPmThread_t)pobj)->pframe);
+#ifdef HAVE_FRAME_STACK
+            HEAP_COMPACT_FIX(((pPmThread_t)pobj)->fstack);
+#endif /* HAVE_FRAME_STACK */
+            break;
 
-                /* Mark the stack object */
-                retval = heap_gcMarkObj(gVmGlobal.nativeframe.nf_stack);
-                PM_RETURN_IF_ERROR(retval);
+#ifdef HAVE_FRAME_STACK
+        case OBJ_TYPE_FST:
+        {
+            pPmFrame_t pframe;
+            pPmFrame_t pnext;
 
-                /* Mark the args to the native func */
-                for (i = 0; i < NATIVE_GET_NUM_ARGS(); i++)
-                {
-                    retval =
-                        heap_gcMarkObj(gVmGlobal.nativeframe.nf_locals[i]);
-                    PM_RETURN_IF_ERROR(retval);
-                }
+            /* Find each frame's end before its fields are fixed */
+            for (pframe = (pPmFrame_t)FRAME_STACK_BASE(pobj);
+                 (uint8_t *)pframe < ((pPmFrameStack_t)pobj)->fs_top;
+                 pframe = pnext)
+            {
+                pnext = (pPmFrame_t)FRAME_GET_END(pframe);
+                heap_compactFixObj((pPmObj_t)pframe);
             }
+            HEAP_COMPACT_FIX(((pPmFrameStack_t)pobj)->fs_prev);
+            HEAP_COMPACT_FIX(((pPmFrameStack_t)pobj)->fs_next);
+            HEAP_COMPACT_FIX(((pPmFrameStack_t)pobj)->fs_top);
             break;
+        }
+#endif /* HAVE_FRAME_STACK */
 
 #ifdef HAVE_BYTEARRAY
         case OBJ_TYPE_BYA:
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
-
-            retval = heap_gcMarkObj((pPmObj_t)((pPmBytearray_t)pobj)->val);
-            break;
-
-        case OBJ_TYPE_BYS:
-            OBJ_SET_GCVAL(pobj, pmHeap.gcval);
+            HEAP_COMPACT_FIX(((pPmBytearray_t)pobj)->val);
             break;
 #endif /* HAVE_BYTEARRAY */
 
+        /* Other objects hold no pointers */
         default:
-            /* There should be no invalid types */
-            PM_RAISE(retval, PM_RET_EX_SYS);
             break;
     }
-    return retval;
 }
 
 
-/*
- * Marks the root objects so they won't be collected during the sweep phase.
- * Recursively marks all objects reachable from the roots.
- */
-static PmReturn_t
-heap_gcMarkRoots(void)
+/* Updates every pointer into the heap that is held outside the heap */
+static void
+heap_compactFixRoots(void)
 {
-    PmReturn_t retval;
+    pPmStringTable_t *pptable;
     uint8_t i;
 
-    /* Toggle the GC marking value so it differs from the last run */
-    pmHeap.gcval ^= 1;
-
-    /* Mark the constant objects */
-    retval = heap_gcMarkObj(PM_NONE);
-    PM_RETURN_IF_ERROR(retval);
-    retval = heap_gcMarkObj(PM_FALSE);
-    PM_RETURN_IF_ERROR(retval);
-    retval = heap_gcMarkObj(PM_TRUE);
-    PM_RETURN_IF_ERROR(retval);
-    retval = heap_gcMarkObj(PM_ZERO);
-    PM_RETURN_IF_ERROR(retval);
-    retval = heap_gcMarkObj(PM_ONE);
-    PM_RETURN_IF_ERROR(retval);
-    retval = heap_gcMarkObj(PM_NEGONE);
-    PM_RETURN_IF_ERROR(retval);
-    retval = heap_gcMarkObj(PM_CODE_STR);
-    PM_RETURN_IF_ERROR(retval);
-
-    /* Mark the builtins dict */
-    retval = heap_gcMarkObj(PM_PBUILTINS);
-    PM_RETURN_IF_ERROR(retval);
+    HEAP_COMPACT_FIX(gVmGlobal.pnone);
+    HEAP_COMPACT_FIX_OBJ(gVmGlobal.pzero);
+    HEAP_COMPACT_FIX_OBJ(gVmGlobal.pone);
+    HEAP_COMPACT_FIX_OBJ(gVmGlobal.pnegone);
+    HEAP_COMPACT_FIX(gVmGlobal.pfalse);
+    HEAP_COMPACT_FIX(gVmGlobal.ptrue);
+    HEAP_COMPACT_FIX(gVmGlobal.pcodeStr);
+    HEAP_COMPACT_FIX(gVmGlobal.builtins);
+    HEAP_COMPACT_FIX(gVmGlobal.threadList);
+    HEAP_COMPACT_FIX(gVmGlobal.pthread);
+#ifdef HAVE_CLASSES
+    HEAP_COMPACT_FIX(gVmGlobal.pinitStr);
+#endif /* HAVE_CLASSES */
+#ifdef HAVE_GENERATORS
+    HEAP_COMPACT_FIX(gVmGlobal.pgenStr);
+    HEAP_COMPACT_FIX(gVmGlobal.pnextStr);
+#endif /* HAVE_GENERATORS */
+#ifdef HAVE_ASSERT
+    HEAP_COMPACT_FIX(gVmGlobal.pexnStr);
+#endif /* HAVE_ASSERT */
+#ifdef HAVE_BYTEARRAY
+    HEAP_COMPACT_FIX(gVmGlobal.pbaStr);
+#endif /* HAVE_BYTEARRAY */
+    HEAP_COMPACT_FIX(gVmGlobal.pmdStr);
 
-    /* Mark the native frame if it is active */
-    retval = heap_gcMarkObj((pPmObj_t)&gVmGlobal.nativeframe);
-    PM_RETURN_IF_ERROR(retval);
+    /* An image path may point to an image that was loaded into RAM */
+    for (i = 0; i < gVmGlobal.imgPaths.pathcount; i++)
+    {
+        HEAP_COMPACT_FIX(gVmGlobal.imgPaths.pimg[i]);
+    }
 
-    /* Mark the thread list */
-    retval = heap_gcMarkObj((pPmObj_t)gVmGlobal.threadList);
-    PM_RETURN_IF_ERROR(retval);
+    /* The native frame is inactive, but keep its pointers consistent */
+    HEAP_COMPACT_FIX(gVmGlobal.nativeframe.nf_back);
+    HEAP_COMPACT_FIX(gVmGlobal.nativeframe.nf_func);
+    HEAP_COMPACT_FIX(gVmGlobal.nativeframe.nf_stack);
+    for (i = 0; i < NATIVE_MAX_NUM_LOCALS; i++)
+    {
+        HEAP_COMPACT_FIX_OBJ(gVmGlobal.nativeframe.nf_locals[i]);
+    }
 
-    /* Mark the temporary roots */
     for (i = 0; i < pmHeap.temp_root_index; i++)
     {
-        retval = heap_gcMarkObj(pmHeap.temp_roots[i]);
-        PM_RETURN_IF_ERROR(retval);
+        HEAP_COMPACT_FIX_OBJ(pmHeap.temp_roots[i]);
+    }
+#ifdef HAVE_GC_NURSERY
+    for (i = 0; i < pmHeap.remset_index; i++)
+    {
+        HEAP_COMPACT_FIX(pmHeap.remset[i]);
     }
+#endif /* HAVE_GC_NURSERY */
 
-    return retval;
+#if USE_STRING_CACHE
+    string_getCache(&pptable);
+    if (pptable != C_NULL)
+    {
+        HEAP_COMPACT_FIX(*pptable);
+    }
+#endif
 }
 
 
-#if USE_STRING_CACHE
-/**
- * Unlinks free objects from the string cache.
- * This function must only be called by the GC after the heap has been marked
- * and before the heap has been swept.
- *
- * This solves the problem where a string object would be collected
- * but its chunk was still linked into the free list
- *
- * @param gcval The current value for chunks marked by the GC
- */
-static PmReturn_t
-heap_purgeStringCache(uint8_t gcval)
+/* Turns the given region into free chunks; the region must not be tiny */
+static void
+heap_compactMakeFree(uint8_t *pchunk, uint32_t size)
 {
-    PmReturn_t retval;
-    pPmString_t *ppstrcache;
-    pPmString_t pstr;
+    uint32_t n;
 
-    /* Update string cache pointer if the first string objs are not marked */
-    retval = string_getCache(&ppstrcache);
-    if (ppstrcache == C_NULL)
+    while (size > 0)
     {
-        return retval;
+        /* Never leave a remainder too small to be a chunk */
+        n = (size > HEAP_MAX_FREE_CHUNK_SIZE) ? HEAP_MAX_FREE_CHUNK_SIZE : size;
+        if ((size - n > 0) && (size - n < HEAP_MIN_CHUNK_SIZE))
+        {
+            n -= HEAP_MIN_CHUNK_SIZE;
+        }
+
+        ((pPmHeapDesc_t)pchunk)->hd = 0;
+        OBJ_SET_FREE(pchunk, 1);
+        CHUNK_SET_SIZE(pchunk, n);
+        pchunk += n;
+        size -= n;
     }
-    while ((*ppstrcache != C_NULL) && (OBJ_GET_GCVAL(*ppstrcache) != gcval))
+}
+
+
+/*
+ * Does one compaction pass starting at the given chunk and ending at the
+ * end of its heap region.  Records the next
+ * runs of free chunks as gaps (up to HEAP_COMPACT_NUM_GAPS), fixes every
+ * pointer into the region they span, then slides the region's live chunks
+ * down over the gaps.  The gaps become free space at the end of the region.
+ * Returns C_FALSE, and changes nothing, if no live chunk follows a gap.
+ */
+static uint8_t
+heap_compactPass(uint8_t **ppstart, uint8_t *pend)
+{
+    uint8_t *pchunk;
+    uint8_t *pdest;
+    uint8_t *pgapend = C_NULL;
+    uint8_t *pregionend;
+    uint32_t shift = 0;
+    uint16_t size;
+    uint8_t moved = C_FALSE;
+    intptr_t *pfrom;
+    intptr_t *pto;
+    uint16_t n;
+    uint8_t r;
+#ifdef HAVE_HEAP_POOLS
+    pPmObj_t pobj;
+#endif /* HAVE_HEAP_POOLS */
+
+    /* Record the gaps and find the end of the region */
+    pmHeap.compact_ngaps = 0;
+    pmHeap.compact_end = pend;
+    for (pchunk = *ppstart; pchunk < pend; pchunk += size)
     {
-        *ppstrcache = (*ppstrcache)->next;
+        size = heap_getChunkSize((pPmObj_t)pchunk);
+        if (!OBJ_GET_FREE(pchunk))
+        {
+            moved |= (pmHeap.compact_ngaps > 0);
+            continue;
+        }
+
+        /* A free chunk that follows a gap makes the gap bigger */
+        shift += size;
+        if ((pmHeap.compact_ngaps > 0) && (pchunk == pgapend))
+        {
+            pmHeap.compact_shift[pmHeap.compact_ngaps - 1] = shift;
+            pgapend = pchunk + size;
+            continue;
+        }
+        if (pmHeap.compact_ngaps == HEAP_COMPACT_NUM_GAPS)
+        {
+            pmHeap.compact_end = pchunk;
+            shift -= size;
+            break;
+        }
+        pgapend = pchunk + size;
+        pmHeap.compact_gap[pmHeap.compact_ngaps] = pchunk;
+        pmHeap.compact_shift[pmHeap.compact_ngaps] = shift;
+        pmHeap.compact_ngaps++;
     }
-    if (*ppstrcache == C_NULL)
+    if (!moved)
     {
-        return retval;
+        return C_FALSE;
     }
 
-    /* Unlink remaining strings that are not marked */
-    for (pstr = *ppstrcache; pstr->next != C_NULL;)
+    /* Fix the pointers held by every live chunk and by the roots */
+    for (r = 0; r < pmHeap.nregions; r++)
     {
-        /* Unlink consecutive non-marked strings */
-        while ((pstr->next != C_NULL) && (OBJ_GET_GCVAL(pstr->next) != gcval))
+        pregionend = &pmHeap.regions[r].base[pmHeap.regions[r].size];
+        for (pchunk = pmHeap.regions[r].base; pchunk < pregionend;
+             pchunk += size)
         {
-            pstr->next = pstr->next->next;
+            size = heap_getChunkSize((pPmObj_t)pchunk);
+            if (!OBJ_GET_FREE(pchunk))
+            {
+                heap_compactFixObj(HEAP_CHUNK_OBJ((pPmObj_t)pchunk));
+                pmHeap.gc_work++;
+            }
         }
+    }
+#ifdef HAVE_HEAP_POOLS
+    for (pobj = heap_poolNextObj(C_NULL); pobj != C_NULL;
+         pobj = heap_poolNextObj(pobj))
+    {
+        heap_compactFixObj(pobj);
+        pmHeap.gc_work++;
+    }
+#endif /* HAVE_HEAP_POOLS */
+    heap_compactFixRoots();
 
-        /* If not at end of cache, string must be marked, skip it */
-        if (pstr->next != C_NULL)
+    /*
+     * Slide the region's live chunks down, in address order.  A chunk only
+     * moves down, so copying it a word at a time from its start is safe.
+     */
+    for (pchunk = pmHeap.compact_gap[0]; pchunk < pmHeap.compact_end;
+         pchunk += size)
+    {
+        size = heap_getChunkSize((pPmObj_t)pchunk);
+        if (OBJ_GET_FREE(pchunk))
+        {
+            continue;
+        }
+        pdest = heap_compactForward(pchunk);
+        pfrom = (intptr_t *)pchunk;
+        pto = (intptr_t *)pdest;
+        for (n = size / sizeof(intptr_t); n > 0; n--)
         {
-            pstr = pstr->next;
+            *pto++ = *pfrom++;
         }
     }
 
-    return retval;
+    /* The next pass starts at the free space left at the end of the region */
+    *ppstart = pmHeap.compact_end - shift;
+    heap_compactMakeFree(*ppstart, shift);
+    return C_TRUE;
 }
-#endif
 
 
 /*
- * Reclaims any object that does not have a current mark.
- * Puts it in the free list.  Coalesces all contiguous free chunks.
+ * Rebuilds the free list from the heap, coalescing adjacent free chunks
+ * within each region
  */
 static PmReturn_t
-heap_gcSweep(void)
+heap_compactRelink(void)
 {
-    PmReturn_t retval;
-    pPmObj_t pobj;
-    pPmHeapDesc_t pchunk;
-    uint16_t totalchunksize;
+    PmReturn_t retval = PM_RET_OK;
+    uint8_t *pchunk;
+    uint8_t *pnext;
+    uint8_t *pend;
+    uint32_t size;
+    uint8_t r;
 
-#if USE_STRING_CACHE
-    retval = heap_purgeStringCache(pmHeap.gcval);
-#endif
+    sli_memset((unsigned char *)pmHeap.bins, 0, sizeof(pmHeap.bins));
+    pmHeap.smallmap = 0;
+    pmHeap.largemap = 0;
+    pmHeap.avail = 0;
 
-    /* Start at the base of the heap */
-    pobj = (pPmObj_t)pmHeap.base;
-    while ((uint8_t *)pobj < &pmHeap.base[pmHeap.size])
+    for (r = 0; r < pmHeap.nregions; r++)
     {
-        /* Skip to the next unmarked or free chunk within the heap */
-        while (!OBJ_GET_FREE(pobj)
-               && (OBJ_GET_GCVAL(pobj) == pmHeap.gcval)
-               && ((uint8_t *)pobj < &pmHeap.base[pmHeap.size]))
-        {
-            pobj = (pPmObj_t)((uint8_t *)pobj + PM_OBJ_GET_SIZE(pobj));
-        }
-
-        /* Stop if reached the end of the heap */
-        if ((uint8_t *)pobj >= &pmHeap.base[pmHeap.size])
-        {
-            break;
-        }
-
-        /* Accumulate the sizes of all consecutive unmarked or free chunks */
-        totalchunksize = 0;
-
-        /* Coalesce all contiguous free chunks */
-        pchunk = (pPmHeapDesc_t)pobj;
-        while (OBJ_GET_FREE(pchunk)
-               || (!OBJ_GET_FREE(pchunk)
-                   && (OBJ_GET_GCVAL(pchunk) != pmHeap.gcval)))
+        pend = &pmHeap.regions[r].base[pmHeap.regions[r].size];
+        for (pchunk = pmHeap.regions[r].base; pchunk < pend; pchunk = pnext)
         {
-            /*
-             * If the chunk is already free, unlink it because its size
-             * is about to change
-             */
-            if (OBJ_GET_FREE(pchunk))
+            size = heap_getChunkSize((pPmObj_t)pchunk);
+            pnext = pchunk + size;
+            if (!OBJ_GET_FREE(pchunk))
             {
-                if ((totalchunksize + CHUNK_GET_SIZE(pchunk))
-                    > HEAP_MAX_FREE_CHUNK_SIZE)
-                {
-                    break;
-                }
-                retval = heap_unlinkFromFreelist(pchunk);
-                PM_RETURN_IF_ERROR(retval);
+                continue;
             }
 
-            /* Otherwise free and reclaim the unmarked chunk */
-            else
+            while ((pnext < pend) && OBJ_GET_FREE(pnext)
+                   && (size + CHUNK_GET_SIZE(pnext)
+                       <= HEAP_MAX_FREE_CHUNK_SIZE))
             {
-                if ((totalchunksize + PM_OBJ_GET_SIZE(pchunk))
-                    > HEAP_MAX_FREE_CHUNK_SIZE)
-                {
-                    break;
-                }
-                OBJ_SET_TYPE(pchunk, 0);
-                OBJ_SET_FREE(pchunk, 1);
+                size += CHUNK_GET_SIZE(pnext);
+                pnext += CHUNK_GET_SIZE(pnext);
             }
-            totalchunksize = totalchunksize + CHUNK_GET_SIZE(pchunk);
+            CHUNK_SET_SIZE(pchunk, size);
+            retval = heap_linkToFreelist((pPmHeapDesc_t)pchunk);
+            PM_RETURN_IF_ERROR(retval);
+        }
+    }
+    return retval;
+}
 
-            C_DEBUG_PRINT(VERBOSITY_HIGH, "heap_gcSweep(), id=%p, s=%d\n",
-                          pchunk, CHUNK_GET_SIZE(pchunk));
 
-            /* Proceed to the next chunk */
-            pchunk = (pPmHeapDesc_t)
-                ((uint8_t *)pchunk + CHUNK_GET_SIZE(pchunk));
+#ifdef HAVE_HASHED_DICTS
+/* Puts back in reach the dict items whose keys hash by a moved address */
+static void
+heap_compactRehash(void)
+{
+    uint8_t *pchunk;
+    uint8_t *pend;
+    uint16_t size;
+    uint8_t r;
+#ifdef HAVE_HEAP_POOLS
+    pPmObj_t pobj;
+#endif /* HAVE_HEAP_POOLS */
 
-            /* Stop if it's past the end of the heap */
-            if ((uint8_t *)pchunk >= &pmHeap.base[pmHeap.size])
+    for (r = 0; r < pmHeap.nregions; r++)
+    {
+        pend = &pmHeap.regions[r].base[pmHeap.regions[r].size];
+        for (pchunk = pmHeap.regions[r].base; pchunk < pend; pchunk += size)
+        {
+            size = heap_getChunkSize((pPmObj_t)pchunk);
+            if (!OBJ_GET_FREE(pchunk)
+                && (OBJ_GET_TYPE(HEAP_CHUNK_OBJ((pPmObj_t)pchunk))
+                    == OBJ_TYPE_DTB))
             {
-                break;
+                dict_rehashTable(HEAP_CHUNK_OBJ((pPmObj_t)pchunk));
             }
         }
+    }
+#ifdef HAVE_HEAP_POOLS
+    for (pobj = heap_poolNextObj(C_NULL); pobj != C_NULL;
+         pobj = heap_poolNextObj(pobj))
+    {
+        if (OBJ_GET_TYPE(pobj) == OBJ_TYPE_DTB)
+        {
+            dict_rehashTable(pobj);
+        }
+    }
+#endif /* HAVE_HEAP_POOLS */
+}
+#endif /* HAVE_HASHED_DICTS */
 
-        /* Set the heap descriptor data */
-        OBJ_SET_FREE(pobj, 1);
-        CHUNK_SET_SIZE(pobj, totalchunksize);
 
-        /* Insert chunk into free list */
-        retval = heap_linkToFreelist((pPmHeapDesc_t)pobj);
+/* Collects garbage, then slides the live objects together */
+PmReturn_t
+heap_gcCompact(void)
+{
+    PmReturn_t retval;
+    uint32_t startms;
+    uint8_t *pstart;
+    uint8_t r;
+
+    C_DEBUG_PRINT(VERBOSITY_LOW, "heap_gcCompact()\n");
+
+    /*
+     * Only live objects may remain, and no incremental cycle may be running;
+     * unswept garbage would be moved and fixed up as if it were live
+     */
+    retval = heap_gcCollect();
+    PM_RETURN_IF_ERROR(retval);
+
+    heap_gcStartPause(&startms);
+    pmHeap.gc_compactcount++;
+
+    /* Each region is compacted on its own; no object moves between them */
+    for (r = 0; r < pmHeap.nregions; r++)
+    {
+        pstart = pmHeap.regions[r].base;
+        while (heap_compactPass(&pstart,
+                                &pmHeap.regions[r].base[pmHeap.regions[r].size]));
+    }
+#ifdef HAVE_HASHED_DICTS
+    heap_compactRehash();
+#endif /* HAVE_HASHED_DICTS */
+    retval = heap_compactRelink();
+#ifdef HAVE_HEAP_GROW
+    heap_releaseRegions();
+#endif /* HAVE_HEAP_GROW */
+
+    heap_gcEndPause(startms);
+    return retval;
+}
+
+
+/* Compacts the heap if it has become too fragmented */
+PmReturn_t
+heap_gcAutoCompact(void)
+{
+    /*
+     * Compact only if it is safe: not in a nested interpret() run,
+     * nor in one whose caller holds objects in C variables
+     */
+    if ((pmHeap.compact_threshold == 0) || (pmHeap.auto_gc != C_TRUE)
+        || (gVmGlobal.nativeframe.nf_active != C_FALSE)
+        || (gVmGlobal.interpNesting > 1))
+    {
+        return PM_RET_OK;
+    }
+
+#ifdef HAVE_GC_LAZY_SWEEP
+    /* The sweep may yet reclaim a big enough chunk without moving anything */
+    if (HEAP_SWEEP_PENDING()
+        && (heap_getMaxFree() < pmHeap.compact_threshold))
+    {
+        PmReturn_t retval;
+
+        retval = heap_gcSweepChunks(0xFFFFFFFF, pmHeap.compact_threshold);
         PM_RETURN_IF_ERROR(retval);
+    }
+#endif /* HAVE_GC_LAZY_SWEEP */
 
-        /* Continue to the next chunk */
-        pobj = (pPmObj_t)pchunk;
+    /*
+     * Compact only if no chunk of the threshold size is free
+     * and if there is enough free memory to make one
+     */
+    if ((pmHeap.avail < ((uint32_t)pmHeap.compact_threshold << 1))
+        || (heap_getMaxFree() >= pmHeap.compact_threshold))
+    {
+        return PM_RET_OK;
     }
 
-    return PM_RET_OK;
+    return heap_gcCompact();
 }
 
 
-/* Runs the mark-sweep garbage collector */
+/* Sets the largest free chunk size under which the heap is auto-compacted */
 PmReturn_t
-heap_gcRun(void)
+heap_gcSetCompactThreshold(uint16_t threshold)
 {
-    PmReturn_t retval;
+    pmHeap.compact_threshold = threshold;
+    return PM_RET_OK;
+}
+#endif /* HAVE_GC_COMPACT */
 
-    /* #239: Fix GC when 2+ unlinked allocs occur */
-    /* This assertion fails when there are too many objects on the temporary
-     * root stack and a GC occurs; consider increasing PM_HEAP_NUM_TEMP_ROOTS
-     */
-    C_ASSERT(pmHeap.temp_root_index < HEAP_NUM_TEMP_ROOTS);
 
-    C_DEBUG_PRINT(VERBOSITY_LOW, "heap_gcRun()\n");
+/* Returns the longest GC pause seen so far */
+void
+heap_gcGetMaxPause(uint32_t *r_work, uint32_t *r_ms)
+{
+    *r_work = pmHeap.gc_maxpausework;
+    *r_ms = pmHeap.gc_maxpausems;
+}
 
-    retval = heap_gcMarkRoots();
-    PM_RETURN_IF_ERROR(retval);
 
-    /*heap_dump();*/
-    retval = heap_gcSweep();
-    /*heap_dump();*/
-    return retval;
+/* Returns the number of full and minor collections so far */
+void
+heap_gcGetCounts(uint32_t *r_full, uint32_t *r_minor)
+{
+    *r_full = pmHeap.gc_fullcount;
+#ifdef HAVE_GC_NURSERY
+    *r_minor = pmHeap.gc_minorcount;
+#else
+    *r_minor = 0;
+#endif /* HAVE_GC_NURSERY */
 }
 
 
@@ -24,6 +24,97 @@
  */
 #define HEAP_GC_NF_THRESHOLD (512)
 
+#ifdef HAVE_GC_INCREMENTAL
+/**
+ * The default number of objects marked or chunks swept
+ * in one incremental GC step.
+ */
+#ifndef HEAP_GC_STEP_BUDGET
+#define HEAP_GC_STEP_BUDGET (64)
+#endif
+#endif /* HAVE_GC_INCREMENTAL */
+
+#ifdef HAVE_GC_COMPACT
+/**
+ * The default size in bytes under which the largest free chunk makes
+ * the interpreter compact the heap.  Zero disables automatic compaction.
+ */
+#ifndef HEAP_GC_COMPACT_THRESHOLD
+#define HEAP_GC_COMPACT_THRESHOLD (512)
+#endif
+#endif /* HAVE_GC_COMPACT */
+
+#if defined(HAVE_GC_INCREMENTAL) || defined(HAVE_GC_NURSERY)
+/** Records a store of pobj into pcontainer for the GC */
+#define HEAP_GC_WRITE_BARRIER(pcontainer, pobj) \
+    heap_gcWriteBarrier((pPmObj_t)(pcontainer), (pPmObj_t)(pobj))
+
+/** Records that pobj was mutated in a way the write barrier does not see */
+#define HEAP_GC_RESCAN_BARRIER(pobj) heap_gcRescanBarrier((pPmObj_t)(pobj))
+#else
+#define HEAP_GC_WRITE_BARRIER(pcontainer, pobj)
+#define HEAP_GC_RESCAN_BARRIER(pobj)
+#endif /* HAVE_GC_INCREMENTAL || HAVE_GC_NURSERY */
+
+
+/** The number of object types counted by the heap statistics */
+#ifdef HAVE_INLINE_CACHES
+#define HEAP_NUM_TYPES (OBJ_TYPE_ICA + 1)
+#else
+#define HEAP_NUM_TYPES (OBJ_TYPE_NFM + 1)
+#endif /* HAVE_INLINE_CACHES */
+
+
+/**
+ * Heap and GC statistics, as filled in by heap_getStats().
+ * Counters for features that are not configured are zero.
+ */
+typedef struct PmHeapStats_s
+{
+    /** Size of the heap in bytes */
+    uint32_t size;
+
+    /** Bytes available, including garbage that is not yet swept */
+    uint32_t avail;
+
+    /** Size in bytes of the largest free chunk */
+    uint16_t maxfree;
+
+    /** Number of chunks in the free list */
+    uint16_t nfree;
+
+    /** Number of full collections */
+    uint32_t gc_fullcount;
+
+    /** Number of minor collections of the nursery */
+    uint32_t gc_minorcount;
+
+    /** Number of compactions */
+    uint32_t gc_compactcount;
+
+    /** Milliseconds spent in GC pauses */
+    uint32_t gc_totalms;
+
+    /** The longest GC pause in milliseconds */
+    uint32_t gc_maxpausems;
+
+    /** The most work (objects marked plus chunks swept) in one GC pause */
+    uint32_t gc_maxpausework;
+
+    /** Bytes of garbage reclaimed by the GC */
+    uint32_t gc_reclaimed;
+
+    /** Number of chunks allocated (needs HAVE_HEAP_STATS) */
+    uint32_t allocs;
+
+    /** Bytes allocated (needs HAVE_HEAP_STATS) */
+    uint32_t allocbytes;
+
+    /** Number of objects created of each type (needs HAVE_HEAP_STATS) */
+    uint32_t typecount[HEAP_NUM_TYPES];
+} PmHeapStats_t,
+ *pPmHeapStats_t;
+
 
 #ifdef __DEBUG__
 #define DEBUG_PRINT_HEAP_AVAIL(s) \
@@ -43,11 +134,27 @@
  */
 PmReturn_t heap_init(uint8_t *base, uint32_t size);
 
+/**
+ * Adds a region of memory to the heap.
+ * The region need not be next to the heap's other regions;
+ * all of it is put in the free list.
+ *
+ * @param base The address where the region begins
+ * @param size The size in bytes (octets) of the region
+ * @return  Return code; PM_RET_EX_MEM if the region table is full
+ */
+PmReturn_t heap_addRegion(uint8_t *base, uint32_t size);
+
 /**
  * Returns a free chunk from the heap.
  *
  * The chunk will be at least the requested size.
- * The actual size can be found in the return chunk's od.od_size.
+ * The actual size is returned by heap_getObjSize().
+ * A request too big for the size field of an object descriptor
+ * is given a large chunk, which carries its size in a descriptor
+ * that precedes the object.
+ * With HAVE_HEAP_GROW, a request that a collection cannot satisfy
+ * makes the heap grow by a new region.
  *
  * @param   requestedsize Requested size of the chunk in bytes.
  * @param   r_pchunk Addr of ptr to chunk (return).
@@ -62,20 +169,79 @@ PmReturn_t heap_getChunk(uint16_t requestedsize, uint8_t **r_pchunk);
  */
 PmReturn_t heap_freeChunk(pPmObj_t ptr);
 
-/** @return  Return number of bytes available in the heap */
+/**
+ * @return  Return number of bytes available in the heap,
+ *          including garbage that is not yet swept
+ */
 uint32_t heap_getAvail(void);
 
 /** @return  Return the size of the heap in bytes */
 uint32_t heap_getSize(void);
 
+/** @return  Return the size in bytes of the largest free chunk */
+uint16_t heap_getMaxFree(void);
+
+/**
+ * Returns the usable size of an object's chunk, including large chunks.
+ *
+ * @param   pobj Ptr to the object
+ * @return  Return the size of the object's chunk in bytes
+ */
+uint16_t heap_getObjSize(pPmObj_t pobj);
+
+/**
+ * Gets the heap and GC statistics
+ *
+ * @param   r_stats Return by reference; the statistics
+ */
+void heap_getStats(pPmHeapStats_t r_stats);
+
+#ifdef HAVE_HEAP_STATS
+/**
+ * Counts the creation of an object of the given type.
+ * Called by OBJ_SET_TYPE().
+ *
+ * @param   type Type of the new object
+ */
+void heap_countObj(PmType_t type);
+#endif /* HAVE_HEAP_STATS */
+
+#ifdef HAVE_HEAP_POOLS
+/**
+ * Obtains a chunk for a fixed-size object of a type that has a pool:
+ * a block, a segment, a sequence iterator, or an int or a float if there
+ * is no nursery.  Pops the head of the pool's free list, falling back to
+ * heap_getChunk() if the pool has no free slot or the type has no pool.
+ * heap_freeChunk() and the GC return the slot to its pool.
+ *
+ * @param   type Type of the object
+ * @param   requestedsize Size of the object in bytes
+ * @param   r_pchunk Addr of ptr to chunk (return)
+ * @return  Return code
+ */
+PmReturn_t heap_getPoolChunk(PmType_t type, uint16_t requestedsize,
+                             uint8_t **r_pchunk);
+#endif /* HAVE_HEAP_POOLS */
+
 #ifdef HAVE_GC
 /**
- * Runs the mark-sweep garbage collector
+ * Runs the mark-sweep garbage collector.
+ * With HAVE_GC_LAZY_SWEEP, only the mark is done here;
+ * heap_getChunk() sweeps the heap as it needs memory.
  *
  * @return  Return code
  */
 PmReturn_t heap_gcRun(void);
 
+/**
+ * Runs the mark-sweep garbage collector to completion.
+ * Unlike heap_gcRun(), sweeps the whole heap even with HAVE_GC_LAZY_SWEEP,
+ * so that all of the garbage is free when it returns, as sys.gc() expects.
+ *
+ * @return  Return code
+ */
+PmReturn_t heap_gcCollect(void);
+
 /**
  * Enables (if true) or disables automatic garbage collection
  *
@@ -84,6 +250,113 @@ PmReturn_t heap_gcRun(void);
  */
 PmReturn_t heap_gcSetAuto(uint8_t auto_gc);
 
+/**
+ * Gets the longest GC pause so far, whether from a full collection
+ * or an incremental step.
+ *
+ * @param   r_work Return by reference; objects marked plus chunks swept
+ * @param   r_ms Return by reference; duration in milliseconds
+ */
+void heap_gcGetMaxPause(uint32_t *r_work, uint32_t *r_ms);
+
+/**
+ * Gets the number of collections so far
+ *
+ * @param   r_full Return by reference; number of full collections
+ * @param   r_minor Return by reference; number of minor collections
+ */
+void heap_gcGetCounts(uint32_t *r_full, uint32_t *r_minor);
+
+#ifdef HAVE_GC_INCREMENTAL
+/**
+ * Does one bounded unit of incremental GC work.
+ * Starts a new cycle when the heap is half used.
+ * Must only be called where all live objects are reachable from the roots,
+ * such as between bytecodes.
+ *
+ * @return  Return code
+ */
+PmReturn_t heap_gcStep(void);
+
+/**
+ * Sets the amount of work done in one incremental GC step
+ *
+ * @param   budget Number of objects marked or chunks swept per step
+ * @return  Return code
+ */
+PmReturn_t heap_gcSetStepBudget(uint16_t budget);
+#endif /* HAVE_GC_INCREMENTAL */
+
+#ifdef HAVE_GC_COMPACT
+/**
+ * Runs the garbage collector, then slides every live object toward the
+ * base of the heap and fixes up every pointer to it, so that all of the
+ * free memory ends up in one contiguous region.
+ * Must only be called where no C variable holds a pointer into the heap,
+ * such as between the bytecodes of an outermost interpret() run; native
+ * code and embedders must never call it.  Objects in the nursery are
+ * not moved.
+ *
+ * @return  Return code
+ */
+PmReturn_t heap_gcCompact(void);
+
+/**
+ * Compacts the heap if the largest free chunk is smaller than
+ * the compaction threshold and compacting would make a larger one.
+ * Does nothing while gVmGlobal.interpNesting is above one.
+ * Must only be called where heap_gcCompact() may be called.
+ *
+ * @return  Return code
+ */
+PmReturn_t heap_gcAutoCompact(void);
+
+/**
+ * Sets the size of the largest free chunk under which
+ * heap_gcAutoCompact() compacts the heap
+ *
+ * @param   threshold Size in bytes; zero disables automatic compaction
+ * @return  Return code
+ */
+PmReturn_t heap_gcSetCompactThreshold(uint16_t threshold);
+#endif /* HAVE_GC_COMPACT */
+
+#if defined(HAVE_GC_INCREMENTAL) || defined(HAVE_GC_NURSERY)
+/**
+ * Records that a reference to pobj was stored into pcontainer.
+ * Grays pobj if the incremental GC is marking, and remembers pcontainer
+ * if pobj is a young object in the nursery.
+ *
+ * @param   pcontainer Object stored into
+ * @param   pobj Object being stored
+ */
+void heap_gcWriteBarrier(pPmObj_t pcontainer, pPmObj_t pobj);
+
+/**
+ * Records that the given object was filled or mutated
+ * without going through the write barrier.
+ * Called after a new tuple is filled and when a generator's frame
+ * is suspended.
+ *
+ * @param   pobj Object that was mutated
+ */
+void heap_gcRescanBarrier(pPmObj_t pobj);
+#endif /* HAVE_GC_INCREMENTAL || HAVE_GC_NURSERY */
+
+#ifdef HAVE_GC_NURSERY
+/**
+ * Obtains a chunk for a small, short-lived object such as an int or
+ * a float.  Takes the next free slot in the nursery by bump allocation,
+ * running a minor collection if the nursery is full.  Falls back to
+ * heap_getChunk() if the object is too big or the nursery has no room.
+ *
+ * @param   requestedsize Requested size of the chunk in bytes
+ * @param   r_pchunk Addr of ptr to chunk (return)
+ * @return  Return code
+ */
+PmReturn_t heap_getNurseryChunk(uint16_t requestedsize, uint8_t **r_pchunk);
+#endif /* HAVE_GC_NURSERY */
+
 #endif /* HAVE_GC */
 
 /**
@@ -27,13 +27,38 @@ int_dup(pPmObj_t pint, pPmObj_t *r_pint)
 {
     PmReturn_t retval = PM_RET_OK;
 
+#ifdef HAVE_TAGGED_INTS
+    /* A tagged int is immutable and holds no memory, so it is its own dup */
+    if (OBJ_IS_TAGGED(pint))
+    {
+        *r_pint = pint;
+        return PM_RET_OK;
+    }
+#endif /* HAVE_TAGGED_INTS */
+
+#ifdef HAVE_SMALL_INT_CACHE
+    /* A small int is shared from the cache */
+    if (INT_IN_CACHE(INT_GET_VAL(pint)))
+    {
+        *r_pint = INT_CACHED(INT_GET_VAL(pint));
+        return PM_RET_OK;
+    }
+#endif /* HAVE_SMALL_INT_CACHE */
+
     /* Allocate new int */
+#ifdef HAVE_GC_NURSERY
+    retval = heap_getNurseryChunk(sizeof(PmInt_t), (uint8_t **)r_pint);
+#elif defined(HAVE_HEAP_POOLS)
+    retval = heap_getPoolChunk(OBJ_TYPE_INT, sizeof(PmInt_t),
+                               (uint8_t **)r_pint);
+#else
     retval = heap_getChunk(sizeof(PmInt_t), (uint8_t **)r_pint);
+#endif /* HAVE_GC_NURSERY */
     PM_RETURN_IF_ERROR(retval);
 
     /* Copy value */
     OBJ_SET_TYPE(*r_pint, OBJ_TYPE_INT);
-    ((pPmInt_t)*r_pint)->val = ((pPmInt_t)pint)->val;
+    ((pPmInt_t)*r_pint)->val = INT_GET_VAL(pint);
     return retval;
 }
 
@@ -43,6 +68,23 @@ int_new(int32_t n, pPmObj_t *r_pint)
 {
     PmReturn_t retval = PM_RET_OK;
 
+#ifdef HAVE_TAGGED_INTS
+    /* Ints that fit in a pointer take no memory */
+    if (INT_FITS_TAG(n))
+    {
+        *r_pint = INT_TAG(n);
+        return PM_RET_OK;
+    }
+#endif /* HAVE_TAGGED_INTS */
+
+#ifdef HAVE_SMALL_INT_CACHE
+    /* If n is small, return the immortal int object from global struct */
+    if (INT_IN_CACHE(n))
+    {
+        *r_pint = INT_CACHED(n);
+        return PM_RET_OK;
+    }
+#else
     /* If n is 0,1,-1, return static int objects from global struct */
     if (n == 0)
     {
@@ -59,9 +101,17 @@ int_new(int32_t n, pPmObj_t *r_pint)
         *r_pint = PM_NEGONE;
         return PM_RET_OK;
     }
+#endif /* HAVE_SMALL_INT_CACHE */
 
     /* Else create and return new int obj */
+#ifdef HAVE_GC_NURSERY
+    retval = heap_getNurseryChunk(sizeof(PmInt_t), (uint8_t **)r_pint);
+#elif defined(HAVE_HEAP_POOLS)
+    retval = heap_getPoolChunk(OBJ_TYPE_INT, sizeof(PmInt_t),
+                               (uint8_t **)r_pint);
+#else
     retval = heap_getChunk(sizeof(PmInt_t), (uint8_t **)r_pint);
+#endif /* HAVE_GC_NURSERY */
     PM_RETURN_IF_ERROR(retval);
     OBJ_SET_TYPE(*r_pint, OBJ_TYPE_INT);
     ((pPmInt_t)*r_pint)->val = n;
@@ -82,7 +132,7 @@ int_positive(pPmObj_t pobj, pPmObj_t *r_pint)
     }
 
     /* Create new int obj */
-    return int_new(((pPmInt_t)pobj)->val, r_pint);
+    return int_new(INT_GET_VAL(pobj), r_pint);
 }
 
 
@@ -99,7 +149,7 @@ int_negative(pPmObj_t pobj, pPmObj_t *r_pint)
     }
 
     /* Create new int obj */
-    return int_new(-((pPmInt_t)pobj)->val, r_pint);
+    return int_new(-INT_GET_VAL(pobj), r_pint);
 }
 
 
@@ -116,7 +166,7 @@ int_bitInvert(pPmObj_t pobj, pPmObj_t *r_pint)
     }
 
     /* Create new int obj */
-    return int_new(~((pPmInt_t)pobj)->val, r_pint);
+    return int_new(~INT_GET_VAL(pobj), r_pint);
 }
 
 
@@ -135,7 +185,7 @@ int_print(pPmObj_t pint)
         return retval;
     }
 
-    retval = sli_ltoa10(((pPmInt_t)pint)->val, buf, sizeof(buf));
+    retval = sli_ltoa10(INT_GET_VAL(pint), buf, sizeof(buf));
     PM_RETURN_IF_ERROR(retval);
     sli_puts(buf);
 
@@ -152,7 +202,7 @@ int_printHex(pPmObj_t pint)
     C_ASSERT(OBJ_GET_TYPE(pint) == OBJ_TYPE_INT);
 
     /* Print the integer object */
-    retval = sli_ltoa16(((pPmInt_t)pint)->val, buf, sizeof(buf), 1);
+    retval = sli_ltoa16(INT_GET_VAL(pint), buf, sizeof(buf), 1);
     sli_puts(buf);
     return retval;
 }
@@ -174,8 +224,8 @@ int_pow(pPmObj_t px, pPmObj_t py, pPmObj_t *r_pn)
         return retval;
     }
 
-    x = ((pPmInt_t)px)->val;
-    y = ((pPmInt_t)py)->val;
+    x = INT_GET_VAL(px);
+    y = INT_GET_VAL(py);
 
     /* Raise Value error if exponent is negative */
     if (y < 0)
@@ -215,8 +265,8 @@ int_divmod(pPmObj_t px, pPmObj_t py, uint8_t op, pPmObj_t *r_pxopy)
         return retval;
     }
 
-    x = ((pPmInt_t)px)->val;
-    y = ((pPmInt_t)py)->val;
+    x = INT_GET_VAL(px);
+    y = INT_GET_VAL(py);
 
     /* Raise ZeroDivisionError if denominator is zero */
     if (y == 0)
@@ -33,6 +33,72 @@ typedef struct PmInt_s
  *pPmInt_t;
 
 
+#ifdef HAVE_TAGGED_INTS
+/** Makes a tagged int from the value; the value must pass INT_FITS_TAG() */
+#define INT_TAG(val) \
+    ((pPmObj_t)(((uintptr_t)(intptr_t)(int32_t)(val) << 1) | (uintptr_t)1))
+
+/** Gets the value of a tagged int */
+#define INT_UNTAG(pobj) ((int32_t)((intptr_t)(pobj) >> 1))
+
+/**
+ * Tells if the value can be held in a tagged int.
+ * A pointer wider than 32 bits holds any int; otherwise one bit is lost
+ * to the tag and larger values are boxed as before.
+ */
+#if UINTPTR_MAX > 0xFFFFFFFFUL
+#define INT_FITS_TAG(val) 1
+#else
+#define INT_FITS_TAG(val) \
+    (((int32_t)(val) >= -0x40000000L) && ((int32_t)(val) <= 0x3FFFFFFFL))
+#endif
+
+/**
+ * Gets the value of an int or bool object, tagged or boxed.
+ * The object MUST be an int or a bool.
+ */
+#define INT_GET_VAL(pobj) \
+    (OBJ_IS_TAGGED(pobj) \
+     ? INT_UNTAG(pobj) \
+     : ((pPmInt_t)(pobj))->val)
+#else
+/** Gets the value of an int or bool object */
+#define INT_GET_VAL(pobj) (((pPmInt_t)(pobj))->val)
+#endif /* HAVE_TAGGED_INTS */
+
+#ifdef HAVE_SMALL_INT_CACHE
+/** The least int in the cache of small ints */
+#ifndef INT_CACHE_MIN
+#define INT_CACHE_MIN (-5)
+#endif
+
+/** The greatest int in the cache of small ints */
+#ifndef INT_CACHE_MAX
+#define INT_CACHE_MAX (1024)
+#endif
+
+#if (INT_CACHE_MIN > -1) || (INT_CACHE_MAX < 1)
+#error The cache of small ints must hold -1, 0 and 1
+#endif
+
+/** The number of ints in the cache of small ints */
+#define INT_CACHE_SIZE (INT_CACHE_MAX - INT_CACHE_MIN + 1)
+
+/** Tells if the value is in the cache of small ints */
+#define INT_IN_CACHE(val) \
+    (((val) >= INT_CACHE_MIN) && ((val) <= INT_CACHE_MAX))
+
+/** Gets the cached int of the value; the value must pass INT_IN_CACHE() */
+#define INT_CACHED(val) \
+    ((pPmObj_t)&gVmGlobal.smallInts[(val) - INT_CACHE_MIN])
+
+/** Tells if the object is one of the cached small ints */
+#define INT_IS_CACHED(pobj) \
+    (((uint8_t *)(pobj) >= (uint8_t *)&gVmGlobal.smallInts[0]) \
+     && ((uint8_t *)(pobj) < (uint8_t *)&gVmGlobal.smallInts[INT_CACHE_SIZE]))
+#endif /* HAVE_SMALL_INT_CACHE */
+
+
 /**
  * Creates a duplicate Integer object
  *
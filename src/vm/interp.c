@@ -21,6 +21,113 @@
 #include "pm.h"
 #include "stdio.h"
 
+
+/**
+ * Writes the stack pointer back to the running frame.
+ * Any bytecode may allocate and so run the GC, which scans each frame's
+ * stack up to fo_sp, so this is done before every bytecode.
+ */
+#define INTERP_SYNC_SP() (PM_FP->fo_sp = PM_SP)
+
+/**
+ * Writes the instruction and stack pointers back to the running frame.
+ * Done where other code may look at the frame: before calls and natives,
+ * before going to the top of the loop, and when an exception is raised.
+ */
+#define INTERP_SAVE() \
+    do \
+    { \
+        PM_FP->fo_ip = PM_IP; \
+        PM_FP->fo_sp = PM_SP; \
+    } while (0)
+
+/** Loads the running thread's frame and its pointers into the locals */
+#define INTERP_LOAD() \
+    do \
+    { \
+        PM_FP = gVmGlobal.pthread->pframe; \
+        PM_IP = PM_FP->fo_ip; \
+        PM_SP = PM_FP->fo_sp; \
+        memspace = PM_FP->fo_memspace; \
+    } while (0)
+
+/**
+ * Makes the given frame the running frame.
+ * The pointers of the frame being left must already be saved.
+ */
+#define INTERP_SET_FRAME(pnewframe) \
+    do \
+    { \
+        gVmGlobal.pthread->pframe = (pnewframe); \
+        INTERP_LOAD(); \
+    } while (0)
+
+#if defined(HAVE_THREADED_DISPATCH) && defined(__GNUC__)
+/** The interpreter uses GCC's labels as values to dispatch bytecodes */
+#define INTERP_THREADED
+#endif
+
+#ifdef INTERP_THREADED
+/** Labels the handler of a bytecode as a case and as a dispatch target */
+#define TARGET(op) case op: TARGET_##op
+
+/** Fetches the next bytecode and jumps straight to its handler */
+#define DISPATCH() \
+    do \
+    { \
+        INTERP_SYNC_SP(); \
+        bc = mem_getByte(memspace, &PM_IP); \
+        goto *dispatchtable[bc]; \
+    } while (0)
+#else
+#define TARGET(op) case op
+
+/** Fetches the next bytecode and switches to its handler */
+#define DISPATCH() goto INTERP_DISPATCH
+#endif /* INTERP_THREADED */
+
+#ifdef HAVE_SUPERINSTRUCTIONS
+/**
+ * Ends the first half of a superinstruction: skips the opcode of the second
+ * bytecode and runs its handler, which gets its argument as usual.
+ */
+#ifdef INTERP_THREADED
+#define DISPATCH_SECOND(op) \
+    do \
+    { \
+        PM_IP++; \
+        bc = (op); \
+        INTERP_SYNC_SP(); \
+        goto TARGET_##op; \
+    } while (0)
+#else
+#define DISPATCH_SECOND(op) \
+    do \
+    { \
+        PM_IP++; \
+        bc = (op); \
+        INTERP_SYNC_SP(); \
+        goto INTERP_EXECUTE; \
+    } while (0)
+#endif /* INTERP_THREADED */
+#endif /* HAVE_SUPERINSTRUCTIONS */
+
+/**
+ * Jumps to the given offset in the code.  A backward jump closes a loop,
+ * so it goes to the top of the interpret loop where threads are rescheduled.
+ */
+#define INTERP_JUMP(offset) \
+    do \
+    { \
+        if ((PM_FP->fo_func->f_co->co_codeaddr + (offset)) <= PM_IP) \
+        { \
+            PM_IP = PM_FP->fo_func->f_co->co_codeaddr + (offset); \
+            INTERP_SAVE(); \
+            goto INTERP_LOOP; \
+        } \
+        PM_IP = PM_FP->fo_func->f_co->co_codeaddr + (offset); \
+    } while (0)
+
 #ifdef _OPCODE_DEBUG_
 char *opcode[] = {
     "STOP_CODE	            ", // 0
@@ -141,19 +248,19 @@ char *opcode[] = {
     "POP_JUMP_IF_FALSE      ",   // 114	/* "" */
     "POP_JUMP_IF_TRUE       ",   // 115	/* "" */
     "LOAD_GLOBAL	        ",   // 116	/* Index in name list */
-    "MISSING_117            ",   // 117 
-    "MISSING_118            ",   // 118
+    "LOAD_FAST_LOAD_FAST    ",   // 117 superinstruction
+    "LOAD_FAST_LOAD_CONST   ",   // 118 superinstruction
     "CONTINUE_LOOP	        ", // 119	/* Start of loop (absolute) */
     "SETUP_LOOP	            ",  // 120	/* Target address (relative) */
     "SETUP_EXCEPT	        ",// 121	/* "" */
     "SETUP_FINALLY	        ", // 122	/* "" */
-    "MISSING_123            ",   // 123 ---
+    "LOAD_FAST_LOAD_ATTR    ",   // 123 superinstruction
     "LOAD_FAST	            ", // 124	/* Local variable number */
     "STORE_FAST	            ",  // 125	/* Local variable number */
     "DELETE_FAST	        ",   // 126	/* Local variable number */
-    "MISSING_127            ",   // 127 --- 
-    "MISSING_128            ",   // 128 --- 
-    "MISSING_129            ",   // 129 --- 
+    "STORE_FAST_LOAD_FAST   ",   // 127 superinstruction
+    "COMPARE_OP_POP_JUMP_IF_FALSE", // 128 superinstruction
+    "COMPARE_OP_POP_JUMP_IF_TRUE", // 129 superinstruction
     "RAISE_VARARGS	        ", // 130	/* Number of raise arguments (1, 2 or 3) */
      //     /* CALL_FUNCTION_XXX opcodes defined below depend on this definition */
     "CALL_FUNCTION	        ", // 131	/* #args + (#kwargs<<8) */
@@ -163,8 +270,8 @@ char *opcode[] = {
     "LOAD_CLOSURE           ",   // 135 /* Load free variable from closure */
     "LOAD_DEREF             ",   // 136 /* Load and dereference from closure cell */ 
     "STORE_DEREF            ",   // 137 /* Store into cell */ 
-    "MISSING_138            ",   // 138 ---
-    "MISSING_139            ",   // 139 ---
+    "LOAD_GLOBAL_LOAD_FAST  ",   // 138 superinstruction
+    "LOAD_GLOBAL_CALL_FUNCTION", // 139 superinstruction
     //     /* The next 3 opcodes must be contiguous and satisfy
     //        (CALL_FUNCTION_VAR - CALL_FUNCTION) & 3 == 1  */
     "CALL_FUNCTION_VAR      ",   // 140	/* #args + (#kwargs<<8) */
@@ -179,8 +286,39 @@ char *opcode[] = {
 };
 #endif
 
-PmReturn_t
-interpret(const uint8_t returnOnNoThreads)
+#if defined(HAVE_INLINE_CACHES) && defined(HAVE_CLASSES)
+/*
+ * Returns the entry of the code object's attribute cache for the name at
+ * the given index, the class and the kind of lookup, or C_NULL if there is
+ * no such entry or the class or a base has changed since it was filled.
+ */
+static pPmAttrEntry_t
+interp_findAttr(pPmCo_t pco, uint16_t indx, pPmObj_t pclass, uint8_t kind)
+{
+    pPmAttrEntry_t pentry;
+    uint8_t i;
+
+    if (pco->co_attrcache == C_NULL)
+    {
+        return C_NULL;
+    }
+
+    pentry = &pco->co_attrcache->ac_entry[indx * CO_ATTR_CACHE_WAYS];
+    for (i = 0; i < CO_ATTR_CACHE_WAYS; i++, pentry++)
+    {
+        if ((pentry->ae_class == pclass) && (pentry->ae_kind == kind))
+        {
+            return (pentry->ae_version == class_getVersion(pclass))
+                   ? pentry : C_NULL;
+        }
+    }
+    return C_NULL;
+}
+#endif /* HAVE_INLINE_CACHES && HAVE_CLASSES */
+
+/* Runs the interpret loop; interpret() counts the runs in progress */
+static PmReturn_t
+interp_run(const uint8_t returnOnNoThreads)
 {
     PmReturn_t retval = PM_RET_OK;
     pPmObj_t pobj1 = C_NULL;
@@ -190,14 +328,171 @@ interpret(const uint8_t returnOnNoThreads)
     int8_t t8 = 0;
     uint8_t bc;
     uint8_t objid, objid2;
+    pPmFrame_t pframe = C_NULL;
+    uint8_t const *pip = C_NULL;
+    pPmObj_t *psp = C_NULL;
+    PmMemSpace_t memspace = MEMSPACE_PROG;
+#ifdef HAVE_INLINE_CACHES
+    pPmCacheEntry_t pentry;
+#ifdef HAVE_CLASSES
+    pPmAttrEntry_t pattrentry;
+#endif /* HAVE_CLASSES */
+#endif /* HAVE_INLINE_CACHES */
+#ifdef INTERP_THREADED
+    /* The handler of each bytecode; an unknown bytecode raises SystemError */
+    static void * const dispatchtable[256] = {
+        [0 ... 255] = &&TARGET_default,
+        [POP_TOP] = &&TARGET_POP_TOP,
+        [ROT_TWO] = &&TARGET_ROT_TWO,
+        [ROT_THREE] = &&TARGET_ROT_THREE,
+        [DUP_TOP] = &&TARGET_DUP_TOP,
+        [ROT_FOUR] = &&TARGET_ROT_FOUR,
+        [NOP] = &&TARGET_NOP,
+        [UNARY_POSITIVE] = &&TARGET_UNARY_POSITIVE,
+        [UNARY_NEGATIVE] = &&TARGET_UNARY_NEGATIVE,
+        [UNARY_NOT] = &&TARGET_UNARY_NOT,
+#ifdef HAVE_BACKTICK
+        [UNARY_CONVERT] = &&TARGET_UNARY_CONVERT,
+#endif /* HAVE_BACKTICK */
+        [UNARY_INVERT] = &&TARGET_UNARY_INVERT,
+        [LIST_APPEND] = &&TARGET_LIST_APPEND,
+        [BINARY_POWER] = &&TARGET_BINARY_POWER,
+        [INPLACE_POWER] = &&TARGET_INPLACE_POWER,
+        [GET_ITER] = &&TARGET_GET_ITER,
+        [BINARY_MULTIPLY] = &&TARGET_BINARY_MULTIPLY,
+        [INPLACE_MULTIPLY] = &&TARGET_INPLACE_MULTIPLY,
+        [BINARY_DIVIDE] = &&TARGET_BINARY_DIVIDE,
+        [INPLACE_DIVIDE] = &&TARGET_INPLACE_DIVIDE,
+        [BINARY_FLOOR_DIVIDE] = &&TARGET_BINARY_FLOOR_DIVIDE,
+        [INPLACE_FLOOR_DIVIDE] = &&TARGET_INPLACE_FLOOR_DIVIDE,
+        [BINARY_MODULO] = &&TARGET_BINARY_MODULO,
+        [INPLACE_MODULO] = &&TARGET_INPLACE_MODULO,
+        [STORE_MAP] = &&TARGET_STORE_MAP,
+        [BINARY_ADD] = &&TARGET_BINARY_ADD,
+        [INPLACE_ADD] = &&TARGET_INPLACE_ADD,
+        [BINARY_SUBTRACT] = &&TARGET_BINARY_SUBTRACT,
+        [INPLACE_SUBTRACT] = &&TARGET_INPLACE_SUBTRACT,
+        [BINARY_SUBSCR] = &&TARGET_BINARY_SUBSCR,
+#ifdef HAVE_FLOAT
+        [BINARY_TRUE_DIVIDE] = &&TARGET_BINARY_TRUE_DIVIDE,
+        [INPLACE_TRUE_DIVIDE] = &&TARGET_INPLACE_TRUE_DIVIDE,
+#endif /* HAVE_FLOAT */
+        [SLICE_0] = &&TARGET_SLICE_0,
+#ifdef HAVE_SLICE
+        [SLICE_1] = &&TARGET_SLICE_1,
+        [SLICE_2] = &&TARGET_SLICE_2,
+        [SLICE_3] = &&TARGET_SLICE_3,
+#endif /* HAVE_SLICE */
+        [STORE_SUBSCR] = &&TARGET_STORE_SUBSCR,
+#ifdef HAVE_DEL
+        [DELETE_SUBSCR] = &&TARGET_DELETE_SUBSCR,
+#endif /* HAVE_DEL */
+        [BINARY_LSHIFT] = &&TARGET_BINARY_LSHIFT,
+        [INPLACE_LSHIFT] = &&TARGET_INPLACE_LSHIFT,
+        [BINARY_RSHIFT] = &&TARGET_BINARY_RSHIFT,
+        [INPLACE_RSHIFT] = &&TARGET_INPLACE_RSHIFT,
+        [BINARY_AND] = &&TARGET_BINARY_AND,
+        [INPLACE_AND] = &&TARGET_INPLACE_AND,
+        [BINARY_XOR] = &&TARGET_BINARY_XOR,
+        [INPLACE_XOR] = &&TARGET_INPLACE_XOR,
+        [BINARY_OR] = &&TARGET_BINARY_OR,
+        [INPLACE_OR] = &&TARGET_INPLACE_OR,
+#ifdef HAVE_PRINT
+        [PRINT_EXPR] = &&TARGET_PRINT_EXPR,
+        [PRINT_ITEM] = &&TARGET_PRINT_ITEM,
+        [PRINT_NEWLINE] = &&TARGET_PRINT_NEWLINE,
+#endif /* HAVE_PRINT */
+        [BREAK_LOOP] = &&TARGET_BREAK_LOOP,
+        [LOAD_LOCALS] = &&TARGET_LOAD_LOCALS,
+        [RETURN_VALUE] = &&TARGET_RETURN_VALUE,
+#ifdef HAVE_IMPORTS
+        [IMPORT_STAR] = &&TARGET_IMPORT_STAR,
+#endif /* HAVE_IMPORTS */
+#ifdef HAVE_GENERATORS
+        [YIELD_VALUE] = &&TARGET_YIELD_VALUE,
+#endif /* HAVE_GENERATORS */
+        [POP_BLOCK] = &&TARGET_POP_BLOCK,
+#ifdef HAVE_CLASSES
+        [BUILD_CLASS] = &&TARGET_BUILD_CLASS,
+#endif /* HAVE_CLASSES */
+        [STORE_NAME] = &&TARGET_STORE_NAME,
+#ifdef HAVE_DEL
+        [DELETE_NAME] = &&TARGET_DELETE_NAME,
+#endif /* HAVE_DEL */
+        [UNPACK_SEQUENCE] = &&TARGET_UNPACK_SEQUENCE,
+        [FOR_ITER] = &&TARGET_FOR_ITER,
+        [STORE_ATTR] = &&TARGET_STORE_ATTR,
+#ifdef HAVE_DEL
+        [DELETE_ATTR] = &&TARGET_DELETE_ATTR,
+#endif /* HAVE_DEL */
+        [STORE_GLOBAL] = &&TARGET_STORE_GLOBAL,
+#ifdef HAVE_DEL
+        [DELETE_GLOBAL] = &&TARGET_DELETE_GLOBAL,
+#endif /* HAVE_DEL */
+        [DUP_TOPX] = &&TARGET_DUP_TOPX,
+        [LOAD_CONST] = &&TARGET_LOAD_CONST,
+        [LOAD_NAME] = &&TARGET_LOAD_NAME,
+        [BUILD_TUPLE] = &&TARGET_BUILD_TUPLE,
+        [BUILD_LIST] = &&TARGET_BUILD_LIST,
+        [BUILD_MAP] = &&TARGET_BUILD_MAP,
+        [LOAD_ATTR] = &&TARGET_LOAD_ATTR,
+        [COMPARE_OP] = &&TARGET_COMPARE_OP,
+        [IMPORT_NAME] = &&TARGET_IMPORT_NAME,
+#ifdef HAVE_IMPORTS
+        [IMPORT_FROM] = &&TARGET_IMPORT_FROM,
+#endif /* HAVE_IMPORTS */
+        [JUMP_FORWARD] = &&TARGET_JUMP_FORWARD,
+        [JUMP_IF_FALSE] = &&TARGET_JUMP_IF_FALSE,
+        [POP_JUMP_IF_FALSE] = &&TARGET_POP_JUMP_IF_FALSE,
+        [JUMP_IF_TRUE] = &&TARGET_JUMP_IF_TRUE,
+        [POP_JUMP_IF_TRUE] = &&TARGET_POP_JUMP_IF_TRUE,
+        [JUMP_ABSOLUTE] = &&TARGET_JUMP_ABSOLUTE,
+        [CONTINUE_LOOP] = &&TARGET_CONTINUE_LOOP,
+        [LOAD_GLOBAL] = &&TARGET_LOAD_GLOBAL,
+        [SETUP_LOOP] = &&TARGET_SETUP_LOOP,
+        [LOAD_FAST] = &&TARGET_LOAD_FAST,
+        [STORE_FAST] = &&TARGET_STORE_FAST,
+#ifdef HAVE_DEL
+        [DELETE_FAST] = &&TARGET_DELETE_FAST,
+#endif /* HAVE_DEL */
+#ifdef HAVE_ASSERT
+        [RAISE_VARARGS] = &&TARGET_RAISE_VARARGS,
+#endif /* HAVE_ASSERT */
+        [CALL_FUNCTION] = &&TARGET_CALL_FUNCTION,
+        [MAKE_FUNCTION] = &&TARGET_MAKE_FUNCTION,
+#ifdef HAVE_CLOSURES
+        [MAKE_CLOSURE] = &&TARGET_MAKE_CLOSURE,
+        [LOAD_CLOSURE] = &&TARGET_LOAD_CLOSURE,
+        [LOAD_DEREF] = &&TARGET_LOAD_DEREF,
+        [STORE_DEREF] = &&TARGET_STORE_DEREF,
+#endif /* HAVE_CLOSURES */
+#ifdef HAVE_SUPERINSTRUCTIONS
+        [LOAD_FAST_LOAD_FAST] = &&TARGET_LOAD_FAST_LOAD_FAST,
+        [LOAD_FAST_LOAD_CONST] = &&TARGET_LOAD_FAST_LOAD_CONST,
+        [LOAD_FAST_LOAD_ATTR] = &&TARGET_LOAD_FAST_LOAD_ATTR,
+        [STORE_FAST_LOAD_FAST] = &&TARGET_STORE_FAST_LOAD_FAST,
+        [COMPARE_OP_POP_JUMP_IF_FALSE] = &&TARGET_COMPARE_OP_POP_JUMP_IF_FALSE,
+        [COMPARE_OP_POP_JUMP_IF_TRUE] = &&TARGET_COMPARE_OP_POP_JUMP_IF_TRUE,
+        [LOAD_GLOBAL_LOAD_FAST] = &&TARGET_LOAD_GLOBAL_LOAD_FAST,
+        [LOAD_GLOBAL_CALL_FUNCTION] = &&TARGET_LOAD_GLOBAL_CALL_FUNCTION,
+#endif /* HAVE_SUPERINSTRUCTIONS */
+    };
+#endif /* INTERP_THREADED */
 
     /* Activate a thread the first time */
     retval = interp_reschedule();
     PM_RETURN_IF_ERROR(retval);
 
-    /* Interpret loop */
+    /*
+     * Interpret loop.  A handler goes on to the next bytecode through
+     * DISPATCH().  Handlers that may switch frames or threads (calls, returns,
+     * yields and imports) and backward jumps save the frame's pointers and go
+     * back to the top of the loop with continue, which is where threads are
+     * rescheduled and the running frame is loaded into the locals.
+     */
     for (;;)
     {
+INTERP_LOOP:
         if (gVmGlobal.pthread == C_NULL)
         {
             if (returnOnNoThreads)
@@ -222,45 +517,58 @@ interpret(const uint8_t returnOnNoThreads)
             PM_BREAK_IF_ERROR(retval);
         }
 
+        /* The frame may have changed or moved since the locals were loaded */
+        INTERP_LOAD();
+
+#ifdef INTERP_THREADED
+        DISPATCH();
+#else
+INTERP_DISPATCH:
+        INTERP_SYNC_SP();
+
         /* Get byte; the func post-incrs PM_IP */
-        bc = mem_getByte(PM_FP->fo_memspace, &PM_IP);
+        bc = mem_getByte(memspace, &PM_IP);
         // printf("%04d %s\n", PM_IP, opcode[bc]);
+#ifdef HAVE_SUPERINSTRUCTIONS
+INTERP_EXECUTE:
+#endif /* HAVE_SUPERINSTRUCTIONS */
+#endif /* INTERP_THREADED */
         switch (bc)
         {
-            case POP_TOP:
+            TARGET(POP_TOP):
                 pobj1 = PM_POP();
-                continue;
+                DISPATCH();
 
-            case ROT_TWO:
+            TARGET(ROT_TWO):
                 pobj1 = TOS;
                 TOS = TOS1;
                 TOS1 = pobj1;
-                continue;
+                DISPATCH();
 
-            case ROT_THREE:
+            TARGET(ROT_THREE):
                 pobj1 = TOS;
                 TOS = TOS1;
                 TOS1 = TOS2;
                 TOS2 = pobj1;
-                continue;
+                DISPATCH();
 
-            case DUP_TOP:
+            TARGET(DUP_TOP):
                 pobj1 = TOS;
                 PM_PUSH(pobj1);
-                continue;
+                DISPATCH();
 
-            case ROT_FOUR:
+            TARGET(ROT_FOUR):
                 pobj1 = TOS;
                 TOS = TOS1;
                 TOS1 = TOS2;
                 TOS2 = TOS3;
                 TOS3 = pobj1;
-                continue;
+                DISPATCH();
 
-            case NOP:
-                continue;
+            TARGET(NOP):
+                DISPATCH();
 
-            case UNARY_POSITIVE:
+            TARGET(UNARY_POSITIVE):
                 /* Raise TypeError if TOS is not an int */
                 if ((OBJ_GET_TYPE(TOS) != OBJ_TYPE_INT)
 #ifdef HAVE_FLOAT
@@ -273,9 +581,9 @@ interpret(const uint8_t returnOnNoThreads)
                 }
 
                 /* When TOS is an int, this is a no-op */
-                continue;
+                DISPATCH();
 
-            case UNARY_NEGATIVE:
+            TARGET(UNARY_NEGATIVE):
 #ifdef HAVE_FLOAT
                 if (OBJ_GET_TYPE(TOS) == OBJ_TYPE_FLT)
                 {
@@ -288,9 +596,9 @@ interpret(const uint8_t returnOnNoThreads)
                 }
                 PM_BREAK_IF_ERROR(retval);
                 TOS = pobj2;
-                continue;
+                DISPATCH();
 
-            case UNARY_NOT:
+            TARGET(UNARY_NOT):
                 pobj1 = PM_POP();
                 if (obj_isFalse(pobj1))
                 {
@@ -300,18 +608,18 @@ interpret(const uint8_t returnOnNoThreads)
                 {
                     PM_PUSH(PM_FALSE);
                 }
-                continue;
+                DISPATCH();
 
 #ifdef HAVE_BACKTICK
             /* #244 Add support for the backtick operation (UNARY_CONVERT) */
-            case UNARY_CONVERT:
+            TARGET(UNARY_CONVERT):
                 retval = obj_repr(TOS, &pobj3);
                 PM_BREAK_IF_ERROR(retval);
                 TOS = pobj3;
-                continue;
+                DISPATCH();
 #endif /* HAVE_BACKTICK */
 
-            case UNARY_INVERT:
+            TARGET(UNARY_INVERT):
                 /* Raise TypeError if it's not an int */
                 if (OBJ_GET_TYPE(TOS) != OBJ_TYPE_INT)
                 {
@@ -323,16 +631,16 @@ interpret(const uint8_t returnOnNoThreads)
                 retval = int_bitInvert(TOS, &pobj2);
                 PM_BREAK_IF_ERROR(retval);
                 TOS = pobj2;
-                continue;
+                DISPATCH();
 
-            case LIST_APPEND:
+            TARGET(LIST_APPEND):
                 /* list_append will raise a TypeError if TOS1 is not a list */
                 retval = list_append(TOS1, TOS);
                 PM_SP -= 2;
-                continue;
+                DISPATCH();
 
-            case BINARY_POWER:
-            case INPLACE_POWER:
+            TARGET(BINARY_POWER):
+            TARGET(INPLACE_POWER):
 
 #ifdef HAVE_FLOAT
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_FLT)
@@ -343,7 +651,7 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 #endif /* HAVE_FLOAT */
 
@@ -354,9 +662,21 @@ interpret(const uint8_t returnOnNoThreads)
                 /* Set return value */
                 PM_SP--;
                 TOS = pobj3;
-                continue;
+                DISPATCH();
+
+            TARGET(GET_ITER):
+#ifdef HAVE_BYTEARRAY
+                /* Iterate over the bytearray a bytearray instance contains */
+                if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_CLI)
+                    && (dict_getItem(
+                            (pPmObj_t)((pPmInstance_t)TOS)->cli_attrs,
+                            PM_NONE, &pobj2) == PM_RET_OK)
+                    && (OBJ_GET_TYPE(pobj2) == OBJ_TYPE_BYA))
+                {
+                    TOS = pobj2;
+                }
+#endif /* HAVE_BYTEARRAY */
 
-            case GET_ITER:
 #ifdef HAVE_GENERATORS
                 /* Raise TypeError if TOS is an instance, but not iterable */
                 if (OBJ_GET_TYPE(TOS) == OBJ_TYPE_CLI)
@@ -378,20 +698,20 @@ interpret(const uint8_t returnOnNoThreads)
                     /* Put sequence-iterator on top of stack */
                     TOS = pobj1;
                 }
-                continue;
+                DISPATCH();
 
-            case BINARY_MULTIPLY:
-            case INPLACE_MULTIPLY:
+            TARGET(BINARY_MULTIPLY):
+            TARGET(INPLACE_MULTIPLY):
                 /* If both objs are ints, perform the op */
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_INT)
                     && (OBJ_GET_TYPE(TOS1) == OBJ_TYPE_INT))
                 {
-                    retval = int_new(((pPmInt_t)TOS1)->val *
-                                     ((pPmInt_t)TOS)->val, &pobj3);
+                    retval = int_new(INT_GET_VAL(TOS1) *
+                                     INT_GET_VAL(TOS), &pobj3);
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 
 #ifdef HAVE_FLOAT
@@ -402,7 +722,7 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 #endif /* HAVE_FLOAT */
 
@@ -411,7 +731,7 @@ interpret(const uint8_t returnOnNoThreads)
                 else if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_INT)
                          && (OBJ_GET_TYPE(TOS1) == OBJ_TYPE_LST))
                 {
-                    t16 = (int16_t)((pPmInt_t)TOS)->val;
+                    t16 = (int16_t)INT_GET_VAL(TOS);
                     if (t16 < 0)
                     {
                         t16 = 0;
@@ -421,14 +741,14 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 
                 /* If it's a tuple replication operation */
                 else if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_INT)
                          && (OBJ_GET_TYPE(TOS1) == OBJ_TYPE_TUP))
                 {
-                    t16 = (int16_t)((pPmInt_t)TOS)->val;
+                    t16 = (int16_t)INT_GET_VAL(TOS);
                     if (t16 < 0)
                     {
                         t16 = 0;
@@ -438,14 +758,14 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 
                 /* If it's a string replication operation */
                 else if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_INT)
                          && (OBJ_GET_TYPE(TOS1) == OBJ_TYPE_STR))
                 {
-                    t16 = (int16_t)((pPmInt_t)TOS)->val;
+                    t16 = (int16_t)INT_GET_VAL(TOS);
                     if (t16 < 0)
                     {
                         t16 = 0;
@@ -458,7 +778,7 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 #endif /* HAVE_REPLICATION */
 
@@ -466,10 +786,10 @@ interpret(const uint8_t returnOnNoThreads)
                 PM_RAISE(retval, PM_RET_EX_TYPE);
                 break;
 
-            case BINARY_DIVIDE:
-            case INPLACE_DIVIDE:
-            case BINARY_FLOOR_DIVIDE:
-            case INPLACE_FLOOR_DIVIDE:
+            TARGET(BINARY_DIVIDE):
+            TARGET(INPLACE_DIVIDE):
+            TARGET(BINARY_FLOOR_DIVIDE):
+            TARGET(INPLACE_FLOOR_DIVIDE):
 
 #ifdef HAVE_FLOAT
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_FLT)
@@ -479,7 +799,7 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 #endif /* HAVE_FLOAT */
 
@@ -488,10 +808,10 @@ interpret(const uint8_t returnOnNoThreads)
                 PM_BREAK_IF_ERROR(retval);
                 PM_SP--;
                 TOS = pobj3;
-                continue;
+                DISPATCH();
 
-            case BINARY_MODULO:
-            case INPLACE_MODULO:
+            TARGET(BINARY_MODULO):
+            TARGET(INPLACE_MODULO):
 
 #ifdef HAVE_STRING_FORMAT
                 /* If it's a string, perform string format */
@@ -501,7 +821,7 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 #endif /* HAVE_STRING_FORMAT */
 
@@ -513,7 +833,7 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 #endif /* HAVE_FLOAT */
 
@@ -522,18 +842,18 @@ interpret(const uint8_t returnOnNoThreads)
                 PM_BREAK_IF_ERROR(retval);
                 PM_SP--;
                 TOS = pobj3;
-                continue;
+                DISPATCH();
 
-            case STORE_MAP:
+            TARGET(STORE_MAP):
                 /* #213: Add support for Python 2.6 bytecodes */
                 C_ASSERT(OBJ_GET_TYPE(TOS2) == OBJ_TYPE_DIC);
                 retval = dict_setItem(TOS2, TOS, TOS1);
                 PM_BREAK_IF_ERROR(retval);
                 PM_SP -= 2;
-                continue;
+                DISPATCH();
 
-            case BINARY_ADD:
-            case INPLACE_ADD:
+            TARGET(BINARY_ADD):
+            TARGET(INPLACE_ADD):
 
 #ifdef HAVE_FLOAT
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_FLT)
@@ -543,7 +863,7 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 #endif /* HAVE_FLOAT */
 
@@ -551,12 +871,12 @@ interpret(const uint8_t returnOnNoThreads)
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_INT)
                     && (OBJ_GET_TYPE(TOS1) == OBJ_TYPE_INT))
                 {
-                    retval = int_new(((pPmInt_t)TOS1)->val +
-                                     ((pPmInt_t)TOS)->val, &pobj3);
+                    retval = int_new(INT_GET_VAL(TOS1) +
+                                     INT_GET_VAL(TOS), &pobj3);
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 
                 /* #242: If both objs are strings, perform concatenation */
@@ -569,15 +889,15 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 
                 /* Otherwise raise a TypeError */
                 PM_RAISE(retval, PM_RET_EX_TYPE);
                 break;
 
-            case BINARY_SUBTRACT:
-            case INPLACE_SUBTRACT:
+            TARGET(BINARY_SUBTRACT):
+            TARGET(INPLACE_SUBTRACT):
 
 #ifdef HAVE_FLOAT
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_FLT)
@@ -587,7 +907,7 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 #endif /* HAVE_FLOAT */
 
@@ -595,19 +915,19 @@ interpret(const uint8_t returnOnNoThreads)
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_INT)
                     && (OBJ_GET_TYPE(TOS1) == OBJ_TYPE_INT))
                 {
-                    retval = int_new(((pPmInt_t)TOS1)->val -
-                                     ((pPmInt_t)TOS)->val, &pobj3);
+                    retval = int_new(INT_GET_VAL(TOS1) -
+                                     INT_GET_VAL(TOS), &pobj3);
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 
                 /* Otherwise raise a TypeError */
                 PM_RAISE(retval, PM_RET_EX_TYPE);
                 break;
 
-            case BINARY_SUBSCR:
+            TARGET(BINARY_SUBSCR):
                 /* Implements TOS = TOS1[TOS]. */
 
                 if (OBJ_GET_TYPE(TOS1) == OBJ_TYPE_DIC)
@@ -638,30 +958,30 @@ interpret(const uint8_t returnOnNoThreads)
 #endif /* HAVE_BYTEARRAY */
 
                     /* Ensure the index doesn't overflow */
-                    C_ASSERT(((pPmInt_t)TOS)->val <= 0x0000FFFF);
-                    t16 = (int16_t)((pPmInt_t)TOS)->val;
+                    C_ASSERT(INT_GET_VAL(TOS) <= 0x0000FFFF);
+                    t16 = (int16_t)INT_GET_VAL(TOS);
 
                     retval = seq_getSubscript(pobj1, t16, &pobj3);
                 }
                 PM_BREAK_IF_ERROR(retval);
                 PM_SP--;
                 TOS = pobj3;
-                continue;
+                DISPATCH();
 
 #ifdef HAVE_FLOAT
             /* #213: Add support for Python 2.6 bytecodes */
-            case BINARY_TRUE_DIVIDE:
-            case INPLACE_TRUE_DIVIDE:
+            TARGET(BINARY_TRUE_DIVIDE):
+            TARGET(INPLACE_TRUE_DIVIDE):
 
                 /* Perform division; float_op() checks for types and zero-div */
                 retval = float_op(TOS1, TOS, &pobj3, '/');
                 PM_BREAK_IF_ERROR(retval);
                 PM_SP--;
                 TOS = pobj3;
-                continue;
+                DISPATCH();
 #endif /* HAVE_FLOAT */
 
-            case SLICE_0:
+            TARGET(SLICE_0):
                 /* Implements TOS = TOS[:], push a copy of the sequence */
 
                 /* Create a copy if it is a list */
@@ -682,12 +1002,12 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_RAISE(retval, PM_RET_EX_TYPE);
                     break;
                 }
-                continue;
+                DISPATCH();
 
 #ifdef HAVE_SLICE
-            case SLICE_1:
-            case SLICE_2:
-            case SLICE_3:
+            TARGET(SLICE_1):
+            TARGET(SLICE_2):
+            TARGET(SLICE_3):
                 {
                     pPmObj_t pstart = PM_ZERO;
                     pPmObj_t pend = PM_NONE;
@@ -724,19 +1044,19 @@ interpret(const uint8_t returnOnNoThreads)
                             retval = list_slice(pobj1, pstart, pend, pstride, &pobj2);
                             PM_BREAK_IF_ERROR(retval);
                             TOS = pobj2;
-                            continue;
+                            DISPATCH();
 
                         case OBJ_TYPE_STR:
                             retval = string_slice(pobj1, pstart, pend, pstride, &pobj2);
                             PM_BREAK_IF_ERROR(retval);
                             TOS = pobj2;
-                            continue;
+                            DISPATCH();
 
                         case OBJ_TYPE_TUP:
                             retval = tuple_slice(pobj1, pstart, pend, pstride, &pobj2);
                             PM_BREAK_IF_ERROR(retval);
                             TOS = pobj2;
-                            continue;
+                            DISPATCH();
 
                         default:
                             PM_RAISE(retval, PM_RET_EX_TYPE);
@@ -746,7 +1066,7 @@ interpret(const uint8_t returnOnNoThreads)
                 }
 #endif /* HAVE_SLICE */
 
-            case STORE_SUBSCR:
+            TARGET(STORE_SUBSCR):
                 /* Implements TOS1[TOS] = TOS2 */
 
                 /* If it's a list */
@@ -762,11 +1082,11 @@ interpret(const uint8_t returnOnNoThreads)
 
                     /* Set the list item */
                     retval = list_setItem(TOS1,
-                                          (int16_t)(((pPmInt_t)TOS)->val),
+                                          (int16_t)(INT_GET_VAL(TOS)),
                                           TOS2);
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP -= 3;
-                    continue;
+                    DISPATCH();
                 }
 
                 /* If it's a dict */
@@ -776,7 +1096,7 @@ interpret(const uint8_t returnOnNoThreads)
                     retval = dict_setItem(TOS1, TOS, TOS2);
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP -= 3;
-                    continue;
+                    DISPATCH();
                 }
 
 #ifdef HAVE_BYTEARRAY
@@ -805,11 +1125,11 @@ interpret(const uint8_t returnOnNoThreads)
                     }
 
                     retval = bytearray_setItem(pobj2,
-                                               (int16_t)(((pPmInt_t)TOS)->val),
+                                               (int16_t)(INT_GET_VAL(TOS)),
                                                TOS2);
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP -= 3;
-                    continue;
+                    DISPATCH();
                 }
 #endif /* HAVE_BYTEARRAY */
 
@@ -818,13 +1138,13 @@ interpret(const uint8_t returnOnNoThreads)
                 break;
 
 #ifdef HAVE_DEL
-            case DELETE_SUBSCR:
+            TARGET(DELETE_SUBSCR):
 
                 if ((OBJ_GET_TYPE(TOS1) == OBJ_TYPE_LST)
                     && (OBJ_GET_TYPE(TOS) == OBJ_TYPE_INT))
                 {
                     retval = list_delItem(TOS1,
-                                          (int16_t)((pPmInt_t)TOS)->val);
+                                          (int16_t)INT_GET_VAL(TOS));
                 }
 
                 else if ((OBJ_GET_TYPE(TOS1) == OBJ_TYPE_DIC)
@@ -841,93 +1161,93 @@ interpret(const uint8_t returnOnNoThreads)
 
                 PM_BREAK_IF_ERROR(retval);
                 PM_SP -= 2;
-                continue;
+                DISPATCH();
 #endif /* HAVE_DEL */
 
-            case BINARY_LSHIFT:
-            case INPLACE_LSHIFT:
+            TARGET(BINARY_LSHIFT):
+            TARGET(INPLACE_LSHIFT):
                 /* If both objs are ints, perform the op */
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_INT)
                     && (OBJ_GET_TYPE(TOS1) == OBJ_TYPE_INT))
                 {
-                    retval = int_new(((pPmInt_t)TOS1)->val <<
-                                     ((pPmInt_t)TOS)->val, &pobj3);
+                    retval = int_new(INT_GET_VAL(TOS1) <<
+                                     INT_GET_VAL(TOS), &pobj3);
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 
                 /* Otherwise raise a TypeError */
                 PM_RAISE(retval, PM_RET_EX_TYPE);
                 break;
 
-            case BINARY_RSHIFT:
-            case INPLACE_RSHIFT:
+            TARGET(BINARY_RSHIFT):
+            TARGET(INPLACE_RSHIFT):
                 /* If both objs are ints, perform the op */
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_INT)
                     && (OBJ_GET_TYPE(TOS1) == OBJ_TYPE_INT))
                 {
-                    retval = int_new(((pPmInt_t)TOS1)->val >>
-                                     ((pPmInt_t)TOS)->val, &pobj3);
+                    retval = int_new(INT_GET_VAL(TOS1) >>
+                                     INT_GET_VAL(TOS), &pobj3);
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 
                 /* Otherwise raise a TypeError */
                 PM_RAISE(retval, PM_RET_EX_TYPE);
                 break;
 
-            case BINARY_AND:
-            case INPLACE_AND:
+            TARGET(BINARY_AND):
+            TARGET(INPLACE_AND):
                 /* If both objs are ints, perform the op */
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_INT)
                     && (OBJ_GET_TYPE(TOS1) == OBJ_TYPE_INT))
                 {
-                    retval = int_new(((pPmInt_t)TOS1)->val &
-                                     ((pPmInt_t)TOS)->val, &pobj3);
+                    retval = int_new(INT_GET_VAL(TOS1) &
+                                     INT_GET_VAL(TOS), &pobj3);
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 
                 /* Otherwise raise a TypeError */
                 PM_RAISE(retval, PM_RET_EX_TYPE);
                 break;
 
-            case BINARY_XOR:
-            case INPLACE_XOR:
+            TARGET(BINARY_XOR):
+            TARGET(INPLACE_XOR):
                 /* If both objs are ints, perform the op */
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_INT)
                     && (OBJ_GET_TYPE(TOS1) == OBJ_TYPE_INT))
                 {
-                    retval = int_new(((pPmInt_t)TOS1)->val ^
-                                     ((pPmInt_t)TOS)->val, &pobj3);
+                    retval = int_new(INT_GET_VAL(TOS1) ^
+                                     INT_GET_VAL(TOS), &pobj3);
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 
                 /* Otherwise raise a TypeError */
                 PM_RAISE(retval, PM_RET_EX_TYPE);
                 break;
 
-            case BINARY_OR:
-            case INPLACE_OR:
+            TARGET(BINARY_OR):
+            TARGET(INPLACE_OR):
                 /* If both objs are ints, perform the op */
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_INT)
                     && (OBJ_GET_TYPE(TOS1) == OBJ_TYPE_INT))
                 {
-                    retval = int_new(((pPmInt_t)TOS1)->val |
-                                     ((pPmInt_t)TOS)->val, &pobj3);
+                    retval = int_new(INT_GET_VAL(TOS1) |
+                                     INT_GET_VAL(TOS), &pobj3);
                     PM_BREAK_IF_ERROR(retval);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 
                 /* Otherwise raise a TypeError */
@@ -935,11 +1255,11 @@ interpret(const uint8_t returnOnNoThreads)
                 break;
 
 #ifdef HAVE_PRINT
-            case PRINT_EXPR:
+            TARGET(PRINT_EXPR):
                 /* Print interactive expression */
                 /* Fallthrough */
 
-            case PRINT_ITEM:
+            TARGET(PRINT_ITEM):
                 if (gVmGlobal.needSoftSpace && (bc == PRINT_ITEM))
                 {
                     retval = plat_putByte(' ');
@@ -953,11 +1273,11 @@ interpret(const uint8_t returnOnNoThreads)
                 PM_SP--;
                 if (bc != PRINT_EXPR)
                 {
-                    continue;
+                    DISPATCH();
                 }
                 /* If PRINT_EXPR, Fallthrough to print a newline */
 
-            case PRINT_NEWLINE:
+            TARGET(PRINT_NEWLINE):
                 gVmGlobal.needSoftSpace = C_FALSE;
                 if (gVmGlobal.somethingPrinted)
                 {
@@ -965,27 +1285,23 @@ interpret(const uint8_t returnOnNoThreads)
                     gVmGlobal.somethingPrinted = C_FALSE;
                 }
                 PM_BREAK_IF_ERROR(retval);
-                continue;
+                DISPATCH();
 #endif /* HAVE_PRINT */
 
-            case BREAK_LOOP:
+            TARGET(BREAK_LOOP):
             {
-                pPmBlock_t pb1 = PM_FP->fo_blockstack;
+                pPmBlock_t pb1;
 
                 /* Ensure there's a block */
-                C_ASSERT(pb1 != C_NULL);
+                C_ASSERT(PM_FP->fo_nblocks > 0);
 
-                /* Delete blocks until first loop block */
-                while ((pb1->b_type != B_LOOP) && (pb1->next != C_NULL))
+                /* Drop blocks until first loop block */
+                t16 = PM_FP->fo_nblocks - 1;
+                while ((PM_FP->fo_blocks[t16].b_type != B_LOOP) && (t16 > 0))
                 {
-                    pobj2 = (pPmObj_t)pb1;
-                    pb1 = pb1->next;
-                    retval = heap_freeChunk(pobj2);
-                    PM_BREAK_IF_ERROR(retval);
+                    t16--;
                 }
-
-                /* Test again outside while loop */
-                PM_BREAK_IF_ERROR(retval);
+                pb1 = &PM_FP->fo_blocks[t16];
 
                 /* Restore PM_SP */
                 PM_SP = pb1->b_sp;
@@ -993,20 +1309,18 @@ interpret(const uint8_t returnOnNoThreads)
                 /* Goto handler */
                 PM_IP = pb1->b_handler;
 
-                /* Pop and delete this block */
-                PM_FP->fo_blockstack = pb1->next;
-                retval = heap_freeChunk((pPmObj_t)pb1);
-                PM_BREAK_IF_ERROR(retval);
+                /* Pop this block */
+                PM_FP->fo_nblocks = t16;
             }
-                continue;
+                DISPATCH();
 
-            case LOAD_LOCALS:
+            TARGET(LOAD_LOCALS):
                 /* Pushes local attrs dict of current frame */
                 /* WARNING: does not copy fo_locals to attrs */
                 PM_PUSH((pPmObj_t)PM_FP->fo_attrs);
-                continue;
+                DISPATCH();
 
-            case RETURN_VALUE:
+            TARGET(RETURN_VALUE):
                 /* Get expiring frame's TOS */
                 pobj2 = PM_POP();
 
@@ -1036,12 +1350,15 @@ interpret(const uint8_t returnOnNoThreads)
                 }
 
                 /* Otherwise return to previous frame */
-                PM_FP = PM_FP->fo_back;
+                INTERP_SET_FRAME(PM_FP->fo_back);
 
 #ifdef HAVE_GENERATORS
                 /* If returning function was a generator */
                 if (((pPmFrame_t)pobj1)->fo_func->f_co->co_flags & CO_GENERATOR)
                 {
+                    /* The generator outlives its caller's frame */
+                    ((pPmFrame_t)pobj1)->fo_back = C_NULL;
+
                     /* Raise a StopIteration exception */
                     PM_RAISE(retval, PM_RET_EX_STOP);
                     break;
@@ -1075,11 +1392,12 @@ interpret(const uint8_t returnOnNoThreads)
                 }
 
                 /* Deallocate expired frame */
-                PM_BREAK_IF_ERROR(heap_freeChunk(pobj1));
+                PM_BREAK_IF_ERROR(frame_free((pPmFrame_t)pobj1));
+                INTERP_SAVE();
                 continue;
 
 #ifdef HAVE_IMPORTS
-            case IMPORT_STAR:
+            TARGET(IMPORT_STAR):
                 /* #102: Implement the remaining IMPORT_ bytecodes */
                 /* Expect a module on the top of the stack */
                 C_ASSERT(OBJ_GET_TYPE(TOS) == OBJ_TYPE_MOD);
@@ -1090,11 +1408,11 @@ interpret(const uint8_t returnOnNoThreads)
                                      C_TRUE);
                 PM_BREAK_IF_ERROR(retval);
                 PM_SP--;
-                continue;
+                DISPATCH();
 #endif /* HAVE_IMPORTS */
 
 #ifdef HAVE_GENERATORS
-            case YIELD_VALUE:
+            TARGET(YIELD_VALUE):
                 /* #207: Add support for the yield keyword */
                 /* Get expiring frame's TOS */
                 pobj1 = PM_POP();
@@ -1107,39 +1425,45 @@ interpret(const uint8_t returnOnNoThreads)
                     break;
                 }
 
-                /* Return to previous frame */
-                PM_FP = PM_FP->fo_back;
+                /* The suspended frame's locals and stack changed while it ran */
+                HEAP_GC_RESCAN_BARRIER(PM_FP);
+
+                /* Return to previous frame; the generator outlives it */
+                INTERP_SAVE();
+                pobj2 = (pPmObj_t)PM_FP;
+                INTERP_SET_FRAME(PM_FP->fo_back);
+                ((pPmFrame_t)pobj2)->fo_back = C_NULL;
 
                 /* Push yield value onto caller's TOS */
                 PM_PUSH(pobj1);
+                INTERP_SAVE();
                 continue;
 #endif /* HAVE_GENERATORS */
 
-            case POP_BLOCK:
-                /* Get ptr to top block */
-                pobj1 = (pPmObj_t)PM_FP->fo_blockstack;
+            TARGET(POP_BLOCK):
+            {
+                pPmBlock_t pb1;
 
                 /* If there's no block, raise SystemError */
-                C_ASSERT(pobj1 != C_NULL);
+                C_ASSERT(PM_FP->fo_nblocks > 0);
 
                 /* Pop block */
-                PM_FP->fo_blockstack = PM_FP->fo_blockstack->next;
+                pb1 = &PM_FP->fo_blocks[--PM_FP->fo_nblocks];
 
                 /* Set stack to previous level, jump to code outside block */
-                PM_SP = ((pPmBlock_t)pobj1)->b_sp;
-                PM_IP = ((pPmBlock_t)pobj1)->b_handler;
-
-                PM_BREAK_IF_ERROR(heap_freeChunk(pobj1));
-                continue;
+                PM_SP = pb1->b_sp;
+                PM_IP = pb1->b_handler;
+            }
+                DISPATCH();
 
 #ifdef HAVE_CLASSES
-            case BUILD_CLASS:
+            TARGET(BUILD_CLASS):
                 /* Create and push new class */
                 retval = class_new(TOS, TOS1, TOS2, &pobj2);
                 PM_BREAK_IF_ERROR(retval);
                 PM_SP -= 2;
                 TOS = pobj2;
-                continue;
+                DISPATCH();
 #endif /* HAVE_CLASSES */
 
 
@@ -1148,7 +1472,7 @@ interpret(const uint8_t returnOnNoThreads)
              * that needs to be swallowed using GET_ARG().
              **************************************************/
 
-            case STORE_NAME:
+            TARGET(STORE_NAME):
                 /* Get name index */
                 t16 = GET_ARG();
 
@@ -1159,10 +1483,10 @@ interpret(const uint8_t returnOnNoThreads)
                 retval = dict_setItem((pPmObj_t)PM_FP->fo_attrs, pobj2, TOS);
                 PM_BREAK_IF_ERROR(retval);
                 PM_SP--;
-                continue;
+                DISPATCH();
 
 #ifdef HAVE_DEL
-            case DELETE_NAME:
+            TARGET(DELETE_NAME):
                 /* Get name index */
                 t16 = GET_ARG();
 
@@ -1172,10 +1496,10 @@ interpret(const uint8_t returnOnNoThreads)
                 /* Remove key,val pair from current frame's attrs dict */
                 retval = dict_delItem((pPmObj_t)PM_FP->fo_attrs, pobj2);
                 PM_BREAK_IF_ERROR(retval);
-                continue;
+                DISPATCH();
 #endif /* HAVE_DEL */
 
-            case UNPACK_SEQUENCE:
+            TARGET(UNPACK_SEQUENCE):
                 /* Get ptr to sequence */
                 pobj1 = PM_POP();
 
@@ -1214,6 +1538,8 @@ interpret(const uint8_t returnOnNoThreads)
                 /* Push sequence's objs onto stack */
                 for (; --t16 >= 0;)
                 {
+                    /* Getting an item may allocate, so the GC must see it */
+                    INTERP_SYNC_SP();
                     retval = seq_getSubscript(pobj1, t16, &pobj2);
                     PM_BREAK_IF_ERROR(retval);
                     PM_PUSH(pobj2);
@@ -1221,9 +1547,9 @@ interpret(const uint8_t returnOnNoThreads)
 
                 /* Test again outside the for loop */
                 PM_BREAK_IF_ERROR(retval);
-                continue;
+                DISPATCH();
 
-            case FOR_ITER:
+            TARGET(FOR_ITER):
                 t16 = GET_ARG();
 
 #ifdef HAVE_GENERATORS
@@ -1256,19 +1582,35 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_SP--;
                     retval = PM_RET_OK;
                     PM_IP += t16;
-                    continue;
+                    DISPATCH();
                 }
                 PM_BREAK_IF_ERROR(retval);
 
                 /* Push the next item onto the stack */
                 PM_PUSH(pobj2);
-                continue;
+                DISPATCH();
 
-            case STORE_ATTR:
+            TARGET(STORE_ATTR):
                 /* TOS.name = TOS1 */
                 /* Get names index */
                 t16 = GET_ARG();
 
+#if defined(HAVE_INLINE_CACHES) && defined(HAVE_CLASSES)
+                /* Store straight into an instance if the cache allows it */
+                if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_CLI)
+                    && (interp_findAttr(PM_FP->fo_func->f_co, t16,
+                                        (pPmObj_t)((pPmInstance_t)TOS)->cli_class,
+                                        ATTR_KIND_STORE) != C_NULL))
+                {
+                    retval = dict_setItem(
+                        (pPmObj_t)((pPmInstance_t)TOS)->cli_attrs,
+                        PM_FP->fo_func->f_co->co_names->val[t16], TOS1);
+                    PM_BREAK_IF_ERROR(retval);
+                    PM_SP -= 2;
+                    DISPATCH();
+                }
+#endif /* HAVE_INLINE_CACHES && HAVE_CLASSES */
+
                 /* Get attrs dict from obj */
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_FXN)
                     || (OBJ_GET_TYPE(TOS) == OBJ_TYPE_MOD))
@@ -1311,11 +1653,39 @@ interpret(const uint8_t returnOnNoThreads)
                 /* Set key=val in obj's dict */
                 retval = dict_setItem(pobj2, pobj3, TOS1);
                 PM_BREAK_IF_ERROR(retval);
+
+#if defined(HAVE_INLINE_CACHES) && defined(HAVE_CLASSES)
+                /*
+                 * An attr stored in an instance may hide an attr of its class;
+                 * mark the class so lookups on its instances check their dicts.
+                 * Then later stores of the name need no check.
+                 */
+                if (OBJ_GET_TYPE(TOS) == OBJ_TYPE_CLI)
+                {
+                    pobj1 = (pPmObj_t)((pPmInstance_t)TOS)->cli_class;
+                    if (!(((pPmClass_t)pobj1)->cl_attrs->d_flags
+                          & DICT_FLAG_SHADOWED))
+                    {
+                        retval = class_getAttr(pobj1, pobj3, &pobj2);
+                        if (retval == PM_RET_OK)
+                        {
+                            dict_setFlags(((pPmClass_t)pobj1)->cl_attrs,
+                                          DICT_FLAG_SHADOWED);
+                        }
+                    }
+                    if ((retval == PM_RET_OK) || (retval == PM_RET_EX_KEY))
+                    {
+                        co_cacheAttr(PM_FP->fo_func->f_co, t16, pobj1,
+                                     ATTR_KIND_STORE, C_NULL);
+                    }
+                    retval = PM_RET_OK;
+                }
+#endif /* HAVE_INLINE_CACHES && HAVE_CLASSES */
                 PM_SP -= 2;
-                continue;
+                DISPATCH();
 
 #ifdef HAVE_DEL
-            case DELETE_ATTR:
+            TARGET(DELETE_ATTR):
                 /* del TOS.name */
                 /* Get names index */
                 t16 = GET_ARG();
@@ -1370,10 +1740,10 @@ interpret(const uint8_t returnOnNoThreads)
 
                 PM_BREAK_IF_ERROR(retval);
                 PM_SP--;
-                continue;
+                DISPATCH();
 #endif /* HAVE_DEL */
 
-            case STORE_GLOBAL:
+            TARGET(STORE_GLOBAL):
                 /* Get name index */
                 t16 = GET_ARG();
 
@@ -1384,10 +1754,10 @@ interpret(const uint8_t returnOnNoThreads)
                 retval = dict_setItem((pPmObj_t)PM_FP->fo_globals, pobj2, TOS);
                 PM_BREAK_IF_ERROR(retval);
                 PM_SP--;
-                continue;
+                DISPATCH();
 
 #ifdef HAVE_DEL
-            case DELETE_GLOBAL:
+            TARGET(DELETE_GLOBAL):
                 /* Get name index */
                 t16 = GET_ARG();
 
@@ -1397,10 +1767,10 @@ interpret(const uint8_t returnOnNoThreads)
                 /* Remove key,val from globals */
                 retval = dict_delItem((pPmObj_t)PM_FP->fo_globals, pobj2);
                 PM_BREAK_IF_ERROR(retval);
-                continue;
+                DISPATCH();
 #endif /* HAVE_DEL */
 
-            case DUP_TOPX:
+            TARGET(DUP_TOPX):
                 t16 = GET_ARG();
                 C_ASSERT(t16 <= 3);
 
@@ -1413,20 +1783,39 @@ interpret(const uint8_t returnOnNoThreads)
                     PM_PUSH(pobj2);
                 if (t16 >= 1)
                     PM_PUSH(pobj1);
-                continue;
+                DISPATCH();
 
-            case LOAD_CONST:
+            TARGET(LOAD_CONST):
                 /* Get const's index in CO */
                 t16 = GET_ARG();
 
                 /* Push const on stack */
                 PM_PUSH(PM_FP->fo_func->f_co->co_consts->val[t16]);
-                continue;
+                DISPATCH();
 
-            case LOAD_NAME:
+            TARGET(LOAD_NAME):
                 /* Get name index */
                 t16 = GET_ARG();
 
+#ifdef HAVE_INLINE_CACHES
+                /*
+                 * At module level the attrs dict is the globals dict,
+                 * so the name is cached as it is for LOAD_GLOBAL
+                 */
+                if ((PM_FP->fo_attrs == PM_FP->fo_globals)
+                    && (PM_FP->fo_func->f_co->co_cache != C_NULL))
+                {
+                    pentry = &PM_FP->fo_func->f_co->co_cache->ic_entry[t16];
+                    if ((pentry->ce_gversion == PM_FP->fo_globals->d_version)
+                        && (pentry->ce_bversion
+                            == gVmGlobal.builtins->d_version))
+                    {
+                        PM_PUSH(pentry->ce_val);
+                        DISPATCH();
+                    }
+                }
+#endif /* HAVE_INLINE_CACHES */
+
                 /* Get name from names tuple */
                 pobj1 = PM_FP->fo_func->f_co->co_names->val[t16];
 
@@ -1452,10 +1841,17 @@ interpret(const uint8_t returnOnNoThreads)
                     }
                 }
                 PM_BREAK_IF_ERROR(retval);
+#ifdef HAVE_INLINE_CACHES
+                if (PM_FP->fo_attrs == PM_FP->fo_globals)
+                {
+                    co_cacheGlobal(PM_FP->fo_func->f_co, t16, pobj2,
+                                   PM_FP->fo_globals, gVmGlobal.builtins);
+                }
+#endif /* HAVE_INLINE_CACHES */
                 PM_PUSH(pobj2);
-                continue;
+                DISPATCH();
 
-            case BUILD_TUPLE:
+            TARGET(BUILD_TUPLE):
                 /* Get num items */
                 t16 = GET_ARG();
                 retval = tuple_new(t16, &pobj1);
@@ -1466,10 +1862,11 @@ interpret(const uint8_t returnOnNoThreads)
                 {
                     ((pPmTuple_t)pobj1)->val[t16] = PM_POP();
                 }
+                HEAP_GC_RESCAN_BARRIER(pobj1);
                 PM_PUSH(pobj1);
-                continue;
+                DISPATCH();
 
-            case BUILD_LIST:
+            TARGET(BUILD_LIST):
                 t16 = GET_ARG();
                 retval = list_new(&pobj1);
                 PM_BREAK_IF_ERROR(retval);
@@ -1487,17 +1884,17 @@ interpret(const uint8_t returnOnNoThreads)
 
                 /* push list onto stack */
                 PM_PUSH(pobj1);
-                continue;
+                DISPATCH();
 
-            case BUILD_MAP:
+            TARGET(BUILD_MAP):
                 /* Argument is ignored */
                 t16 = GET_ARG();
                 retval = dict_new(&pobj1);
                 PM_BREAK_IF_ERROR(retval);
                 PM_PUSH(pobj1);
-                continue;
+                DISPATCH();
 
-            case LOAD_ATTR:
+            TARGET(LOAD_ATTR):
                 /* Implements TOS.attr */
                 t16 = GET_ARG();
                 // printf("ARG: %d\n", t16);
@@ -1507,6 +1904,36 @@ interpret(const uint8_t returnOnNoThreads)
                 PM_BREAK_IF_ERROR(retval);
 #endif
 
+#if defined(HAVE_INLINE_CACHES) && defined(HAVE_CLASSES)
+                /* Use the cached attr of a class while its version still matches */
+                pattrentry = C_NULL;
+                if (OBJ_GET_TYPE(TOS) == OBJ_TYPE_CLI)
+                {
+                    pattrentry = interp_findAttr(PM_FP->fo_func->f_co, t16,
+                        (pPmObj_t)((pPmInstance_t)TOS)->cli_class,
+                        ATTR_KIND_INSTANCE);
+                }
+                else if (OBJ_GET_TYPE(TOS) == OBJ_TYPE_CLO)
+                {
+                    pattrentry = interp_findAttr(PM_FP->fo_func->f_co, t16,
+                                                 TOS, ATTR_KIND_CLASS);
+                }
+                if (pattrentry != C_NULL)
+                {
+                    pobj3 = pattrentry->ae_val;
+
+                    /* If obj is an instance and attr is a func, create method */
+                    if ((pattrentry->ae_kind == ATTR_KIND_INSTANCE)
+                        && (OBJ_GET_TYPE(pobj3) == OBJ_TYPE_FXN))
+                    {
+                        retval = class_method(TOS, pobj3, &pobj3);
+                        PM_BREAK_IF_ERROR(retval);
+                    }
+                    TOS = pobj3;
+                    DISPATCH();
+                }
+#endif /* HAVE_INLINE_CACHES && HAVE_CLASSES */
+
                 /* Get attrs dict from obj */
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_FXN) ||
                     (OBJ_GET_TYPE(TOS) == OBJ_TYPE_MOD))
@@ -1559,6 +1986,23 @@ interpret(const uint8_t returnOnNoThreads)
                         || (OBJ_GET_TYPE(TOS) == OBJ_TYPE_CLI)))
                 {
                     retval = class_getAttr(TOS, pobj2, &pobj3);
+
+#ifdef HAVE_INLINE_CACHES
+                    /*
+                     * Cache an attr an instance gets from its class, and
+                     * so that the name is not in the instance's dict,
+                     * unless an instance of the class may hide the attr
+                     */
+                    if ((retval == PM_RET_OK)
+                        && (OBJ_GET_TYPE(TOS) == OBJ_TYPE_CLI)
+                        && !class_isShadowed((pPmObj_t)
+                                             ((pPmInstance_t)TOS)->cli_class))
+                    {
+                        co_cacheAttr(PM_FP->fo_func->f_co, t16,
+                                     (pPmObj_t)((pPmInstance_t)TOS)->cli_class,
+                                     ATTR_KIND_INSTANCE, pobj3);
+                    }
+#endif /* HAVE_INLINE_CACHES */
                 }
 #endif /* HAVE_CLASSES */
 
@@ -1569,6 +2013,15 @@ interpret(const uint8_t returnOnNoThreads)
                 }
                 PM_BREAK_IF_ERROR(retval);
 
+#if defined(HAVE_INLINE_CACHES) && defined(HAVE_CLASSES)
+                /* Cache an attr of a class, found in it or in a base */
+                if (OBJ_GET_TYPE(TOS) == OBJ_TYPE_CLO)
+                {
+                    co_cacheAttr(PM_FP->fo_func->f_co, t16, TOS,
+                                 ATTR_KIND_CLASS, pobj3);
+                }
+#endif /* HAVE_INLINE_CACHES && HAVE_CLASSES */
+
 #ifdef HAVE_CLASSES
                 /* If obj is an instance and attr is a func, create method */
                 if ((OBJ_GET_TYPE(TOS) == OBJ_TYPE_CLI) &&
@@ -1582,9 +2035,13 @@ interpret(const uint8_t returnOnNoThreads)
 
                 /* Put attr on the stack */
                 TOS = pobj3;
-                continue;
+                DISPATCH();
 
-            case COMPARE_OP:
+            TARGET(COMPARE_OP):
+#ifdef HAVE_SUPERINSTRUCTIONS
+            TARGET(COMPARE_OP_POP_JUMP_IF_FALSE):
+            TARGET(COMPARE_OP_POP_JUMP_IF_TRUE):
+#endif /* HAVE_SUPERINSTRUCTIONS */
                 retval = PM_RET_OK;
                 t16 = GET_ARG();
 
@@ -1595,7 +2052,7 @@ interpret(const uint8_t returnOnNoThreads)
                     retval = float_compare(TOS1, TOS, &pobj3, (PmCompare_t)t16);
                     PM_SP--;
                     TOS = pobj3;
-                    continue;
+                    DISPATCH();
                 }
 #endif /* HAVE_FLOAT */
 
@@ -1605,8 +2062,8 @@ interpret(const uint8_t returnOnNoThreads)
                     && ((OBJ_GET_TYPE(TOS1) == OBJ_TYPE_INT)
                         || (OBJ_GET_TYPE(TOS1) == OBJ_TYPE_BOOL)))
                 {
-                    int32_t a = ((pPmInt_t)TOS1)->val;
-                    int32_t b = ((pPmInt_t)TOS)->val;
+                    int32_t a = INT_GET_VAL(TOS1);
+                    int32_t b = INT_GET_VAL(TOS);
 
                     switch (t16)
                     {
@@ -1691,9 +2148,19 @@ interpret(const uint8_t returnOnNoThreads)
                 }
                 PM_SP--;
                 TOS = pobj3;
-                continue;
+#ifdef HAVE_SUPERINSTRUCTIONS
+                if (bc == COMPARE_OP_POP_JUMP_IF_FALSE)
+                {
+                    DISPATCH_SECOND(POP_JUMP_IF_FALSE);
+                }
+                if (bc == COMPARE_OP_POP_JUMP_IF_TRUE)
+                {
+                    DISPATCH_SECOND(POP_JUMP_IF_TRUE);
+                }
+#endif /* HAVE_SUPERINSTRUCTIONS */
+                DISPATCH();
 
-            case IMPORT_NAME:
+            TARGET(IMPORT_NAME):
                 /* Get name index */
                 t16 = GET_ARG();
 
@@ -1714,6 +2181,7 @@ interpret(const uint8_t returnOnNoThreads)
                 if (retval == PM_RET_OK)
                 {
                     TOS = pobj2;
+                    INTERP_SAVE();
                     continue;
                 }
                 if (retval != PM_RET_EX_KEY)
@@ -1741,7 +2209,7 @@ interpret(const uint8_t returnOnNoThreads)
                 /* Code after here is a duplicate of CALL_FUNCTION */
                 /* Make frame object to interpret the module's root code */
                 heap_gcPushTempRoot(pobj2, &objid);
-                retval = frame_new(pobj2, &pobj3);
+                retval = frame_push(pobj2, &pobj3);
                 heap_gcPopTempRoot(objid);
                 PM_BREAK_IF_ERROR(retval);
 
@@ -1754,11 +2222,12 @@ interpret(const uint8_t returnOnNoThreads)
                 ((pPmFrame_t)pobj3)->fo_isImport = (uint8_t)1;
 
                 /* Set new frame */
-                PM_FP = (pPmFrame_t)pobj3;
+                INTERP_SAVE();
+                INTERP_SET_FRAME((pPmFrame_t)pobj3);
                 continue;
 
 #ifdef HAVE_IMPORTS
-            case IMPORT_FROM:
+            TARGET(IMPORT_FROM):
                 /* #102: Implement the remaining IMPORT_ bytecodes */
                 /* Expect the module on the top of the stack */
                 C_ASSERT(OBJ_GET_TYPE(TOS) == OBJ_TYPE_MOD);
@@ -1775,123 +2244,191 @@ interpret(const uint8_t returnOnNoThreads)
 
                 /* Push the object onto the top of the stack */
                 PM_PUSH(pobj3);
-                continue;
+                DISPATCH();
 #endif /* HAVE_IMPORTS */
 
-            case JUMP_FORWARD:
+            TARGET(JUMP_FORWARD):
                 t16 = GET_ARG();
                 PM_IP += t16;
-                continue;
+                DISPATCH();
 
-            case JUMP_IF_FALSE:
-            case POP_JUMP_IF_FALSE:
+            TARGET(JUMP_IF_FALSE):
+            TARGET(POP_JUMP_IF_FALSE):
                 t16 = GET_ARG();
                 t8 = obj_isFalse(TOS);
-                if (t8)
-                {
-                    /* Jump to base_ip + arg */
-                    PM_IP = PM_FP->fo_func->f_co->co_codeaddr + t16;
-                }
                 if ((bc == POP_JUMP_IF_FALSE) || (!t8))
                 {
                     pobj1 = PM_POP();
                 }
-               continue;
-
-            case JUMP_IF_TRUE:
-            case POP_JUMP_IF_TRUE:
-                t16 = GET_ARG();
-                t8 = obj_isFalse(TOS);
-                if (!t8)
+                if (t8)
                 {
                     /* Jump to base_ip + arg */
-                    PM_IP = PM_FP->fo_func->f_co->co_codeaddr + t16;
+                    INTERP_JUMP(t16);
                 }
+                DISPATCH();
+
+            TARGET(JUMP_IF_TRUE):
+            TARGET(POP_JUMP_IF_TRUE):
+                t16 = GET_ARG();
+                t8 = obj_isFalse(TOS);
                 if ((bc == POP_JUMP_IF_TRUE) || t8)
                 {
                     pobj1 = PM_POP();
                 }
-                continue;
+                if (!t8)
+                {
+                    /* Jump to base_ip + arg */
+                    INTERP_JUMP(t16);
+                }
+                DISPATCH();
 
-            case JUMP_ABSOLUTE:
-            case CONTINUE_LOOP:
+            TARGET(JUMP_ABSOLUTE):
+            TARGET(CONTINUE_LOOP):
                 /* Get target offset (bytes) */
                 t16 = GET_ARG();
 
                 /* Jump to base_ip + arg */
                 PM_IP = PM_FP->fo_func->f_co->co_codeaddr + t16;
+                INTERP_SAVE();
                 continue;
 
-            case LOAD_GLOBAL:
+            TARGET(LOAD_GLOBAL):
+#ifdef HAVE_SUPERINSTRUCTIONS
+            TARGET(LOAD_GLOBAL_LOAD_FAST):
+            TARGET(LOAD_GLOBAL_CALL_FUNCTION):
+#endif /* HAVE_SUPERINSTRUCTIONS */
                 /* Get name */
                 t16 = GET_ARG();
-                pobj1 = PM_FP->fo_func->f_co->co_names->val[t16];
-
-                /* Try globals first */
-                retval = dict_getItem((pPmObj_t)PM_FP->fo_globals,
-                                      pobj1, &pobj2);
 
-                /* If that didn't work, try builtins */
-                if (retval == PM_RET_EX_KEY)
+#ifdef HAVE_INLINE_CACHES
+                /* Use the cached value while neither dict has changed */
+                pentry = C_NULL;
+                if (PM_FP->fo_func->f_co->co_cache != C_NULL)
+                {
+                    pentry = &PM_FP->fo_func->f_co->co_cache->ic_entry[t16];
+                }
+                if ((pentry != C_NULL)
+                    && (pentry->ce_gversion == PM_FP->fo_globals->d_version)
+                    && (pentry->ce_bversion == gVmGlobal.builtins->d_version))
                 {
-                    retval = dict_getItem(PM_PBUILTINS, pobj1, &pobj2);
+                    pobj2 = pentry->ce_val;
+                }
+                else
+#endif /* HAVE_INLINE_CACHES */
+                {
+                    pobj1 = PM_FP->fo_func->f_co->co_names->val[t16];
+
+                    /* Try globals first */
+                    retval = dict_getItem((pPmObj_t)PM_FP->fo_globals,
+                                          pobj1, &pobj2);
 
-                    /* No such global, raise NameError */
+                    /* If that didn't work, try builtins */
                     if (retval == PM_RET_EX_KEY)
                     {
-                        PM_RAISE(retval, PM_RET_EX_NAME);
-                        break;
+                        retval = dict_getItem(PM_PBUILTINS, pobj1, &pobj2);
+
+                        /* No such global, raise NameError */
+                        if (retval == PM_RET_EX_KEY)
+                        {
+                            PM_RAISE(retval, PM_RET_EX_NAME);
+                            break;
+                        }
                     }
+                    PM_BREAK_IF_ERROR(retval);
+#ifdef HAVE_INLINE_CACHES
+                    co_cacheGlobal(PM_FP->fo_func->f_co, t16, pobj2,
+                                   PM_FP->fo_globals, gVmGlobal.builtins);
+#endif /* HAVE_INLINE_CACHES */
                 }
-                PM_BREAK_IF_ERROR(retval);
                 PM_PUSH(pobj2);
-                continue;
+#ifdef HAVE_SUPERINSTRUCTIONS
+                if (bc == LOAD_GLOBAL_LOAD_FAST)
+                {
+                    DISPATCH_SECOND(LOAD_FAST);
+                }
+                if (bc == LOAD_GLOBAL_CALL_FUNCTION)
+                {
+                    DISPATCH_SECOND(CALL_FUNCTION);
+                }
+#endif /* HAVE_SUPERINSTRUCTIONS */
+                DISPATCH();
 
-            case SETUP_LOOP:
+            TARGET(SETUP_LOOP):
             {
-                uint8_t *pchunk;
+                pPmBlock_t pb1;
 
                 /* Get block span (bytes) */
                 t16 = GET_ARG();
 
-                /* Create block */
-                retval = heap_getChunk(sizeof(PmBlock_t), &pchunk);
-                PM_BREAK_IF_ERROR(retval);
-                pobj1 = (pPmObj_t)pchunk;
-                OBJ_SET_TYPE(pobj1, OBJ_TYPE_BLK);
+                /* Push a block; the frame has room for co_nblocks of them */
+                C_ASSERT(PM_FP->fo_nblocks < PM_FP->fo_func->f_co->co_nblocks);
+                pb1 = &PM_FP->fo_blocks[PM_FP->fo_nblocks++];
 
                 /* Store current stack pointer */
-                ((pPmBlock_t)pobj1)->b_sp = PM_SP;
+                pb1->b_sp = PM_SP;
 
                 /* Default handler is to exit block/loop */
-                ((pPmBlock_t)pobj1)->b_handler = PM_IP + t16;
-                ((pPmBlock_t)pobj1)->b_type = B_LOOP;
-
-                /* Insert block into blockstack */
-                ((pPmBlock_t)pobj1)->next = PM_FP->fo_blockstack;
-                PM_FP->fo_blockstack = (pPmBlock_t)pobj1;
-                continue;
+                pb1->b_handler = PM_IP + t16;
+                pb1->b_type = B_LOOP;
+                DISPATCH();
             }
 
-            case LOAD_FAST:
+            TARGET(LOAD_FAST):
                 t16 = GET_ARG();
                 PM_PUSH(PM_FP->fo_locals[t16]);
-                continue;
+                DISPATCH();
 
-            case STORE_FAST:
+            TARGET(STORE_FAST):
                 t16 = GET_ARG();
                 PM_FP->fo_locals[t16] = PM_POP();
-                continue;
+                DISPATCH();
+
+#ifdef HAVE_SUPERINSTRUCTIONS
+            TARGET(LOAD_FAST_LOAD_FAST):
+                t16 = GET_ARG();
+                PM_PUSH(PM_FP->fo_locals[t16]);
+
+                /* Skip the second LOAD_FAST's opcode */
+                PM_IP++;
+                t16 = GET_ARG();
+                PM_PUSH(PM_FP->fo_locals[t16]);
+                DISPATCH();
+
+            TARGET(LOAD_FAST_LOAD_CONST):
+                t16 = GET_ARG();
+                PM_PUSH(PM_FP->fo_locals[t16]);
+
+                /* Skip the LOAD_CONST's opcode */
+                PM_IP++;
+                t16 = GET_ARG();
+                PM_PUSH(PM_FP->fo_func->f_co->co_consts->val[t16]);
+                DISPATCH();
+
+            TARGET(LOAD_FAST_LOAD_ATTR):
+                t16 = GET_ARG();
+                PM_PUSH(PM_FP->fo_locals[t16]);
+                DISPATCH_SECOND(LOAD_ATTR);
+
+            TARGET(STORE_FAST_LOAD_FAST):
+                t16 = GET_ARG();
+                PM_FP->fo_locals[t16] = PM_POP();
+
+                /* Skip the LOAD_FAST's opcode */
+                PM_IP++;
+                t16 = GET_ARG();
+                PM_PUSH(PM_FP->fo_locals[t16]);
+                DISPATCH();
+#endif /* HAVE_SUPERINSTRUCTIONS */
 
 #ifdef HAVE_DEL
-            case DELETE_FAST:
+            TARGET(DELETE_FAST):
                 t16 = GET_ARG();
                 PM_FP->fo_locals[t16] = PM_NONE;
-                continue;
+                DISPATCH();
 #endif /* HAVE_DEL */
 
 #ifdef HAVE_ASSERT
-            case RAISE_VARARGS:
+            TARGET(RAISE_VARARGS):
                 t16 = GET_ARG();
 
                 /* Only supports taking 1 arg for now */
@@ -1929,11 +2466,11 @@ interpret(const uint8_t returnOnNoThreads)
                 PM_BREAK_IF_ERROR(retval);
 
                 /* Raise exception by breaking with retval set to code */
-                PM_RAISE(retval, (PmReturn_t)(((pPmInt_t)pobj2)->val & 0xFF));
+                PM_RAISE(retval, (PmReturn_t)(INT_GET_VAL(pobj2) & 0xFF));
                 break;
 #endif /* HAVE_ASSERT */
 
-            case CALL_FUNCTION:
+            TARGET(CALL_FUNCTION):
                 /* Get num args */
                 t16 = GET_ARG();
 
@@ -1947,6 +2484,41 @@ interpret(const uint8_t returnOnNoThreads)
                 /* Get the callable */
                 pobj1 = STACK(t16);
 
+#ifdef HAVE_FAST_CALLS
+                /*
+                 * A func whose code needs no cells or generator, called with
+                 * exactly its argcount, only needs its args moved into a new
+                 * frame.  Nothing is allocated after the frame, so nothing
+                 * needs to be a temp root.
+                 */
+                if ((OBJ_GET_TYPE(pobj1) == OBJ_TYPE_FXN)
+                    && (OBJ_GET_TYPE(((pPmFunc_t)pobj1)->f_co) == OBJ_TYPE_COB)
+                    && (((pPmFunc_t)pobj1)->f_co->co_flags & CO_FASTCALL)
+                    && (t16 == ((pPmFunc_t)pobj1)->f_co->co_argcount))
+                {
+                    INTERP_SYNC_SP();
+                    retval = frame_push(pobj1, &pobj2);
+                    PM_BREAK_IF_ERROR(retval);
+
+                    /* Pop args (pushed left to right) into the new frame */
+                    while (--t16 >= 0)
+                    {
+                        ((pPmFrame_t)pobj2)->fo_locals[t16] = PM_POP();
+                    }
+
+                    /* Pop func obj */
+                    PM_SP--;
+
+                    /* Keep ref to current frame */
+                    ((pPmFrame_t)pobj2)->fo_back = PM_FP;
+
+                    /* Set new frame */
+                    INTERP_SAVE();
+                    INTERP_SET_FRAME((pPmFrame_t)pobj2);
+                    continue;
+                }
+#endif /* HAVE_FAST_CALLS */
+
                 /* Useless push to get temp-roots stack level used in cleanup */
                 heap_gcPushTempRoot(pobj1, &objid);
 
@@ -1992,6 +2564,7 @@ interpret(const uint8_t returnOnNoThreads)
                     sli_memcpy((uint8_t *)&((pPmTuple_t)pobj2)->val,
                                (uint8_t *)&STACK(t16),
                                (t16 + 1) * sizeof(pPmObj_t));
+                    HEAP_GC_RESCAN_BARRIER(pobj2);
 
                     /* Remove old args, push func/args tuple as one arg */
                     PM_SP -= t16;
@@ -2032,6 +2605,7 @@ interpret(const uint8_t returnOnNoThreads)
 
                         /* Otherwise, continue with instance */
                         heap_gcPopTempRoot(objid);
+                        INTERP_SAVE();
                         continue;
                     }
                     else if (retval != PM_RET_OK)
@@ -2045,6 +2619,7 @@ interpret(const uint8_t returnOnNoThreads)
                     {
                         STACK(t8) = STACK(t8 + 1);
                     }
+                    INTERP_SYNC_SP();
 
                     /* Convert __init__ to method, insert it as the callable */
                     retval = class_method(pobj2, pobj3, &pobj1);
@@ -2118,7 +2693,8 @@ CALL_FUNC_FOR_ITER:
                     }
 
                     /* Make frame object to run the func object */
-                    retval = frame_new(pobj1, &pobj2);
+                    INTERP_SYNC_SP();
+                    retval = frame_push(pobj1, &pobj2);
                     heap_gcPushTempRoot(pobj2, &objid2);
                     PM_GOTO_IF_ERROR(retval, CALL_FUNC_CLEANUP);
 
@@ -2170,14 +2746,14 @@ CALL_FUNC_FOR_ITER:
                              t8 < ((pPmFunc_t)pobj1)->f_co->co_cellvars->length;
                              t8++)
                         {
-                            if (((pPmInt_t)((pPmFunc_t)pobj1)->
-                                f_co->co_cellvars->val[t8])->val >= 0)
+                            if (INT_GET_VAL(((pPmFunc_t)pobj1)->
+                                    f_co->co_cellvars->val[t8]) >= 0)
                             {
                                 ((pPmFrame_t)pobj2)->fo_locals[
                                     ((pPmFunc_t)pobj1)->f_co->co_nlocals + t8] =
                                     ((pPmFrame_t)pobj2)->fo_locals[
-                                        ((pPmInt_t)(((pPmFunc_t)pobj1)->
-                                            f_co->co_cellvars->val[t8]))->val
+                                        INT_GET_VAL(((pPmFunc_t)pobj1)->
+                                            f_co->co_cellvars->val[t8])
                                     ];
                             }
                         }
@@ -2203,7 +2779,8 @@ CALL_FUNC_FOR_ITER:
                     ((pPmFrame_t)pobj2)->fo_back = PM_FP;
 
                     /* Set new frame */
-                    PM_FP = (pPmFrame_t)pobj2;
+                    INTERP_SAVE();
+                    INTERP_SET_FRAME((pPmFrame_t)pobj2);
                 }
 
                 /* If it's native func */
@@ -2219,6 +2796,9 @@ CALL_FUNC_FOR_ITER:
                         gVmGlobal.nativeframe.nf_locals[t16] = PM_POP();
                     }
 
+                    /* The last native's return obj may since have been freed */
+                    gVmGlobal.nativeframe.nf_stack = C_NULL;
+
                     /* Set flag, so the GC knows a native session is active */
                     gVmGlobal.nativeframe.nf_active = C_TRUE;
 
@@ -2241,22 +2821,29 @@ CALL_FUNC_FOR_ITER:
                     /*
                      * CALL NATIVE FXN: pass caller's frame and numargs
                      */
+                    INTERP_SAVE();
+
                     /* Positive index is a stdlib func */
                     if (t16 >= 0)
                     {
-                        retval = std_nat_fxn_table[t16] (&PM_FP);
+                        retval = std_nat_fxn_table[t16] (
+                            &gVmGlobal.pthread->pframe);
                     }
 
                     /* Negative index is a usrlib func */
                     else
                     {
-                        retval = usr_nat_fxn_table[-t16] (&PM_FP);
+                        retval = usr_nat_fxn_table[-t16] (
+                            &gVmGlobal.pthread->pframe);
                     }
 
                     /*
                      * RETURN FROM NATIVE FXN
                      */
 
+                    /* The native may have switched frames or run the GC */
+                    INTERP_LOAD();
+
                     /* Clear flag, so frame will not be marked by the GC */
                     gVmGlobal.nativeframe.nf_active = C_FALSE;
 
@@ -2290,9 +2877,10 @@ CALL_FUNC_FOR_ITER:
 CALL_FUNC_CLEANUP:
                 heap_gcPopTempRoot(objid);
                 PM_BREAK_IF_ERROR(retval);
+                INTERP_SAVE();
                 continue;
 
-            case MAKE_FUNCTION:
+            TARGET(MAKE_FUNCTION):
                 /* Get num default args to fxn */
                 t16 = GET_ARG();
 
@@ -2318,6 +2906,7 @@ CALL_FUNC_CLEANUP:
                     {
                         ((pPmTuple_t)pobj3)->val[t16] = PM_POP();
                     }
+                    HEAP_GC_RESCAN_BARRIER(pobj3);
 
                     /* Set func's default args */
                     ((pPmFunc_t)pobj2)->f_defaultargs = (pPmTuple_t)pobj3;
@@ -2335,10 +2924,10 @@ CALL_FUNC_CLEANUP:
 
                 /* Push func obj */
                 PM_PUSH(pobj2);
-                continue;
+                DISPATCH();
 
 #ifdef HAVE_CLOSURES
-            case MAKE_CLOSURE:
+            TARGET(MAKE_CLOSURE):
                 /* Get number of default args */
                 t16 = GET_ARG();
                 retval = func_new(TOS, (pPmObj_t)PM_FP->fo_globals, &pobj2);
@@ -2360,15 +2949,16 @@ CALL_FUNC_CLEANUP:
                     {
                         ((pPmTuple_t)pobj3)->val[t16] = PM_POP();
                     }
+                    HEAP_GC_RESCAN_BARRIER(pobj3);
                     ((pPmFunc_t)pobj2)->f_defaultargs = (pPmTuple_t)pobj3;
                 }
 
                 /* Push new func with closure */
                 PM_PUSH(pobj2);
-                continue;
+                DISPATCH();
 
-            case LOAD_CLOSURE:
-            case LOAD_DEREF:
+            TARGET(LOAD_CLOSURE):
+            TARGET(LOAD_DEREF):
                 /* Loads the i'th cell of free variable storage onto TOS */
                 t16 = GET_ARG();
                 pobj1 = PM_FP->fo_locals[PM_FP->fo_func->f_co->co_nlocals + t16];
@@ -2378,51 +2968,72 @@ CALL_FUNC_CLEANUP:
                     break;
                 }
                 PM_PUSH(pobj1);
-                continue;
+                DISPATCH();
 
-            case STORE_DEREF:
+            TARGET(STORE_DEREF):
                 /* Stores TOS into the i'th cell of free variable storage */
                 t16 = GET_ARG();
                 PM_FP->fo_locals[PM_FP->fo_func->f_co->co_nlocals + t16] = PM_POP();
-                continue;
+                DISPATCH();
 #endif /* HAVE_CLOSURES */
 
 
             default:
+#ifdef INTERP_THREADED
+            TARGET_default:
+#endif /* INTERP_THREADED */
                 /* SystemError, unknown or unimplemented opcode */
                 PM_RAISE(retval, PM_RET_EX_SYS);
                 break;
         }
 
+        /* Leaving the running frame; the error report shows its fo_ip */
+        INTERP_SAVE();
+
 #ifdef HAVE_GENERATORS
         /* If got a StopIteration exception, check for a B_LOOP block */
         if (retval == PM_RET_EX_STOP)
         {
             pobj1 = (pPmObj_t)PM_FP;
+            pobj3 = C_NULL;
             while ((retval == PM_RET_EX_STOP) && (pobj1 != C_NULL))
             {
-                pobj2 = (pPmObj_t)((pPmFrame_t)pobj1)->fo_blockstack;
-                while ((retval == PM_RET_EX_STOP) && (pobj2 != C_NULL))
+                t16 = ((pPmFrame_t)pobj1)->fo_nblocks;
+                while ((retval == PM_RET_EX_STOP) && (t16 > 0))
                 {
+                    t16--;
+                    pobj2 = (pPmObj_t)&((pPmFrame_t)pobj1)->fo_blocks[t16];
                     if (((pPmBlock_t)pobj2)->b_type == B_LOOP)
                     {
                         /* Resume execution where the block handler says */
-                        /* Set PM_FP first, so PM_SP and PM_IP are set in the frame */
-                        PM_FP = (pPmFrame_t)pobj1;
+                        INTERP_SET_FRAME((pPmFrame_t)pobj1);
                         PM_SP = ((pPmBlock_t)pobj2)->b_sp;
                         PM_IP = ((pPmBlock_t)pobj2)->b_handler;
-                        ((pPmFrame_t)pobj1)->fo_blockstack =
-                            ((pPmFrame_t)pobj1)->fo_blockstack->next;
+                        ((pPmFrame_t)pobj1)->fo_nblocks = t16;
                         retval = PM_RET_OK;
                         break;
                     }
-
-                    pobj2 = (pPmObj_t)((pPmBlock_t)pobj2)->next;
                 }
+#ifdef HAVE_FRAME_STACK
+                /* Remember the oldest stacked frame that is unwound */
+                if ((retval == PM_RET_EX_STOP)
+                    && (((pPmFrame_t)pobj1)->fo_stack != C_NULL))
+                {
+                    pobj3 = pobj1;
+                }
+#endif /* HAVE_FRAME_STACK */
                 pobj1 = (pPmObj_t)((pPmFrame_t)pobj1)->fo_back;
             }
             if (retval == PM_RET_OK)
             {
+#ifdef HAVE_FRAME_STACK
+                /* Pop the unwound frames off the frame stack */
+                if (pobj3 != C_NULL)
+                {
+                    PM_BREAK_IF_ERROR(frame_free((pPmFrame_t)pobj3));
+                }
+#endif /* HAVE_FRAME_STACK */
+                INTERP_SAVE();
                 continue;
             }
         }
@@ -2455,6 +3066,19 @@ CALL_FUNC_CLEANUP:
 }
 
 
+PmReturn_t
+interpret(const uint8_t returnOnNoThreads)
+{
+    PmReturn_t retval;
+
+    gVmGlobal.interpNesting++;
+    retval = interp_run(returnOnNoThreads);
+    gVmGlobal.interpNesting--;
+
+    return retval;
+}
+
+
 PmReturn_t
 interp_reschedule(void)
 {
@@ -2483,6 +3107,17 @@ interp_reschedule(void)
 
     /* Clear flag to indicate a reschedule has occurred */
     interp_setRescheduleFlag(0);
+
+#ifdef HAVE_GC_INCREMENTAL
+    /* Do a slice of GC work once per time slice */
+    retval = heap_gcStep();
+#endif /* HAVE_GC_INCREMENTAL */
+
+#ifdef HAVE_GC_COMPACT
+    /* Between bytecodes no C variable holds an object, so objects may move */
+    PM_RETURN_IF_ERROR(retval);
+    retval = heap_gcAutoCompact();
+#endif /* HAVE_GC_COMPACT */
     return retval;
 }
 
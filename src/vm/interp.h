@@ -25,12 +25,18 @@
 #define INTERP_RETURN_ON_NO_THREADS  1
 
 
-/** Frame pointer ; currently for single thread */
-#define PM_FP (gVmGlobal.pthread->pframe)
+/*
+ * interpret() keeps the running frame, its instruction pointer, stack pointer
+ * and code memspace in local variables, so the macros below are only valid
+ * inside interpret().  The pointers are written back to the frame where
+ * other code may look at them (see interp.c).
+ */
+/** Frame pointer of the running thread */
+#define PM_FP           pframe
 /** Instruction pointer */
-#define PM_IP (PM_FP->fo_ip)
+#define PM_IP           pip
 /** Argument stack pointer */
-#define PM_SP (PM_FP->fo_sp)
+#define PM_SP           psp
 
 /** top of stack */
 #define TOS             (*(PM_SP - 1))
@@ -47,7 +53,7 @@
 /** pushes an obj on the stack */
 #define PM_PUSH(pobj)   (*(PM_SP++) = (pobj))
 /** gets the argument (S16) from the instruction stream */
-#define GET_ARG()       mem_getWord(PM_FP->fo_memspace, &PM_IP)
+#define GET_ARG()       mem_getWord(memspace, &PM_IP)
 
 /** pushes an obj in the only stack slot of the native frame */
 #define NATIVE_SET_TOS(pobj) (gVmGlobal.nativeframe.nf_stack = \
@@ -87,6 +93,12 @@ typedef enum PmCompare_e
 typedef enum PmBcode_e
 {
     /*
+     * The opcodes marked as superinstructions are not Python's.
+     * pmImgCreator puts one in place of the opcode of the first of two
+     * bytecodes that often come together (see SUPERINSTRUCTIONS there).
+     * The second bytecode is left in the code; its handler is run
+     * without fetching its opcode.
+     *
      * Python source to create this list:
      * import dis
      * o = dis.opname
@@ -217,19 +229,19 @@ typedef enum PmBcode_e
     POP_JUMP_IF_FALSE,          /* new in 2.7*/
     POP_JUMP_IF_TRUE,          /* new in 2.7*/
     LOAD_GLOBAL,
-    UNUSED_75,
-    UNUSED_76,
+    LOAD_FAST_LOAD_FAST,        /* superinstruction */
+    LOAD_FAST_LOAD_CONST,       /* superinstruction */
     CONTINUE_LOOP,
     SETUP_LOOP,                 /* d120 */
     SETUP_EXCEPT,
     SETUP_FINALLY,
-    UNUSED_7B,
+    LOAD_FAST_LOAD_ATTR,        /* superinstruction */
     LOAD_FAST,
     STORE_FAST,
     DELETE_FAST,
-    UNUSED_79,
-    UNUSED_80,                  /* 0x80 */
-    UNUSED_81,
+    STORE_FAST_LOAD_FAST,       /* superinstruction */
+    COMPARE_OP_POP_JUMP_IF_FALSE, /* 0x80 superinstruction */
+    COMPARE_OP_POP_JUMP_IF_TRUE, /* superinstruction */
     RAISE_VARARGS,              /* d130 */
     CALL_FUNCTION,
     MAKE_FUNCTION,
@@ -238,8 +250,8 @@ typedef enum PmBcode_e
     LOAD_CLOSURE,
     LOAD_DEREF,
     STORE_DEREF,
-    UNUSED_8A,
-    UNUSED_8B,
+    LOAD_GLOBAL_LOAD_FAST,      /* superinstruction */
+    LOAD_GLOBAL_CALL_FUNCTION,  /* superinstruction */
     CALL_FUNCTION_VAR,          /* d140 */
     CALL_FUNCTION_KW,
     CALL_FUNCTION_VAR_KW,
@@ -282,6 +294,11 @@ typedef enum PmBcode_e
 /**
  * Interprets the available threads. Does not return.
  *
+ * With HAVE_GC_COMPACT, objects may move while an outermost run
+ * reschedules.  A caller that keeps objects in C variables across the
+ * call must increment gVmGlobal.interpNesting around it, as
+ * global_loadBuiltins() does.
+ *
  * @param returnOnNoThreads Loop forever if 0, exit with status if no more
  *                          threads left.
  * @return Return status if called with returnOnNoThreads != 0,
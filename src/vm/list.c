@@ -21,11 +21,130 @@
 #include "pm.h"
 
 
+#ifdef HAVE_LIST_ARRAYS
+/** The fewest slots in an item array */
+#define LIST_ARRAY_MIN_SIZE 4
+
+/**
+ * The most slots in an item array: as many as fit in a chunk of just
+ * under 64 KB.  A longer list keeps its items in a seglist.
+ */
+#define LIST_ARRAY_MAX_SIZE \
+    ((uint16_t)((0xFF00 - sizeof(PmListArray_t)) / sizeof(pPmObj_t) + 1))
+
+/** Evaluates to the list's item array, or C_NULL if it has none */
+#define LIST_GET_ARRAY(plist) \
+    ((((pPmList_t)(plist))->val != C_NULL) \
+     && (OBJ_GET_TYPE(((pPmList_t)(plist))->val) == OBJ_TYPE_LAR) \
+     ? (pPmListArray_t)((pPmList_t)(plist))->val : (pPmListArray_t)C_NULL)
+
+
+/*
+ * Moves the items of a list whose item array is full to a seglist.
+ */
+static PmReturn_t
+list_toSeglist(pPmList_t plist)
+{
+    PmReturn_t retval;
+    pPmListArray_t parray = (pPmListArray_t)plist->val;
+    pSeglist_t pseglist;
+    uint16_t i;
+    uint8_t objid;
+
+    retval = seglist_new(&pseglist);
+    PM_RETURN_IF_ERROR(retval);
+
+    heap_gcPushTempRoot((pPmObj_t)pseglist, &objid);
+    for (i = 0; i < plist->length; i++)
+    {
+        retval = seglist_appendItem(pseglist, parray->la_val[i]);
+        if (retval != PM_RET_OK)
+        {
+            heap_gcPopTempRoot(objid);
+            return retval;
+        }
+    }
+    heap_gcPopTempRoot(objid);
+
+    plist->val = (pPmObj_t)pseglist;
+    HEAP_GC_WRITE_BARRIER(plist, pseglist);
+    return heap_freeChunk((pPmObj_t)parray);
+}
+
+
+/*
+ * Makes room in the list for one more item.  Gives an empty list an item
+ * array, doubles a full array, or moves the items to a seglist once they
+ * fill the largest array.  The list and the item to add are kept alive
+ * while memory is allocated.
+ */
+static PmReturn_t
+list_makeRoom(pPmList_t plist, pPmObj_t pobj)
+{
+    PmReturn_t retval = PM_RET_OK;
+    pPmListArray_t pold = (pPmListArray_t)plist->val;
+    pPmListArray_t pnew;
+    uint8_t *pchunk;
+    uint16_t size;
+    uint8_t objid;
+    uint8_t objid2;
+
+    /* A seglist, or an array with a free slot, has room */
+    if ((pold != C_NULL)
+        && ((OBJ_GET_TYPE(pold) != OBJ_TYPE_LAR)
+            || (plist->length < pold->la_size)))
+    {
+        return retval;
+    }
+
+    heap_gcPushTempRoot((pPmObj_t)plist, &objid);
+    heap_gcPushTempRoot(pobj, &objid2);
+    if ((pold != C_NULL) && (pold->la_size == LIST_ARRAY_MAX_SIZE))
+    {
+        retval = list_toSeglist(plist);
+        heap_gcPopTempRoot(objid);
+        return retval;
+    }
+
+    /* Double the array, up to its largest size */
+    size = LIST_ARRAY_MIN_SIZE;
+    if (pold != C_NULL)
+    {
+        size = (pold->la_size < (LIST_ARRAY_MAX_SIZE >> 1))
+               ? (pold->la_size << 1) : LIST_ARRAY_MAX_SIZE;
+    }
+    retval = heap_getChunk(sizeof(PmListArray_t)
+                           + (size - 1) * sizeof(pPmObj_t), &pchunk);
+    heap_gcPopTempRoot(objid);
+    PM_RETURN_IF_ERROR(retval);
+    pnew = (pPmListArray_t)pchunk;
+    OBJ_SET_TYPE(pnew, OBJ_TYPE_LAR);
+    pnew->la_size = size;
+    sli_memset((unsigned char *)pnew->la_val, 0, size * sizeof(pPmObj_t));
+
+    /* The items are traced through the list, which now holds the array */
+    if (pold != C_NULL)
+    {
+        sli_memcpy((unsigned char *)pnew->la_val,
+                   (unsigned char const *)pold->la_val,
+                   plist->length * sizeof(pPmObj_t));
+        retval = heap_freeChunk((pPmObj_t)pold);
+    }
+    plist->val = (pPmObj_t)pnew;
+    HEAP_GC_WRITE_BARRIER(plist, pnew);
+    return retval;
+}
+#endif /* HAVE_LIST_ARRAYS */
+
+
 PmReturn_t
 list_append(pPmObj_t plist, pPmObj_t pobj)
 {
     PmReturn_t retval;
     uint8_t objid;
+#ifdef HAVE_LIST_ARRAYS
+    pPmListArray_t parray;
+#endif /* HAVE_LIST_ARRAYS */
 
     C_ASSERT(plist != C_NULL);
     C_ASSERT(pobj != C_NULL);
@@ -37,16 +156,31 @@ list_append(pPmObj_t plist, pPmObj_t pobj)
         return retval;
     }
 
+#ifdef HAVE_LIST_ARRAYS
+    retval = list_makeRoom((pPmList_t)plist, pobj);
+    PM_RETURN_IF_ERROR(retval);
+
+    /* Put the object in the array's first free slot */
+    parray = LIST_GET_ARRAY(plist);
+    if (parray != C_NULL)
+    {
+        parray->la_val[((pPmList_t)plist)->length] = pobj;
+        HEAP_GC_WRITE_BARRIER(plist, pobj);
+        ((pPmList_t)plist)->length++;
+        return retval;
+    }
+#else
     /* Create new seglist if needed */
     if (((pPmList_t)plist)->length == 0)
     {
-        retval = seglist_new(&((pPmList_t)plist)->val);
+        retval = seglist_new((pSeglist_t *)&((pPmList_t)plist)->val);
         PM_RETURN_IF_ERROR(retval);
     }
+#endif /* HAVE_LIST_ARRAYS */
 
     /* Append object to list */
     heap_gcPushTempRoot((pPmObj_t)((pPmList_t)plist)->val, &objid);
-    retval = seglist_appendItem(((pPmList_t)plist)->val, pobj);
+    retval = seglist_appendItem((pSeglist_t)((pPmList_t)plist)->val, pobj);
     heap_gcPopTempRoot(objid);
     PM_RETURN_IF_ERROR(retval);
 
@@ -82,8 +216,17 @@ list_getItem(pPmObj_t plist, int16_t index, pPmObj_t *r_pobj)
         return retval;
     }
 
+#ifdef HAVE_LIST_ARRAYS
+    if (LIST_GET_ARRAY(plist) != C_NULL)
+    {
+        *r_pobj = ((pPmListArray_t)((pPmList_t)plist)->val)->la_val[index];
+        return PM_RET_OK;
+    }
+#endif /* HAVE_LIST_ARRAYS */
+
     /* Get item from seglist */
-    retval = seglist_getItem(((pPmList_t)plist)->val, index, r_pobj);
+    retval = seglist_getItem((pSeglist_t)((pPmList_t)plist)->val, index,
+                             r_pobj);
     return retval;
 }
 
@@ -94,6 +237,9 @@ list_insert(pPmObj_t plist, int16_t index, pPmObj_t pobj)
     PmReturn_t retval;
     int16_t len;
     uint8_t objid;
+#ifdef HAVE_LIST_ARRAYS
+    pPmListArray_t parray;
+#endif /* HAVE_LIST_ARRAYS */
 
     C_ASSERT(plist != C_NULL);
     C_ASSERT(pobj != C_NULL);
@@ -120,16 +266,35 @@ list_insert(pPmObj_t plist, int16_t index, pPmObj_t pobj)
         index = len;
     }
 
+#ifdef HAVE_LIST_ARRAYS
+    retval = list_makeRoom((pPmList_t)plist, pobj);
+    PM_RETURN_IF_ERROR(retval);
+
+    /* Move the items after the index up one slot */
+    parray = LIST_GET_ARRAY(plist);
+    if (parray != C_NULL)
+    {
+        sli_memmove((unsigned char *)&parray->la_val[index + 1],
+                    (unsigned char const *)&parray->la_val[index],
+                    (len - index) * sizeof(pPmObj_t));
+        parray->la_val[index] = pobj;
+        HEAP_GC_WRITE_BARRIER(plist, pobj);
+        ((pPmList_t)plist)->length++;
+        return retval;
+    }
+#else
     /* Create new seglist if needed */
     if (((pPmList_t)plist)->length == 0)
     {
-        retval = seglist_new(&((pPmList_t)plist)->val);
+        retval = seglist_new((pSeglist_t *)&((pPmList_t)plist)->val);
         PM_RETURN_IF_ERROR(retval);
     }
+#endif /* HAVE_LIST_ARRAYS */
 
     /* Insert the item in the container */
     heap_gcPushTempRoot((pPmObj_t)((pPmList_t)plist)->val, &objid);
-    retval = seglist_insertItem(((pPmList_t)plist)->val, pobj, index);
+    retval = seglist_insertItem((pSeglist_t)((pPmList_t)plist)->val, pobj,
+                                index);
     heap_gcPopTempRoot(objid);
     PM_RETURN_IF_ERROR(retval);
 
@@ -234,8 +399,18 @@ list_setItem(pPmObj_t plist, int16_t index, pPmObj_t pobj)
         return retval;
     }
 
+#ifdef HAVE_LIST_ARRAYS
+    if (LIST_GET_ARRAY(plist) != C_NULL)
+    {
+        ((pPmListArray_t)((pPmList_t)plist)->val)->la_val[index] = pobj;
+        HEAP_GC_WRITE_BARRIER(plist, pobj);
+        return PM_RET_OK;
+    }
+#endif /* HAVE_LIST_ARRAYS */
+
     /* Set the item */
-    retval = seglist_setItem(((pPmList_t)plist)->val, pobj, index);
+    retval = seglist_setItem((pSeglist_t)((pPmList_t)plist)->val, pobj,
+                             index);
     return retval;
 }
 
@@ -258,16 +433,7 @@ list_remove(pPmObj_t plist, pPmObj_t item)
     PM_RETURN_IF_ERROR(retval);
 
     /* Remove the item and decrement the list length */
-    retval = seglist_removeItem(((pPmList_t)plist)->val, index);
-    ((pPmList_t)plist)->length--;
-
-    /* Unlink seglist if there are no contents */
-    if (((pPmList_t)plist)->length == 0)
-    {
-        ((pPmList_t)plist)->val = C_NULL;
-    }
-
-    return retval;
+    return list_delItem(plist, (int16_t)index);
 }
 
 
@@ -275,7 +441,6 @@ PmReturn_t
 list_index(pPmObj_t plist, pPmObj_t pitem, uint16_t *r_index)
 {
     PmReturn_t retval = PM_RET_OK;
-    pSeglist_t pseglist;
     pPmObj_t pobj;
     uint16_t index;
 
@@ -293,12 +458,10 @@ list_index(pPmObj_t plist, pPmObj_t pitem, uint16_t *r_index)
         return retval;
     }
 
-    pseglist = ((pPmList_t)plist)->val;
-
     /* Iterate over the list's contents */
-    for (index = 0; index < pseglist->sl_length; index++)
+    for (index = 0; index < ((pPmList_t)plist)->length; index++)
     {
-        retval = seglist_getItem(pseglist, index, &pobj);
+        retval = list_getItem(plist, (int16_t)index, &pobj);
         PM_RETURN_IF_ERROR(retval);
 
         /* If the list item matches the given item, return the index */
@@ -317,6 +480,9 @@ PmReturn_t
 list_delItem(pPmObj_t plist, int16_t index)
 {
     PmReturn_t retval = PM_RET_OK;
+#ifdef HAVE_LIST_ARRAYS
+    pPmListArray_t parray;
+#endif /* HAVE_LIST_ARRAYS */
 
     /* If it's not a list, raise TypeError */
     if (OBJ_GET_TYPE(plist) != OBJ_TYPE_LST)
@@ -338,8 +504,22 @@ list_delItem(pPmObj_t plist, int16_t index)
         return retval;
     }
 
+#ifdef HAVE_LIST_ARRAYS
+    /* Move the items after the index down one slot, clear the last slot */
+    parray = LIST_GET_ARRAY(plist);
+    if (parray != C_NULL)
+    {
+        ((pPmList_t)plist)->length--;
+        sli_memmove((unsigned char *)&parray->la_val[index],
+                    (unsigned char const *)&parray->la_val[index + 1],
+                    (((pPmList_t)plist)->length - index) * sizeof(pPmObj_t));
+        parray->la_val[((pPmList_t)plist)->length] = C_NULL;
+        return retval;
+    }
+#endif /* HAVE_LIST_ARRAYS */
+
     /* Remove the item and decrement the list length */
-    retval = seglist_removeItem(((pPmList_t)plist)->val, index);
+    retval = seglist_removeItem((pSeglist_t)((pPmList_t)plist)->val, index);
     ((pPmList_t)plist)->length--;
 
     /* Unlink seglist if there are no contents */
@@ -358,7 +538,6 @@ list_print(pPmObj_t plist)
 {
     PmReturn_t retval = PM_RET_OK;
     int16_t index;
-    pSeglist_t vals;
     pPmObj_t pobj1;
 
     C_ASSERT(plist != C_NULL);
@@ -372,8 +551,6 @@ list_print(pPmObj_t plist)
 
     plat_putByte('[');
 
-    vals = ((pPmList_t)plist)->val;
-
     /* Iterate over the list's contents */
     for (index = 0; index < ((pPmList_t)plist)->length; index++)
     {
@@ -384,7 +561,7 @@ list_print(pPmObj_t plist)
         }
 
         /* Print each item */
-        retval = seglist_getItem(vals, index, &pobj1);
+        retval = list_getItem(plist, index, &pobj1);
         PM_RETURN_IF_ERROR(retval);
         retval = obj_print(pobj1, C_FALSE, C_TRUE);
         PM_RETURN_IF_ERROR(retval);
@@ -441,7 +618,7 @@ list_slice(pPmObj_t plist, pPmObj_t pstart, pPmObj_t pend, pPmObj_t pstride, pPm
         return retval;
     }
 
-    start = ((pPmInt_t)pstart)->val;
+    start = INT_GET_VAL(pstart);
 
     if (start < 0)
     {
@@ -470,7 +647,7 @@ list_slice(pPmObj_t plist, pPmObj_t pstart, pPmObj_t pend, pPmObj_t pstride, pPm
             return retval;
         }
 
-        end = ((pPmInt_t)pend)->val;
+        end = INT_GET_VAL(pend);
 
         if (end < 0)
         {
@@ -494,7 +671,7 @@ list_slice(pPmObj_t plist, pPmObj_t pstart, pPmObj_t pend, pPmObj_t pstride, pPm
         return retval;
     }
 
-    stride = ((pPmInt_t)pstride)-> val;
+    stride = INT_GET_VAL(pstride);
 
     /* Create the sequence to hold the slice */
     retval = list_new(&pslice);
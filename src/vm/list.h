@@ -16,10 +16,34 @@
  * List object type header.
  */
 
+#ifdef HAVE_LIST_ARRAYS
+/**
+ * List item array
+ *
+ * The items of a list, in order, from the start of the array.
+ * The slots past the list's length are C_NULL.
+ */
+typedef struct PmListArray_s
+{
+    /** Object descriptor */
+    PmObjDesc_t od;
+
+    /** Number of slots */
+    uint16_t la_size;
+
+    /** Array of ptrs to items */
+    pPmObj_t la_val[1];
+} PmListArray_t,
+ *pPmListArray_t;
+#endif /* HAVE_LIST_ARRAYS */
+
+
 /**
  * List obj
  *
- * Mutable ordered sequence of objects.  Contains ptr to linked list of nodes.
+ * Mutable ordered sequence of objects.  Contains ptr to linked list of nodes,
+ * or with HAVE_LIST_ARRAYS, ptr to an item array unless the list has
+ * outgrown the largest array.
  */
 typedef struct PmList_s
 {
@@ -29,8 +53,8 @@ typedef struct PmList_s
     /** List length; number of objs linked */
     uint16_t length;
 
-    /** Ptr to linked list of nodes */
-    pSeglist_t val;
+    /** Ptr to seglist or item array; C_NULL while the list is empty */
+    pPmObj_t val;
 } PmList_t,
  *pPmList_t;
 
@@ -31,7 +31,7 @@ obj_loadFromImg(PmMemSpace_t memspace,
 
     /* Get the object descriptor */
     obj.od = (PmObjDesc_t)0x0000;
-    OBJ_SET_TYPE(&obj, mem_getByte(memspace, paddr));
+    OBJ_SET_TYPE_RAW(&obj, mem_getByte(memspace, paddr));
 
     switch (OBJ_GET_TYPE(&obj))
     {
@@ -113,7 +113,7 @@ obj_isFalse(pPmObj_t pobj)
 
         case OBJ_TYPE_INT:
             /* Only the integer zero is false */
-            return ((pPmInt_t)pobj)->val == 0;
+            return INT_GET_VAL(pobj) == 0;
 
 #ifdef HAVE_FLOAT
         case OBJ_TYPE_FLT:
@@ -260,6 +260,24 @@ obj_compare(pPmObj_t pobj1, pPmObj_t pobj2)
         return C_SAME;
     }
 
+#ifdef HAVE_TAGGED_INTS
+    /* An int that fits in a tag is never boxed, so a tagged int is only
+     * equal to itself */
+    if (OBJ_IS_TAGGED(pobj1) || OBJ_IS_TAGGED(pobj2))
+    {
+        return C_DIFFER;
+    }
+#endif /* HAVE_TAGGED_INTS */
+
+#ifdef HAVE_SMALL_INT_CACHE
+    /* A small int is never made twice, so a cached int is only equal
+     * to itself */
+    if (INT_IS_CACHED(pobj1) || INT_IS_CACHED(pobj2))
+    {
+        return C_DIFFER;
+    }
+#endif /* HAVE_SMALL_INT_CACHE */
+
     /* If types are different, objs must differ */
     if (OBJ_GET_TYPE(pobj1) != OBJ_GET_TYPE(pobj2))
     {
@@ -299,8 +317,8 @@ obj_compare(pPmObj_t pobj1, pPmObj_t pobj2)
             return C_SAME;
 
         case OBJ_TYPE_INT:
-            return ((pPmInt_t)pobj1)->val ==
-                ((pPmInt_t)pobj2)->val ? C_SAME : C_DIFFER;
+            return INT_GET_VAL(pobj1) ==
+                INT_GET_VAL(pobj2) ? C_SAME : C_DIFFER;
 
 #ifdef HAVE_FLOAT
         case OBJ_TYPE_FLT:
@@ -334,6 +352,68 @@ obj_compare(pPmObj_t pobj1, pPmObj_t pobj2)
 }
 
 
+#ifdef HAVE_HASHED_DICTS
+uint16_t
+obj_hash(pPmObj_t pobj)
+{
+    uintptr_t a;
+    int32_t n;
+    uint16_t h;
+    int16_t i;
+
+    switch (OBJ_GET_TYPE(pobj))
+    {
+        case OBJ_TYPE_INT:
+            n = INT_GET_VAL(pobj);
+            return (uint16_t)(n ^ (n >> 16));
+
+#ifdef HAVE_FLOAT
+        case OBJ_TYPE_FLT:
+        {
+            union
+            {
+                float f;
+                uint32_t u;
+            } v;
+
+            /* 0.0 and -0.0 are equal but have different bits */
+            v.f = ((pPmFloat_t)pobj)->val;
+            if (v.f == 0.0)
+            {
+                return 0;
+            }
+            return (uint16_t)(v.u ^ (v.u >> 16));
+        }
+#endif /* HAVE_FLOAT */
+
+        case OBJ_TYPE_STR:
+            return string_hash((pPmString_t)pobj);
+
+        case OBJ_TYPE_TUP:
+            h = (uint16_t)((pPmTuple_t)pobj)->length;
+            for (i = 0; i < ((pPmTuple_t)pobj)->length; i++)
+            {
+                h = (uint16_t)((h * 31) + obj_hash(((pPmTuple_t)pobj)->val[i]));
+            }
+            return h;
+
+        /* Unhashable, but obj_compare() finds them equal by contents */
+        case OBJ_TYPE_LST:
+        case OBJ_TYPE_DIC:
+#ifdef HAVE_BYTEARRAY
+        case OBJ_TYPE_BYA:
+#endif /* HAVE_BYTEARRAY */
+            return (uint16_t)OBJ_GET_TYPE(pobj);
+
+        default:
+            /* Equal only to itself; the compactor rehashes it if it moves */
+            a = (uintptr_t)pobj >> 3;
+            return (uint16_t)(a ^ (a >> 16));
+    }
+}
+#endif /* HAVE_HASHED_DICTS */
+
+
 #ifdef HAVE_PRINT
 PmReturn_t
 obj_print(pPmObj_t pobj, uint8_t is_expr_repr, uint8_t is_nested)
@@ -446,7 +526,7 @@ obj_repr(pPmObj_t pobj, pPmObj_t *r_pstr)
     switch (OBJ_GET_TYPE(pobj))
     {
         case OBJ_TYPE_INT:
-            retval = sli_ltoa10(((pPmInt_t)pobj)->val, tBuffer, sizeof(tBuffer));
+            retval = sli_ltoa10(INT_GET_VAL(pobj), tBuffer, sizeof(tBuffer));
             PM_RETURN_IF_ERROR(retval);
             retval = string_new(&pcstr, r_pstr);
             break;
@@ -61,18 +61,40 @@
 /** Gets the size in bytes of the object. */
 #define PM_OBJ_GET_SIZE(pobj) (((pPmObj_t)pobj)->od & OD_SIZE_MASK)
 
+#ifdef HAVE_TAGGED_INTS
+/**
+ * Tells if the object pointer is a tagged int: an int whose value is held
+ * in the pointer itself, which has its least significant bit set.
+ * Objects in the heap are aligned, so no real object pointer has that bit
+ * set.  A tagged int has no object descriptor.
+ */
+#define OBJ_IS_TAGGED(pobj) (((uintptr_t)(pobj) & (uintptr_t)1) != 0)
+
+/**
+ * Gets the type of the object
+ * This MUST NOT be called on objects that are free.
+ */
+#define OBJ_GET_TYPE(pobj) \
+    (OBJ_IS_TAGGED(pobj) \
+     ? OBJ_TYPE_INT \
+     : ((((pPmObj_t)pobj)->od) >> OD_TYPE_SHIFT))
+#else
+/** Tells if the object pointer is a tagged int (never without the feature) */
+#define OBJ_IS_TAGGED(pobj) 0
+
 /**
  * Gets the type of the object
  * This MUST NOT be called on objects that are free.
  */
 #define OBJ_GET_TYPE(pobj) \
     ((((pPmObj_t)pobj)->od) >> OD_TYPE_SHIFT)
+#endif /* HAVE_TAGGED_INTS */
 
 /**
  * Sets the type of the object
  * This MUST NOT be called on objects that are free.
  */
-#define OBJ_SET_TYPE(pobj, type) \
+#define OBJ_SET_TYPE_RAW(pobj, type) \
     do \
     { \
         ((pPmObj_t)pobj)->od &= ~OD_TYPE_MASK; \
@@ -80,6 +102,23 @@
     } \
     while (0)
 
+/**
+ * Sets the type of a new object.
+ * With HAVE_HEAP_STATS, the object is counted in the heap statistics;
+ * use OBJ_SET_TYPE_RAW() for anything that is not a new object.
+ */
+#ifdef HAVE_HEAP_STATS
+#define OBJ_SET_TYPE(pobj, type) \
+    do \
+    { \
+        OBJ_SET_TYPE_RAW(pobj, type); \
+        heap_countObj((PmType_t)(type)); \
+    } \
+    while (0)
+#else
+#define OBJ_SET_TYPE(pobj, type) OBJ_SET_TYPE_RAW(pobj, type)
+#endif /* HAVE_HEAP_STATS */
+
 
 /**
  * Object type enum
@@ -160,6 +199,19 @@ typedef enum PmType_e
     OBJ_TYPE_BYA = 0x14,
 #endif /* HAVE_BYTEARRAY */
 
+#ifdef HAVE_LIST_ARRAYS
+    /** Item array of a list */
+    OBJ_TYPE_LAR = 0x15,
+#endif /* HAVE_LIST_ARRAYS */
+
+    /** String cache (hash set of interned strings) */
+    OBJ_TYPE_STB = 0x16,
+
+#ifdef HAVE_HASHED_DICTS
+    /** Hash table of a dict */
+    OBJ_TYPE_DTB = 0x17,
+#endif /* HAVE_HASHED_DICTS */
+
     /* All types after this are not accessible to the user */
     OBJ_TYPE_ACCESSIBLE_MAX = 0x18,
 
@@ -171,8 +223,10 @@ typedef enum PmType_e
     /** Frame type */
     OBJ_TYPE_FRM = 0x19,
 
-    /** Block type (for,while,try,etc) */
-    OBJ_TYPE_BLK = 0x1A,
+#ifdef HAVE_FRAME_STACK
+    /** Segment of a thread's frame stack */
+    OBJ_TYPE_FST = 0x1A,
+#endif /* HAVE_FRAME_STACK */
 
     /** Segment (within a seglist) */
     OBJ_TYPE_SEG = 0x1B,
@@ -185,6 +239,11 @@ typedef enum PmType_e
 
     /** Native frame (there is only one) */
     OBJ_TYPE_NFM = 0x1E,
+
+#ifdef HAVE_INLINE_CACHES
+    /** Inline cache of a code object */
+    OBJ_TYPE_ICA = 0x1F,
+#endif /* HAVE_INLINE_CACHES */
 } PmType_t, *pPmType_t;
 
 
@@ -300,6 +359,19 @@ PmReturn_t obj_isIn(pPmObj_t pobj, pPmObj_t pitem);
  */
 int8_t obj_compare(pPmObj_t pobj1, pPmObj_t pobj2);
 
+#ifdef HAVE_HASHED_DICTS
+/**
+ * Gets the hash of a hashable object.  Objects that obj_compare() finds
+ * equal have equal hashes.  Ints, floats, strings and tuples hash by
+ * value; objects that are only equal to themselves hash by address.
+ * When the compactor moves those, it rehashes the dict tables.
+ *
+ * @param   pobj Ptr to object
+ * @return  The object's hash
+ */
+uint16_t obj_hash(pPmObj_t pobj);
+#endif /* HAVE_HASHED_DICTS */
+
 /**
  * Print an object, thereby using objects helpers.
  *
@@ -66,4 +66,24 @@ PmReturn_t plat_getMsTicks(uint32_t *r_ticks);
  */
 void plat_reportError(PmReturn_t result);
 
+#ifdef HAVE_HEAP_GROW
+/**
+ * Obtains a new region of memory for the heap.
+ *
+ * @param   size Least number of bytes wanted
+ * @param   r_base Return by reference; the start of the region
+ * @param   r_size Return by reference; the size of the region in bytes
+ * @return  Return code; PM_RET_EX_MEM if no memory could be had
+ */
+PmReturn_t plat_heapGrow(uint32_t size, uint8_t **r_base, uint32_t *r_size);
+
+/**
+ * Gives back a region of memory obtained from plat_heapGrow()
+ *
+ * @param   base The start of the region
+ * @param   size The size of the region in bytes
+ */
+void plat_heapRelease(uint8_t *base, uint32_t size);
+#endif /* HAVE_HEAP_GROW */
+
 #endif /* __PLAT_H__ */
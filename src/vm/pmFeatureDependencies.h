@@ -39,6 +39,187 @@
  * will occur.
  *
  *
+ * HAVE_GC_INCREMENTAL
+ * -------------------
+ *
+ * When defined, the garbage collector also runs incrementally: once per
+ * thread time slice (see pm_vmPeriodic()), interp_reschedule() does a
+ * bounded step of marking or sweeping (HEAP_GC_STEP_BUDGET objects).
+ * Stores into containers go through a write barrier while marking.
+ * A full collection still runs if an allocation fails.
+ * REQUIRES HAVE_GC
+ *
+ *
+ * HAVE_GC_NURSERY
+ * ---------------
+ *
+ * When defined, ints and floats are allocated by bumping a pointer through
+ * a nursery carved from the tail of the heap.  When the nursery is full,
+ * a minor collection keeps only the young objects referenced by the frames,
+ * the temporary roots or the objects in the remembered set; the rest of
+ * the heap is not marked or swept.  Stores into seglists go through a write
+ * barrier; C code that fills a tuple or a frame directly must call
+ * HEAP_GC_RESCAN_BARRIER() on it afterward.
+ * REQUIRES HAVE_GC
+ *
+ *
+ * HAVE_GC_COMPACT
+ * ---------------
+ *
+ * When defined, the heap can be compacted: after a full collection, live
+ * objects slide toward the base of the heap and every pointer to them is
+ * fixed up, leaving one contiguous free region.  interp_reschedule() does
+ * this when the largest free chunk is smaller than
+ * HEAP_GC_COMPACT_THRESHOLD bytes but twice that much memory is free,
+ * and only in an outermost interpret() run (see interpret()).
+ * REQUIRES HAVE_GC
+ *
+ *
+ * HAVE_GC_LAZY_SWEEP
+ * ------------------
+ *
+ * When defined, a full collection only marks.  The heap is swept later, in
+ * address order, by heap_getChunk() whenever the free list cannot satisfy
+ * a request, so the collector's pause depends on the number of live objects
+ * rather than on the size of the heap.
+ * REQUIRES HAVE_GC
+ *
+ *
+ * HAVE_HEAP_POOLS
+ * ---------------
+ *
+ * When defined, segments and sequence iterators (and ints and floats if
+ * there is no nursery) are allocated from per-type pools of fixed-size
+ * slots carved from the tail of the heap.  Allocating and freeing such an
+ * object pops or pushes a free list instead of searching the free bins,
+ * and the GC returns dead objects' slots to their pools.
+ * HEAP_POOL_SLOTS sets the most slots in each pool.
+ *
+ *
+ * HAVE_HEAP_STATS
+ * ---------------
+ *
+ * When defined, the heap counts the chunks and bytes it allocates and the
+ * objects created of each type, for heap_getStats() and sys.gcstats().
+ *
+ *
+ * HAVE_HEAP_GROW
+ * --------------
+ *
+ * When defined, the heap grows when a garbage collection cannot satisfy
+ * a request: it gets a new region of memory from plat_heapGrow() and links
+ * it into the free list.  A region that becomes empty again is handed back
+ * through plat_heapRelease() if the heap would be left no more than half used.
+ * The platform must implement both functions (desktop64 uses mmap).
+ *
+ *
+ * HAVE_THREADED_DISPATCH
+ * ----------------------
+ *
+ * When defined and the compiler is GCC (or compatible), the interpreter
+ * jumps from the end of each bytecode's handler straight to the handler of
+ * the next through a table of label addresses, instead of going back to the
+ * switch statement at the top of the interpret loop.  Threads are then
+ * rescheduled only at calls, returns and backward jumps.  Other compilers
+ * use the switch statement.
+ *
+ *
+ * HAVE_SUPERINSTRUCTIONS
+ * ----------------------
+ *
+ * When defined, pmImgCreator replaces the opcode of the first of two
+ * bytecodes that often come together, such as LOAD_FAST followed by
+ * LOAD_CONST, with a fused opcode whose handler runs both bytecodes
+ * with one dispatch.  The second bytecode stays in the code, so code sizes
+ * and jump targets do not change.  Images must be made with the same
+ * setting as the VM that runs them.
+ *
+ *
+ * HAVE_INLINE_CACHES
+ * ------------------
+ *
+ * When defined, every dict has a version that changes whenever the dict
+ * changes, and each code object keeps a cache of the globals it has looked
+ * up by LOAD_GLOBAL, or by LOAD_NAME at module level.  A cached global is
+ * used while the versions of the globals and builtins dicts still match,
+ * which saves two dict lookups.  A second cache keeps, for a few classes per
+ * name, the attrs that LOAD_ATTR finds in a class, and which STORE_ATTRs
+ * into instances need no check.  An attr cache entry is used while neither
+ * the class nor its bases have changed.  The caches take RAM per name in
+ * a code object and the versions take four bytes per dict, which a small
+ * fixed heap may not spare.
+ *
+ *
+ * HAVE_FAST_CALLS
+ * ---------------
+ *
+ * When defined, co_loadFromImg() sets CO_FASTCALL in the flags of each code
+ * object that is not a generator and has no cellvars or freevars.
+ * CALL_FUNCTION calls a func with such code and exactly co_argcount args
+ * by popping the args into a new frame's locals.  It skips the checks for
+ * generators, classes, methods, natives, default args and closures.
+ *
+ *
+ * HAVE_TAGGED_INTS
+ * ----------------
+ *
+ * When defined, an int is held in the object pointer itself, with the
+ * pointer's least significant bit set, instead of in a heap chunk.  Int
+ * arithmetic then allocates nothing and the GC never sees ints.  Where a
+ * pointer has only 32 bits, an int outside -2**30 .. 2**30-1 is boxed as
+ * before.  C code must read an int's value with INT_GET_VAL() and must
+ * test OBJ_IS_TAGGED() before it touches an object's descriptor.
+ *
+ *
+ * HAVE_SMALL_INT_CACHE
+ * --------------------
+ *
+ * When defined, the ints from INT_CACHE_MIN to INT_CACHE_MAX (by default
+ * -5 to 1024) are made once, in the global struct, and int_new() returns
+ * them instead of allocating.  They are never collected or moved.  This is
+ * for targets that keep boxed ints; it costs sizeof(PmInt_t) of RAM per
+ * cached int.
+ * EXCLUDES HAVE_TAGGED_INTS
+ *
+ *
+ * HAVE_FRAME_STACK
+ * ----------------
+ *
+ * When defined, each thread keeps a stack of frames in a chain of segments
+ * of at least FRAME_STACK_SIZE bytes.  A call bumps the top of the stack to
+ * make the callee's frame and a return pops it, so calls do not allocate
+ * from or free to the heap.  One empty segment is kept above the current
+ * one, so recursion at a segment boundary does not allocate either.
+ * Generator frames, and frames made by eval() or for a new thread, are still
+ * allocated from the heap because they outlive their caller, as is a frame
+ * for which no segment can be allocated.  The segments hold on to their
+ * memory, so this suits a heap that can grow more than a small fixed one.
+ *
+ *
+ * HAVE_HASHED_DICTS
+ * -----------------
+ *
+ * When defined, a dict keeps its items in an open-addressing hash table
+ * (probed linearly) instead of in a pair of seglists searched from the
+ * start, so a lookup costs one hash and a few compares.  The table doubles
+ * when it is three quarters full (counting deleted slots) and is at most
+ * 32 KB, which holds 2047 items on a 64-bit host (4095 on a 32-bit one);
+ * a dict that outgrows it moves its items to seglists.
+ * Keys that are only equal to themselves hash by address, so with
+ * HAVE_GC_COMPACT the compactor rehashes the tables after moving objects.
+ * A dict is iterated in table order, not insertion order.
+ *
+ *
+ * HAVE_LIST_ARRAYS
+ * ----------------
+ *
+ * When defined, a list keeps its items in one array that doubles when it
+ * is full, instead of in a seglist of 8-item segments, so indexing costs
+ * the same at any position and insert and delete move the items with a
+ * memmove.  A list that outgrows the largest array (just under 64 KB, so
+ * 8159 items on a 64-bit host) moves its items to a seglist.
+ *
+ *
  * HAVE_FLOAT
  * ----------
  *
@@ -161,6 +342,36 @@
 
 /* Check for dependencies */
 
+#if defined(HAVE_GC_INCREMENTAL) && !defined(HAVE_GC)
+#error HAVE_GC_INCREMENTAL requires HAVE_GC
+#endif
+
+
+#if defined(HAVE_GC_NURSERY) && !defined(HAVE_GC)
+#error HAVE_GC_NURSERY requires HAVE_GC
+#endif
+
+
+#if defined(HAVE_GC_COMPACT) && !defined(HAVE_GC)
+#error HAVE_GC_COMPACT requires HAVE_GC
+#endif
+
+
+#if defined(HAVE_GC_LAZY_SWEEP) && !defined(HAVE_GC)
+#error HAVE_GC_LAZY_SWEEP requires HAVE_GC
+#endif
+
+
+#if defined(HAVE_HEAP_GROW) && !defined(HAVE_GC)
+#error HAVE_HEAP_GROW requires HAVE_GC
+#endif
+
+
+#if defined(HAVE_SMALL_INT_CACHE) && defined(HAVE_TAGGED_INTS)
+#error HAVE_SMALL_INT_CACHE and HAVE_TAGGED_INTS exclude each other
+#endif
+
+
 #if defined(HAVE_ASSERT) && !defined(HAVE_CLASSES)
 #error HAVE_ASSERT requires HAVE_CLASSES
 #endif
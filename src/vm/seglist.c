@@ -76,6 +76,7 @@ seglist_clear(pSeglist_t pseglist)
 #endif
 
     /* Clear seglist fields */
+    gVmGlobal.segUnlinks++;
     ((pSeglist_t)pseglist)->sl_rootseg = C_NULL;
     ((pSeglist_t)pseglist)->sl_lastseg = C_NULL;
     ((pSeglist_t)pseglist)->sl_length = 0;
@@ -119,7 +120,8 @@ seglist_findEqual(pSeglist_t pseglist, pPmObj_t pobj, int16_t *r_index)
             }
 
             /* If items are equal, return with index of found item */
-            if (obj_compare(pobj, pseg->s_val[segindex]) == C_SAME)
+            if ((pobj == pseg->s_val[segindex])
+                || (obj_compare(pobj, pseg->s_val[segindex]) == C_SAME))
             {
                 return PM_RET_OK;
             }
@@ -174,17 +176,29 @@ seglist_insertItem(pSeglist_t pseglist, pPmObj_t pobj, int16_t index)
 
     C_ASSERT(index <= pseglist->sl_length);
 
+    /* Raise a MemoryError if the length would overflow */
+    if (pseglist->sl_length == (int16_t)0x7FFF)
+    {
+        PM_RAISE(retval, PM_RET_EX_MEM);
+        return retval;
+    }
+
     /* If a new seg is needed */
     if ((pseglist->sl_length % SEGLIST_OBJS_PER_SEG) == 0)
     {
         /* Alloc and init new segment */
+#ifdef HAVE_HEAP_POOLS
+        retval = heap_getPoolChunk(OBJ_TYPE_SEG, sizeof(Segment_t), &pchunk);
+#else
         retval = heap_getChunk(sizeof(Segment_t), &pchunk);
+#endif /* HAVE_HEAP_POOLS */
         PM_RETURN_IF_ERROR(retval);
         pseg = (pSegment_t)pchunk;
         OBJ_SET_TYPE(pseg, OBJ_TYPE_SEG);
         sli_memset((unsigned char *)pseg->s_val,
                    0, SEGLIST_OBJS_PER_SEG * sizeof(pPmObj_t));
         pseg->next = C_NULL;
+        HEAP_GC_WRITE_BARRIER(pseglist, pseg);
 
         /* If this is the first seg, set as root */
         if (pseglist->sl_rootseg == C_NULL)
@@ -212,6 +226,7 @@ seglist_insertItem(pSeglist_t pseglist, pPmObj_t pobj, int16_t index)
     }
 
     /* Insert obj and ripple copy all those afterward */
+    HEAP_GC_WRITE_BARRIER(pseglist, pobj);
     indx = index % SEGLIST_OBJS_PER_SEG;;
     pobj1 = pobj;
     while (pobj1 != C_NULL)
@@ -246,6 +261,9 @@ seglist_new(pSeglist_t *r_pseglist)
     (*r_pseglist)->sl_rootseg = C_NULL;
     (*r_pseglist)->sl_lastseg = C_NULL;
     (*r_pseglist)->sl_length = 0;
+
+    /* The new seglist is about to be stored in its container */
+    HEAP_GC_WRITE_BARRIER(C_NULL, *r_pseglist);
     return retval;
 }
 
@@ -268,6 +286,7 @@ seglist_setItem(pSeglist_t pseglist, pPmObj_t pobj, int16_t index)
     }
 
     /* Set item in this seg at the index */
+    HEAP_GC_WRITE_BARRIER(pseglist, pobj);
     pseg->s_val[index % SEGLIST_OBJS_PER_SEG] = pobj;
     return PM_RET_OK;
 }
@@ -320,6 +339,8 @@ seglist_removeItem(pSeglist_t pseglist, uint16_t index)
     /* Remove the last segment if it was emptied */
     if (pseglist->sl_length % SEGLIST_OBJS_PER_SEG == 0)
     {
+        /* Iterators may hold the segment; make them find theirs again */
+        gVmGlobal.segUnlinks++;
         pseg = pseglist->sl_rootseg;
 
         /* Find the segment before the last */
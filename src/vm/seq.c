@@ -145,7 +145,11 @@ PmReturn_t
 seq_getSubscript(pPmObj_t pobj, int16_t index, pPmObj_t *r_pobj)
 {
     PmReturn_t retval;
+#ifdef HAVE_HASHED_DICTS
+    uint16_t i;
+#else
     pSeglist_t pkeys;
+#endif /* HAVE_HASHED_DICTS */
     uint8_t c;
 
     switch (OBJ_GET_TYPE(pobj))
@@ -189,8 +193,26 @@ seq_getSubscript(pPmObj_t pobj, int16_t index, pPmObj_t *r_pobj)
 
         /* Issue #176 Add support to iterate over keys in a dict */
         case OBJ_TYPE_DIC:
+#ifdef HAVE_HASHED_DICTS
+            /* Count the keys in table order up to the index */
+            if (index < 0)
+            {
+                PM_RAISE(retval, PM_RET_EX_INDX);
+                break;
+            }
+            i = 0;
+            do
+            {
+                retval = dict_getNext(pobj, &i, r_pobj, C_NULL);
+            } while ((retval == PM_RET_OK) && (--index >= 0));
+            if (retval == PM_RET_NO)
+            {
+                PM_RAISE(retval, PM_RET_EX_INDX);
+            }
+#else
             pkeys = ((pPmDict_t)pobj)->d_keys;
             retval = seglist_getItem(pkeys, index, r_pobj);
+#endif /* HAVE_HASHED_DICTS */
             break;
 
         default:
@@ -203,38 +225,145 @@ seq_getSubscript(pPmObj_t pobj, int16_t index, pPmObj_t *r_pobj)
 }
 
 
+/*
+ * Returns the item at the iterator's index in the given seglist and moves
+ * the iterator's cursor past it.  The cursor is only trusted while no
+ * segment has been unlinked since it was found; a seglist only links new
+ * segments at its end, so until then the segment at each position stays put.
+ */
+static PmReturn_t
+seqiter_getSegItem(pPmSeqIter_t psi, pSeglist_t pseglist, pPmObj_t *r_pitem)
+{
+    pSegment_t pseg;
+    uint8_t offset;
+    int16_t i;
+
+    /* Walk out to the segment if the cursor is unset or stale */
+    pseg = psi->si_seg;
+    if ((pseg == C_NULL) || (psi->si_unlinks != gVmGlobal.segUnlinks))
+    {
+        pseg = pseglist->sl_rootseg;
+        for (i = (psi->si_index / SEGLIST_OBJS_PER_SEG); i > 0; i--)
+        {
+            pseg = pseg->next;
+            C_ASSERT(pseg != C_NULL);
+        }
+        psi->si_unlinks = gVmGlobal.segUnlinks;
+    }
+
+    offset = psi->si_index % SEGLIST_OBJS_PER_SEG;
+    *r_pitem = pseg->s_val[offset];
+
+    /* Step to the next segment after the last item of this one */
+    if (offset == (SEGLIST_OBJS_PER_SEG - 1))
+    {
+        pseg = pseg->next;
+    }
+    psi->si_seg = pseg;
+
+    return PM_RET_OK;
+}
+
+
 PmReturn_t
 seqiter_getNext(pPmObj_t pobj, pPmObj_t *r_pitem)
 {
-    PmReturn_t retval;
+    PmReturn_t retval = PM_RET_OK;
+    pPmSeqIter_t psi;
+    pPmObj_t pseq;
+    pSeglist_t pseglist = C_NULL;
     uint16_t length;
 
     C_ASSERT(pobj != C_NULL);
     C_ASSERT(*r_pitem != C_NULL);
     C_ASSERT(OBJ_GET_TYPE(pobj) == OBJ_TYPE_SQI);
 
+    psi = (pPmSeqIter_t)pobj;
+    pseq = psi->si_sequence;
+
+    /* Raise StopIteration if the iterator is spent */
+    if (pseq == C_NULL)
+    {
+        PM_RAISE(retval, PM_RET_EX_STOP);
+        return retval;
+    }
+
+#ifdef HAVE_HASHED_DICTS
+    /* A dict's iterator keeps its position in the dict's table */
+    if ((OBJ_GET_TYPE(pseq) == OBJ_TYPE_DIC)
+        && (DICT_GET_KEYS(pseq) == C_NULL))
+    {
+        length = (uint16_t)psi->si_index;
+        retval = dict_getNext(pseq, &length, r_pitem, C_NULL);
+        if (retval == PM_RET_NO)
+        {
+            psi->si_sequence = C_NULL;
+            PM_RAISE(retval, PM_RET_EX_STOP);
+            return retval;
+        }
+        psi->si_index = (int16_t)length;
+        return retval;
+    }
+#endif /* HAVE_HASHED_DICTS */
+
     /*
      * Raise TypeError if sequence iterator's object is not a sequence
      * otherwise, the get sequence's length
      */
-    retval = seq_getLength(((pPmSeqIter_t)pobj)->si_sequence, &length);
+    retval = seq_getLength(pseq, &length);
     PM_RETURN_IF_ERROR(retval);
 
-    /* Raise StopIteration if at the end of the sequence */
-    if (((pPmSeqIter_t)pobj)->si_index == length)
+    /* Raise StopIteration at the end, or if the sequence shrank past it */
+    if ((uint16_t)psi->si_index >= length)
     {
         /* Make null the pointer to the sequence */
-        ((pPmSeqIter_t)pobj)->si_sequence = C_NULL;
+        psi->si_sequence = C_NULL;
+        psi->si_seg = C_NULL;
         PM_RAISE(retval, PM_RET_EX_STOP);
         return retval;
     }
 
-    /* Get the item at the current index */
-    retval = seq_getSubscript(((pPmSeqIter_t)pobj)->si_sequence,
-                              ((pPmSeqIter_t)pobj)->si_index, r_pitem);
+    /* Get the item at the current index without a bounds check or walk */
+    switch (OBJ_GET_TYPE(pseq))
+    {
+        case OBJ_TYPE_STR:
+            retval = string_newFromChar(
+                ((pPmString_t)pseq)->val[psi->si_index], r_pitem);
+            break;
+
+        case OBJ_TYPE_TUP:
+            *r_pitem = ((pPmTuple_t)pseq)->val[psi->si_index];
+            break;
+
+        case OBJ_TYPE_LST:
+#ifdef HAVE_LIST_ARRAYS
+            if (OBJ_GET_TYPE(((pPmList_t)pseq)->val) == OBJ_TYPE_LAR)
+            {
+                *r_pitem = ((pPmListArray_t)((pPmList_t)pseq)->val)
+                    ->la_val[psi->si_index];
+                break;
+            }
+#endif /* HAVE_LIST_ARRAYS */
+            pseglist = (pSeglist_t)((pPmList_t)pseq)->val;
+            break;
+
+        case OBJ_TYPE_DIC:
+            pseglist = DICT_GET_KEYS(pseq);
+            break;
+
+        default:
+            retval = seq_getSubscript(pseq, psi->si_index, r_pitem);
+            break;
+    }
+
+    /* Follow the cursor through a seglist */
+    if (pseglist != C_NULL)
+    {
+        retval = seqiter_getSegItem(psi, pseglist, r_pitem);
+    }
 
     /* Increment the index */
-    ((pPmSeqIter_t)pobj)->si_index++;
+    psi->si_index++;
 
     return retval;
 }
@@ -254,6 +383,9 @@ seqiter_new(pPmObj_t pobj, pPmObj_t *r_pobj)
     if ((OBJ_GET_TYPE(pobj) != OBJ_TYPE_STR)
         && (OBJ_GET_TYPE(pobj) != OBJ_TYPE_TUP)
         && (OBJ_GET_TYPE(pobj) != OBJ_TYPE_LST)
+#ifdef HAVE_BYTEARRAY
+        && (OBJ_GET_TYPE(pobj) != OBJ_TYPE_BYA)
+#endif /* HAVE_BYTEARRAY */
         && (OBJ_GET_TYPE(pobj) != OBJ_TYPE_DIC))
     {
         PM_RAISE(retval, PM_RET_EX_TYPE);
@@ -261,7 +393,11 @@ seqiter_new(pPmObj_t pobj, pPmObj_t *r_pobj)
     }
 
     /* Alloc a chunk for the sequence iterator obj */
+#ifdef HAVE_HEAP_POOLS
+    retval = heap_getPoolChunk(OBJ_TYPE_SQI, sizeof(PmSeqIter_t), &pchunk);
+#else
     retval = heap_getChunk(sizeof(PmSeqIter_t), &pchunk);
+#endif /* HAVE_HEAP_POOLS */
     PM_RETURN_IF_ERROR(retval);
 
     /* Set the sequence iterator's fields */
@@ -269,6 +405,8 @@ seqiter_new(pPmObj_t pobj, pPmObj_t *r_pobj)
     OBJ_SET_TYPE(psi, OBJ_TYPE_SQI);
     psi->si_sequence = pobj;
     psi->si_index = 0;
+    psi->si_seg = C_NULL;
+    psi->si_unlinks = 0;
 
     *r_pobj = (pPmObj_t)psi;
     return retval;
@@ -21,6 +21,9 @@
  *
  * Instances of this object are created by GET_ITER and used by FOR_ITER.
  * Stores a pointer to a sequence and an index int16_t.
+ * A seglist-backed sequence is also given a cursor: the segment that holds
+ * the item at the index, so each step costs O(1) instead of a walk
+ * from the root segment.
  */
 typedef struct PmSeqIter_s
 {
@@ -32,6 +35,12 @@ typedef struct PmSeqIter_s
 
     /** Index value */
     int16_t si_index;
+
+    /** Segment holding the item at si_index, or C_NULL when not known */
+    struct Segment_s *si_seg;
+
+    /** Value of gVmGlobal.segUnlinks when si_seg was found */
+    uint32_t si_unlinks;
 } PmSeqIter_t,
  *pPmSeqIter_t;
 
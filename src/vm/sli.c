@@ -73,6 +73,22 @@ sli_memcpy(unsigned char *to, unsigned char const *from, unsigned int n)
 }
 
 
+void *
+sli_memmove(unsigned char *to, unsigned char const *from, unsigned int n)
+{
+    /* Copy backwards if the destination overlaps the end of the source */
+    if ((to > from) && (to < from + n))
+    {
+        for (; n > 0; n--)
+        {
+            to[n - 1] = from[n - 1];
+        }
+        return to;
+    }
+    return sli_memcpy(to, from, n);
+}
+
+
 int
 sli_strlen(char const *s)
 {
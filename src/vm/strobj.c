@@ -21,21 +21,193 @@
 
 
 #if USE_STRING_CACHE
-/** String obj cachche: a list of all string objects. */
-static pPmString_t pstrcache = C_NULL;
+/** String obj cache: a hash set of the interned strings */
+static pPmStringTable_t pstrcache = C_NULL;
+
+/** The fewest slots in the string cache */
+#define STRING_CACHE_MIN_SIZE 32
+
+/**
+ * The most slots in the string cache: the largest power of two whose slots
+ * take at most 32 KB, so the cache always fits in one chunk.
+ */
+#define STRING_CACHE_MAX_SIZE ((uint16_t)(0x8000 / sizeof(pPmString_t)))
+
+
+/*
+ * Moves the cached strings to a new table with room for at least one more
+ * string.  The new table has no deleted slots, and its strings fill at most
+ * half of it.  A table at the largest size with no deleted slots is kept.
+ * Returns PM_RET_NO if the cache is full at its largest size.
+ */
+static PmReturn_t
+string_cacheResize(void)
+{
+    PmReturn_t retval = PM_RET_OK;
+    pPmStringTable_t pold = pstrcache;
+    pPmStringTable_t pnew;
+    uint8_t *pchunk;
+    uint16_t count;
+    uint16_t size;
+    uint16_t mask;
+    uint16_t i;
+    uint16_t j;
+
+    count = (pold != C_NULL) ? pold->count : 0;
+    size = STRING_CACHE_MIN_SIZE;
+    while ((size < STRING_CACHE_MAX_SIZE)
+           && (size < (((uint32_t)count + 1) << 1)))
+    {
+        size <<= 1;
+    }
+
+    /* Keep an empty slot to end every probe */
+    if ((uint32_t)count + 1 >= size)
+    {
+        return PM_RET_NO;
+    }
+
+    /* A table at its largest size with no deleted slots is kept as is */
+    if ((pold != C_NULL) && (pold->length == size)
+        && (pold->fill == pold->count))
+    {
+        return retval;
+    }
+
+    retval = heap_getChunk(sizeof(PmStringTable_t)
+                           + (size - 1) * sizeof(pPmString_t), &pchunk);
+    PM_RETURN_IF_ERROR(retval);
+    pnew = (pPmStringTable_t)pchunk;
+    OBJ_SET_TYPE(pnew, OBJ_TYPE_STB);
+    pnew->length = size;
+    pnew->count = 0;
+    pnew->fill = 0;
+    sli_memset((unsigned char *)pnew->st_slot, 0,
+               size * sizeof(pPmString_t));
+
+    /* The allocation may have run the GC, which deletes strings */
+    pold = pstrcache;
+    if (pold != C_NULL)
+    {
+        mask = size - 1;
+        pnew->count = pold->count;
+        pnew->fill = pold->count;
+        for (i = 0; i < pold->length; i++)
+        {
+            if ((pold->st_slot[i] != C_NULL)
+                && (pold->st_slot[i] != (pPmString_t)PM_NONE))
+            {
+                j = pold->st_slot[i]->hash & mask;
+                while (pnew->st_slot[j] != C_NULL)
+                {
+                    j = (j + 1) & mask;
+                }
+                pnew->st_slot[j] = pold->st_slot[i];
+            }
+        }
+        retval = heap_freeChunk((pPmObj_t)pold);
+    }
+
+    pstrcache = pnew;
+    return retval;
+}
 #endif /* USE_STRING_CACHE */
 
 
+PmReturn_t
+string_intern(pPmObj_t pstr, pPmObj_t *r_pstring)
+{
+#if USE_STRING_CACHE
+    PmReturn_t retval = PM_RET_OK;
+    pPmString_t *pslot;
+    pPmString_t *pdeleted;
+    uint16_t hash;
+    uint16_t mask;
+    uint16_t i;
+    uint8_t objid;
+
+    *r_pstring = pstr;
+    if (((pPmString_t)pstr)->interned)
+    {
+        return retval;
+    }
+
+    /* Every cached string is hashed, so its slot is found by its hash */
+    hash = string_hash((pPmString_t)pstr);
+
+    /* Grow the cache before three quarters of its slots are used */
+    if ((pstrcache == C_NULL)
+        || (((uint32_t)pstrcache->fill + 1) * 4
+            > (uint32_t)pstrcache->length * 3))
+    {
+        /* The string is not yet referenced by anything the GC sees */
+        heap_gcPushTempRoot(pstr, &objid);
+        retval = string_cacheResize();
+        heap_gcPopTempRoot(objid);
+
+        /* A string that does not fit is returned uninterned */
+        if ((retval == PM_RET_NO) || (pstrcache == C_NULL))
+        {
+            return PM_RET_OK;
+        }
+        PM_RETURN_IF_ERROR(retval);
+    }
+
+    /* Look for a twin from the slot the hash selects */
+    mask = pstrcache->length - 1;
+    pdeleted = C_NULL;
+    for (i = hash & mask; ; i = (i + 1) & mask)
+    {
+        pslot = &pstrcache->st_slot[i];
+        if (*pslot == C_NULL)
+        {
+            break;
+        }
+        if (*pslot == (pPmString_t)PM_NONE)
+        {
+            if (pdeleted == C_NULL)
+            {
+                pdeleted = pslot;
+            }
+        }
+        else if (string_compare(*pslot, (pPmString_t)pstr) == C_SAME)
+        {
+            /* The twin may be unmarked while the GC marks; keep it alive */
+            HEAP_GC_WRITE_BARRIER(pstrcache, *pslot);
+            *r_pstring = (pPmObj_t)*pslot;
+            return retval;
+        }
+    }
+
+    /* Insert string obj into cache */
+    if (pdeleted != C_NULL)
+    {
+        pslot = pdeleted;
+    }
+    else
+    {
+        pstrcache->fill++;
+    }
+    pstrcache->count++;
+    *pslot = (pPmString_t)pstr;
+    ((pPmString_t)pstr)->interned = C_TRUE;
+    return retval;
+#else
+    *r_pstring = pstr;
+    return PM_RET_OK;
+#endif /* USE_STRING_CACHE */
+}
+
+
 /* The following 2 ascii values are used to escape printing to ipm */
 #define REPLY_TERMINATOR 0x04
 #define ESCAPE_CHAR 0x1B
 
 
 /*
- * If USE_STRING_CACHE is defined nonzero, the string cache
- * will be searched for an existing String object.
- * If not found, a new object is created and inserted
- * into the cache.
+ * If USE_STRING_CACHE is defined nonzero, a string loaded from an image
+ * is interned: the string cache is searched for an existing String object
+ * and, if one is not found, the new object is inserted into the cache.
  */
 PmReturn_t
 string_create(PmMemSpace_t memspace, uint8_t const **paddr, int16_t len,
@@ -46,10 +218,10 @@ string_create(PmMemSpace_t memspace, uint8_t const **paddr, int16_t len,
     uint8_t *pdst = C_NULL;
     uint8_t const *psrc = C_NULL;
 
+    uint8_t *pchunk;
 #if USE_STRING_CACHE
-    pPmString_t pcacheentry = C_NULL;
+    uint8_t isimg = (len < 0);
 #endif /* USE_STRING_CACHE */
-    uint8_t *pchunk;
 
     /* If loading from an image, get length from the image */
     if (len < 0)
@@ -63,6 +235,13 @@ string_create(PmMemSpace_t memspace, uint8_t const **paddr, int16_t len,
         len = sli_strlen((char const *)*paddr);
     }
 
+    /* Raise a MemoryError for a String too big for the heap to hold */
+    if ((sizeof(PmString_t) + (uint32_t)len * n) > 0xFFFF)
+    {
+        PM_RAISE(retval, PM_RET_EX_MEM);
+        return retval;
+    }
+
     /* Get space for String obj */
     retval = heap_getChunk(sizeof(PmString_t) + len * n, &pchunk);
     PM_RETURN_IF_ERROR(retval);
@@ -71,6 +250,10 @@ string_create(PmMemSpace_t memspace, uint8_t const **paddr, int16_t len,
     /* Fill the string obj */
     OBJ_SET_TYPE(pstr, OBJ_TYPE_STR);
     pstr->length = len * n;
+    pstr->hash = 0;
+#if USE_STRING_CACHE
+    pstr->interned = C_FALSE;
+#endif /* USE_STRING_CACHE */
 
     /* Copy C-string into String obj */
     pdst = (uint8_t *)&(pstr->val);
@@ -84,32 +267,22 @@ string_create(PmMemSpace_t memspace, uint8_t const **paddr, int16_t len,
     *paddr = psrc;
 
     /* Zero-pad end of string */
-    for (; pdst < (uint8_t *)pstr + PM_OBJ_GET_SIZE(pstr); pdst++)
+    for (; pdst < (uint8_t *)pstr + heap_getObjSize((pPmObj_t)pstr); pdst++)
     {
         *pdst = 0;
     }
 
 #if USE_STRING_CACHE
-    /* Check for twin string in cache */
-    for (pcacheentry = pstrcache;
-         pcacheentry != C_NULL; pcacheentry = pcacheentry->next)
+    /* Names and constants from an image are interned; freed if a twin is */
+    if (isimg)
     {
-        /* If string already exists */
-        if (string_compare(pcacheentry, pstr) == C_SAME)
+        retval = string_intern((pPmObj_t)pstr, r_pstring);
+        if ((retval == PM_RET_OK) && (*r_pstring != (pPmObj_t)pstr))
         {
-            /* Free the string */
             retval = heap_freeChunk((pPmObj_t)pstr);
-
-            /* Return ptr to old */
-            *r_pstring = (pPmObj_t)pcacheentry;
-            return retval;
         }
+        return retval;
     }
-
-    /* Insert string obj into cache */
-    pstr->next = pstrcache;
-    pstrcache = pstr;
-
 #endif /* USE_STRING_CACHE */
 
     *r_pstring = (pPmObj_t)pstr;
@@ -128,13 +301,8 @@ string_newFromChar(uint8_t const c, pPmObj_t *r_pstring)
     cstr[1] = '\0';
     pcstr = cstr;
 
-    retval = string_new(&pcstr, r_pstring);
-
-    /* If c was a null character, force the length to 1 */
-    if (c == '\0')
-    {
-        ((pPmString_t)*r_pstring)->length = 1;
-    }
+    /* Give the length so that a null character is kept */
+    retval = string_newWithLen(&pcstr, 1, r_pstring);
 
     return retval;
 }
@@ -160,9 +328,10 @@ string_newFromLength(uint16_t len, pPmObj_t *r_pstring)
     /* Fill the string obj */
     OBJ_SET_TYPE(pstr, OBJ_TYPE_STR);
     pstr->length = len;
+    pstr->hash = 0;
 
 #if USE_STRING_CACHE
-    pstr->next = C_NULL;
+    pstr->interned = C_FALSE;
 #endif
 
     *r_pstring = (pPmObj_t)pstr;
@@ -174,8 +343,23 @@ string_newFromLength(uint16_t len, pPmObj_t *r_pstring)
 int8_t
 string_compare(pPmString_t pstr1, pPmString_t pstr2)
 {
-    /* Return false if lengths are not equal */
-    if (pstr1->length != pstr2->length)
+    if (pstr1 == pstr2)
+    {
+        return C_SAME;
+    }
+
+#if USE_STRING_CACHE
+    /* The cache holds one string of each value */
+    if (pstr1->interned && pstr2->interned)
+    {
+        return C_DIFFER;
+    }
+#endif /* USE_STRING_CACHE */
+
+    /* Return false if lengths or known hashes are not equal */
+    if ((pstr1->length != pstr2->length)
+        || ((pstr1->hash != 0) && (pstr2->hash != 0)
+            && (pstr1->hash != pstr2->hash)))
     {
         return C_DIFFER;
     }
@@ -187,6 +371,32 @@ string_compare(pPmString_t pstr1, pPmString_t pstr2)
 }
 
 
+uint16_t
+string_hash(pPmString_t pstr)
+{
+    uint16_t h;
+    uint16_t i;
+
+    if (pstr->hash != 0)
+    {
+        return pstr->hash;
+    }
+
+    /* Bernstein's hash, truncated to 16 bits; 0 is kept for "not yet" */
+    h = 5381;
+    for (i = 0; i < pstr->length; i++)
+    {
+        h = (uint16_t)((h << 5) + h + pstr->val[i]);
+    }
+    if (h == 0)
+    {
+        h = 1;
+    }
+    pstr->hash = h;
+    return h;
+}
+
+
 #ifdef HAVE_PRINT
 PmReturn_t
 string_printFormattedBytes(uint8_t *pb, uint8_t is_escaped, uint16_t n)
@@ -277,19 +487,21 @@ string_print(pPmObj_t pstr, uint8_t is_escaped)
 PmReturn_t
 string_cacheInit(void)
 {
+#if USE_STRING_CACHE
     pstrcache = C_NULL;
+#endif
 
     return PM_RET_OK;
 }
 
 
 PmReturn_t
-string_getCache(pPmString_t **r_ppstrcache)
+string_getCache(pPmStringTable_t **r_pptable)
 {
 #if USE_STRING_CACHE
-    *r_ppstrcache = &pstrcache;
+    *r_pptable = &pstrcache;
 #else
-    *r_ppstrcache = C_NULL;
+    *r_pptable = C_NULL;
 #endif
     return PM_RET_OK;
 }
@@ -302,9 +514,6 @@ string_concat(pPmString_t pstr1, pPmString_t pstr2, pPmObj_t *r_pstring)
     pPmString_t pstr = C_NULL;
     uint8_t *pdst = C_NULL;
     uint8_t const *psrc = C_NULL;
-#if USE_STRING_CACHE
-    pPmString_t pcacheentry = C_NULL;
-#endif /* USE_STRING_CACHE */
     uint8_t *pchunk;
     uint16_t len;
 
@@ -315,6 +524,10 @@ string_concat(pPmString_t pstr1, pPmString_t pstr2, pPmObj_t *r_pstring)
     pstr = (pPmString_t)pchunk;
     OBJ_SET_TYPE(pstr, OBJ_TYPE_STR);
     pstr->length = len;
+    pstr->hash = 0;
+#if USE_STRING_CACHE
+    pstr->interned = C_FALSE;
+#endif /* USE_STRING_CACHE */
 
     /* Concatenate C-strings into String obj and apply null terminator */
     pdst = (uint8_t *)&(pstr->val);
@@ -324,28 +537,6 @@ string_concat(pPmString_t pstr1, pPmString_t pstr2, pPmObj_t *r_pstring)
     mem_copy(MEMSPACE_RAM, &pdst, &psrc, pstr2->length);
     *pdst = '\0';
 
-#if USE_STRING_CACHE
-    /* Check for twin string in cache */
-    for (pcacheentry = pstrcache;
-         pcacheentry != C_NULL; pcacheentry = pcacheentry->next)
-    {
-        /* If string already exists */
-        if (string_compare(pcacheentry, pstr) == C_SAME)
-        {
-            /* Free the string */
-            retval = heap_freeChunk((pPmObj_t)pstr);
-
-            /* Return ptr to old */
-            *r_pstring = (pPmObj_t)pcacheentry;
-            return retval;
-        }
-    }
-
-    /* Insert string obj into cache */
-    pstr->next = pstrcache;
-    pstrcache = pstr;
-#endif /* USE_STRING_CACHE */
-
     *r_pstring = (pPmObj_t)pstr;
     return PM_RET_OK;
 }
@@ -375,9 +566,6 @@ string_format(pPmString_t pstr, pPmObj_t parg, pPmObj_t *r_pstring)
     uint8_t expectedargcount = 0;
     pPmString_t pnewstr;
     uint8_t *pchunk;
-#if USE_STRING_CACHE
-    pPmString_t pcacheentry = C_NULL;
-#endif /* USE_STRING_CACHE */
 
     /* Get the first arg */
     pobj = parg;
@@ -423,18 +611,18 @@ string_format(pPmString_t pstr, pPmObj_t parg, pPmObj_t *r_pstring)
 #ifdef HAVE_SNPRINTF_FORMAT
                 smallfmtcstr[j] = '\0';
                 fmtretval = snprintf((char *)fmtdbuf, SIZEOF_FMTDBUF,
-                    (char *)smallfmtcstr, ((pPmInt_t)pobj)->val);
+                    (char *)smallfmtcstr, INT_GET_VAL(pobj));
 #else
                 if (fmtcstr[i] == 'd')
                 {
-                    retval = sli_ltoa10(((pPmInt_t)pobj)->val,
+                    retval = sli_ltoa10(INT_GET_VAL(pobj),
                                         fmtdbuf,
                                         sizeof(fmtdbuf));
                     PM_RETURN_IF_ERROR(retval);
                 }
                 else
                 {
-                    sli_ltoa16(((pPmInt_t)pobj)->val,
+                    sli_ltoa16(INT_GET_VAL(pobj),
                                fmtdbuf,
                                sizeof(fmtdbuf),
                                fmtcstr[i] == 'X');
@@ -504,6 +692,10 @@ string_format(pPmString_t pstr, pPmObj_t parg, pPmObj_t *r_pstring)
     pnewstr = (pPmString_t)pchunk;
     OBJ_SET_TYPE(pnewstr, OBJ_TYPE_STR);
     pnewstr->length = strsize;
+    pnewstr->hash = 0;
+#if USE_STRING_CACHE
+    pnewstr->interned = C_FALSE;
+#endif /* USE_STRING_CACHE */
 
     /* Fill contents of String obj */
     strindex = 0;
@@ -552,18 +744,18 @@ string_format(pPmString_t pstr, pPmObj_t parg, pPmObj_t *r_pstring)
 #ifdef HAVE_SNPRINTF_FORMAT
                 smallfmtcstr[j] = '\0';
                 fmtretval = snprintf((char *)fmtdbuf, SIZEOF_FMTDBUF,
-                    (char *)smallfmtcstr, ((pPmInt_t)pobj)->val);
+                    (char *)smallfmtcstr, INT_GET_VAL(pobj));
 #else
                 if (fmtcstr[i] == 'd')
                 {
-                    retval = sli_ltoa10(((pPmInt_t)pobj)->val,
+                    retval = sli_ltoa10(INT_GET_VAL(pobj),
                                         fmtdbuf,
                                         sizeof(fmtdbuf));
                     PM_RETURN_IF_ERROR(retval);
                 }
                 else
                 {
-                    sli_ltoa16(((pPmInt_t)pobj)->val,
+                    sli_ltoa16(INT_GET_VAL(pobj),
                                fmtdbuf,
                                sizeof(fmtdbuf),
                                fmtcstr[i] == 'X');
@@ -611,29 +803,6 @@ string_format(pPmString_t pstr, pPmObj_t parg, pPmObj_t *r_pstring)
     }
     pnewstr->val[strindex] = '\0';
 
-#if USE_STRING_CACHE
-    /* Check for twin string in cache */
-    for (pcacheentry = pstrcache;
-         pcacheentry != C_NULL; pcacheentry = pcacheentry->next)
-    {
-        /* If string already exists */
-        if (string_compare(pcacheentry, pnewstr) == C_SAME)
-        {
-            /* Free the string */
-            retval = heap_freeChunk((pPmObj_t)pnewstr);
-
-            /* Return ptr to old */
-            *r_pstring = (pPmObj_t)pcacheentry;
-            return retval;
-        }
-    }
-
-    /* Insert string obj into cache */
-    pnewstr->next = pstrcache;
-    pstrcache = pnewstr;
-
-#endif /* USE_STRING_CACHE */
-
     *r_pstring = (pPmObj_t)pnewstr;
     return PM_RET_OK;
 }
@@ -663,7 +832,7 @@ string_slice(pPmObj_t pstring, pPmObj_t pstart, pPmObj_t pend, pPmObj_t pstride,
         return retval;
     }
 
-    start = ((pPmInt_t)pstart)->val;
+    start = INT_GET_VAL(pstart);
 
     if (start < 0)
     {
@@ -692,7 +861,7 @@ string_slice(pPmObj_t pstring, pPmObj_t pstart, pPmObj_t pend, pPmObj_t pstride,
             return retval;
         }
 
-        end = ((pPmInt_t)pend)->val;
+        end = INT_GET_VAL(pend);
     }
 
     if (end < 0)
@@ -715,7 +884,7 @@ string_slice(pPmObj_t pstring, pPmObj_t pstart, pPmObj_t pend, pPmObj_t pstride,
         PM_RAISE(retval, PM_RET_EX_TYPE);
         return retval;
     }
-    stride = ((pPmInt_t)pstride)-> val;
+    stride = INT_GET_VAL(pstride);
 
     /* New meaning for variable len */
     if (end > start)
@@ -81,9 +81,12 @@ typedef struct PmString_s
     /** Length of string */
     uint16_t length;
 
+    /** Hash of the chars, or 0 until string_hash() computes it */
+    uint16_t hash;
+
 #if USE_STRING_CACHE
-    /** Ptr to next string in cache */
-    struct PmString_s *next;
+    /** Nonzero if the string is in the cache, which holds no twins */
+    uint8_t interned;
 #endif                          /* USE_STRING_CACHE */
 
     /**
@@ -97,6 +100,31 @@ typedef struct PmString_s
  *pPmString_t;
 
 
+/**
+ * String cache
+ *
+ * An open-addressed hash set of the interned strings.  A string is looked
+ * for from the slot its hash selects, then in the following slots
+ * (wrapping around), up to the first empty slot.  The cache does not keep
+ * its strings alive: the GC deletes the unmarked strings from it before
+ * they are swept.
+ */
+typedef struct PmStringTable_s
+{
+    /** object descriptor */
+    PmObjDesc_t od;
+    /** number of slots, a power of two */
+    uint16_t length;
+    /** number of strings */
+    uint16_t count;
+    /** number of strings and deleted slots */
+    uint16_t fill;
+    /** array of slots: C_NULL if empty, PM_NONE if deleted, else a string */
+    pPmString_t st_slot[1];
+} PmStringTable_t,
+ *pPmStringTable_t;
+
+
 /***************************************************************
  * Prototypes
  **************************************************************/
@@ -143,6 +171,8 @@ PmReturn_t string_newFromChar(uint8_t const c, pPmObj_t *r_pstring);
 
 /**
  * Compares two String objects for equality.
+ * Two strings from the cache are equal only if they are the same object,
+ * and two strings whose hashes are known differ if the hashes do.
  *
  * @param   pstr1 Ptr to first string
  * @param   pstr2 Ptr to second string
@@ -150,6 +180,16 @@ PmReturn_t string_newFromChar(uint8_t const c, pPmObj_t *r_pstring);
  */
 int8_t string_compare(pPmString_t pstr1, pPmString_t pstr2);
 
+/**
+ * Gets the hash of a String object's contents.
+ * The hash is computed on the first call and kept in the string,
+ * so a string's contents must not change once it is hashed.
+ *
+ * @param   pstr Ptr to string
+ * @return  The string's hash, which is never 0
+ */
+uint16_t string_hash(pPmString_t pstr);
+
 #ifdef HAVE_PRINT
 /**
  * Sends out a string object bytewise. Escaping and framing is configurable
@@ -172,8 +212,24 @@ PmReturn_t string_print(pPmObj_t pstr, uint8_t is_escaped);
 PmReturn_t string_cacheInit(void);
 
 
-/** Returns a pointer to the base of the string cache */
-PmReturn_t string_getCache(pPmString_t **r_ppstrcache);
+/** Returns a pointer to the ptr to the string cache */
+PmReturn_t string_getCache(pPmStringTable_t **r_pptable);
+
+/**
+ * Returns the string in the cache that equals the given string.
+ * Puts the given string in the cache if it has no twin there.
+ * The given string is not freed: the caller frees it if it is unused.
+ * Strings loaded from an image are interned when they are created;
+ * other strings are interned only on demand, so transient results
+ * such as concatenations do not fill the cache.
+ * If the cache cannot hold another string, returns the given string
+ * uninterned, which only costs the pointer comparison fast path.
+ *
+ * @param pstr Ptr to string obj
+ * @param r_pstring Return arg; ptr to the interned string
+ * @return Return status
+ */
+PmReturn_t string_intern(pPmObj_t pstr, pPmObj_t *r_pstring);
 
 /**
  * Returns a new string object that is the concatenation
@@ -44,6 +44,9 @@ thread_new(pPmObj_t pframe, pPmObj_t *r_pobj)
     pthread = (pPmThread_t)*r_pobj;
     OBJ_SET_TYPE(pthread, OBJ_TYPE_THR);
     pthread->pframe = (pPmFrame_t)pframe;
+#ifdef HAVE_FRAME_STACK
+    pthread->fstack = C_NULL;
+#endif /* HAVE_FRAME_STACK */
     pthread->interpctrl = INTERP_CTRL_CONT;
 
     return retval;
@@ -57,6 +57,11 @@ typedef struct PmThread_s
     /** current frame pointer */
     pPmFrame_t pframe;
 
+#ifdef HAVE_FRAME_STACK
+    /** Current segment of the thread's frame stack (C_NULL until a call) */
+    pPmFrameStack_t fstack;
+#endif /* HAVE_FRAME_STACK */
+
     /**
      * Interpreter loop control value
      *
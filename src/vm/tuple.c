@@ -21,10 +21,6 @@
 #include "pm.h"
 
 
-/* The follwing value should match that in pmImgCreator.py */
-#define MAX_TUPLE_LEN 253
-
-
 PmReturn_t
 tuple_loadFromImg(PmMemSpace_t memspace,
                   uint8_t const **paddr, pPmObj_t *r_ptuple)
@@ -56,6 +52,7 @@ tuple_loadFromImg(PmMemSpace_t memspace,
             return retval;
         }
         ((pPmTuple_t)*r_ptuple)->length++;
+        HEAP_GC_WRITE_BARRIER(*r_ptuple, ((pPmTuple_t)*r_ptuple)->val[i]);
     }
     heap_gcPopTempRoot(objid);
     return PM_RET_OK;
@@ -68,10 +65,10 @@ tuple_new(uint16_t n, pPmObj_t *r_ptuple)
     PmReturn_t retval = PM_RET_OK;
     uint16_t size = 0;
 
-    /* Raise a SystemError for a Tuple that is too large */
-    if (n > MAX_TUPLE_LEN)
+    /* Raise a MemoryError for a Tuple too big for the heap to hold */
+    if ((sizeof(PmTuple_t) + (uint32_t)n * sizeof(pPmObj_t)) > 0xFFFF)
     {
-        PM_RAISE(retval, PM_RET_EX_SYS);
+        PM_RAISE(retval, PM_RET_EX_MEM);
         return retval;
     }
 
@@ -132,6 +129,7 @@ tuple_replicate(pPmObj_t ptup, int16_t n, pPmObj_t *r_ptuple)
                 ((pPmTuple_t)ptup)->val[j];
         }
     }
+    HEAP_GC_RESCAN_BARRIER(*r_ptuple);
     return retval;
 }
 
@@ -218,7 +216,7 @@ tuple_slice(pPmObj_t ptuple, pPmObj_t pstart, pPmObj_t pend, pPmObj_t pstride, p
         return retval;
     }
 
-    start = ((pPmInt_t)pstart)->val;
+    start = INT_GET_VAL(pstart);
 
     if (start < 0)
     {
@@ -247,7 +245,7 @@ tuple_slice(pPmObj_t ptuple, pPmObj_t pstart, pPmObj_t pend, pPmObj_t pstride, p
             return retval;
         }
 
-        end = ((pPmInt_t)pend)->val;
+        end = INT_GET_VAL(pend);
     }
 
     if (end < 0)
@@ -270,7 +268,7 @@ tuple_slice(pPmObj_t ptuple, pPmObj_t pstart, pPmObj_t pend, pPmObj_t pstride, p
         PM_RAISE(retval, PM_RET_EX_TYPE);
         return retval;
     }
-    stride = ((pPmInt_t)pstride)-> val;
+    stride = INT_GET_VAL(pstride);
 
     /* Redefine meaning of variable len */
     if (end > start)
@@ -291,6 +289,7 @@ tuple_slice(pPmObj_t ptuple, pPmObj_t pstart, pPmObj_t pend, pPmObj_t pstride, p
 
         ((pPmTuple_t)pslice)->val[j++] = pitem;
     }
+    HEAP_GC_RESCAN_BARRIER(pslice);
 
     *r_pslice = pslice;
     return retval;